@@ -0,0 +1,85 @@
+#include "Commands.h"
+#include "../src/statistics/RunSetLoader.h"
+#include "../src/analysis/RunAggregator.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+
+namespace {
+
+QString formatValue(double value)
+{
+    return QString::number(value, 'g', 6);
+}
+
+}
+
+int runAggregate(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Aggregate every counter across runs: mean, stddev, min/max and p5/p50/p95.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("paths", "statistic.txt files or directories searched recursively.", "<paths...>");
+    QCommandLineOption filterOption("filter", "Only report columns matching this regular expression.", "regex");
+    QCommandLineOption csvOption("csv", "Print comma-separated values instead of a table.");
+    parser.addOptions({filterOption, csvOption});
+    parser.process(QStringList{"ppv-cli aggregate"} + arguments);
+
+    if (parser.positionalArguments().isEmpty()) {
+        parser.showHelp(2);
+    }
+
+    QRegularExpression filter(parser.value(filterOption));
+    if (!filter.isValid()) {
+        err() << "Invalid --filter: " << filter.errorString() << "\n";
+        return 2;
+    }
+
+    QStringList files = RunSetLoader::discoverRuns(parser.positionalArguments());
+    if (files.isEmpty()) {
+        err() << "No statistic.txt found\n";
+        return 2;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    CounterStore store;
+    RunSetLoader loader;
+    loader.load(files, store);
+    qint64 loadMs = timer.restart();
+
+    RunAggregator aggregator;
+    aggregator.aggregate(store);
+    qint64 aggregateMs = timer.elapsed();
+
+    err() << store.runCount() << " runs loaded (" << loader.failedFiles().size() << " failed), "
+          << store.columnCount() << " columns; parse " << loadMs << " ms, aggregate " << aggregateMs << " ms\n";
+
+    bool csv = parser.isSet(csvOption);
+    if (csv) {
+        out() << "counter,samples,mean,stddev,min,p5,p50,p95,max\n";
+    } else {
+        out() << qSetFieldWidth(48) << Qt::left << "counter" << qSetFieldWidth(0)
+              << "     n         mean       stddev          min           p5          p50          p95          max\n";
+    }
+
+    const QStringList& names = aggregator.columnNames();
+    for (int i = 0; i < names.size(); ++i) {
+        const CounterDistribution& d = aggregator.distributions()[i];
+        if (d.samples == 0 || !names[i].contains(filter)) continue;
+
+        const QList<double> values = {d.mean, d.stddev, d.min, d.p5, d.p50, d.p95, d.max};
+        if (csv) {
+            out() << names[i] << "," << d.samples;
+            for (double value : values) out() << "," << formatValue(value);
+            out() << "\n";
+        } else {
+            out() << qSetFieldWidth(48) << Qt::left << names[i] << qSetFieldWidth(6) << Qt::right << d.samples;
+            for (double value : values) out() << qSetFieldWidth(13) << formatValue(value);
+            out() << qSetFieldWidth(0) << Qt::left << "\n";
+        }
+    }
+
+    return loader.failedFiles().isEmpty() ? 0 : 1;
+}
@@ -0,0 +1,114 @@
+#include "Commands.h"
+#include "../src/graphics/ChipLayout.h"
+#include "../src/statistics/SetupLoader.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <cmath>
+
+namespace {
+
+// 每个总线节点一个核 (CPU、私有 L2、L3 分片)，每 16 个节点一个内存节点
+SetupModel syntheticSetup(int nodes, const QList<QPair<int, int>>& links)
+{
+    SetupModel setup;
+    int port = 0;
+    for (int node = 0; node < nodes; ++node) {
+        setup.components[QString("CPU%1").arg(node)];
+        QStringList attached = {QString("L2Cache%1").arg(node), QString("L3Cache%1").arg(node)};
+        if (node % 16 == 0) attached.append(QString("MemoryNode%1").arg(node / 16));
+        for (const QString& component : attached) {
+            setup.components[component]["port_id"] = QString::number(port);
+            setup.portToNode[port++] = node;
+        }
+    }
+    setup.portCount = port;
+    for (const auto& link : links) {
+        setup.edges.append(link);
+        setup.edges.append(qMakePair(link.second, link.first));
+    }
+    return setup;
+}
+
+}
+
+int runBenchLayout(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Time the chip layout (topology detection, placement and edge routing) on setup.txt or a\n"
+        "synthetic bus topology with one core per node.");
+    parser.addHelpOption();
+    QCommandLineOption topologyOption("topology", "setup, ring, mesh or random (default setup).", "kind", "setup");
+    QCommandLineOption nodesOption("nodes", "Bus nodes of a synthetic topology (default 5000).", "n", "5000");
+    QCommandLineOption setupOption("setup", "setup.txt to lay out (default: found as the GUI does).", "file");
+    QCommandLineOption seedOption("seed", "Random seed for --topology random (default 1).", "n", "1");
+    parser.addOptions({topologyOption, nodesOption, setupOption, seedOption});
+    parser.process(QStringList{"ppv-cli bench-layout"} + arguments);
+
+    const QString topology = parser.value(topologyOption);
+    const int nodes = parser.value(nodesOption).toInt();
+    SetupModel setup;
+    if (topology == "setup") {
+        SetupLoader loader;
+        bool loaded = parser.isSet(setupOption) ? loader.loadSetup(parser.value(setupOption)) : loader.loadSetup();
+        if (!loaded) {
+            err() << "Cannot read setup.txt\n";
+            return 2;
+        }
+        setup = loader.getSetup();
+    } else {
+        if (nodes < 2) {
+            err() << "--nodes must be at least 2\n";
+            return 2;
+        }
+        QList<QPair<int, int>> links;
+        int count = nodes;
+        if (topology == "ring") {
+            for (int i = 0; i < count; ++i) links.append(qMakePair(i, (i + 1) % count));
+        } else if (topology == "mesh") {
+            int columns = qMax(1, static_cast<int>(std::lround(std::sqrt(static_cast<double>(nodes)))));
+            int rows = qMax(1, nodes / columns);
+            count = rows * columns;
+            for (int i = 0; i < count; ++i) {
+                if ((i + 1) % columns != 0) links.append(qMakePair(i, i + 1));
+                if (i + columns < count) links.append(qMakePair(i, i + columns));
+            }
+        } else if (topology == "random") {
+            // 随机生成树加上一半数量的额外边
+            QRandomGenerator random(parser.value(seedOption).toUInt());
+            for (int i = 1; i < count; ++i) links.append(qMakePair(i, random.bounded(i)));
+            for (int i = 0; i < count / 2; ++i) links.append(qMakePair(random.bounded(count), random.bounded(count)));
+        } else {
+            err() << "Unknown topology " << topology << "\n";
+            return 2;
+        }
+        setup = syntheticSetup(count, links);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    ChipLayout layout = ChipLayout::cached(setup);
+    qint64 computeNs = timer.nsecsElapsed();
+
+    timer.restart();
+    ChipLayout::cached(setup);
+    qint64 cachedNs = timer.nsecsElapsed();
+
+    int busLinks = 0;
+    int routed = 0;
+    for (const LayoutLink& link : layout.links) {
+        if (link.kind != LayoutLink::BusLink) continue;
+        busLinks++;
+        if (link.points.size() > 2) routed++;
+    }
+
+    out() << "Topology:   " << GraphLayout::kindName(layout.topology) << "\n"
+          << "Scene:      " << layout.components.size() << " components, " << layout.busNodes.size() << " bus nodes, "
+          << busLinks << " bus links (" << routed << " routed through channels), "
+          << QString::number(layout.bounds.width(), 'f', 0) << " x " << QString::number(layout.bounds.height(), 'f', 0)
+          << "\n"
+          << "Layout:     " << QString::number(computeNs / 1e6, 'f', 1) << " ms\n"
+          << "Cached:     " << QString::number(cachedNs / 1e6, 'f', 3) << " ms\n";
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "Commands.h"
+#include "../src/statistics/TimeSeriesStore.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <cmath>
+
+namespace {
+
+QString megabytes(qint64 bytes)
+{
+    return QString::number(bytes / (1024.0 * 1024.0), 'f', 1) + " MB";
+}
+
+QString ratio(qint64 raw, qint64 encoded)
+{
+    return encoded > 0 ? QString::number(static_cast<double>(raw) / encoded, 'f', 2) + "x" : QString("-");
+}
+
+}
+
+int runBenchSeries(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Benchmark the compressed time-series store on synthetic periodic dumps: integer counters grow\n"
+        "with jitter, rates are cumulative ratios. Reports compression ratio and decode throughput.");
+    parser.addHelpOption();
+    QCommandLineOption countersOption("counters", "Number of counter columns (default 1000).", "n", "1000");
+    QCommandLineOption samplesOption("samples", "Number of dumps (default 100000).", "n", "100000");
+    QCommandLineOption rateOption("rates", "Fraction of columns that are floating-point rates (default 0.3).", "fraction", "0.3");
+    QCommandLineOption seedOption("seed", "Random seed (default 1).", "n", "1");
+    parser.addOptions({countersOption, samplesOption, rateOption, seedOption});
+    parser.process(QStringList{"ppv-cli bench-series"} + arguments);
+
+    const int counterCount = parser.value(countersOption).toInt();
+    const int sampleCount = parser.value(samplesOption).toInt();
+    const double rateFraction = parser.value(rateOption).toDouble();
+    if (counterCount <= 0 || sampleCount <= 0 || rateFraction < 0 || rateFraction > 1) {
+        err() << "--counters and --samples must be positive, --rates within [0, 1]\n";
+        return 2;
+    }
+
+    QRandomGenerator random(parser.value(seedOption).toUInt());
+    TimeSeriesStore store;
+
+    // 每列的生成参数: 计数器按各自的速率增长，比例列是累计命中数 / 累计访问数
+    const int rateColumns = static_cast<int>(counterCount * rateFraction);
+    QVector<double> increment(counterCount), jitter(counterCount), hits(counterCount, 0), accesses(counterCount, 0);
+    for (int c = 0; c < counterCount; ++c) {
+        bool isRate = c < rateColumns;
+        store.ensureColumn(QString("Component%1.%2_%3").arg(c % 16).arg(isRate ? "rate" : "count").arg(c));
+        increment[c] = c % 10 == 0 ? 0 : random.bounded(1, 5000);     // 每 10 列一个常量
+        jitter[c] = increment[c] * random.bounded(0.2);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<double> values(counterCount, 0);
+    quint64 tick = 0;
+    for (int s = 0; s < sampleCount; ++s) {
+        tick += 10000;
+        for (int c = 0; c < counterCount; ++c) {
+            double step = increment[c] + std::floor(random.bounded(1.0) * jitter[c]);
+            if (c < rateColumns) {
+                accesses[c] += increment[c] + 1;
+                hits[c] += std::floor((increment[c] + 1) * random.bounded(1.0));
+                values[c] = hits[c] / accesses[c];
+            } else {
+                values[c] += step;
+            }
+        }
+        store.append(tick, values);
+    }
+    qint64 appendMs = timer.restart();
+
+    TimeSeriesStore::Footprint footprint = store.footprint();
+    const double values64 = static_cast<double>(footprint.samples) * counterCount;
+    out() << "Samples:      " << footprint.samples << " x " << counterCount << " columns ("
+          << rateColumns << " rates), " << store.blockCount() << " blocks of " << TimeSeriesStore::kBlockSamples << "\n";
+    out() << "Append:       " << appendMs << " ms, " << QString::number(values64 / qMax<qint64>(1, appendMs) / 1000.0, 'f', 1)
+          << " M values/s (including generation)\n";
+    out() << "Raw:          " << megabytes(footprint.rawBytes) << "\n";
+    out() << "Encoded:      " << megabytes(footprint.encodedBytes) << " (" << ratio(footprint.rawBytes, footprint.encodedBytes) << ")\n";
+    out() << "  ticks       " << megabytes(footprint.tickEncodedBytes) << " (" << ratio(footprint.tickRawBytes, footprint.tickEncodedBytes) << ")\n";
+    out() << "  integers    " << megabytes(footprint.integerEncodedBytes) << " in " << footprint.integerBlocks
+          << " blocks (" << ratio(footprint.integerRawBytes, footprint.integerEncodedBytes) << ")\n";
+    out() << "  floats      " << megabytes(footprint.floatEncodedBytes) << " in " << footprint.floatBlocks
+          << " blocks (" << ratio(footprint.floatRawBytes, footprint.floatEncodedBytes) << ")\n";
+
+    // 全量解压: 单线程逐块逐列
+    QVector<double> buffer(TimeSeriesStore::kBlockSamples);
+    QVector<quint64> ticks(TimeSeriesStore::kBlockSamples);
+    double checksum = 0;
+    timer.restart();
+    for (int b = 0; b < store.blockCount(); ++b) {
+        store.decodeTicks(b, ticks.data());
+        for (int c = 0; c < store.columnCount(); ++c) {
+            store.decodeBlock(c, b, buffer.data());
+            checksum += buffer[store.blockLength(b) - 1];
+        }
+    }
+    qint64 decodeNs = qMax<qint64>(1, timer.nsecsElapsed());
+    double decodedValues = 0;
+    for (int b = 0; b < store.blockCount(); ++b) decodedValues += static_cast<double>(store.blockLength(b)) * counterCount;
+    out() << "Decode:       " << decodeNs / 1000000 << " ms, " << QString::number(decodedValues / decodeNs * 1000.0, 'f', 1)
+          << " M values/s, " << QString::number(decodedValues * sizeof(double) / decodeNs, 'f', 2) << " GB/s raw, 1 thread\n";
+
+    // 范围查询: 随机列上覆盖 1% 时间线的窗口
+    const int queryCount = 200;
+    const quint64 extent = store.lastTick() - store.firstTick();
+    const quint64 span = extent / 100;
+    qint64 blocksDecoded = 0;
+    qint64 samplesReturned = 0;
+    QVector<quint64> rangeTicks;
+    QVector<double> rangeValues;
+    timer.restart();
+    for (int q = 0; q < queryCount; ++q) {
+        quint64 from = store.firstTick() + random.bounded(extent - span + 1);
+        blocksDecoded += store.range(random.bounded(counterCount), from, from + span, rangeTicks, rangeValues);
+        samplesReturned += rangeValues.size();
+    }
+    qint64 queryNs = timer.nsecsElapsed();
+    out() << "Range query:  " << QString::number(queryNs / 1000.0 / queryCount, 'f', 1) << " us per 1% window, "
+          << QString::number(static_cast<double>(blocksDecoded) / queryCount, 'f', 1) << " of " << store.blockCount()
+          << " blocks decoded, " << samplesReturned / queryCount << " samples\n";
+
+    err() << "checksum " << checksum << "\n";
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "Commands.h"
+#include "../src/statistics/RunCatalog.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QSet>
+#include <cmath>
+
+int runCatalog(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Build or incrementally update the persistent run catalog of an archive.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("roots", "Archive directories searched recursively for statistic.txt.", "<roots...>");
+    QCommandLineOption catalogOption("catalog", "Catalog file (default: <first root>/.ppv-catalog).", "file");
+    QCommandLineOption patternOption("summary", "Regular expression selecting summary columns of newly parsed runs.", "regex");
+    QCommandLineOption listOption("list", "Print each run with these comma-separated summary columns.", "columns");
+    parser.addOptions({catalogOption, patternOption, listOption});
+    parser.process(QStringList{"ppv-cli catalog"} + arguments);
+
+    QStringList roots = parser.positionalArguments();
+    if (roots.isEmpty()) {
+        parser.showHelp(2);
+    }
+
+    QString catalogPath = parser.isSet(catalogOption) ? parser.value(catalogOption)
+                                                      : RunCatalog::defaultCatalogPath(roots);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    RunCatalog catalog;
+    bool existed = catalog.load(catalogPath);
+    if (parser.isSet(patternOption)) {
+        QRegularExpression pattern(parser.value(patternOption));
+        if (!pattern.isValid()) {
+            err() << "Invalid --summary: " << pattern.errorString() << "\n";
+            return 2;
+        }
+        catalog.setSummaryPattern(pattern);
+    }
+
+    int reparsed = catalog.update(roots);
+    if ((reparsed > 0 || catalog.removedCount() > 0 || !existed) && !catalog.save(catalogPath)) {
+        err() << "Cannot write " << catalogPath << "\n";
+        return 1;
+    }
+
+    QSet<QByteArray> setups;
+    for (int i = 0; i < catalog.size(); ++i) {
+        setups.insert(catalog.entry(i).setupHash);
+    }
+    err() << catalogPath << ": " << catalog.size() << " runs, " << reparsed << " parsed, "
+          << catalog.unchangedCount() << " unchanged, " << catalog.removedCount() << " removed, "
+          << setups.size() << " distinct setups, " << catalog.summaryColumns().size() << " columns ("
+          << timer.elapsed() << " ms)\n";
+
+    if (parser.isSet(listOption)) {
+        QStringList columns = parser.value(listOption).split(',', Qt::SkipEmptyParts);
+        out() << "run";
+        for (const QString& column : columns) out() << "\t" << column;
+        out() << "\n";
+        for (int i = 0; i < catalog.size(); ++i) {
+            out() << catalog.entry(i).id;
+            for (const QString& column : columns) {
+                double value = catalog.value(i, column);
+                out() << "\t" << (std::isnan(value) ? QString("-") : QString::number(value, 'g', 6));
+            }
+            out() << "\n";
+        }
+    }
+    return 0;
+}
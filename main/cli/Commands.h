@@ -0,0 +1,27 @@
+#ifndef COMMANDS_H
+#define COMMANDS_H
+
+#include <QStringList>
+#include <QTextStream>
+
+// ppv-cli 的子命令，参数不含程序名与子命令名，返回进程退出码
+int runValidate(const QStringList& arguments);
+int runNuca(const QStringList& arguments);
+int runAggregate(const QStringList& arguments);
+int runCompare(const QStringList& arguments);
+int runCatalog(const QStringList& arguments);
+int runQuery(const QStringList& arguments);
+int runExport(const QStringList& arguments);
+int runBenchSeries(const QStringList& arguments);
+int runBenchLayout(const QStringList& arguments);
+int runShmProduce(const QStringList& arguments);
+int runShmIngest(const QStringList& arguments);
+int runServe(const QStringList& arguments);
+int runSearch(const QStringList& arguments);
+int runRender(const QStringList& arguments);
+
+// 标准输出与标准错误
+QTextStream& out();
+QTextStream& err();
+
+#endif // COMMANDS_H
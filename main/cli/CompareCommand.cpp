@@ -0,0 +1,85 @@
+#include "Commands.h"
+#include "../src/statistics/RunSetLoader.h"
+#include "../src/analysis/RegressionDetector.h"
+#include <QCommandLineParser>
+
+namespace {
+
+const char* directionName(CounterComparison::Direction direction)
+{
+    switch (direction) {
+    case CounterComparison::Regression: return "REGRESSION";
+    case CounterComparison::Improvement: return "improvement";
+    case CounterComparison::Changed: return "changed";
+    default: return "-";
+    }
+}
+
+bool loadRunSet(const QString& path, CounterStore& store)
+{
+    QStringList files = RunSetLoader::discoverRuns({path});
+    RunSetLoader loader;
+    if (files.isEmpty() || loader.load(files, store) == 0) {
+        err() << "No loadable statistic.txt under " << path << "\n";
+        return false;
+    }
+    if (!loader.failedFiles().isEmpty()) {
+        err() << loader.failedFiles().size() << " files under " << path << " failed to load\n";
+    }
+    return true;
+}
+
+}
+
+int runCompare(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Find counters that changed significantly between a baseline and a candidate run set "
+                                     "(Mann-Whitney U per counter, Benjamini-Hochberg FDR across counters).");
+    parser.addHelpOption();
+    parser.addPositionalArgument("baseline", "Baseline run directory.", "<baseline>");
+    parser.addPositionalArgument("candidate", "Candidate run directory.", "<candidate>");
+    QCommandLineOption fdrOption("fdr", "False discovery rate.", "rate", "0.05");
+    QCommandLineOption effectOption("min-effect", "Ignore changes with |Cliff's delta| below this.", "delta", "0.2");
+    QCommandLineOption allOption("all", "Also print counters that did not change.");
+    parser.addOptions({fdrOption, effectOption, allOption});
+    parser.process(QStringList{"ppv-cli compare"} + arguments);
+
+    if (parser.positionalArguments().size() != 2) {
+        parser.showHelp(2);
+    }
+
+    CounterStore baseline, candidate;
+    if (!loadRunSet(parser.positionalArguments()[0], baseline) ||
+        !loadRunSet(parser.positionalArguments()[1], candidate)) {
+        return 2;
+    }
+    if (baseline.runCount() < 3 || candidate.runCount() < 3) {
+        err() << "Warning: fewer than 3 runs per set, no change can reach significance\n";
+    }
+
+    RegressionDetector detector(parser.value(fdrOption).toDouble(), parser.value(effectOption).toDouble());
+    QVector<CounterComparison> comparisons = detector.compare(baseline, candidate);
+
+    out() << baseline.runCount() << " baseline runs, " << candidate.runCount() << " candidate runs, "
+          << comparisons.size() << " counters compared\n\n";
+
+    int regressions = 0;
+    for (const CounterComparison& c : comparisons) {
+        if (c.direction == CounterComparison::Regression) regressions++;
+        if (c.direction == CounterComparison::Unchanged && !parser.isSet(allOption)) continue;
+
+        out() << qSetFieldWidth(12) << Qt::left << directionName(c.direction)
+              << qSetFieldWidth(48) << c.column << qSetFieldWidth(0)
+              << QString("%1 -> %2 (%3%4%)  delta %5  q %6\n")
+                     .arg(c.baselineMedian, 0, 'g', 6)
+                     .arg(c.candidateMedian, 0, 'g', 6)
+                     .arg(c.relativeChange >= 0 ? "+" : "")
+                     .arg(c.relativeChange * 100, 0, 'f', 2)
+                     .arg(c.effectSize, 0, 'f', 2)
+                     .arg(c.qValue, 0, 'g', 3);
+    }
+
+    out() << "\n" << regressions << " regressions\n";
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+#include "Commands.h"
+#include "../src/export/ArrowExporter.h"
+#include "../src/statistics/RunSetLoader.h"
+#include "../src/statistics/RunCatalog.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+
+int runExport(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Export counters and derived metrics as Arrow IPC files: one <type>.arrow per component type\n"
+        "(rows are run x component instance) and ports.arrow with the port-to-port packet matrix.\n"
+        "Read them with pyarrow.ipc.open_file, pandas.read_feather or polars.read_ipc.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("paths", "statistic.txt files or directories searched recursively.", "[paths...]");
+    QCommandLineOption outputOption({"o", "output"}, "Output directory (created if missing).", "dir");
+    QCommandLineOption catalogOption("catalog", "Export the summary columns of a run catalog instead of parsing files.", "file");
+    QCommandLineOption batchOption("batch", "Runs parsed and written per record batch (default 1024).", "runs", "1024");
+    parser.addOptions({outputOption, catalogOption, batchOption});
+    parser.process(QStringList{"ppv-cli export"} + arguments);
+
+    if (!parser.isSet(outputOption) || (parser.positionalArguments().isEmpty() && !parser.isSet(catalogOption))) {
+        parser.showHelp(2);
+    }
+
+    bool ok = false;
+    int batchRuns = parser.value(batchOption).toInt(&ok);
+    if (!ok || batchRuns <= 0) {
+        err() << "Invalid --batch: " << parser.value(batchOption) << "\n";
+        return 2;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    ArrowExporter exporter(batchRuns);
+    bool exported;
+    if (parser.isSet(catalogOption)) {
+        RunCatalog catalog;
+        if (!catalog.load(parser.value(catalogOption))) {
+            err() << "Cannot read catalog " << parser.value(catalogOption) << "\n";
+            return 2;
+        }
+        CounterStore store;
+        catalog.toCounterStore(store);
+        exported = exporter.exportStore(store, parser.value(outputOption));
+    } else {
+        QStringList files = RunSetLoader::discoverRuns(parser.positionalArguments());
+        if (files.isEmpty()) {
+            err() << "No statistic.txt found\n";
+            return 2;
+        }
+        exported = exporter.exportRuns(files, parser.value(outputOption));
+    }
+
+    if (!exported) {
+        err() << "Export failed: " << exporter.errorString() << "\n";
+        return 2;
+    }
+
+    for (const QString& file : exporter.writtenFiles()) {
+        out() << file << "\n";
+    }
+    err() << exporter.exportedRuns() << " runs exported (" << exporter.failedFiles().size() << " failed) to "
+          << exporter.writtenFiles().size() << " files in " << timer.elapsed() << " ms\n";
+    if (exporter.skippedColumnCount() > 0) {
+        err() << exporter.skippedColumnCount() << " columns first seen after the first batch were not exported; "
+              << "increase --batch to include them\n";
+    }
+    return exporter.failedFiles().isEmpty() ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#include "Commands.h"
+#include "../src/statistics/RunSetLoader.h"
+#include "../src/statistics/SetupLoader.h"
+#include "../src/analysis/NucaBalance.h"
+#include <QCommandLineParser>
+#include <QFileInfo>
+#include <QDir>
+
+namespace {
+
+void printSnapshot(const NucaSnapshot& snapshot, const QStringList& slices)
+{
+    out() << qSetFieldWidth(24) << Qt::left << snapshot.label << qSetFieldWidth(0)
+          << QString(" acc %1/%2  miss %3/%4  traffic %5/%6")
+                 .arg(snapshot.accessBalance.maxOverMean, 0, 'f', 3)
+                 .arg(snapshot.accessBalance.cv, 0, 'f', 3)
+                 .arg(snapshot.missBalance.maxOverMean, 0, 'f', 3)
+                 .arg(snapshot.missBalance.cv, 0, 'f', 3)
+                 .arg(snapshot.trafficBalance.maxOverMean, 0, 'f', 3)
+                 .arg(snapshot.trafficBalance.cv, 0, 'f', 3);
+
+    QStringList hot;
+    for (int slice : snapshot.hotSlices) hot.append(slices[slice]);
+    if (!hot.isEmpty()) out() << "  HOT: " << hot.join(", ");
+    out() << "\n";
+}
+
+}
+
+int runNuca(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Report L3 NUCA slice imbalance per run, per window and overall.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("paths", "statistic.txt files or directories searched recursively.", "<paths...>");
+    QCommandLineOption setupOption("setup", "setup.txt with slice ports (default: next to the first run).", "file");
+    QCommandLineOption windowOption("window", "Aggregate consecutive runs in windows of this size (0: per run).", "runs", "0");
+    QCommandLineOption thresholdOption("hot-threshold", "A slice is hot above this multiple of the mean load.", "ratio", "1.25");
+    QCommandLineOption hotOnlyOption("hot-only", "Only print snapshots with hot slices.");
+    parser.addOptions({setupOption, windowOption, thresholdOption, hotOnlyOption});
+    parser.process(QStringList{"ppv-cli nuca"} + arguments);
+
+    if (parser.positionalArguments().isEmpty()) {
+        parser.showHelp(2);
+    }
+
+    QStringList files = RunSetLoader::discoverRuns(parser.positionalArguments());
+    if (files.isEmpty()) {
+        err() << "No statistic.txt found\n";
+        return 2;
+    }
+
+    SetupLoader setupLoader;
+    QString setupPath = parser.isSet(setupOption)
+        ? parser.value(setupOption)
+        : QFileInfo(files.first()).dir().filePath("setup.txt");
+    if (!QFileInfo::exists(setupPath) || !setupLoader.loadSetup(setupPath)) {
+        err() << "No setup.txt found, slice ports unknown (port traffic reported as 0)\n";
+    }
+
+    CounterStore store;
+    RunSetLoader loader;
+    loader.load(files, store);
+
+    NucaBalanceAnalyzer analyzer(setupLoader.getSetup(), parser.value(thresholdOption).toDouble());
+    if (!analyzer.bind(store)) {
+        err() << "No L3 slices found\n";
+        return 1;
+    }
+
+    out() << store.runCount() << " runs, " << analyzer.slices().size() << " slices"
+          << "  (columns: max/mean and CV of accesses, misses, port traffic)\n\n";
+
+    int window = parser.value(windowOption).toInt();
+    QVector<NucaSnapshot> snapshots = window > 0 ? analyzer.analyzeWindows(window) : analyzer.analyzeRuns();
+    int hotSnapshots = 0;
+    for (const NucaSnapshot& snapshot : snapshots) {
+        if (!snapshot.hotSlices.isEmpty()) hotSnapshots++;
+        if (parser.isSet(hotOnlyOption) && snapshot.hotSlices.isEmpty()) continue;
+        printSnapshot(snapshot, analyzer.slices());
+    }
+
+    out() << "\n";
+    printSnapshot(analyzer.analyzeAll(), analyzer.slices());
+    out() << hotSnapshots << " of " << snapshots.size() << " snapshots have hot slices\n";
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "Commands.h"
+#include "../src/statistics/RunSetLoader.h"
+#include "../src/statistics/RunCatalog.h"
+#include "../src/analysis/QueryEngine.h"
+#include <QCommandLineParser>
+#include <cmath>
+
+int runQuery(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Run a query over counters of many runs, e.g.\n"
+        "  select run, CPU*.ipc where L3Cache*.llc_hit_rate < 0.4 order by MemoryNode0.busy_rate desc limit 20\n"
+        "  select avg(CPU*.ipc), count(*) where Bus.avg_transmit_latency > 3");
+    parser.addHelpOption();
+    parser.addPositionalArgument("query", "Query text (quote it).", "<query>");
+    parser.addPositionalArgument("paths", "statistic.txt files or directories searched recursively.", "[paths...]");
+    QCommandLineOption catalogOption("catalog", "Query the summary columns of a run catalog instead of parsing files.", "file");
+    QCommandLineOption csvOption("csv", "Separate columns with commas instead of tabs.");
+    parser.addOptions({catalogOption, csvOption});
+    parser.process(QStringList{"ppv-cli query"} + arguments);
+
+    QStringList positional = parser.positionalArguments();
+    if (positional.isEmpty() || (positional.size() == 1 && !parser.isSet(catalogOption))) {
+        parser.showHelp(2);
+    }
+
+    CounterStore store;
+    if (parser.isSet(catalogOption)) {
+        RunCatalog catalog;
+        if (!catalog.load(parser.value(catalogOption))) {
+            err() << "Cannot read catalog " << parser.value(catalogOption) << "\n";
+            return 2;
+        }
+        catalog.toCounterStore(store);
+    } else {
+        QStringList files = RunSetLoader::discoverRuns(positional.mid(1));
+        if (files.isEmpty()) {
+            err() << "No statistic.txt found\n";
+            return 2;
+        }
+        RunSetLoader loader;
+        loader.load(files, store);
+    }
+
+    QueryEngine engine(store);
+    QueryResult result = engine.execute(positional.first());
+    if (!result.error.isEmpty()) {
+        err() << "Query error: " << result.error << "\n";
+        return 2;
+    }
+
+    const QString separator = parser.isSet(csvOption) ? "," : "\t";
+    auto format = [](double value) {
+        return std::isnan(value) ? QString("-") : QString::number(value, 'g', 8);
+    };
+
+    QStringList header = result.columnNames;
+    if (!result.aggregate) header.prepend("run");
+    out() << header.join(separator) << "\n";
+
+    int rows = result.aggregate ? 1 : result.runIds.size();
+    for (int row = 0; row < rows; ++row) {
+        QStringList fields;
+        if (!result.aggregate) fields.append(result.runIds[row]);
+        for (const QVector<double>& column : result.columns) fields.append(format(column[row]));
+        out() << fields.join(separator) << "\n";
+    }
+
+    err() << result.matchedRuns << " of " << result.totalRuns << " runs matched; "
+          << result.skippedChunks << " of " << result.chunkCount << " chunks decided by min/max summaries; "
+          << result.elapsedMs << " ms\n";
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "Commands.h"
+#include "../src/graphics/ChipPainter.h"
+#include "../src/statistics/RunSetLoader.h"
+#include "../src/statistics/SetupLoader.h"
+#include "../src/statistics/StatsLoader.h"
+#include "../src/concurrency/WorkStealingPool.h"
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QHash>
+#include <QSet>
+#include <memory>
+
+namespace {
+
+// 同一拓扑的运行共用布局与利用率模型，出图时只剩解析与绘制
+struct Topology {
+    ChipLayout layout;
+    std::shared_ptr<BusUtilization> utilization;
+};
+
+struct RenderResult {
+    bool ok = false;
+    qint64 parseNs = 0;
+    qint64 renderNs = 0;
+};
+
+}
+
+int runRender(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Render one chip image per run, colored by bus utilization, without a display (offscreen platform).\n"
+        "Runs are rendered in parallel; runs sharing a topology reuse one cached layout.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("paths", "statistic.txt files or directories searched recursively.", "<paths...>");
+    QCommandLineOption outOption("out", "Output directory (default: current directory).", "dir", ".");
+    QCommandLineOption formatOption("format", "png or svg (default png).", "format", "png");
+    QCommandLineOption metricOption("metric", "busy, traffic or none (default busy).", "metric", "busy");
+    QCommandLineOption scaleOption("scale", "PNG pixels per scene unit (default 0.5).", "factor", "0.5");
+    QCommandLineOption setupOption("setup",
+                                   "setup.txt for runs without one next to their statistic.txt "
+                                   "(default: found as the GUI does).", "file");
+    parser.addOptions({outOption, formatOption, metricOption, scaleOption, setupOption});
+    parser.process(QStringList{"ppv-cli render"} + arguments);
+
+    if (parser.positionalArguments().isEmpty()) {
+        parser.showHelp(2);
+    }
+
+    const QString format = parser.value(formatOption);
+    if (format != "png" && format != "svg") {
+        err() << "--format must be png or svg\n";
+        return 2;
+    }
+    const QString metricName = parser.value(metricOption);
+    if (metricName != "busy" && metricName != "traffic" && metricName != "none") {
+        err() << "--metric must be busy, traffic or none\n";
+        return 2;
+    }
+    const BusUtilization::Metric metric = metricName == "traffic" ? BusUtilization::Traffic : BusUtilization::BusyRate;
+    bool scaleOk = false;
+    const double scale = parser.value(scaleOption).toDouble(&scaleOk);
+    if (!scaleOk || scale <= 0) {
+        err() << "--scale must be a positive number\n";
+        return 2;
+    }
+    QDir outDir(parser.value(outOption));
+    if (!outDir.mkpath(".")) {
+        err() << "Cannot create " << outDir.path() << "\n";
+        return 2;
+    }
+
+    QStringList files = RunSetLoader::discoverRuns(parser.positionalArguments());
+    if (files.isEmpty()) {
+        err() << "No statistic.txt found\n";
+        return 2;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // 每个运行的 setup.txt (同目录下没有时用 --setup)，相同文件只读取、布局一次
+    SetupLoader defaultLoader;
+    bool haveDefault = parser.isSet(setupOption) ? defaultLoader.loadSetup(parser.value(setupOption))
+                                                 : defaultLoader.loadSetup();
+    QHash<QString, int> topologyOfSetup;
+    QVector<Topology> topologies;
+    QVector<int> runTopology(files.size(), -1);
+    QStringList outputs;
+    QSet<QString> usedNames;
+    for (int i = 0; i < files.size(); ++i) {
+        QFileInfo statistic(files[i]);
+        QString setupPath = statistic.dir().filePath("setup.txt");
+        if (!QFileInfo::exists(setupPath)) setupPath.clear();
+
+        if (!topologyOfSetup.contains(setupPath)) {
+            SetupLoader loader;
+            int index = -1;
+            if (setupPath.isEmpty() ? haveDefault : loader.loadSetup(setupPath)) {
+                const SetupModel& setup = setupPath.isEmpty() ? defaultLoader.getSetup() : loader.getSetup();
+                Topology topology;
+                topology.layout = ChipLayout::cached(setup);
+                topology.utilization = std::make_shared<BusUtilization>(setup);
+                index = topologies.size();
+                topologies.append(topology);
+            }
+            topologyOfSetup.insert(setupPath, index);
+        }
+        runTopology[i] = topologyOfSetup.value(setupPath);
+
+        // 输出文件以运行目录命名，重名时加序号
+        QString name = statistic.dir().dirName();
+        if (name.isEmpty() || name == ".") name = "run";
+        QString unique = name;
+        for (int n = 2; usedNames.contains(unique); ++n) unique = QString("%1-%2").arg(name).arg(n);
+        usedNames.insert(unique);
+        outputs.append(outDir.filePath(unique + "." + format));
+    }
+    qint64 prepareMs = timer.restart();
+
+    QVector<RenderResult> results(files.size());
+    WorkStealingPool::instance().parallelFor(files.size(), [&](int i) {
+        RenderResult& result = results[i];
+        if (runTopology[i] < 0) return;
+        const Topology& topology = topologies[runTopology[i]];
+
+        QElapsedTimer step;
+        step.start();
+        StatsLoader loader;
+        if (!loader.loadStatistics(files[i])) return;
+        BusUtilization::Values values;
+        if (metricName != "none") values = topology.utilization->compute(metric, loader.getPortTransmissions());
+        result.parseNs = step.nsecsElapsed();
+
+        step.restart();
+        const BusUtilization::Values* colors = metricName != "none" ? &values : nullptr;
+        QString title = QString("%1  (%2)").arg(QDir::toNativeSeparators(files[i]),
+                                                colors ? BusUtilization::metricName(metric) : QString("no overlay"));
+        if (format == "svg") {
+            result.ok = ChipPainter::renderSvg(outputs[i], topology.layout, colors, title);
+        } else {
+            result.ok = ChipPainter::renderImage(topology.layout, colors, scale, title).save(outputs[i], "PNG");
+        }
+        result.renderNs = step.nsecsElapsed();
+    });
+    qint64 renderMs = timer.elapsed();
+
+    int rendered = 0;
+    qint64 parseNs = 0;
+    qint64 renderNs = 0;
+    for (int i = 0; i < results.size(); ++i) {
+        if (!results[i].ok) {
+            err() << "Failed: " << files[i]
+                  << (runTopology[i] < 0 ? " (no setup.txt)" : "") << "\n";
+            continue;
+        }
+        rendered++;
+        parseNs += results[i].parseNs;
+        renderNs += results[i].renderNs;
+    }
+
+    out() << "Rendered " << rendered << " of " << files.size() << " runs to " << QDir::toNativeSeparators(outDir.path())
+          << " (" << topologies.size() << " topologies, " << WorkStealingPool::instance().threadCount() << " workers)\n"
+          << "Setup and layout: " << prepareMs << " ms, rendering: " << renderMs << " ms\n";
+    if (rendered > 0) {
+        out() << "Per run: parse " << QString::number(parseNs / 1e6 / rendered, 'f', 2) << " ms, draw and encode "
+              << QString::number(renderNs / 1e6 / rendered, 'f', 2) << " ms\n";
+    }
+    return rendered == files.size() ? 0 : 1;
+}
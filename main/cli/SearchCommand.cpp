@@ -0,0 +1,70 @@
+#include "Commands.h"
+#include "../src/analysis/CounterSearch.h"
+#include "../src/statistics/StatsLoader.h"
+#include <QCommandLineParser>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFileInfo>
+
+int runSearch(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Find components and counters by name or name fragment (l3, miss, busy) across runs.\n"
+        "Prefixes and single typos match; every word of the query must match.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("query", "Words to search for, e.g. \"l3 miss\".");
+    QCommandLineOption fromOption("from", "statistic.txt to index; repeat for several runs (default: search as the GUI does).", "file");
+    QCommandLineOption limitOption("limit", "Maximum number of matches (default 20).", "n", "20");
+    parser.addOptions({fromOption, limitOption});
+    parser.process(QStringList{"ppv-cli search"} + arguments);
+
+    QString query = parser.positionalArguments().join(' ');
+    if (query.trimmed().isEmpty()) {
+        err() << "No query given\n";
+        return 2;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    CounterSearch search;
+    QStringList paths = parser.values(fromOption);
+    if (paths.isEmpty()) {
+        StatsLoader loader;
+        if (!loader.loadStatistics()) {
+            err() << "Cannot read statistic.txt\n";
+            return 2;
+        }
+        search.addRun("default", loader.getStatsData());
+    }
+    for (const QString& path : paths) {
+        StatsLoader loader;
+        if (!loader.loadStatistics(path)) {
+            err() << "Cannot read " << path << "\n";
+            continue;
+        }
+        search.addRun(QFileInfo(path).dir().dirName(), loader.getStatsData());
+    }
+    qint64 loadNs = timer.nsecsElapsed();
+
+    timer.restart();
+    search.finalize();
+    qint64 indexNs = timer.nsecsElapsed();
+
+    timer.restart();
+    QVector<CounterSearch::Match> matches = search.search(query, parser.value(limitOption).toInt());
+    qint64 searchNs = timer.nsecsElapsed();
+
+    for (const CounterSearch::Match& match : matches) {
+        QString name = match.counter.isEmpty() ? match.component : match.component + "." + match.counter;
+        out() << name;
+        if (!match.counter.isEmpty()) out() << " = " << match.value;
+        if (match.runs.size() > 1) out() << " (" << match.runs.size() << " runs)";
+        out() << "\n";
+    }
+    err() << matches.size() << " matches among " << search.documentCount() << " components and counters ("
+          << search.termCount() << " terms); load " << QString::number(loadNs / 1e6, 'f', 1) << " ms, index "
+          << QString::number(indexNs / 1e6, 'f', 1) << " ms, search " << QString::number(searchNs / 1e3, 'f', 1)
+          << " us\n";
+    return matches.isEmpty() ? 1 : 0;
+}
@@ -0,0 +1,75 @@
+#include "Commands.h"
+#include "../src/server/SnapshotServer.h"
+#include "../src/concurrency/WorkStealingPool.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QSet>
+
+int runServe(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Serve runs as JSON on 127.0.0.1 for dashboards: /api/runs, /api/runs/<run>/components[/<name>],\n"
+        "/api/runs/<run>/derived and /api/runs/<run>/ports. Responses carry ETags; send If-None-Match\n"
+        "when polling to get 304 Not Modified. Stop with Ctrl+C.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("paths", "statistic.txt files (default: search as the GUI does).", "[paths...]");
+    QCommandLineOption portOption("port", "TCP port on 127.0.0.1 (default 8765, 0 picks a free port).", "port", "8765");
+    parser.addOption(portOption);
+    parser.process(QStringList{"ppv-cli serve"} + arguments);
+
+    // 运行标识与图形界面一致: 取所在目录名，重名时加序号
+    QVector<PublishedRun> runs;
+    QSet<QString> ids;
+    for (const QString& path : parser.positionalArguments()) {
+        QString base = QFileInfo(path).dir().dirName();
+        QString id = base;
+        for (int suffix = 2; ids.contains(id); ++suffix) {
+            id = QString("%1 (%2)").arg(base).arg(suffix);
+        }
+        ids.insert(id);
+
+        PublishedRun run;
+        run.id = id;
+        run.path = path;
+        runs.append(run);
+    }
+    if (runs.isEmpty()) {
+        PublishedRun run;
+        run.id = "default";
+        runs.append(run);
+    }
+
+    PublishedRun* output = runs.data();
+    WorkStealingPool::instance().parallelFor(runs.size(), [output](int i) {
+        auto loader = std::make_shared<StatsLoader>();
+        bool ok = output[i].path.isEmpty() ? loader->loadStatistics() : loader->loadStatistics(output[i].path);
+        if (ok) output[i].stats = loader;
+        output[i].state = ok ? "Loaded" : "Failed";
+    });
+
+    int loaded = 0;
+    for (const PublishedRun& run : runs) {
+        if (run.stats) {
+            loaded++;
+        } else {
+            err() << "Cannot read " << (run.path.isEmpty() ? QString("statistic.txt") : run.path) << "\n";
+        }
+    }
+    if (loaded == 0) return 2;
+
+    SnapshotServer server;
+    if (!server.start(static_cast<quint16>(parser.value(portOption).toUInt()))) {
+        err() << server.errorString() << "\n";
+        return 2;
+    }
+    QObject::connect(&server, &SnapshotServer::published, &server, [&server](int documents, qint64 bytes) {
+        out() << "Serving " << documents << " documents (" << QString::number(bytes / 1024.0, 'f', 1)
+              << " KB) at http://127.0.0.1:" << server.port() << "/api\n";
+        out().flush();
+    });
+    server.publish(runs);
+    return QCoreApplication::exec();
+}
@@ -0,0 +1,63 @@
+#include "Commands.h"
+#include "../src/statistics/LiveIngestor.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QThread>
+
+namespace {
+
+QString microseconds(qint64 nanoseconds)
+{
+    return QString::number(nanoseconds / 1000.0, 'f', 1) + " us";
+}
+
+}
+
+int runShmIngest(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Drain a shared-memory counter ring into the compressed time-series store on a dedicated thread\n"
+        "and report sustained records/s and the producer-to-store latency.");
+    parser.addHelpOption();
+    QCommandLineOption nameOption("name", "Shared-memory name (default /ppv-live).", "name", "/ppv-live");
+    QCommandLineOption durationOption("duration", "Seconds to run (default 10).", "s", "10");
+    parser.addOptions({nameOption, durationOption});
+    parser.process(QStringList{"ppv-cli shm-ingest"} + arguments);
+
+    LiveIngestor ingestor;
+    if (!ingestor.start(parser.value(nameOption))) {
+        err() << ingestor.errorString() << "\n";
+        return 2;
+    }
+
+    const qint64 durationMs = static_cast<qint64>(parser.value(durationOption).toDouble() * 1000);
+    QElapsedTimer timer;
+    timer.start();
+    qint64 lastRecords = 0;
+    while (timer.elapsed() < durationMs) {
+        QThread::msleep(1000);
+        LiveIngestor::Statistics stats = ingestor.statistics();
+        out() << stats.records - lastRecords << " records/s, " << stats.dumps << " dumps, ingest latency p50 "
+              << microseconds(stats.ingestP50Ns) << ", p99 " << microseconds(stats.ingestP99Ns) << "\n";
+        out().flush();
+        lastRecords = stats.records;
+    }
+    ingestor.stop();
+
+    LiveIngestor::Statistics stats = ingestor.statistics();
+    out() << "Total: " << stats.records << " records, " << stats.dumps << " dumps, "
+          << QString::number(stats.recordsPerSecond / 1e6, 'f', 2) << " M records/s sustained; ingest latency p50 "
+          << microseconds(stats.ingestP50Ns) << ", p99 " << microseconds(stats.ingestP99Ns) << "\n";
+    if (stats.unknownCounters > 0) {
+        out() << stats.unknownCounters << " records referenced unregistered counters\n";
+    }
+
+    ingestor.readStore([](const TimeSeriesStore& store) {
+        TimeSeriesStore::Footprint footprint = store.footprint();
+        out() << "Store: " << store.columnCount() << " columns, " << footprint.samples << " samples, "
+              << QString::number(footprint.encodedBytes / (1024.0 * 1024.0), 'f', 1) << " MB encoded ("
+              << QString::number(footprint.rawBytes / (1024.0 * 1024.0), 'f', 1) << " MB raw)\n";
+    });
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include "Commands.h"
+#include "../src/statistics/SharedMemoryRing.h"
+#include "../src/statistics/StatsLoader.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QRandomGenerator>
+#include <QThread>
+#include <cmath>
+#include <thread>
+
+int runShmProduce(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Stand-in for a co-located simulator: writes periodic counter dumps into a shared-memory ring.\n"
+        "Counter names and starting values come from a statistic.txt, counters then grow every dump.\n"
+        "Run 'ppv-cli shm-ingest' or start Live Ingestion in the GUI to consume them.");
+    parser.addHelpOption();
+    QCommandLineOption nameOption("name", "Shared-memory name (default /ppv-live).", "name", "/ppv-live");
+    QCommandLineOption fromOption("from", "statistic.txt supplying counter names and values (default: search as the GUI does).", "file");
+    QCommandLineOption rateOption("rate", "Dumps per second, 0 for as fast as the consumer keeps up (default 100).", "n", "100");
+    QCommandLineOption durationOption("duration", "Seconds to run (default 10).", "s", "10");
+    QCommandLineOption capacityOption("capacity", "Ring capacity in records (default 65536).", "n", "65536");
+    parser.addOptions({nameOption, fromOption, rateOption, durationOption, capacityOption});
+    parser.process(QStringList{"ppv-cli shm-produce"} + arguments);
+
+    StatsLoader loader;
+    bool loaded = parser.isSet(fromOption) ? loader.loadStatistics(parser.value(fromOption)) : loader.loadStatistics();
+    if (!loaded) {
+        err() << "Cannot read statistic.txt\n";
+        return 2;
+    }
+
+    SharedMemoryRing ring;
+    QString name = parser.value(nameOption);
+    if (!ring.create(name, parser.value(capacityOption).toUInt())) {
+        err() << ring.errorString() << "\n";
+        return 2;
+    }
+
+    // 登记数值计数器，记下初始值
+    QVector<ShmCounterRecord> dump;
+    QVector<double> base;
+    const QMap<QString, ComponentStats>& statsData = loader.getStatsData();
+    for (auto component = statsData.begin(); component != statsData.end(); ++component) {
+        for (auto it = component.value().data.begin(); it != component.value().data.end(); ++it) {
+            bool ok = false;
+            double value = it.value().toDouble(&ok);
+            if (!ok) continue;
+            int id = ring.registerCounter(component.key() + "." + it.key());
+            if (id < 0) break;
+            ShmCounterRecord record = {};
+            record.counter = static_cast<quint32>(id);
+            dump.append(record);
+            base.append(value);
+        }
+    }
+    if (dump.isEmpty()) {
+        err() << "No numeric counters to send\n";
+        SharedMemoryRing::unlink(name);
+        return 2;
+    }
+
+    const double rate = parser.value(rateOption).toDouble();
+    const qint64 durationNs = static_cast<qint64>(parser.value(durationOption).toDouble() * 1e9);
+    err() << "Writing " << dump.size() << " counters per dump to " << name << " (" << ring.capacity()
+          << " records)" << (rate > 0 ? QString(" at %1 dumps/s").arg(rate) : QString(" as fast as possible")) << "\n";
+    err().flush();
+
+    QRandomGenerator random(1);
+    QElapsedTimer timer;
+    timer.start();
+    qint64 dumps = 0;
+    qint64 stalls = 0;
+    quint64 tick = 0;
+    while (timer.nsecsElapsed() < durationNs) {
+        // 按目标速率节拍发送
+        if (rate > 0) {
+            qint64 due = static_cast<qint64>(dumps * 1e9 / rate);
+            qint64 wait = due - timer.nsecsElapsed();
+            if (wait > 0) QThread::usleep(static_cast<unsigned long>(wait / 1000));
+        }
+
+        // 整数计数器按初始值的千分之一 (带抖动) 增长，小数指标在初始值附近波动
+        tick += 10000;
+        for (int i = 0; i < dump.size(); ++i) {
+            double value = base[i];
+            if (value == std::floor(value)) {
+                value += std::floor(base[i] / 1000.0 * (dumps + 1) * (0.9 + random.bounded(0.2)));
+            } else {
+                value *= 0.95 + random.bounded(0.1);
+            }
+            dump[i].tick = tick;
+            dump[i].value = value;
+            dump[i].flags = 0;
+        }
+        dump.last().flags = kShmEndOfDump;
+
+        // 时间戳取写入前的时刻，环满时等待消费者
+        qint64 sendNs = SharedMemoryRing::monotonicNs();
+        for (ShmCounterRecord& record : dump) record.sendNs = sendNs;
+        int written = 0;
+        while (written < dump.size()) {
+            int pushed = ring.push(dump.constData() + written, dump.size() - written);
+            if (pushed == 0) {
+                stalls++;
+                std::this_thread::yield();
+                if (timer.nsecsElapsed() > durationNs + 1000000000) break;
+            }
+            written += pushed;
+        }
+        dumps++;
+    }
+
+    double seconds = timer.nsecsElapsed() / 1e9;
+    out() << dumps << " dumps, " << dumps * dump.size() << " records in " << QString::number(seconds, 'f', 2) << " s: "
+          << QString::number(dumps * dump.size() / seconds / 1e6, 'f', 2) << " M records/s, "
+          << stalls << " waits on a full ring\n";
+
+    // 名称删除后已映射的消费者仍可读完剩余记录
+    SharedMemoryRing::unlink(name);
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "Commands.h"
+#include "../src/statistics/RunSetLoader.h"
+#include "../src/statistics/SetupLoader.h"
+#include "../src/analysis/ConservationValidator.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFileInfo>
+#include <QDir>
+
+int runValidate(const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Check conservation laws across statistic.txt runs.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("paths", "statistic.txt files or directories searched recursively.", "<paths...>");
+    QCommandLineOption rulesOption("rules", "Rule file (default: built-in rules).", "file");
+    QCommandLineOption setupOption("setup", "setup.txt for port/node topology (default: next to the first run).", "file");
+    QCommandLineOption printRulesOption("print-rules", "Print the built-in rules and exit.");
+    QCommandLineOption errorsOnlyOption("errors-only", "Do not report warnings.");
+    parser.addOptions({rulesOption, setupOption, printRulesOption, errorsOnlyOption});
+    parser.process(QStringList{"ppv-cli validate"} + arguments);
+
+    if (parser.isSet(printRulesOption)) {
+        out() << ConservationValidator::defaultRules();
+        return 0;
+    }
+    if (parser.positionalArguments().isEmpty()) {
+        parser.showHelp(2);
+    }
+
+    ConservationValidator validator;
+    if (parser.isSet(rulesOption) && !validator.loadRules(parser.value(rulesOption))) {
+        err() << "Cannot load rules from " << parser.value(rulesOption) << "\n";
+        return 2;
+    }
+
+    QStringList files = RunSetLoader::discoverRuns(parser.positionalArguments());
+    if (files.isEmpty()) {
+        err() << "No statistic.txt found\n";
+        return 2;
+    }
+
+    // 拓扑用于 ports() 规则
+    SetupLoader setupLoader;
+    QString setupPath = parser.isSet(setupOption)
+        ? parser.value(setupOption)
+        : QFileInfo(files.first()).dir().filePath("setup.txt");
+    if (QFileInfo::exists(setupPath) && setupLoader.loadSetup(setupPath)) {
+        validator.setSetup(setupLoader.getSetup());
+    } else {
+        err() << "No setup.txt found, topology rules skipped\n";
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    CounterStore store;
+    RunSetLoader loader;
+    int loaded = loader.load(files, store);
+    double loadSeconds = timer.nsecsElapsed() / 1e9;
+    for (const QString& path : loader.failedFiles()) {
+        err() << "Cannot read " << path << "\n";
+    }
+
+    timer.restart();
+    QVector<ValidationIssue> issues = validator.validate(store);
+    double validateSeconds = timer.nsecsElapsed() / 1e9;
+
+    out() << "Loaded " << loaded << " runs, " << store.columnCount() << " counters in "
+          << QString::number(loadSeconds, 'f', 2) << " s\n";
+    out() << "Checked " << validator.instanceCount() << " rule instances in "
+          << QString::number(validateSeconds * 1000, 'f', 1) << " ms\n\n";
+
+    // 按运行分组输出
+    bool errorsOnly = parser.isSet(errorsOnlyOption);
+    int failedRuns = 0;
+    int index = 0;
+    while (index < issues.size()) {
+        int run = issues[index].run;
+        int errors = 0, warnings = 0;
+        int end = index;
+        for (; end < issues.size() && issues[end].run == run; ++end) {
+            if (issues[end].severity == ValidationIssue::Error) {
+                errors++;
+            } else {
+                warnings++;
+            }
+        }
+        if (errors > 0) failedRuns++;
+
+        if (errors > 0 || !errorsOnly) {
+            out() << store.run(run).id << ": " << errors << " errors, " << warnings << " warnings\n";
+            for (int i = index; i < end; ++i) {
+                const ValidationIssue& issue = issues[i];
+                if (errorsOnly && issue.severity != ValidationIssue::Error) continue;
+                out() << (issue.severity == ValidationIssue::Error ? "  ERROR   " : "  WARNING ")
+                      << issue.rule << ": " << issue.message;
+                if (!issue.counters.isEmpty()) out() << "  [" << issue.counters.join(", ") << "]";
+                out() << "\n";
+            }
+        }
+        index = end;
+    }
+
+    out() << "\n" << failedRuns << " of " << loaded << " runs failed validation\n";
+    return failedRuns > 0 || !loader.failedFiles().isEmpty() ? 1 : 0;
+}
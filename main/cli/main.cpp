@@ -0,0 +1,106 @@
+#include "Commands.h"
+#include <QCoreApplication>
+#include <QGuiApplication>
+#include <QMap>
+#include <functional>
+#include <memory>
+#include <cstdio>
+
+namespace {
+
+bool verbose = false;
+
+// 默认只输出警告与错误，--verbose 时保留加载过程的调试信息
+void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message)
+{
+    Q_UNUSED(context);
+    if (type == QtDebugMsg && !verbose) return;
+    fprintf(stderr, "%s\n", qPrintable(message));
+}
+
+void printUsage()
+{
+    err() << "Usage: ppv-cli <command> [options]\n"
+          << "\n"
+          << "Commands:\n"
+          << "  validate    Check conservation laws across statistic.txt runs\n"
+          << "  nuca        Report L3 slice imbalance and hot slices\n"
+          << "  aggregate   Per-counter mean, stddev and percentiles across runs\n"
+          << "  compare     Significant counter changes between two run sets\n"
+          << "  catalog     Build or update the persistent run catalog of an archive\n"
+          << "  query       Filter, sort and aggregate counters across runs\n"
+          << "  export      Write counters as Arrow IPC files for pandas and Polars\n"
+          << "  bench-series Compression ratio and decode speed of the time-series store\n"
+          << "  bench-layout Chip layout time on setup.txt or a synthetic ring, mesh or random bus\n"
+          << "  shm-produce  Stand-in simulator writing counter dumps into a shared-memory ring\n"
+          << "  shm-ingest   Drain a shared-memory ring and report throughput and latency\n"
+          << "  serve       Serve runs as JSON over HTTP on localhost for dashboards\n"
+          << "  search      Find components and counters by name fragment across runs\n"
+          << "  render      Draw chip images colored by bus utilization to PNG or SVG, one per run\n"
+          << "\n"
+          << "Run 'ppv-cli <command> --help' for command options.\n";
+}
+
+}
+
+QTextStream& out()
+{
+    static QTextStream stream(stdout);
+    return stream;
+}
+
+QTextStream& err()
+{
+    static QTextStream stream(stderr);
+    return stream;
+}
+
+int main(int argc, char *argv[])
+{
+    // render 用 QPainter 画图和排字，需要 QGuiApplication；没有显示器时使用 offscreen 平台
+    // --verbose 可以出现在命令之前，按去掉它之后的第一个参数判断命令
+    const char* commandName = nullptr;
+    for (int i = 1; i < argc && !commandName; ++i) {
+        if (qstrcmp(argv[i], "--verbose") != 0) commandName = argv[i];
+    }
+    std::unique_ptr<QCoreApplication> app;
+    if (qstrcmp(commandName, "render") == 0) {
+        if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+        app.reset(new QGuiApplication(argc, argv));
+    } else {
+        app.reset(new QCoreApplication(argc, argv));
+    }
+    QCoreApplication::setApplicationName("ppv-cli");
+
+    QStringList arguments = QCoreApplication::arguments().mid(1);
+    verbose = arguments.removeAll("--verbose") > 0;
+    qInstallMessageHandler(messageHandler);
+
+    const QMap<QString, std::function<int(const QStringList&)>> commands = {
+        {"validate", runValidate},
+        {"nuca", runNuca},
+        {"aggregate", runAggregate},
+        {"compare", runCompare},
+        {"catalog", runCatalog},
+        {"query", runQuery},
+        {"export", runExport},
+        {"bench-series", runBenchSeries},
+        {"bench-layout", runBenchLayout},
+        {"shm-produce", runShmProduce},
+        {"shm-ingest", runShmIngest},
+        {"serve", runServe},
+        {"search", runSearch},
+        {"render", runRender},
+    };
+
+    if (arguments.isEmpty() || !commands.contains(arguments.first())) {
+        printUsage();
+        return 2;
+    }
+
+    QString command = arguments.takeFirst();
+    int status = commands[command](arguments);
+    out().flush();
+    err().flush();
+    return status;
+}
@@ -0,0 +1,110 @@
+#include "BusUtilization.h"
+#include <QRegularExpression>
+#include <algorithm>
+
+namespace {
+
+const double kFullBusyRate = 1.0;
+
+}
+
+BusUtilization::BusUtilization(const SetupModel& setup)
+    : portToNode(setup.portToNode)
+{
+    for (const auto& edge : setup.edges) {
+        if (edge.first == edge.second) continue;
+        QVector<int>& next = successors[edge.first];
+        if (!next.contains(edge.second)) next.append(edge.second);
+    }
+    for (QVector<int>& next : successors) {
+        std::sort(next.begin(), next.end());
+    }
+}
+
+QString BusUtilization::metricName(Metric metric)
+{
+    switch (metric) {
+    case BusyRate: return "Busy rate";
+    case Traffic: return "Attributed traffic";
+    }
+    return QString();
+}
+
+QHash<int, int> BusUtilization::shortestPathTree(int source) const
+{
+    QHash<int, int> previous;
+    previous.insert(source, source);
+    QVector<int> queue{source};
+    for (int head = 0; head < queue.size(); ++head) {
+        int node = queue[head];
+        for (int next : successors.value(node)) {
+            if (previous.contains(next)) continue;
+            previous.insert(next, node);
+            queue.append(next);
+        }
+    }
+    return previous;
+}
+
+BusUtilization::Values BusUtilization::compute(Metric metric, const QMap<QString, QString>& busCounters) const
+{
+    Values values;
+
+    if (metric == BusyRate) {
+        static const QRegularExpression edgeRe("^edge_(\\d+)_to_(\\d+)_busy_rate$");
+        static const QRegularExpression nodeRe("^node_(\\d+)_busy_rate$");
+        for (auto it = busCounters.begin(); it != busCounters.end(); ++it) {
+            if (!it.key().endsWith("_busy_rate")) continue;
+            QRegularExpressionMatch match = edgeRe.match(it.key());
+            if (match.hasMatch()) {
+                values.edges.insert(qMakePair(match.captured(1).toInt(), match.captured(2).toInt()), it.value().toDouble());
+                continue;
+            }
+            match = nodeRe.match(it.key());
+            if (match.hasMatch()) values.nodes.insert(match.captured(1).toInt(), it.value().toDouble());
+        }
+    } else {
+        // 按源节点分组，每个源节点只做一次广度优先搜索
+        static const QRegularExpression portRe("^transmit_package_number_from_(\\d+)_to_(\\d+)$");
+        QMap<int, QVector<QPair<int, double>>> flows;      // 源节点 -> (目的节点, 包数)
+        for (auto it = busCounters.begin(); it != busCounters.end(); ++it) {
+            if (!it.key().startsWith("transmit_package_number_from_")) continue;
+            QRegularExpressionMatch match = portRe.match(it.key());
+            if (!match.hasMatch()) continue;
+            double packets = it.value().toDouble();
+            if (packets <= 0) continue;
+            int fromPort = match.captured(1).toInt();
+            int toPort = match.captured(2).toInt();
+            if (!portToNode.contains(fromPort) || !portToNode.contains(toPort)) {
+                values.unroutable++;
+                continue;
+            }
+            flows[portToNode.value(fromPort)].append(qMakePair(portToNode.value(toPort), packets));
+        }
+
+        for (auto source = flows.begin(); source != flows.end(); ++source) {
+            QHash<int, int> previous = shortestPathTree(source.key());
+            for (const auto& flow : source.value()) {
+                int node = flow.first;
+                if (!previous.contains(node)) {
+                    values.unroutable++;
+                    continue;
+                }
+                // 同一节点上的端口之间不经过任何边，只计入节点
+                values.nodes[node] += flow.second;
+                while (node != source.key()) {
+                    int before = previous.value(node);
+                    values.edges[qMakePair(before, node)] += flow.second;
+                    values.nodes[before] += flow.second;
+                    node = before;
+                }
+            }
+        }
+    }
+
+    for (double value : values.edges) values.edgeMax = qMax(values.edgeMax, value);
+    for (double value : values.nodes) values.nodeMax = qMax(values.nodeMax, value);
+    values.edgeScale = metric == BusyRate ? kFullBusyRate : values.edgeMax;
+    values.nodeScale = metric == BusyRate ? kFullBusyRate : values.nodeMax;
+    return values;
+}
@@ -0,0 +1,49 @@
+#ifndef BUSUTILIZATION_H
+#define BUSUTILIZATION_H
+
+#include "../statistics/SetupModel.h"
+#include <QHash>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+// 总线各有向边与各节点的利用率，供芯片视图的热力叠加层着色
+// BusyRate 直接读取 edge_X_to_Y_busy_rate 与 node_X_busy_rate；
+// Traffic 把端口间的包数 (transmit_package_number_from_A_to_B) 沿总线上的最短路径 (按跳数，
+// 相同时取编号小的前驱) 分摊到经过的每条边和每个节点
+class BusUtilization
+{
+public:
+    enum Metric {
+        BusyRate,
+        Traffic
+    };
+
+    struct Values {
+        QHash<QPair<int, int>, double> edges;       // (发送节点, 接收节点) -> 值
+        QHash<int, double> nodes;
+        double edgeMax = 0;
+        double nodeMax = 0;
+        // 着色的满刻度: BusyRate 是绝对的比例，固定为 1，颜色不随运行或快照中的最大值变化；Traffic 为最大值
+        double edgeScale = 0;
+        double nodeScale = 0;
+        int unroutable = 0;                         // Traffic: 找不到路径的端口对
+    };
+
+    explicit BusUtilization(const SetupModel& setup);
+
+    // busCounters 为 Bus 组件的计数器 (StatsLoader::getPortTransmissions() 的格式)
+    Values compute(Metric metric, const QMap<QString, QString>& busCounters) const;
+
+    static QString metricName(Metric metric);
+
+private:
+    // 从 source 出发的广度优先搜索，返回各节点在最短路径树上的前驱
+    QHash<int, int> shortestPathTree(int source) const;
+
+    QMap<int, int> portToNode;
+    QMap<int, QVector<int>> successors;             // 按编号排序
+};
+
+#endif // BUSUTILIZATION_H
@@ -0,0 +1,464 @@
+#include "ConservationValidator.h"
+#include <QFile>
+#include <QTextStream>
+#include <QSet>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 浮点比较的最小相对误差
+const double kEpsilon = 1e-9;
+
+// 重复键在报告中最多列出的数量
+const int kMaxListedKeys = 8;
+
+}
+
+ConservationValidator::ConservationValidator()
+    : lastInstanceCount(0)
+{
+    parseRules(defaultRules());
+}
+
+QString ConservationValidator::defaultRules()
+{
+    return QStringLiteral(R"(# 乘号两侧需有空格，"*" 紧贴名称时是通配符
+# 总线: 总包数等于所有端口对的包数之和，节点包数不超过其端口的收发总量
+bus_total: Bus.transmit_package_number = sum(Bus.transmit_package_number_from_*_to_*)
+node_ports: Bus.node_{k}_transmit_package_number <= ports({k})
+
+# CPU: 命中 + 缺失 = 访问，每次访问至少消耗一个周期
+ld_accesses: CPU{n}.ld_inst_cnt = CPU{n}.ld_cache_hit_count + CPU{n}.ld_cache_miss_count
+st_accesses: CPU{n}.st_inst_cnt = CPU{n}.st_cache_hit_count + CPU{n}.st_cache_miss_count
+ld_ticks: CPU{n}.ld_mem_tick_sum >= CPU{n}.ld_inst_cnt
+st_ticks: CPU{n}.st_mem_tick_sum >= CPU{n}.st_inst_cnt
+
+# 内存: 处理的请求数等于 L3 缺失事件数，每次缺失至少经过一次总线传输
+memory_requests: MemoryNode0.message_precossed = cache_event_trace.l1miss_l2miss_l3miss_cnt
+l3miss_ticks: cache_event_trace.l1miss_l2miss_l3miss_tick >= cache_event_trace.l1miss_l2miss_l3miss_cnt * Bus.avg_transmit_latency
+
+# cache_event_trace: 每类事件各段的时间比例之和为 1
+l2forward_split: sum(cache_event_trace.l1miss_l2forward_*_avg) = 1 tolerance 0.001 if cache_event_trace.l1miss_l2forward_cnt > 0
+l3hit_split: cache_event_trace.l1miss_l2miss_l1_l2_avg + cache_event_trace.l1miss_l2miss_l2_l3_avg + cache_event_trace.l1miss_l2miss_l3_l2_avg + cache_event_trace.l1miss_l2miss_l2_l1_avg = 1 tolerance 0.001 if cache_event_trace.l1miss_l2miss_l3hit_cnt > 0
+l3forward_split: sum(cache_event_trace.l1miss_l2miss_l3forward_*_avg) = 1 tolerance 0.001 if cache_event_trace.l1miss_l2miss_l3forward_cnt > 0
+l3miss_split: sum(cache_event_trace.l1miss_l2miss_l3miss_*_avg) = 1 tolerance 0.001 if cache_event_trace.l1miss_l2miss_l3miss_cnt > 0
+
+# 使用率与命中率都在 [0, 1] 内
+rates: *.*_rate in [0, 1]
+)");
+}
+
+bool ConservationValidator::loadRules(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Cannot open validation rules at" << path;
+        return false;
+    }
+    return parseRules(QTextStream(&file).readAll());
+}
+
+bool ConservationValidator::parseRules(const QString& text)
+{
+    QVector<Rule> parsed;
+    QRegularExpression conditionRe("\\s+if\\s+(\\S+)\\s*>\\s*0\\s*$");
+    QRegularExpression toleranceRe("\\s+tolerance\\s+(\\S+)\\s*$");
+    QRegularExpression rangeRe("^(\\S+)\\s+in\\s+\\[([^,\\]]+),([^\\]]+)\\]$");
+    QRegularExpression placeholderRe("\\{(\\w+)\\}");
+
+    const QStringList lines = text.split('\n');
+    for (int lineNumber = 1; lineNumber <= lines.size(); ++lineNumber) {
+        QString line = lines[lineNumber - 1].section('#', 0, 0).trimmed();
+        if (line.isEmpty()) continue;
+
+        int colon = line.indexOf(':');
+        if (colon <= 0) {
+            qDebug() << "Validation rules line" << lineNumber << ": missing rule name";
+            return false;
+        }
+
+        Rule rule;
+        rule.name = line.left(colon).trimmed();
+        QString body = line.mid(colon + 1).trimmed();
+
+        QRegularExpressionMatch match = conditionRe.match(body);
+        if (match.hasMatch()) {
+            rule.condition = match.captured(1);
+            body = body.left(match.capturedStart()).trimmed();
+        }
+        match = toleranceRe.match(body);
+        if (match.hasMatch()) {
+            rule.tolerance = match.captured(1).toDouble();
+            body = body.left(match.capturedStart()).trimmed();
+        }
+
+        match = rangeRe.match(body);
+        bool ok = true;
+        if (match.hasMatch()) {
+            bool lowOk = false, highOk = false;
+            rule.isRange = true;
+            rule.rangePattern = match.captured(1);
+            rule.low = match.captured(2).trimmed().toDouble(&lowOk);
+            rule.high = match.captured(3).trimmed().toDouble(&highOk);
+            ok = lowOk && highOk;
+        } else {
+            for (const QString& relation : {QString("<="), QString(">="), QString("=")}) {
+                int position = body.indexOf(relation);
+                if (position < 0) continue;
+                rule.relation = relation;
+                ok = parseExpression(body.left(position), rule.lhs)
+                  && parseExpression(body.mid(position + relation.size()), rule.rhs);
+                break;
+            }
+            ok = ok && !rule.relation.isEmpty();
+        }
+
+        if (!ok) {
+            qDebug() << "Validation rules line" << lineNumber << ": cannot parse" << line;
+            return false;
+        }
+
+        QRegularExpressionMatchIterator it = placeholderRe.globalMatch(body + " " + rule.condition);
+        while (it.hasNext()) {
+            QString name = it.next().captured(1);
+            if (!rule.placeholders.contains(name)) rule.placeholders.append(name);
+        }
+        parsed.append(rule);
+    }
+
+    rules = parsed;
+    return true;
+}
+
+bool ConservationValidator::parseExpression(const QString& text, Expression& expression) const
+{
+    QRegularExpression numberRe("^[-+]?[0-9]*\\.?[0-9]+([eE][-+]?[0-9]+)?$");
+    QRegularExpression functionRe("^(sum|ports)\\((\\S+)\\)$");
+
+    expression.clear();
+    for (const QString& termText : text.split('+')) {
+        Product product;
+        for (QString factorText : termText.split(QRegularExpression("\\s\\*\\s"))) {
+            factorText = factorText.trimmed();
+            if (factorText.isEmpty()) return false;
+
+            Factor factor;
+            QRegularExpressionMatch function = functionRe.match(factorText);
+            if (numberRe.match(factorText).hasMatch()) {
+                factor.type = Factor::Number;
+                factor.number = factorText.toDouble();
+            } else if (function.hasMatch()) {
+                factor.type = function.captured(1) == "sum" ? Factor::Sum : Factor::Ports;
+                factor.pattern = function.captured(2);
+            } else if (!factorText.contains(' ') && !factorText.contains('(')) {
+                factor.type = Factor::Counter;
+                factor.pattern = factorText;
+            } else {
+                return false;
+            }
+            product.append(factor);
+        }
+        expression.append(product);
+    }
+    return !expression.isEmpty();
+}
+
+QRegularExpression ConservationValidator::patternRegex(const QString& pattern)
+{
+    // "*" 匹配名称片段 (不跨越组件与计数器之间的 "."), "{x}" 捕获为命名分组
+    QString regex = QRegularExpression::escape(pattern);
+    regex.replace("\\*", "[A-Za-z0-9_]*");
+    regex.replace(QRegularExpression("\\\\\\{(\\w+)\\\\\\}"), "(?<\\1>[A-Za-z0-9]+)");
+    return QRegularExpression(QRegularExpression::anchoredPattern(regex));
+}
+
+QString ConservationValidator::substitute(QString pattern, const QMap<QString, QString>& binding)
+{
+    for (auto it = binding.begin(); it != binding.end(); ++it) {
+        pattern.replace("{" + it.key() + "}", it.value());
+    }
+    return pattern;
+}
+
+QList<QMap<QString, QString>> ConservationValidator::bindings(const Rule& rule, const CounterStore& store) const
+{
+    if (rule.placeholders.isEmpty()) return {QMap<QString, QString>()};
+
+    // 用第一个含全部占位符的计数器模式枚举取值，其次是 sum() 的模式
+    QString source;
+    for (int pass = 0; pass < 2 && source.isEmpty(); ++pass) {
+        Factor::Type wanted = pass == 0 ? Factor::Counter : Factor::Sum;
+        for (const Expression* expression : {&rule.lhs, &rule.rhs}) {
+            for (const Product& product : *expression) {
+                for (const Factor& factor : product) {
+                    if (factor.type != wanted || !source.isEmpty()) continue;
+                    bool coversAll = std::all_of(rule.placeholders.begin(), rule.placeholders.end(),
+                        [&factor](const QString& name) { return factor.pattern.contains("{" + name + "}"); });
+                    if (coversAll) source = factor.pattern;
+                }
+            }
+        }
+    }
+    if (source.isEmpty()) {
+        qDebug() << "Validation rule" << rule.name << ": placeholders cannot be resolved";
+        return {};
+    }
+
+    QRegularExpression regex = patternRegex(source);
+    QList<QMap<QString, QString>> result;
+    QSet<QString> seen;
+    for (const QString& name : store.columnNames()) {
+        QRegularExpressionMatch match = regex.match(name);
+        if (!match.hasMatch()) continue;
+
+        QMap<QString, QString> binding;
+        QString key;
+        for (const QString& placeholder : rule.placeholders) {
+            binding[placeholder] = match.captured(placeholder);
+            key += binding[placeholder] + "\n";
+        }
+        if (seen.contains(key)) continue;
+        seen.insert(key);
+        result.append(binding);
+    }
+    return result;
+}
+
+QVector<int> ConservationValidator::portColumns(const QString& node, const CounterStore& store) const
+{
+    // 节点上所有端口发出或收到的包数
+    bool ok = false;
+    int nodeId = node.toInt(&ok);
+    QVector<int> columns;
+    if (!ok) return columns;
+
+    QSet<int> ports;
+    for (int port : setup.portsOfNode(nodeId)) ports.insert(port);
+
+    QRegularExpression re("^Bus\\.transmit_package_number_from_(\\d+)_to_(\\d+)$");
+    for (int i = 0; i < store.columnCount(); ++i) {
+        QRegularExpressionMatch match = re.match(store.columnName(i));
+        if (match.hasMatch() && (ports.contains(match.captured(1).toInt()) || ports.contains(match.captured(2).toInt()))) {
+            columns.append(i);
+        }
+    }
+    return columns;
+}
+
+bool ConservationValidator::compileExpression(const Expression& expression, const QMap<QString, QString>& binding,
+                                              const CounterStore& store, QVector<Term>& terms,
+                                              QVector<int>& counters) const
+{
+    for (const Product& product : expression) {
+        QVector<Term> partial(1);
+        for (const Factor& factor : product) {
+            QString pattern = substitute(factor.pattern, binding);
+            if (factor.type == Factor::Number) {
+                for (Term& term : partial) term.coefficient *= factor.number;
+            } else if (factor.type == Factor::Counter) {
+                // 所有运行都没有的计数器: 规则不适用
+                int column = store.columnIndex(pattern);
+                if (column < 0) return false;
+                for (Term& term : partial) {
+                    term.columns.append(column);
+                    term.zeroIfMissing.append(false);
+                }
+                counters.append(column);
+            } else {
+                if (factor.type == Factor::Ports && setup.portToNode.isEmpty()) return false;
+                QVector<int> columns = factor.type == Factor::Sum
+                    ? store.columnsMatching(patternRegex(pattern))
+                    : portColumns(pattern, store);
+
+                // 按加法分配展开
+                QVector<Term> expanded;
+                for (const Term& term : partial) {
+                    for (int column : columns) {
+                        Term next = term;
+                        next.columns.append(column);
+                        next.zeroIfMissing.append(true);
+                        expanded.append(next);
+                    }
+                }
+                partial = expanded;
+            }
+        }
+        terms += partial;
+    }
+    return true;
+}
+
+void ConservationValidator::evaluateTerms(const QVector<Term>& terms, const CounterStore& store,
+                                          QVector<double>& result) const
+{
+    const int runs = store.runCount();
+    result.fill(0.0, runs);
+    QVector<double> product(runs);
+
+    // 逐列的连续循环，编译器可以向量化
+    double* sum = result.data();
+    double* p = product.data();
+    for (const Term& term : terms) {
+        std::fill(p, p + runs, term.coefficient);
+        for (int i = 0; i < term.columns.size(); ++i) {
+            const double* values = store.column(term.columns[i]).constData();
+            if (term.zeroIfMissing[i]) {
+                for (int r = 0; r < runs; ++r) p[r] *= values[r] == values[r] ? values[r] : 0.0;
+            } else {
+                for (int r = 0; r < runs; ++r) p[r] *= values[r];
+            }
+        }
+        for (int r = 0; r < runs; ++r) sum[r] += p[r];
+    }
+}
+
+void ConservationValidator::evaluate(const Instance& instance, const CounterStore& store,
+                                     QVector<ValidationIssue>& issues) const
+{
+    const int runs = store.runCount();
+    QVector<double> lhs, rhs;
+    evaluateTerms(instance.lhs, store, lhs);
+    evaluateTerms(instance.rhs, store, rhs);
+
+    // 先算出所有运行的违例标记，再只对违例的运行生成报告
+    QVector<char> violated(runs);
+    const double* l = lhs.constData();
+    const double* r = rhs.constData();
+    char* bad = violated.data();
+    const double tolerance = instance.tolerance + kEpsilon;
+    if (instance.relation == "=") {
+        for (int i = 0; i < runs; ++i) bad[i] = !(std::fabs(l[i] - r[i]) <= tolerance * std::max(1.0, std::fabs(r[i])));
+    } else if (instance.relation == "<=") {
+        for (int i = 0; i < runs; ++i) bad[i] = !(l[i] - r[i] <= tolerance * std::max(1.0, std::fabs(r[i])));
+    } else {
+        for (int i = 0; i < runs; ++i) bad[i] = !(r[i] - l[i] <= tolerance * std::max(1.0, std::fabs(r[i])));
+    }
+    if (instance.conditionColumn >= 0) {
+        const double* condition = store.column(instance.conditionColumn).constData();
+        for (int i = 0; i < runs; ++i) bad[i] = bad[i] && condition[i] > 0;
+    }
+
+    for (int run = 0; run < runs; ++run) {
+        if (!bad[run]) continue;
+
+        ValidationIssue issue;
+        issue.run = run;
+        issue.rule = instance.name;
+
+        // NaN 说明某个计数器在这次运行中缺失 (可能是截断的文件)
+        if (std::isnan(l[run]) || std::isnan(r[run])) {
+            for (int column : instance.counters) {
+                if (std::isnan(store.column(column)[run])) issue.counters.append(store.columnName(column));
+            }
+            issue.message = "missing counter";
+        } else {
+            for (int column : instance.counters) issue.counters.append(store.columnName(column));
+            issue.message = QString("%1 %2 %3 does not hold (difference %4)")
+                                .arg(l[run], 0, 'g', 10)
+                                .arg(instance.relation)
+                                .arg(r[run], 0, 'g', 10)
+                                .arg(l[run] - r[run], 0, 'g', 6);
+        }
+        issues.append(issue);
+    }
+}
+
+void ConservationValidator::evaluateRange(const Rule& rule, const CounterStore& store,
+                                          QVector<ValidationIssue>& issues) const
+{
+    const int runs = store.runCount();
+    for (int column : store.columnsMatching(patternRegex(rule.rangePattern))) {
+        lastInstanceCount++;
+        const double* values = store.column(column).constData();
+        for (int run = 0; run < runs; ++run) {
+            // 缺失值不算越界
+            if (!(values[run] < rule.low || values[run] > rule.high)) continue;
+
+            ValidationIssue issue;
+            issue.run = run;
+            issue.rule = rule.name;
+            issue.counters = {store.columnName(column)};
+            issue.message = QString("%1 outside [%2, %3]").arg(values[run]).arg(rule.low).arg(rule.high);
+            issues.append(issue);
+        }
+    }
+}
+
+void ConservationValidator::reportParseIssues(const CounterStore& store, QVector<ValidationIssue>& issues) const
+{
+    for (int run = 0; run < store.runCount(); ++run) {
+        const RunInfo& info = store.run(run);
+
+        for (const QString& key : info.conflictingKeys) {
+            ValidationIssue issue;
+            issue.run = run;
+            issue.rule = "duplicates";
+            issue.counters = {key};
+            issue.message = "key appears more than once with different values";
+            issues.append(issue);
+        }
+
+        if (!info.duplicateKeys.isEmpty()) {
+            ValidationIssue issue;
+            issue.run = run;
+            issue.severity = ValidationIssue::Warning;
+            issue.rule = "duplicates";
+            issue.counters = info.duplicateKeys.mid(0, kMaxListedKeys);
+            issue.message = QString("%1 keys repeated with identical values").arg(info.duplicateKeys.size());
+            issues.append(issue);
+        }
+
+        if (info.malformedLines > 0) {
+            ValidationIssue issue;
+            issue.run = run;
+            issue.rule = "format";
+            issue.message = QString("%1 malformed or truncated lines").arg(info.malformedLines);
+            issues.append(issue);
+        }
+    }
+}
+
+QVector<ValidationIssue> ConservationValidator::validate(const CounterStore& store) const
+{
+    QVector<ValidationIssue> issues;
+    lastInstanceCount = 0;
+    if (store.runCount() == 0) return issues;
+
+    reportParseIssues(store, issues);
+
+    for (const Rule& rule : rules) {
+        if (rule.isRange) {
+            evaluateRange(rule, store, issues);
+            continue;
+        }
+
+        for (const QMap<QString, QString>& binding : bindings(rule, store)) {
+            Instance instance;
+            instance.relation = rule.relation;
+            instance.tolerance = rule.tolerance;
+            if (!compileExpression(rule.lhs, binding, store, instance.lhs, instance.counters)) continue;
+            if (!compileExpression(rule.rhs, binding, store, instance.rhs, instance.counters)) continue;
+
+            if (!rule.condition.isEmpty()) {
+                instance.conditionColumn = store.columnIndex(substitute(rule.condition, binding));
+                if (instance.conditionColumn < 0) continue;
+            }
+
+            QStringList values;
+            for (auto it = binding.begin(); it != binding.end(); ++it) {
+                values.append(it.key() + "=" + it.value());
+            }
+            instance.name = values.isEmpty() ? rule.name : rule.name + "[" + values.join(",") + "]";
+
+            lastInstanceCount++;
+            evaluate(instance, store, issues);
+        }
+    }
+
+    std::stable_sort(issues.begin(), issues.end(), [](const ValidationIssue& a, const ValidationIssue& b) {
+        return a.run < b.run;
+    });
+    return issues;
+}
@@ -0,0 +1,107 @@
+#ifndef CONSERVATIONVALIDATOR_H
+#define CONSERVATIONVALIDATOR_H
+
+#include "../statistics/CounterStore.h"
+#include "../statistics/SetupModel.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+
+// 校验发现的一个问题
+struct ValidationIssue {
+    enum Severity {
+        Warning,    // 冗余但不影响结果 (如值相同的重复行)
+        Error       // 守恒关系不成立、计数器缺失或数据损坏
+    };
+
+    int run = -1;               // CounterStore 中的行号
+    Severity severity = Error;
+    QString rule;               // 规则实例名，如 "ld_accesses[n=0]"
+    QStringList counters;       // 涉及的计数器 ("组件.计数器")
+    QString message;
+};
+
+// 守恒关系校验器
+// 规则文本每行一条:
+//   <名称>: <表达式> (= | <= | >=) <表达式> [tolerance <相对误差>] [if <计数器> > 0]
+//   <名称>: <计数器模式> in [<下界>, <上界>]
+// 表达式由 "+" 连接的乘积项组成，因子可以是数字、计数器、sum(<模式>) 或 ports(<节点>)。
+// 模式中 "*" 匹配任意名称片段，"{x}" 为占位符，按匹配到的计数器展开为多个规则实例。
+// 校验时每个规则实例对所有运行做一次按列的向量化计算
+class ConservationValidator
+{
+public:
+    ConservationValidator();
+
+    // 内置的默认规则 (适用于 statistic.txt 的格式)
+    static QString defaultRules();
+
+    bool loadRules(const QString& path);
+    bool parseRules(const QString& text);
+    int ruleCount() const { return rules.size(); }
+
+    // ports(<节点>) 需要端口到节点的映射
+    void setSetup(const SetupModel& setup) { this->setup = setup; }
+
+    QVector<ValidationIssue> validate(const CounterStore& store) const;
+
+    // 上一次 validate 评估的规则实例数
+    int instanceCount() const { return lastInstanceCount; }
+
+private:
+    struct Factor {
+        enum Type { Number, Counter, Sum, Ports } type = Number;
+        double number = 0;
+        QString pattern;
+    };
+    using Product = QVector<Factor>;
+    using Expression = QVector<Product>;
+
+    struct Rule {
+        QString name;
+        bool isRange = false;
+        Expression lhs, rhs;
+        QString relation;           // "=", "<=", ">="
+        double tolerance = 0;
+        QString condition;          // 为空表示无条件
+        QString rangePattern;
+        double low = 0, high = 0;
+        QStringList placeholders;
+    };
+
+    // 编译后的乘积项: 系数 × 各列之积
+    struct Term {
+        double coefficient = 1;
+        QVector<int> columns;
+        QVector<bool> zeroIfMissing;    // sum()/ports() 展开的列缺失时按 0 计
+    };
+
+    struct Instance {
+        QString name;
+        QVector<Term> lhs, rhs;
+        QString relation;
+        double tolerance = 0;
+        int conditionColumn = -1;
+        QVector<int> counters;          // 报告中列出的计数器 (不含 sum 展开)
+    };
+
+    bool parseExpression(const QString& text, Expression& expression) const;
+    QList<QMap<QString, QString>> bindings(const Rule& rule, const CounterStore& store) const;
+    bool compileExpression(const Expression& expression, const QMap<QString, QString>& binding,
+                           const CounterStore& store, QVector<Term>& terms, QVector<int>& counters) const;
+    QVector<int> portColumns(const QString& node, const CounterStore& store) const;
+    void evaluate(const Instance& instance, const CounterStore& store, QVector<ValidationIssue>& issues) const;
+    void evaluateRange(const Rule& rule, const CounterStore& store, QVector<ValidationIssue>& issues) const;
+    void evaluateTerms(const QVector<Term>& terms, const CounterStore& store, QVector<double>& result) const;
+    void reportParseIssues(const CounterStore& store, QVector<ValidationIssue>& issues) const;
+
+    static QString substitute(QString pattern, const QMap<QString, QString>& binding);
+    static QRegularExpression patternRegex(const QString& pattern);
+
+    QVector<Rule> rules;
+    SetupModel setup;
+    mutable int lastInstanceCount;
+};
+
+#endif // CONSERVATIONVALIDATOR_H
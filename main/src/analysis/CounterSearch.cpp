@@ -0,0 +1,265 @@
+#include "CounterSearch.h"
+#include <QSet>
+#include <algorithm>
+
+namespace {
+
+const int kExactScore = 3;
+const int kPrefixScore = 2;
+const int kFuzzyScore = 1;
+const int kMinFuzzyLength = 3;      // 更短的词做模糊匹配几乎总能命中
+
+// 最优字符串对齐距离是否不超过 1 (替换、插入、删除或相邻交换一次)
+bool withinOneEdit(const QString& a, const QString& b)
+{
+    int lengthA = a.size();
+    int lengthB = b.size();
+    if (qAbs(lengthA - lengthB) > 1) return false;
+
+    int prefix = 0;
+    while (prefix < lengthA && prefix < lengthB && a[prefix] == b[prefix]) prefix++;
+    if (prefix == lengthA && prefix == lengthB) return true;
+
+    auto sameTail = [&](int fromA, int fromB) {
+        return QStringView(a).mid(fromA) == QStringView(b).mid(fromB);
+    };
+    if (lengthA == lengthB) {
+        if (sameTail(prefix + 1, prefix + 1)) return true;
+        return prefix + 1 < lengthA && a[prefix] == b[prefix + 1] && a[prefix + 1] == b[prefix]
+               && sameTail(prefix + 2, prefix + 2);
+    }
+    return lengthA > lengthB ? sameTail(prefix + 1, prefix) : sameTail(prefix, prefix + 1);
+}
+
+QStringList queryTerms(const QString& query)
+{
+    QStringList result;
+    QString current;
+    for (QChar c : query) {
+        if (c.isLetterOrNumber()) {
+            current.append(c.toLower());
+        } else if (!current.isEmpty()) {
+            result.append(current);
+            current.clear();
+        }
+    }
+    if (!current.isEmpty()) result.append(current);
+    result.removeDuplicates();
+    return result;
+}
+
+}
+
+CounterSearch::CounterSearch()
+    : finalized(true)
+{
+}
+
+QStringList CounterSearch::tokenize(const QString& name)
+{
+    QStringList tokens;
+    auto addToken = [&tokens](const QString& token) {
+        if (token.isEmpty()) return;
+        tokens.append(token);
+
+        // 去掉末尾编号: cpu12 -> cpu
+        int end = token.size();
+        while (end > 0 && token[end - 1].isDigit()) end--;
+        if (end > 0 && end < token.size()) tokens.append(token.left(end));
+    };
+
+    addToken(name.toLower());
+
+    int partBegin = 0;
+    for (int i = 0; i <= name.size(); ++i) {
+        if (i < name.size() && name[i].isLetterOrNumber()) continue;
+        QString part = name.mid(partBegin, i - partBegin);
+        partBegin = i + 1;
+        if (part.isEmpty()) continue;
+        addToken(part.toLower());
+
+        // 大小写边界: 小写或数字后接大写 (L3Cache)，连续大写后接大写加小写 (LLCHit)
+        int fragmentBegin = 0;
+        for (int j = 1; j < part.size(); ++j) {
+            bool upper = part[j].isUpper();
+            bool previousLowerOrDigit = part[j - 1].isLower() || part[j - 1].isDigit();
+            bool acronymEnd = part[j - 1].isUpper() && j + 1 < part.size() && part[j + 1].isLower();
+            if (upper && (previousLowerOrDigit || acronymEnd)) {
+                addToken(part.mid(fragmentBegin, j - fragmentBegin).toLower());
+                fragmentBegin = j;
+            }
+        }
+        if (fragmentBegin > 0) addToken(part.mid(fragmentBegin).toLower());
+    }
+
+    tokens.removeDuplicates();
+    return tokens;
+}
+
+void CounterSearch::addRun(const QString& runId, const QMap<QString, ComponentStats>& statsData)
+{
+    for (auto component = statsData.begin(); component != statsData.end(); ++component) {
+        addDocument(runId, component.key(), QString(), QString());
+        const ComponentStats& stats = component.value();
+        for (auto it = stats.data.begin(); it != stats.data.end(); ++it) {
+            addDocument(runId, component.key(), it.key(), it.value());
+        }
+        for (auto it = stats.percentages.begin(); it != stats.percentages.end(); ++it) {
+            addDocument(runId, component.key(), it.key(), QString::number(it.value(), 'f', 2));
+        }
+    }
+}
+
+int CounterSearch::addDocument(const QString& runId, const QString& component, const QString& counter,
+                               const QString& value)
+{
+    QString key = counter.isEmpty() ? component : component + "." + counter;
+    auto existing = documentIds.constFind(key);
+    if (existing != documentIds.constEnd()) {
+        QStringList& runs = documents[existing.value()].runs;
+        if (runs.isEmpty() || runs.last() != runId) runs.append(runId);
+        return existing.value();
+    }
+
+    int id = documents.size();
+    Document document;
+    document.component = component;
+    document.counter = counter;
+    document.value = value;
+    document.runs.append(runId);
+    documents.append(document);
+    documentIds.insert(key, id);
+
+    // 文档只在第一次出现时登记，编号递增，倒排表无需排序
+    QStringList tokens = tokenize(component);
+    if (!counter.isEmpty()) tokens += tokenize(counter);
+    tokens.removeDuplicates();
+    for (const QString& token : tokens) {
+        pendingPostings[token].append(id);
+    }
+    finalized = false;
+    return id;
+}
+
+void CounterSearch::clear()
+{
+    documents.clear();
+    documentIds.clear();
+    pendingPostings.clear();
+    terms.clear();
+    postings.clear();
+    deletions.clear();
+    finalized = true;
+}
+
+void CounterSearch::finalize()
+{
+    if (finalized) return;
+
+    terms = pendingPostings.keys();
+    std::sort(terms.begin(), terms.end());
+    postings.clear();
+    postings.reserve(terms.size());
+    deletions.clear();
+
+    for (int t = 0; t < terms.size(); ++t) {
+        const QString& term = terms[t];
+        postings.append(pendingPostings.value(term));
+        if (term.size() < kMinFuzzyLength) continue;
+
+        deletions[term].append(t);
+        for (int i = 0; i < term.size(); ++i) {
+            QString deleted = term.left(i) + term.mid(i + 1);
+            QVector<int>& candidates = deletions[deleted];
+            if (candidates.isEmpty() || candidates.last() != t) candidates.append(t);
+        }
+    }
+    finalized = true;
+}
+
+QVector<CounterSearch::Match> CounterSearch::search(const QString& query, int limit)
+{
+    finalize();
+    QStringList words = queryTerms(query);
+    if (words.isEmpty() || documents.isEmpty()) return {};
+
+    const int count = documents.size();
+    QVector<int> total(count, 0);
+    QVector<int> matchedWords(count, 0);
+    QVector<int> best(count, 0);        // 当前查询词在各文档上的最好得分
+    QVector<int> touched;
+
+    for (const QString& word : words) {
+        // 词典中以该词开头的连续区间: 完全匹配或前缀匹配
+        QVector<QPair<int, int>> matchedTerms;      // (词下标, 得分)
+        auto first = std::lower_bound(terms.begin(), terms.end(), word);
+        for (auto it = first; it != terms.end() && it->startsWith(word); ++it) {
+            matchedTerms.append(qMakePair(static_cast<int>(it - terms.begin()), *it == word ? kExactScore : kPrefixScore));
+        }
+
+        // 删除邻域: 查询词本身及删去一个字符后的形式，候选再用编辑距离确认
+        if (word.size() >= kMinFuzzyLength) {
+            QSet<int> seen;
+            for (const auto& term : matchedTerms) seen.insert(term.first);
+            auto consider = [&](const QString& key) {
+                auto it = deletions.constFind(key);
+                if (it == deletions.constEnd()) return;
+                for (int t : it.value()) {
+                    if (seen.contains(t)) continue;
+                    seen.insert(t);
+                    if (withinOneEdit(word, terms[t])) matchedTerms.append(qMakePair(t, kFuzzyScore));
+                }
+            };
+            consider(word);
+            for (int i = 0; i < word.size(); ++i) {
+                consider(word.left(i) + word.mid(i + 1));
+            }
+        }
+
+        touched.clear();
+        for (const auto& term : matchedTerms) {
+            for (int document : postings[term.first]) {
+                if (best[document] == 0) touched.append(document);
+                best[document] = qMax(best[document], term.second);
+            }
+        }
+        for (int document : touched) {
+            total[document] += best[document];
+            matchedWords[document]++;
+            best[document] = 0;
+        }
+    }
+
+    // 只保留匹配所有查询词的文档
+    QVector<int> hits;
+    for (int document : touched) {
+        if (matchedWords[document] == words.size()) hits.append(document);
+    }
+    auto keyLength = [this](int document) {
+        return documents[document].component.size() + documents[document].counter.size();
+    };
+    auto better = [&](int a, int b) {
+        if (total[a] != total[b]) return total[a] > total[b];
+        if (keyLength(a) != keyLength(b)) return keyLength(a) < keyLength(b);
+        return a < b;
+    };
+    if (limit > 0 && hits.size() > limit) {
+        std::partial_sort(hits.begin(), hits.begin() + limit, hits.end(), better);
+        hits.resize(limit);
+    } else {
+        std::sort(hits.begin(), hits.end(), better);
+    }
+
+    QVector<Match> result;
+    result.reserve(hits.size());
+    for (int document : hits) {
+        Match match;
+        match.component = documents[document].component;
+        match.counter = documents[document].counter;
+        match.value = documents[document].value;
+        match.runs = documents[document].runs;
+        match.score = total[document];
+        result.append(match);
+    }
+    return result;
+}
@@ -0,0 +1,63 @@
+#ifndef COUNTERSEARCH_H
+#define COUNTERSEARCH_H
+
+#include "../statistics/ComponentStats.h"
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// 计数器搜索: 对组件名、计数器名 (含派生指标) 及其拆分出的片段 (如 l3、miss、busy) 建立倒排索引
+// 词典按字典序排列，前缀匹配用二分查找定位连续区间；拼写错误通过删除邻域匹配编辑距离为 1 的词。
+// 查询按非字母数字字符拆成多个词，结果须匹配所有词，按匹配方式 (完全 3 > 前缀 2 > 模糊 1) 计分排序。
+// 同名计数器在多次运行中只占一个文档，记录出现过的运行
+class CounterSearch
+{
+public:
+    struct Match {
+        QString component;
+        QString counter;        // 为空表示组件本身
+        QString value;          // 最先加入的运行中的值
+        QStringList runs;       // 包含该计数器的运行
+        int score = 0;
+    };
+
+    CounterSearch();
+
+    void addRun(const QString& runId, const QMap<QString, ComponentStats>& statsData);
+    void clear();
+
+    // 建立词典与删除邻域；加入运行后第一次搜索时自动调用
+    void finalize();
+
+    QVector<Match> search(const QString& query, int limit = 50);
+
+    int documentCount() const { return documents.size(); }
+    int termCount() const { return terms.size(); }
+
+    // 名称拆成小写片段: 在非字母数字字符和大小写边界处断开 (L3Cache -> l3, cache)，
+    // 同时保留完整名称与去掉末尾编号的形式 (CPU12 -> cpu12, cpu)
+    static QStringList tokenize(const QString& name);
+
+private:
+    struct Document {
+        QString component;
+        QString counter;
+        QString value;
+        QStringList runs;
+    };
+
+    int addDocument(const QString& runId, const QString& component, const QString& counter, const QString& value);
+
+    QVector<Document> documents;
+    QHash<QString, int> documentIds;                // "组件.计数器" -> 文档
+    QHash<QString, QVector<int>> pendingPostings;   // finalize 前按词收集的文档
+
+    QStringList terms;                              // 排序后的词典
+    QVector<QVector<int>> postings;                 // 与 terms 对应，文档编号递增
+    QHash<QString, QVector<int>> deletions;         // 删去一个字符后的形式 (及词本身) -> 词下标
+    bool finalized;
+};
+
+#endif // COUNTERSEARCH_H
@@ -0,0 +1,463 @@
+#include "DesignSpaceExplorer.h"
+#include "../concurrency/WorkStealingPool.h"
+#include <QRandomGenerator>
+#include <QSet>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+// 阵列容量每翻倍，线延迟增加的周期数
+const double kWireCyclesPerDoubling = 1.0;
+
+// MSHR 利用率上限，避免排队因子发散
+const double kMaxMshrUtilization = 0.95;
+
+// frontUpdated 信号的最小间隔 (毫秒)
+const int kFrontSignalIntervalMs = 100;
+
+QVector<int> uniqueSorted(QVector<int> values)
+{
+    values.erase(std::remove_if(values.begin(), values.end(), [](int v) { return v <= 0; }), values.end());
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    return values;
+}
+
+// 一个参数的取值；基准配置中没有该参数 (如没有 L3) 时只取基准值，不让整个网格为空
+QVector<int> axis(int baselineValue, const QVector<int>& candidates)
+{
+    if (baselineValue <= 0) return {baselineValue};
+    return uniqueSorted(candidates);
+}
+
+double lineCount(const CacheGeometry& geometry)
+{
+    return static_cast<double>(geometry.setCount) * geometry.wayCount;
+}
+
+}
+
+// ==================== DesignSpace ====================
+
+DesignSpace DesignSpace::aroundBaseline(const CacheGeometry& l2, const CacheGeometry& l3)
+{
+    DesignSpace space;
+    space.l2Sets = axis(l2.setCount, {l2.setCount / 4, l2.setCount / 2, l2.setCount, l2.setCount * 2, l2.setCount * 4});
+    space.l2Ways = axis(l2.wayCount, {2, 4, 8, 16, l2.wayCount});
+    space.l2Mshrs = axis(l2.mshrCount, {4, 8, 16, l2.mshrCount});
+    space.l2Latencies = axis(l2.indexLatency, {l2.indexLatency - 1, l2.indexLatency, l2.indexLatency + 2});
+    space.l3Sets = axis(l3.setCount, {l3.setCount / 4, l3.setCount / 2, l3.setCount, l3.setCount * 2, l3.setCount * 4});
+    space.l3Ways = axis(l3.wayCount, {4, 8, 16, l3.wayCount});
+    space.l3Mshrs = axis(l3.mshrCount, {4, 8, 16, l3.mshrCount});
+    space.l3Latencies = axis(l3.indexLatency, {l3.indexLatency - 2, l3.indexLatency, l3.indexLatency + 4});
+    return space;
+}
+
+qint64 DesignSpace::gridSize() const
+{
+    return static_cast<qint64>(l2Sets.size()) * l2Ways.size() * l2Mshrs.size() * l2Latencies.size()
+         * l3Sets.size() * l3Ways.size() * l3Mshrs.size() * l3Latencies.size();
+}
+
+void DesignSpace::decode(qint64 index, CacheGeometry& l2, CacheGeometry& l3) const
+{
+    auto take = [&index](const QVector<int>& values) {
+        int value = values[static_cast<int>(index % values.size())];
+        index /= values.size();
+        return value;
+    };
+
+    l2.setCount = take(l2Sets);
+    l2.wayCount = take(l2Ways);
+    l2.mshrCount = take(l2Mshrs);
+    l2.indexLatency = take(l2Latencies);
+    l3.setCount = take(l3Sets);
+    l3.wayCount = take(l3Ways);
+    l3.mshrCount = take(l3Mshrs);
+    l3.indexLatency = take(l3Latencies);
+}
+
+// ==================== CacheModel ====================
+
+bool CacheModel::calibrate(const QMap<QString, ComponentStats>& statsData, const SetupModel& setup,
+                           const QMap<QString, MissRatioCurve>& curves)
+{
+    l2Caches.clear();
+    l3Caches.clear();
+
+    for (auto it = setup.components.begin(); it != setup.components.end(); ++it) {
+        const QString& name = it.key();
+        const ComponentStats stats = statsData.value(name);
+
+        CacheLevel level;
+        level.id = name;
+        level.curve = curves.value(name);
+
+        if (it.value().contains("l2_set_count")) {
+            if (l2Caches.isEmpty()) {
+                baseL2.setCount = setup.intParam(name, "l2_set_count");
+                baseL2.wayCount = setup.intParam(name, "l2_way_count");
+                baseL2.mshrCount = setup.intParam(name, "l2_mshr_count");
+                baseL2.indexLatency = setup.intParam(name, "l2_index_latency");
+            }
+            double hits = stats.data.value("l2_hit_count").toDouble();
+            double misses = stats.data.value("l2_miss_count").toDouble();
+            level.accesses = hits + misses;
+            level.missRate = level.accesses > 0 ? misses / level.accesses : 0;
+            l2Caches.append(level);
+        } else if (it.value().contains("set_count")) {
+            if (l3Caches.isEmpty()) {
+                baseL3.setCount = setup.intParam(name, "set_count");
+                baseL3.wayCount = setup.intParam(name, "way_count");
+                baseL3.mshrCount = setup.intParam(name, "mshr_count");
+                baseL3.indexLatency = setup.intParam(name, "index_latency");
+            }
+            double hits = stats.data.value("llc_hit_count").toDouble();
+            double misses = stats.data.value("llc_miss_count").toDouble();
+            level.accesses = hits + misses;
+            level.missRate = level.accesses > 0 ? misses / level.accesses : 0;
+            l3Caches.append(level);
+        }
+    }
+
+    l2Count = l2Caches.size();
+    l3Count = l3Caches.size();
+    if (l2Caches.isEmpty() || lineCount(baseL2) <= 0) {
+        qDebug() << "Design space model: no L2 geometry in setup";
+        l2Caches.clear();
+        return false;
+    }
+
+    // 用 cache_event_trace 中各类事件的平均周期拆出总线与内存开销
+    const ComponentStats events = statsData.value("cache_event_trace");
+    auto averageTicks = [&events](const QString& prefix) {
+        double count = events.data.value(prefix + "_cnt").toDouble();
+        double ticks = events.data.value(prefix + "_tick").toDouble();
+        return count > 0 ? ticks / count : -1.0;
+    };
+    double l2HitAvg = averageTicks("l1miss_l2hit");
+    double l3HitAvg = averageTicks("l1miss_l2miss_l3hit");
+    double l3MissAvg = averageTicks("l1miss_l2miss_l3miss");
+    double busLatency = statsData.value("Bus").data.value("avg_transmit_latency", "1").toDouble();
+
+    l2OverheadCycles = l2HitAvg > 0 ? qMax(0.0, l2HitAvg - baseL2.indexLatency) : 0;
+    busCycles = 2 * busLatency;
+    if (l3HitAvg > 0 && l2HitAvg > 0) {
+        busCycles = qMax(busCycles, l3HitAvg - l2HitAvg - baseL3.indexLatency);
+    }
+    memoryCycles = (l3MissAvg > 0 && l3HitAvg > 0) ? qMax(1.0, l3MissAvg - l3HitAvg) : 100.0;
+
+    runCycles = 1;
+    for (auto it = statsData.begin(); it != statsData.end(); ++it) {
+        if (it.key().startsWith("CPU")) {
+            runCycles = qMax(runCycles, it.value().data.value("total_tick_processed").toDouble());
+        }
+    }
+
+    qDebug() << "Design space model calibrated: L2 overhead" << l2OverheadCycles
+             << "bus" << busCycles << "memory" << memoryCycles << "cycles";
+    return true;
+}
+
+double CacheModel::predictMissRate(const CacheLevel& level, const CacheGeometry& base,
+                                   const CacheGeometry& geometry) const
+{
+    double baseLines = lineCount(base);
+    double lines = lineCount(geometry);
+    if (baseLines <= 0 || lines <= 0) return level.missRate;
+
+    // 容量: 优先使用缺失率曲线的相对变化，否则按 √2 经验法则 (容量翻倍，缺失率降为 1/√2)
+    double ratio;
+    if (level.curve.capacityBytes.size() >= 2) {
+        double baseMiss = 1.0 - level.curve.hitRatioAt(baseLines * lineBytes);
+        double newMiss = 1.0 - level.curve.hitRatioAt(lines * lineBytes);
+        ratio = baseMiss > 0 ? newMiss / baseMiss : 1.0;
+    } else {
+        ratio = std::pow(lines / baseLines, -0.5);
+    }
+
+    // 相联度: 冲突缺失近似与 1/路数 成正比
+    ratio *= (1.0 + 1.0 / geometry.wayCount) / (1.0 + 1.0 / base.wayCount);
+
+    return qBound(0.0, level.missRate * ratio, 1.0);
+}
+
+double CacheModel::effectiveLatency(const CacheGeometry& base, const CacheGeometry& geometry) const
+{
+    double baseLines = lineCount(base);
+    double lines = lineCount(geometry);
+    double wire = (baseLines > 0 && lines > 0) ? kWireCyclesPerDoubling * std::log2(lines / baseLines) : 0;
+    return qMax(1.0, geometry.indexLatency + wire);
+}
+
+double CacheModel::queueingFactor(double missesPerCycle, double missLatency, int mshrCount) const
+{
+    // Little 定律: 平均在途缺失数 = 到达率 × 缺失延迟
+    if (mshrCount <= 0) return 1.0;
+    double utilization = qMin(kMaxMshrUtilization, missesPerCycle * missLatency / mshrCount);
+    return 1.0 / (1.0 - utilization);
+}
+
+double CacheModel::evaluateInternal(const CacheGeometry& l2, const CacheGeometry& l3,
+                                    QMap<QString, QMap<QString, QString>>* details) const
+{
+    double l2Latency = effectiveLatency(baseL2, l2) + l2OverheadCycles;
+    double l3Latency = l3Count > 0 ? effectiveLatency(baseL3, l3) : 0;
+
+    // L2 缺失数变化后，L3 的访问量按比例缩放
+    double baseL2Misses = 0;
+    double newL2Misses = 0;
+    QVector<double> l2MissRates;
+    for (const CacheLevel& level : l2Caches) {
+        double missRate = predictMissRate(level, baseL2, l2);
+        l2MissRates.append(missRate);
+        baseL2Misses += level.accesses * level.missRate;
+        newL2Misses += level.accesses * missRate;
+    }
+    double l3Scale = baseL2Misses > 0 ? newL2Misses / baseL2Misses : 1.0;
+
+    // L3: 每次访问的平均缺失代价
+    double l3Accesses = 0;
+    double l3MissCost = 0;
+    for (const CacheLevel& level : l3Caches) {
+        double accesses = level.accesses * l3Scale;
+        double missRate = predictMissRate(level, baseL3, l3);
+        double misses = accesses * missRate;
+        double queueing = queueingFactor(misses / runCycles, memoryCycles + l3Latency, l3.mshrCount);
+        l3Accesses += accesses;
+        l3MissCost += misses * memoryCycles * queueing;
+
+        if (details) {
+            QMap<QString, QString>& row = (*details)[level.id];
+            row["Predicted Accesses"] = QString::number(accesses, 'f', 0);
+            row["Predicted Hit Rate"] = QString::number((1.0 - missRate) * 100, 'f', 2) + "%";
+            row["Predicted Misses"] = QString::number(misses, 'f', 0);
+            row["Index Latency"] = QString::number(l3Latency, 'f', 1) + " cycles";
+            row["MSHR Queueing Factor"] = QString::number(queueing, 'f', 3);
+        }
+    }
+    double l3AccessCost = busCycles + l3Latency + (l3Accesses > 0 ? l3MissCost / l3Accesses : memoryCycles);
+
+    // L2: 按各 L2 访问量加权得到 AMAT
+    double totalAccesses = 0;
+    double totalCycles = 0;
+    for (int i = 0; i < l2Caches.size(); ++i) {
+        const CacheLevel& level = l2Caches[i];
+        double missRate = l2MissRates[i];
+        double misses = level.accesses * missRate;
+        double queueing = queueingFactor(misses / runCycles, l3AccessCost, l2.mshrCount);
+        double cost = l2Latency + missRate * l3AccessCost * queueing;
+        totalAccesses += level.accesses;
+        totalCycles += level.accesses * cost;
+
+        if (details) {
+            QMap<QString, QString>& row = (*details)[level.id];
+            row["Predicted Hit Rate"] = QString::number((1.0 - missRate) * 100, 'f', 2) + "%";
+            row["Predicted Misses"] = QString::number(misses, 'f', 0);
+            row["Index Latency"] = QString::number(l2Latency, 'f', 1) + " cycles";
+            row["MSHR Queueing Factor"] = QString::number(queueing, 'f', 3);
+            row["Avg Access Time"] = QString::number(cost, 'f', 2) + " cycles";
+        }
+    }
+
+    return totalAccesses > 0 ? totalCycles / totalAccesses : l2Latency;
+}
+
+DesignPoint CacheModel::evaluate(const CacheGeometry& l2, const CacheGeometry& l3) const
+{
+    DesignPoint point;
+    point.l2 = l2;
+    point.l3 = l3;
+    point.capacityBytes = (l2Count * lineCount(l2) + l3Count * lineCount(l3)) * lineBytes;
+    point.amat = evaluateInternal(l2, l3, nullptr);
+    return point;
+}
+
+QMap<QString, QMap<QString, QString>> CacheModel::predictComponents(const CacheGeometry& l2,
+                                                                    const CacheGeometry& l3) const
+{
+    QMap<QString, QMap<QString, QString>> details;
+    double amat = evaluateInternal(l2, l3, &details);
+    double capacity = (l2Count * lineCount(l2) + l3Count * lineCount(l3)) * lineBytes;
+
+    QMap<QString, QString>& summary = details["Summary"];
+    summary["AMAT"] = QString::number(amat, 'f', 3) + " cycles";
+    summary["Total Capacity"] = QString::number(capacity / 1024.0, 'f', 0) + " KB";
+    summary["L2 Geometry"] = QString("%1 sets x %2 ways, %3 MSHR, latency %4")
+                                 .arg(l2.setCount).arg(l2.wayCount).arg(l2.mshrCount).arg(l2.indexLatency);
+    summary["L3 Geometry"] = QString("%1 sets x %2 ways, %3 MSHR, latency %4")
+                                 .arg(l3.setCount).arg(l3.wayCount).arg(l3.mshrCount).arg(l3.indexLatency);
+    return details;
+}
+
+// ==================== ParetoFront ====================
+
+bool ParetoFront::insert(const DesignPoint& point)
+{
+    auto byCapacity = [](double capacity, const DesignPoint& p) { return capacity < p.capacityBytes; };
+    auto it = std::upper_bound(front.begin(), front.end(), point.capacityBytes, byCapacity);
+    int position = static_cast<int>(it - front.begin());
+
+    // 容量不大于它的点中 AMAT 最小的就是前一个点
+    if (position > 0 && front[position - 1].amat <= point.amat) return false;
+
+    // 同容量但 AMAT 更大的旧点被支配
+    while (position > 0 && front[position - 1].capacityBytes == point.capacityBytes) {
+        front.remove(position - 1);
+        position--;
+    }
+
+    // 容量更大但 AMAT 不更小的旧点被支配
+    int end = position;
+    while (end < front.size() && front[end].amat >= point.amat) end++;
+    front.remove(position, end - position);
+
+    front.insert(position, point);
+    return true;
+}
+
+// ==================== DesignSpaceExplorer ====================
+
+DesignSpaceExplorer::DesignSpaceExplorer(QObject* parent)
+    : QObject(parent)
+    , cancelRequested(false)
+{
+}
+
+DesignSpaceExplorer::~DesignSpaceExplorer()
+{
+    cancel();
+    sweepTask.cancel();
+    sweepTask.wait();
+}
+
+bool DesignSpaceExplorer::setBaseline(const QMap<QString, ComponentStats>& statsData, const SetupModel& setup,
+                                      const QMap<QString, MissRatioCurve>& curves)
+{
+    if (isRunning()) return false;
+    if (!model.calibrate(statsData, setup, curves)) return false;
+
+    designSpace = DesignSpace::aroundBaseline(model.baselineL2(), model.baselineL3());
+    baseline = model.evaluate(model.baselineL2(), model.baselineL3());
+
+    QMutexLocker locker(&mutex);
+    points.clear();
+    front.clear();
+    return true;
+}
+
+void DesignSpaceExplorer::start(SweepMode mode, int sampleCount)
+{
+    if (isRunning() || !model.isValid()) return;
+
+    qint64 total = designSpace.gridSize();
+    QVector<qint64> indices;
+    if (mode == GridSweep || sampleCount >= total) {
+        indices.resize(total);
+        std::iota(indices.begin(), indices.end(), 0);
+    } else {
+        // 固定种子，同一数据多次抽样结果可复现
+        QRandomGenerator generator(static_cast<quint32>(sampleCount));
+        QSet<qint64> chosen;
+        while (chosen.size() < sampleCount) {
+            chosen.insert(generator.bounded(total));
+        }
+        indices = QVector<qint64>(chosen.begin(), chosen.end());
+        std::sort(indices.begin(), indices.end());
+    }
+
+    {
+        QMutexLocker locker(&mutex);
+        points.clear();
+        front.clear();
+        points.reserve(indices.size());
+        lastFrontSignal.start();
+    }
+
+    cancelRequested = false;
+    // 扫描是批量任务，点击等交互任务优先
+    sweepTask = runInBackground(WorkStealingPool::Batch, this, [this, indices]() { runSweep(indices); }, [this]() {
+        sweepTask.reset();
+        emit frontUpdated();
+        emit finished();
+    });
+}
+
+void DesignSpaceExplorer::cancel()
+{
+    cancelRequested = true;
+}
+
+bool DesignSpaceExplorer::isRunning() const
+{
+    return sweepTask.isValid();
+}
+
+void DesignSpaceExplorer::runSweep(QVector<qint64> indices)
+{
+    const int grainSize = 64;
+    int total = indices.size();
+    int chunks = (total + grainSize - 1) / grainSize;
+    std::atomic<int> done(0);
+
+    WorkStealingPool::instance().parallelFor(chunks, [&](int chunk) {
+        if (cancelRequested || !WorkStealingPool::checkpoint()) return;
+
+        int begin = chunk * grainSize;
+        int end = qMin(total, begin + grainSize);
+
+        QVector<DesignPoint> batch;
+        batch.reserve(end - begin);
+        for (int i = begin; i < end; ++i) {
+            CacheGeometry l2, l3;
+            designSpace.decode(indices[i], l2, l3);
+            DesignPoint point = model.evaluate(l2, l3);
+            point.id = indices[i];
+            batch.append(point);
+        }
+
+        bool frontChanged = false;
+        bool notify = false;
+        {
+            QMutexLocker locker(&mutex);
+            for (const DesignPoint& point : batch) {
+                points.append(point);
+                frontChanged |= front.insert(point);
+            }
+            if (frontChanged && lastFrontSignal.elapsed() >= kFrontSignalIntervalMs) {
+                lastFrontSignal.restart();
+                notify = true;
+            }
+        }
+
+        emit progressChanged(done.fetch_add(batch.size()) + batch.size(), total);
+        if (notify) emit frontUpdated();
+    });
+
+    qDebug() << "Design space sweep evaluated" << done.load() << "of" << total << "configurations";
+}
+
+QVector<DesignPoint> DesignSpaceExplorer::evaluatedPoints() const
+{
+    QMutexLocker locker(&mutex);
+    return points;
+}
+
+QVector<DesignPoint> DesignSpaceExplorer::paretoFront() const
+{
+    QMutexLocker locker(&mutex);
+    return front.points();
+}
+
+DesignPoint DesignSpaceExplorer::baselinePoint() const
+{
+    return baseline;
+}
+
+QMap<QString, QMap<QString, QString>> DesignSpaceExplorer::predictComponents(const DesignPoint& point) const
+{
+    return model.predictComponents(point.l2, point.l3);
+}
@@ -0,0 +1,156 @@
+#ifndef DESIGNSPACEEXPLORER_H
+#define DESIGNSPACEEXPLORER_H
+
+#include "../statistics/ComponentStats.h"
+#include "../statistics/SetupModel.h"
+#include "MissRatioCurve.h"
+#include "../concurrency/BackgroundTask.h"
+#include <QObject>
+#include <QVector>
+#include <QMap>
+#include <QMutex>
+#include <QElapsedTimer>
+#include <atomic>
+
+// 一级缓存的几何参数 (同级的所有缓存使用相同配置)
+struct CacheGeometry {
+    int setCount = 0;
+    int wayCount = 0;
+    int mshrCount = 0;
+    int indexLatency = 0;
+};
+
+// 一个被评估的设计点
+struct DesignPoint {
+    qint64 id = -1;             // 网格下标，基准配置为 -1
+    CacheGeometry l2;
+    CacheGeometry l3;
+    double capacityBytes = 0;   // 所有 L2 与 L3 的总容量
+    double amat = 0;            // L1 缺失后的平均访存时间 (周期)
+};
+
+// 扫描范围，每个参数一组候选值
+struct DesignSpace {
+    QVector<int> l2Sets, l2Ways, l2Mshrs, l2Latencies;
+    QVector<int> l3Sets, l3Ways, l3Mshrs, l3Latencies;
+
+    // 以当前配置为中心生成默认扫描范围
+    static DesignSpace aroundBaseline(const CacheGeometry& l2, const CacheGeometry& l3);
+
+    qint64 gridSize() const;
+
+    // 按混合进制把网格下标解码为配置
+    void decode(qint64 index, CacheGeometry& l2, CacheGeometry& l3) const;
+};
+
+// 基于当前统计数据校准的快速解析模型
+// 容量变化通过缺失率曲线 (若有) 或 √2 经验法则外推，相联度、MSHR 排队与索引延迟分别修正
+class CacheModel
+{
+public:
+    bool calibrate(const QMap<QString, ComponentStats>& statsData, const SetupModel& setup,
+                   const QMap<QString, MissRatioCurve>& curves);
+
+    DesignPoint evaluate(const CacheGeometry& l2, const CacheGeometry& l3) const;
+
+    // 各组件的预测统计 (组件名 -> 指标 -> 显示文本)
+    QMap<QString, QMap<QString, QString>> predictComponents(const CacheGeometry& l2,
+                                                            const CacheGeometry& l3) const;
+
+    const CacheGeometry& baselineL2() const { return baseL2; }
+    const CacheGeometry& baselineL3() const { return baseL3; }
+    bool isValid() const { return !l2Caches.isEmpty(); }
+
+private:
+    struct CacheLevel {
+        QString id;
+        double accesses = 0;        // 基准运行中的访问数
+        double missRate = 0;        // 基准运行中的缺失率
+        MissRatioCurve curve;       // 可选: 地址 trace 得到的缺失率曲线
+    };
+
+    double predictMissRate(const CacheLevel& level, const CacheGeometry& base,
+                           const CacheGeometry& geometry) const;
+    double effectiveLatency(const CacheGeometry& base, const CacheGeometry& geometry) const;
+    double queueingFactor(double missesPerCycle, double missLatency, int mshrCount) const;
+    double evaluateInternal(const CacheGeometry& l2, const CacheGeometry& l3,
+                            QMap<QString, QMap<QString, QString>>* details) const;
+
+    QVector<CacheLevel> l2Caches;
+    QVector<CacheLevel> l3Caches;
+    CacheGeometry baseL2;
+    CacheGeometry baseL3;
+    int l2Count = 0;
+    int l3Count = 0;
+    double l2OverheadCycles = 0;    // L2 命中中除索引以外的开销
+    double busCycles = 0;           // L2 与 L3 之间的总线往返
+    double memoryCycles = 0;        // L3 缺失后访问内存的额外开销
+    double runCycles = 1;           // 运行总周期 (用于估计 MSHR 占用)
+    int lineBytes = 64;
+};
+
+// 增量维护的帕累托前沿 (容量与 AMAT 都越小越好)
+// 按容量升序保存，前沿上的 AMAT 严格递减
+class ParetoFront
+{
+public:
+    // 插入新点，被支配时返回 false；同时移除被新点支配的旧点
+    bool insert(const DesignPoint& point);
+    const QVector<DesignPoint>& points() const { return front; }
+    void clear() { front.clear(); }
+
+private:
+    QVector<DesignPoint> front;
+};
+
+// 设计空间探索引擎: 在工作窃取线程池上并行评估配置，并增量更新帕累托前沿
+class DesignSpaceExplorer : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum SweepMode {
+        GridSweep,      // 评估完整网格
+        RandomSample    // 在网格中随机抽样
+    };
+
+    explicit DesignSpaceExplorer(QObject* parent = nullptr);
+    ~DesignSpaceExplorer();
+
+    // 用当前运行的数据校准模型，并以其配置为中心生成扫描范围
+    bool setBaseline(const QMap<QString, ComponentStats>& statsData, const SetupModel& setup,
+                     const QMap<QString, MissRatioCurve>& curves);
+
+    void start(SweepMode mode, int sampleCount = 500);
+    void cancel();
+    bool isRunning() const;
+
+    QVector<DesignPoint> evaluatedPoints() const;
+    QVector<DesignPoint> paretoFront() const;
+    DesignPoint baselinePoint() const;
+    qint64 gridSize() const { return designSpace.gridSize(); }
+
+    QMap<QString, QMap<QString, QString>> predictComponents(const DesignPoint& point) const;
+
+signals:
+    void frontUpdated();
+    void progressChanged(int done, int total);
+    void finished();
+
+private:
+    void runSweep(QVector<qint64> indices);
+
+    CacheModel model;
+    DesignSpace designSpace;
+    DesignPoint baseline;
+
+    mutable QMutex mutex;
+    QVector<DesignPoint> points;
+    ParetoFront front;
+    QElapsedTimer lastFrontSignal;  // 限制 frontUpdated 的发送频率
+
+    TaskHandle sweepTask;           // 结果交给界面前保持有效
+    std::atomic<bool> cancelRequested;
+};
+
+#endif // DESIGNSPACEEXPLORER_H
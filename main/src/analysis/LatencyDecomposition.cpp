@@ -0,0 +1,277 @@
+#include "LatencyDecomposition.h"
+#include <QRegularExpression>
+#include <QSet>
+#include <QQueue>
+#include <QDebug>
+#include <algorithm>
+
+// ==================== EventLatency ====================
+
+double EventLatency::lookupCycles() const
+{
+    double sum = 0;
+    for (const HopLatency& hop : hops) sum += hop.lookupCycles;
+    return sum;
+}
+
+double EventLatency::busCycles() const
+{
+    double sum = 0;
+    for (const HopLatency& hop : hops) sum += hop.busCycles;
+    return sum;
+}
+
+double EventLatency::memoryCycles() const
+{
+    double sum = 0;
+    for (const HopLatency& hop : hops) sum += hop.memoryCycles;
+    return sum;
+}
+
+double EventLatency::otherCycles() const
+{
+    double sum = 0;
+    for (const HopLatency& hop : hops) sum += hop.otherCycles;
+    return sum;
+}
+
+// ==================== LatencyDecomposer ====================
+
+namespace {
+
+// 端点所在的总线位置: 请求方核心 (L1/L2)、其他核心、L3 或内存
+QString hostOf(const QString& endpoint)
+{
+    if (endpoint == "l1" || endpoint == "l2") return "self";
+    if (endpoint.startsWith("o")) return "other";
+    return endpoint;
+}
+
+}
+
+LatencyDecomposer::LatencyDecomposer(const SetupModel& setup, const QMap<QString, ComponentStats>& statsData,
+                                     const QMap<QString, QString>& portTransmissions)
+    : setup(setup)
+    , trace(statsData.value("cache_event_trace"))
+    , cyclesPerHop(0)
+{
+    QRegularExpression re("transmit_package_number_from_(\\d+)_to_(\\d+)");
+    for (auto it = portTransmissions.begin(); it != portTransmissions.end(); ++it) {
+        QRegularExpressionMatch match = re.match(it.key());
+        if (match.hasMatch()) {
+            portTraffic[qMakePair(match.captured(1).toInt(), match.captured(2).toInt())] = it.value().toULongLong();
+        }
+    }
+
+    // 总线节点之间的最短跳数 (BFS，边是有向的)
+    QMap<int, QList<int>> adjacency;
+    for (const QPair<int, int>& edge : setup.edges) {
+        adjacency[edge.first].append(edge.second);
+    }
+    QSet<int> nodes(setup.portToNode.begin(), setup.portToNode.end());
+    for (int source : nodes) {
+        QMap<int, int>& distance = nodeDistance[source];
+        distance[source] = 0;
+        QQueue<int> queue;
+        queue.enqueue(source);
+        while (!queue.isEmpty()) {
+            int node = queue.dequeue();
+            for (int next : adjacency.value(node)) {
+                if (!distance.contains(next)) {
+                    distance[next] = distance[node] + 1;
+                    queue.enqueue(next);
+                }
+            }
+        }
+    }
+
+    // avg_transmit_latency 是所有数据包的平均值，除以流量加权的平均跳数得到每跳周期数
+    double busLatency = statsData.value("Bus").data.value("avg_transmit_latency", "0").toDouble();
+    double weightedHops = 0;
+    double packets = 0;
+    for (auto it = portTraffic.begin(); it != portTraffic.end(); ++it) {
+        int fromNode = setup.portToNode.value(it.key().first, -1);
+        int toNode = setup.portToNode.value(it.key().second, -1);
+        if (!nodeDistance.value(fromNode).contains(toNode)) continue;
+        weightedHops += nodeDistance[fromNode][toNode] * static_cast<double>(it.value());
+        packets += it.value();
+    }
+    double meanHops = packets > 0 ? weightedHops / packets : 0;
+    cyclesPerHop = meanHops > 0 ? busLatency / meanHops : busLatency;
+}
+
+QStringList LatencyDecomposer::componentsOf(const QString& endpoint) const
+{
+    if (endpoint == "l3") return setup.componentsWithPrefix("L3Cache");
+    if (endpoint == "mem") return setup.componentsWithPrefix("MemoryNode");
+    return setup.componentsWithPrefix("L2Cache");
+}
+
+double LatencyDecomposer::averageBusHops(const QString& from, const QString& to) const
+{
+    // 按实际流量加权；端口对之间没有流量时取平均
+    double weightedHops = 0;
+    double packets = 0;
+    double plainHops = 0;
+    int pairs = 0;
+
+    for (const QString& source : componentsOf(from)) {
+        for (const QString& target : componentsOf(to)) {
+            if (source == target) continue;
+            int sourcePort = setup.portOf(source);
+            int targetPort = setup.portOf(target);
+            int sourceNode = setup.portToNode.value(sourcePort, -1);
+            int targetNode = setup.portToNode.value(targetPort, -1);
+            if (!nodeDistance.value(sourceNode).contains(targetNode)) continue;
+
+            int hops = nodeDistance[sourceNode][targetNode];
+            double traffic = portTraffic.value(qMakePair(sourcePort, targetPort), 0);
+            weightedHops += hops * traffic;
+            packets += traffic;
+            plainHops += hops;
+            pairs++;
+        }
+    }
+
+    if (packets > 0) return weightedHops / packets;
+    return pairs > 0 ? plainHops / pairs : 0;
+}
+
+double LatencyDecomposer::indexLatencyOf(const QString& endpoint) const
+{
+    // L1 没有单独的延迟配置，视为核内开销
+    if (endpoint == "l2" || endpoint == "ol2") {
+        QStringList caches = setup.componentsWithPrefix("L2Cache");
+        return caches.isEmpty() ? 0 : setup.intParam(caches.first(), "l2_index_latency");
+    }
+    if (endpoint == "l3") {
+        QStringList caches = setup.componentsWithPrefix("L3Cache");
+        return caches.isEmpty() ? 0 : setup.intParam(caches.first(), "index_latency");
+    }
+    return 0;
+}
+
+QVector<HopLatency> LatencyDecomposer::orderHops(QVector<HopLatency> hops) const
+{
+    // 从 l1 出发沿路径串联；有多条出边时先走远离请求方的一条，回到 l1 的边留到最后
+    QVector<HopLatency> ordered;
+    QString current = "l1";
+    while (!hops.isEmpty()) {
+        int next = -1;
+        for (int i = 0; i < hops.size(); ++i) {
+            if (hops[i].from != current) continue;
+            if (next < 0 || hops[next].to == "l1") next = i;
+        }
+        if (next < 0) break;
+        current = hops[next].to;
+        ordered.append(hops.takeAt(next));
+    }
+
+    // 无法串联的段按原顺序附在末尾
+    ordered += hops;
+    return ordered;
+}
+
+void LatencyDecomposer::attribute(EventLatency& event) const
+{
+    // 每段先扣除总线传输；首次到达某个缓存时扣除其索引延迟，首次到达内存时剩余部分计为内存访问
+    QSet<QString> visited = {"l1"};
+    for (HopLatency& hop : event.hops) {
+        double remaining = hop.cycles;
+
+        hop.onBus = hostOf(hop.from) != hostOf(hop.to);
+        if (hop.onBus) {
+            hop.busCycles = qMin(remaining, averageBusHops(hop.from, hop.to) * cyclesPerHop);
+            remaining -= hop.busCycles;
+        }
+
+        if (!visited.contains(hop.to)) {
+            visited.insert(hop.to);
+            if (hop.to == "mem") {
+                hop.memoryCycles = remaining;
+                remaining = 0;
+            } else {
+                hop.lookupCycles = qMin(remaining, indexLatencyOf(hop.to));
+                remaining -= hop.lookupCycles;
+            }
+        }
+
+        hop.otherCycles = remaining;
+    }
+}
+
+QString LatencyDecomposer::labelOf(const QString& eventClass)
+{
+    // l1miss_l2miss_l3forward -> "L3 Forward"
+    QString last = eventClass.section('_', -1);
+    QRegularExpressionMatch match = QRegularExpression("^(l\\d)(\\w+)$").match(last);
+    if (!match.hasMatch()) return eventClass;
+    QString outcome = match.captured(2);
+    outcome[0] = outcome[0].toUpper();
+    return match.captured(1).toUpper() + " " + outcome;
+}
+
+QVector<EventLatency> LatencyDecomposer::decompose() const
+{
+    QVector<EventLatency> events;
+    if (trace.data.isEmpty()) {
+        qDebug() << "No cache_event_trace section in statistics";
+        return events;
+    }
+
+    QRegularExpression hopPattern("^([a-z0-9]+)_([a-z0-9]+)_avg$");
+    for (auto it = trace.data.begin(); it != trace.data.end(); ++it) {
+        if (!it.key().endsWith("_cnt")) continue;
+
+        EventLatency event;
+        event.eventClass = it.key().chopped(4);
+        event.label = labelOf(event.eventClass);
+        event.count = it.value().toULongLong();
+        event.totalTicks = trace.data.value(event.eventClass + "_tick").toDouble();
+        if (event.count == 0) continue;
+        event.avgCycles = event.totalTicks / event.count;
+
+        // 分段比例的键以事件类为前缀；L3 命中的键省略了最后一级 (l1miss_l2miss_l1_l2_avg)
+        QStringList prefixes = {event.eventClass + "_", event.eventClass.section('_', 0, -2) + "_"};
+        for (const QString& prefix : prefixes) {
+            for (auto hopIt = trace.data.begin(); hopIt != trace.data.end(); ++hopIt) {
+                if (!hopIt.key().startsWith(prefix)) continue;
+                QRegularExpressionMatch match = hopPattern.match(hopIt.key().mid(prefix.size()));
+                if (!match.hasMatch()) continue;
+
+                HopLatency hop;
+                hop.from = match.captured(1);
+                hop.to = match.captured(2);
+                hop.fraction = hopIt.value().toDouble();
+                event.hops.append(hop);
+            }
+            if (!event.hops.isEmpty()) break;
+        }
+
+        // 没有分段比例 (如 L2 命中) 时视为一次 L1 -> L2 的往返
+        if (event.hops.isEmpty()) {
+            HopLatency hop;
+            hop.from = "l1";
+            hop.to = "l2";
+            hop.fraction = 1.0;
+            event.hops.append(hop);
+        }
+
+        // 比例之和不严格为 1，按比例归一化使各段之和等于平均延迟
+        double fractionSum = 0;
+        for (const HopLatency& hop : event.hops) fractionSum += hop.fraction;
+        for (HopLatency& hop : event.hops) {
+            hop.cycles = fractionSum > 0 ? event.avgCycles * hop.fraction / fractionSum : 0;
+        }
+
+        event.hops = orderHops(event.hops);
+        attribute(event);
+        events.append(event);
+    }
+
+    // 按平均延迟升序: L2 命中在前，L3 缺失在后
+    std::sort(events.begin(), events.end(), [](const EventLatency& a, const EventLatency& b) {
+        return a.avgCycles < b.avgCycles;
+    });
+    return events;
+}
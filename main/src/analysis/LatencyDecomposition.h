@@ -0,0 +1,67 @@
+#ifndef LATENCYDECOMPOSITION_H
+#define LATENCYDECOMPOSITION_H
+
+#include "../statistics/ComponentStats.h"
+#include "../statistics/SetupModel.h"
+#include <QString>
+#include <QVector>
+#include <QMap>
+
+// 一类缓存事件中的一段传输 (如 l2 -> l3)，单位均为平均每次事件的周期数
+struct HopLatency {
+    QString from;               // 端点: l1, l2, l3, mem, ol1 (另一个 L1), ol2 (另一个 L2)
+    QString to;
+    double fraction = 0;        // cache_event_trace 中的 xxx_avg
+    double cycles = 0;
+    double lookupCycles = 0;    // 目标缓存的索引延迟 (index_latency)
+    double busCycles = 0;       // 按拓扑距离估计的总线传输
+    double memoryCycles = 0;    // 内存 (DRAM) 访问
+    double otherCycles = 0;     // 剩余部分: 排队、MSHR 等待、核内传输
+
+    bool onBus = false;         // 两端是否位于不同的总线端口
+};
+
+// 一类缓存事件 (如 l1miss_l2miss_l3miss) 的逐段延迟分解
+struct EventLatency {
+    QString eventClass;         // cache_event_trace 中的键前缀
+    QString label;              // 显示名称
+    quint64 count = 0;
+    double totalTicks = 0;
+    double avgCycles = 0;
+    QVector<HopLatency> hops;   // 按请求路径排序
+
+    double lookupCycles() const;
+    double busCycles() const;
+    double memoryCycles() const;
+    double otherCycles() const;
+};
+
+// 把 cache_event_trace 的比例拆分换算成每一段的绝对周期数，
+// 再结合总线拓扑与 index_latency 把每段归因到缓存查找、总线传输或内存访问
+class LatencyDecomposer
+{
+public:
+    LatencyDecomposer(const SetupModel& setup, const QMap<QString, ComponentStats>& statsData,
+                      const QMap<QString, QString>& portTransmissions);
+
+    QVector<EventLatency> decompose() const;
+
+    // 由 Bus 的 avg_transmit_latency 与各端口对的流量反推的每跳周期数
+    double cyclesPerBusHop() const { return cyclesPerHop; }
+
+private:
+    QStringList componentsOf(const QString& endpoint) const;
+    double averageBusHops(const QString& from, const QString& to) const;
+    double indexLatencyOf(const QString& endpoint) const;
+    QVector<HopLatency> orderHops(QVector<HopLatency> hops) const;
+    void attribute(EventLatency& event) const;
+    static QString labelOf(const QString& eventClass);
+
+    SetupModel setup;
+    ComponentStats trace;
+    QMap<QPair<int, int>, quint64> portTraffic;    // (源端口, 目的端口) -> 数据包数
+    QMap<int, QMap<int, int>> nodeDistance;        // 总线节点间的最短跳数
+    double cyclesPerHop;
+};
+
+#endif // LATENCYDECOMPOSITION_H
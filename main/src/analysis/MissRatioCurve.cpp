@@ -0,0 +1,319 @@
+#include "MissRatioCurve.h"
+#include "../concurrency/WorkStealingPool.h"
+#include <QFile>
+#include <QDir>
+#include <QDebug>
+#include <QtMath>
+#include <cmath>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace {
+
+// 哈希取值空间 P，采样率 = T / P
+const quint32 kHashModulus = 1u << 24;
+
+// 对数分桶覆盖的最大距离 (2^32 个缓存行)
+const int kMaxOctaves = 32;
+
+quint32 blockHash(quint64 block)
+{
+    // splitmix64 的末尾混合，保证相邻地址的哈希足够分散
+    block ^= block >> 33;
+    block *= 0xff51afd7ed558ccdULL;
+    block ^= block >> 33;
+    block *= 0xc4ceb9fe1a85ec53ULL;
+    block ^= block >> 33;
+    return static_cast<quint32>(block & (kHashModulus - 1));
+}
+
+}
+
+// ==================== MissRatioCurve ====================
+
+double MissRatioCurve::hitRatioAt(double bytes) const
+{
+    if (capacityBytes.isEmpty()) return 0;
+    if (bytes <= capacityBytes.first()) return hitRatio.first();
+    if (bytes >= capacityBytes.last()) return hitRatio.last();
+
+    for (int i = 1; i < capacityBytes.size(); ++i) {
+        if (capacityBytes[i] >= bytes) {
+            double x0 = std::log2(capacityBytes[i - 1]);
+            double x1 = std::log2(capacityBytes[i]);
+            double t = (std::log2(bytes) - x0) / (x1 - x0);
+            return hitRatio[i - 1] + t * (hitRatio[i] - hitRatio[i - 1]);
+        }
+    }
+    return hitRatio.last();
+}
+
+// ==================== ShardsProfiler ====================
+
+ShardsProfiler::ShardsProfiler(int maxTrackedBlocks, int binsPerOctave)
+    : maxTracked(qMax(64, maxTrackedBlocks))
+    , binsPerOctave(qMax(1, binsPerOctave))
+    , threshold(kHashModulus)
+    , clock(1)
+    , coldMisses(0)
+    , totalAccesses(0)
+{
+    // 逻辑时间用满后压缩重编号，Fenwick 树大小保持为跟踪上限的常数倍
+    fenwick.fill(0, 4 * maxTracked + 2);
+    histogram.fill(0.0, kMaxOctaves * this->binsPerOctave);
+    tracked.reserve(maxTracked + 1);
+}
+
+double ShardsProfiler::sampleRate() const
+{
+    return static_cast<double>(threshold) / kHashModulus;
+}
+
+void ShardsProfiler::access(quint64 block)
+{
+    totalAccesses++;
+
+    quint32 hash = blockHash(block);
+    if (hash >= threshold) return;
+
+    double weight = 1.0 / sampleRate();
+
+    auto it = tracked.find(block);
+    if (it != tracked.end()) {
+        // 上次访问之后被访问过的不同缓存行数即为重用距离
+        int previous = static_cast<int>(it->timestamp);
+        int distinct = fenwickPrefix(static_cast<int>(clock) - 1) - fenwickPrefix(previous);
+        recordDistance(distinct * weight, weight);
+        fenwickAdd(previous, -1);
+        it->timestamp = clock;
+    } else {
+        coldMisses += weight;
+        tracked.insert(block, Entry{clock, hash});
+        hashHeap.push(std::make_pair(hash, block));
+    }
+
+    fenwickAdd(static_cast<int>(clock), 1);
+    clock++;
+
+    if (tracked.size() > maxTracked) {
+        evictOverBudget();
+    }
+    if (static_cast<int>(clock) >= fenwick.size()) {
+        compactTimestamps();
+    }
+}
+
+void ShardsProfiler::recordDistance(double distance, double weight)
+{
+    // 第 i 个桶覆盖 (距离 + 1) 属于 [2^(i/k), 2^((i+1)/k))
+    int bin = static_cast<int>(std::log2(distance + 1.0) * binsPerOctave);
+    bin = qBound(0, bin, histogram.size() - 1);
+    histogram[bin] += weight;
+}
+
+void ShardsProfiler::evictOverBudget()
+{
+    // 降低阈值到当前最大的 hash，淘汰所有不再满足采样条件的缓存行
+    while (tracked.size() > maxTracked && !hashHeap.empty()) {
+        threshold = hashHeap.top().first;
+        while (!hashHeap.empty() && hashHeap.top().first >= threshold) {
+            auto it = tracked.find(hashHeap.top().second);
+            if (it != tracked.end()) {
+                fenwickAdd(static_cast<int>(it->timestamp), -1);
+                tracked.erase(it);
+            }
+            hashHeap.pop();
+        }
+    }
+}
+
+void ShardsProfiler::compactTimestamps()
+{
+    std::vector<std::pair<quint32, quint64>> order;
+    order.reserve(tracked.size());
+    for (auto it = tracked.begin(); it != tracked.end(); ++it) {
+        order.push_back(std::make_pair(it->timestamp, it.key()));
+    }
+    std::sort(order.begin(), order.end());
+
+    fenwick.fill(0);
+    quint32 next = 1;
+    for (const auto& item : order) {
+        tracked[item.second].timestamp = next;
+        fenwickAdd(static_cast<int>(next), 1);
+        next++;
+    }
+    clock = next;
+}
+
+void ShardsProfiler::fenwickAdd(int index, int delta)
+{
+    for (; index < fenwick.size(); index += index & -index) {
+        fenwick[index] += delta;
+    }
+}
+
+int ShardsProfiler::fenwickPrefix(int index) const
+{
+    int sum = 0;
+    for (; index > 0; index -= index & -index) {
+        sum += fenwick[index];
+    }
+    return sum;
+}
+
+MissRatioCurve ShardsProfiler::buildCurve(int lineBytes, double minCapacityLines) const
+{
+    MissRatioCurve curve;
+    curve.sampleRate = sampleRate();
+    curve.accessCount = totalAccesses;
+    if (totalAccesses == 0) return curve;
+
+    // SHARDS_adj: 采样带来的总数偏差集中修正到最小距离的桶
+    QVector<double> bins = histogram;
+    double estimated = coldMisses;
+    for (double count : bins) estimated += count;
+    bins[0] = qMax(0.0, bins[0] + static_cast<double>(totalAccesses) - estimated);
+
+    double total = coldMisses;
+    int lastBin = 0;
+    for (int i = 0; i < bins.size(); ++i) {
+        total += bins[i];
+        if (bins[i] > 0) lastBin = i;
+    }
+
+    int minBins = static_cast<int>(std::ceil(std::log2(qMax(1.0, minCapacityLines)) * binsPerOctave));
+    int pointCount = qMin(bins.size(), qMax(lastBin + 1, minBins));
+
+    // 容量 2^(j/k) 行可以容纳前 j 个桶中的全部重用
+    double hits = 0;
+    for (int j = 0; j <= pointCount; ++j) {
+        if (j > 0) hits += bins[j - 1];
+        curve.capacityBytes.append(std::pow(2.0, static_cast<double>(j) / binsPerOctave) * lineBytes);
+        curve.hitRatio.append(hits / total);
+    }
+    return curve;
+}
+
+// ==================== MissRatioAnalyzer ====================
+
+MissRatioAnalyzer::MissRatioAnalyzer(const SetupModel& setup, int lineBytes)
+    : setup(setup)
+    , lineBytes(qMax(1, lineBytes))
+    , nucaNum(0)
+{
+    for (auto it = setup.components.begin(); it != setup.components.end(); ++it) {
+        const QString& name = it.key();
+        double lines = 0;
+
+        if (it.value().contains("l2_set_count")) {
+            lines = setup.intParam(name, "l2_set_count") * setup.intParam(name, "l2_way_count");
+        } else if (it.value().contains("set_count")) {
+            lines = setup.intParam(name, "set_count") * setup.intParam(name, "way_count");
+            if (it.value().contains("nuca_index")) {
+                l3ByNucaIndex[setup.intParam(name, "nuca_index")] = static_cast<int>(profilers.size());
+                nucaNum = qMax(nucaNum, setup.intParam(name, "nuca_num"));
+            }
+        } else {
+            continue;
+        }
+
+        profilerIndex[name.toLatin1()] = static_cast<int>(profilers.size());
+        profilerIds.append(name);
+        configuredLines.append(lines);
+        profilers.emplace_back();
+    }
+}
+
+QString MissRatioAnalyzer::locateTrace()
+{
+    QStringList possiblePaths = {
+        "files/address_trace.txt",
+        "../files/address_trace.txt",
+        "../../files/address_trace.txt",
+        QDir::currentPath() + "/files/address_trace.txt",
+        QDir::currentPath() + "/../files/address_trace.txt"
+    };
+
+    for (const QString& path : possiblePaths) {
+        if (QFile::exists(path)) return path;
+    }
+    return QString();
+}
+
+int MissRatioAnalyzer::profilerFor(const QByteArray& component, quint64 block)
+{
+    if (component == "L3") {
+        if (nucaNum <= 0) return -1;
+        return l3ByNucaIndex.value(static_cast<int>(block % nucaNum), -1);
+    }
+    return profilerIndex.value(component, -1);
+}
+
+bool MissRatioAnalyzer::processTrace(const QString& tracePath)
+{
+    QFile file(tracePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Cannot open address trace at" << tracePath;
+        return false;
+    }
+    if (profilers.empty()) {
+        qDebug() << "No cache geometry in setup, skipping address trace";
+        return false;
+    }
+
+    char buffer[256];
+    quint64 lineCount = 0;
+    quint64 skipped = 0;
+
+    while (!file.atEnd()) {
+        qint64 length = file.readLine(buffer, sizeof(buffer));
+        if (length <= 0) continue;
+        lineCount++;
+
+        // 长时间的单个任务: 定期让出给更高优先级的任务，被取消时放弃
+        if ((lineCount & 0xFFFF) == 0 && !WorkStealingPool::checkpoint()) {
+            qDebug() << "Address trace processing cancelled";
+            return false;
+        }
+
+        char* p = buffer;
+        while (*p == ' ' || *p == '\t') ++p;
+        if (*p == '\0' || *p == '\n' || *p == '\r' || *p == '#' || (p[0] == '/' && p[1] == '/')) continue;
+
+        char* nameBegin = p;
+        while (*p && !std::isspace(static_cast<unsigned char>(*p))) ++p;
+        QByteArray component = QByteArray::fromRawData(nameBegin, static_cast<int>(p - nameBegin));
+
+        char* end = nullptr;
+        quint64 address = std::strtoull(p, &end, 0);
+        if (end == p) {
+            skipped++;
+            continue;
+        }
+
+        quint64 block = address / static_cast<quint64>(lineBytes);
+        int index = profilerFor(component, block);
+        if (index < 0) {
+            skipped++;
+            continue;
+        }
+        profilers[index].access(block);
+    }
+
+    curves.clear();
+    for (int i = 0; i < static_cast<int>(profilers.size()); ++i) {
+        if (profilers[i].accessCount() == 0) continue;
+
+        // 横轴至少覆盖到配置容量的 4 倍，便于观察扩容收益
+        MissRatioCurve curve = profilers[i].buildCurve(lineBytes, configuredLines[i] * 4);
+        curve.componentId = profilerIds[i];
+        curve.configuredBytes = configuredLines[i] * lineBytes;
+        curves[curve.componentId] = curve;
+    }
+
+    qDebug() << "Processed address trace" << tracePath << ":" << lineCount << "lines,"
+             << skipped << "skipped," << curves.size() << "curves";
+    return true;
+}
@@ -0,0 +1,97 @@
+#ifndef MISSRATIOCURVE_H
+#define MISSRATIOCURVE_H
+
+#include "../statistics/SetupModel.h"
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QMap>
+#include <QByteArray>
+#include <queue>
+#include <vector>
+#include <utility>
+
+// 缺失率曲线: 缓存容量 -> 预测命中率
+struct MissRatioCurve {
+    QString componentId;
+    QVector<double> capacityBytes;   // 横轴: 容量 (字节)，按对数刻度采样
+    QVector<double> hitRatio;        // 纵轴: LRU 下的预测命中率 [0, 1]
+    double configuredBytes = 0;      // setup.txt 中配置的容量
+    double sampleRate = 1.0;         // 结束时的空间采样率
+    quint64 accessCount = 0;         // 该缓存收到的访问总数
+
+    // 任意容量处的命中率 (按对数容量线性插值，超出范围时取端点值)
+    double hitRatioAt(double bytes) const;
+};
+
+// SHARDS 风格的单遍重用距离分析
+// 按缓存行地址的哈希做空间采样，跟踪的缓存行数量超过上限时降低采样阈值，
+// 因此内存占用只与 maxTrackedBlocks 有关，与 trace 长度无关
+class ShardsProfiler
+{
+public:
+    explicit ShardsProfiler(int maxTrackedBlocks = 16384, int binsPerOctave = 8);
+
+    // 处理一次对缓存行 block 的访问
+    void access(quint64 block);
+
+    // 生成曲线，容量至少覆盖到 minCapacityLines
+    MissRatioCurve buildCurve(int lineBytes, double minCapacityLines) const;
+
+    double sampleRate() const;
+    quint64 accessCount() const { return totalAccesses; }
+
+private:
+    struct Entry {
+        quint32 timestamp;   // 最近一次访问的逻辑时间 (Fenwick 树下标)
+        quint32 hash;
+    };
+
+    void recordDistance(double distance, double weight);
+    void evictOverBudget();
+    void compactTimestamps();
+    void fenwickAdd(int index, int delta);
+    int fenwickPrefix(int index) const;
+
+    int maxTracked;
+    int binsPerOctave;
+    quint32 threshold;                      // 采样阈值 T，只采样 hash < T 的缓存行
+    quint32 clock;                          // 下一个逻辑时间
+    QHash<quint64, Entry> tracked;          // 被采样的缓存行
+    std::priority_queue<std::pair<quint32, quint64>> hashHeap; // 按 hash 排序，用于降低阈值时淘汰
+    QVector<int> fenwick;                   // 标记每个逻辑时间是否为某缓存行的最近访问
+    QVector<double> histogram;              // 对数分桶的重用距离直方图 (已按采样率放大)
+    double coldMisses;                      // 首次访问 (估计值)
+    quint64 totalAccesses;
+};
+
+// 从地址 trace 单遍生成所有 L2/L3 的缺失率曲线
+class MissRatioAnalyzer
+{
+public:
+    explicit MissRatioAnalyzer(const SetupModel& setup, int lineBytes = 64);
+
+    // trace 每行格式: "<组件> <地址>"，组件为 L2CacheN / L3CacheN，
+    // 或 "L3" 表示按 nuca_index 交织分配到各个 L3 分片
+    bool processTrace(const QString& tracePath);
+
+    // 在默认位置查找 address_trace.txt，找不到时返回空字符串
+    static QString locateTrace();
+
+    const QMap<QString, MissRatioCurve>& getCurves() const { return curves; }
+
+private:
+    int profilerFor(const QByteArray& component, quint64 block);
+
+    SetupModel setup;
+    int lineBytes;
+    std::vector<ShardsProfiler> profilers;
+    QStringList profilerIds;
+    QVector<double> configuredLines;
+    QHash<QByteArray, int> profilerIndex;
+    QMap<int, int> l3ByNucaIndex;           // nuca_index -> 分析器下标
+    int nucaNum;
+    QMap<QString, MissRatioCurve> curves;
+};
+
+#endif // MISSRATIOCURVE_H
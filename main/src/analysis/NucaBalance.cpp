@@ -0,0 +1,167 @@
+#include "NucaBalance.h"
+#include <QRegularExpression>
+#include <QSet>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+NucaBalanceAnalyzer::NucaBalanceAnalyzer(const SetupModel& setup, double hotThreshold)
+    : setup(setup)
+    , hotThreshold(hotThreshold)
+    , store(nullptr)
+{
+}
+
+bool NucaBalanceAnalyzer::bind(const CounterStore& store)
+{
+    this->store = &store;
+    sliceIds.clear();
+    columns.clear();
+
+    // 分片列表: 优先 setup.txt 中带 nuca_index 的 L3，否则从存储的列名推断
+    QList<QPair<int, QString>> ordered;
+    for (const QString& id : setup.componentsWithPrefix("L3Cache")) {
+        ordered.append(qMakePair(setup.intParam(id, "nuca_index", ordered.size()), id));
+    }
+    if (ordered.isEmpty()) {
+        QRegularExpression re("^(L3Cache(\\d+))\\.llc_hit_count$");
+        for (const QString& name : store.columnNames()) {
+            QRegularExpressionMatch match = re.match(name);
+            if (match.hasMatch()) ordered.append(qMakePair(match.captured(2).toInt(), match.captured(1)));
+        }
+    }
+    std::sort(ordered.begin(), ordered.end());
+
+    // 端口对列按源端口与目的端口建立索引，避免每个分片都扫描所有列
+    QMap<int, QVector<int>> trafficByPort;
+    QRegularExpression trafficRe("^Bus\\.transmit_package_number_from_(\\d+)_to_(\\d+)$");
+    for (int i = 0; i < store.columnCount(); ++i) {
+        QRegularExpressionMatch match = trafficRe.match(store.columnName(i));
+        if (!match.hasMatch()) continue;
+        int from = match.captured(1).toInt();
+        int to = match.captured(2).toInt();
+        trafficByPort[from].append(i);
+        if (to != from) trafficByPort[to].append(i);
+    }
+
+    for (const auto& entry : ordered) {
+        SliceColumns slice;
+        slice.hits = store.columnIndex(CounterStore::columnKey(entry.second, "llc_hit_count"));
+        slice.misses = store.columnIndex(CounterStore::columnKey(entry.second, "llc_miss_count"));
+        if (slice.hits < 0 && slice.misses < 0) continue;
+
+        int port = setup.portOf(entry.second);
+        if (port >= 0) slice.traffic = trafficByPort.value(port);
+
+        sliceIds.append(entry.second);
+        columns.append(slice);
+    }
+
+    if (sliceIds.isEmpty()) {
+        qDebug() << "NUCA balance: no L3 slices found";
+        return false;
+    }
+    return true;
+}
+
+ImbalanceMetric NucaBalanceAnalyzer::imbalance(const QVector<double>& values)
+{
+    ImbalanceMetric metric;
+    if (values.isEmpty()) return metric;
+
+    double sum = 0;
+    double max = -1;
+    for (int i = 0; i < values.size(); ++i) {
+        sum += values[i];
+        if (values[i] > max) {
+            max = values[i];
+            metric.hottest = i;
+        }
+    }
+    metric.mean = sum / values.size();
+    if (metric.mean <= 0) return metric;
+
+    double variance = 0;
+    for (double value : values) {
+        variance += (value - metric.mean) * (value - metric.mean);
+    }
+    metric.maxOverMean = max / metric.mean;
+    metric.cv = std::sqrt(variance / values.size()) / metric.mean;
+    return metric;
+}
+
+NucaSnapshot NucaBalanceAnalyzer::aggregate(int firstRun, int lastRun, const QString& label) const
+{
+    NucaSnapshot snapshot;
+    snapshot.label = label;
+    snapshot.firstRun = firstRun;
+    snapshot.lastRun = lastRun;
+
+    const int count = sliceIds.size();
+    snapshot.accesses.fill(0, count);
+    snapshot.misses.fill(0, count);
+    snapshot.traffic.fill(0, count);
+
+    // 缺失的值 (NaN) 按 0 计
+    auto columnSum = [&](int column) {
+        if (column < 0) return 0.0;
+        const double* values = store->column(column).constData();
+        double sum = 0;
+        for (int run = firstRun; run <= lastRun; ++run) {
+            sum += values[run] == values[run] ? values[run] : 0.0;
+        }
+        return sum;
+    };
+
+    for (int i = 0; i < count; ++i) {
+        const SliceColumns& slice = columns[i];
+        double misses = columnSum(slice.misses);
+        snapshot.misses[i] = misses;
+        snapshot.accesses[i] = columnSum(slice.hits) + misses;
+        for (int column : slice.traffic) {
+            snapshot.traffic[i] += columnSum(column);
+        }
+    }
+
+    snapshot.accessBalance = imbalance(snapshot.accesses);
+    snapshot.missBalance = imbalance(snapshot.misses);
+    snapshot.trafficBalance = imbalance(snapshot.traffic);
+
+    for (int i = 0; i < count; ++i) {
+        bool hot = (snapshot.accessBalance.mean > 0 && snapshot.accesses[i] >= hotThreshold * snapshot.accessBalance.mean)
+                || (snapshot.missBalance.mean > 0 && snapshot.misses[i] >= hotThreshold * snapshot.missBalance.mean)
+                || (snapshot.trafficBalance.mean > 0 && snapshot.traffic[i] >= hotThreshold * snapshot.trafficBalance.mean);
+        if (hot) snapshot.hotSlices.append(i);
+    }
+    return snapshot;
+}
+
+QVector<NucaSnapshot> NucaBalanceAnalyzer::analyzeRuns() const
+{
+    QVector<NucaSnapshot> snapshots;
+    if (!store) return snapshots;
+
+    snapshots.reserve(store->runCount());
+    for (int run = 0; run < store->runCount(); ++run) {
+        snapshots.append(aggregate(run, run, store->run(run).id));
+    }
+    return snapshots;
+}
+
+QVector<NucaSnapshot> NucaBalanceAnalyzer::analyzeWindows(int windowSize) const
+{
+    QVector<NucaSnapshot> snapshots;
+    if (!store || windowSize <= 0) return snapshots;
+
+    for (int first = 0; first < store->runCount(); first += windowSize) {
+        int last = qMin(store->runCount(), first + windowSize) - 1;
+        snapshots.append(aggregate(first, last, QString("runs %1-%2").arg(first).arg(last)));
+    }
+    return snapshots;
+}
+
+NucaSnapshot NucaBalanceAnalyzer::analyzeAll() const
+{
+    if (!store || store->runCount() == 0) return NucaSnapshot();
+    return aggregate(0, store->runCount() - 1, "all runs");
+}
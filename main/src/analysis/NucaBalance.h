@@ -0,0 +1,71 @@
+#ifndef NUCABALANCE_H
+#define NUCABALANCE_H
+
+#include "../statistics/CounterStore.h"
+#include "../statistics/SetupModel.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// 一组分片负载的不均衡程度
+struct ImbalanceMetric {
+    double mean = 0;
+    double maxOverMean = 0;     // 最大负载 / 平均负载，完全均衡时为 1
+    double cv = 0;              // 变异系数 = 标准差 / 平均值
+    int hottest = -1;           // 负载最大的分片下标
+};
+
+// 一个快照 (单次运行、一个时间窗口或整个运行集合) 中各 L3 分片的负载
+struct NucaSnapshot {
+    QString label;
+    int firstRun = 0;           // 覆盖的运行范围 [firstRun, lastRun]
+    int lastRun = 0;
+    QVector<double> accesses;   // 按分片: llc_hit_count + llc_miss_count
+    QVector<double> misses;     // llc_miss_count
+    QVector<double> traffic;    // 分片端口收发的总线包数
+    ImbalanceMetric accessBalance;
+    ImbalanceMetric missBalance;
+    ImbalanceMetric trafficBalance;
+    QVector<int> hotSlices;     // 任一指标超过平均值 hotThreshold 倍的分片
+};
+
+// NUCA 分片负载均衡分析
+// 分片按 nuca_index 排序；计数器从列式存储按列读取，分片数与运行数都只影响线性扫描的长度
+class NucaBalanceAnalyzer
+{
+public:
+    explicit NucaBalanceAnalyzer(const SetupModel& setup, double hotThreshold = 1.25);
+
+    // 在存储中查找各分片的列，找不到任何分片时返回 false
+    bool bind(const CounterStore& store);
+
+    const QStringList& slices() const { return sliceIds; }
+
+    // 每次运行一个快照
+    QVector<NucaSnapshot> analyzeRuns() const;
+
+    // 按运行顺序划分为不重叠的窗口，每个窗口内计数器求和
+    QVector<NucaSnapshot> analyzeWindows(int windowSize) const;
+
+    // 整个运行集合
+    NucaSnapshot analyzeAll() const;
+
+    static ImbalanceMetric imbalance(const QVector<double>& values);
+
+private:
+    struct SliceColumns {
+        int hits = -1;
+        int misses = -1;
+        QVector<int> traffic;   // 该分片端口作为源或目的的所有端口对
+    };
+
+    NucaSnapshot aggregate(int firstRun, int lastRun, const QString& label) const;
+
+    SetupModel setup;
+    double hotThreshold;
+    const CounterStore* store;
+    QStringList sliceIds;
+    QVector<SliceColumns> columns;
+};
+
+#endif // NUCABALANCE_H
@@ -0,0 +1,79 @@
+#include "PortTraffic.h"
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QIODevice>
+#include <QRegularExpression>
+#include <algorithm>
+#include <climits>
+
+QString PortTraffic::Port::label() const
+{
+    if (component.isEmpty()) return QString("Port %1").arg(id);
+    return QString("%1 (P%2)").arg(component).arg(id);
+}
+
+PortTraffic PortTraffic::fromCounters(const QMap<QString, QString>& busCounters, const SetupModel& setup)
+{
+    static const QRegularExpression pattern("^transmit_package_number_from_(\\d+)_to_(\\d+)$");
+
+    // 端口 -> 组件只建一次，端口很多时不逐个遍历组件
+    QHash<int, QString> componentOfPort;
+    for (auto it = setup.components.begin(); it != setup.components.end(); ++it) {
+        int port = setup.portOf(it.key());
+        if (port >= 0 && !componentOfPort.contains(port)) componentOfPort.insert(port, it.key());
+    }
+
+    QMap<QPair<int, int>, double> packets;       // (发送端口, 接收端口) -> 包数
+    QMap<int, Port> ports;
+    for (auto it = busCounters.begin(); it != busCounters.end(); ++it) {
+        QRegularExpressionMatch match = pattern.match(it.key());
+        if (!match.hasMatch()) continue;
+        double value = it.value().toDouble();
+        if (value <= 0) continue;
+
+        int from = match.captured(1).toInt();
+        int to = match.captured(2).toInt();
+        packets[qMakePair(from, to)] += value;
+        ports[from].sent += value;
+        ports[to].received += value;
+    }
+
+    PortTraffic traffic;
+    for (auto it = ports.begin(); it != ports.end(); ++it) {
+        Port port = it.value();
+        port.id = it.key();
+        port.node = setup.portToNode.value(port.id, -1);
+        port.component = componentOfPort.value(port.id);
+        traffic.portList.append(port);
+    }
+    std::stable_sort(traffic.portList.begin(), traffic.portList.end(), [](const Port& a, const Port& b) {
+        // 未映射的端口排在最后
+        int nodeA = a.node < 0 ? INT_MAX : a.node;
+        int nodeB = b.node < 0 ? INT_MAX : b.node;
+        return nodeA != nodeB ? nodeA < nodeB : a.id < b.id;
+    });
+
+    QHash<int, int> indexOfPort;
+    for (int i = 0; i < traffic.portList.size(); ++i) indexOfPort.insert(traffic.portList[i].id, i);
+    for (auto it = packets.begin(); it != packets.end(); ++it) {
+        Flow flow;
+        flow.from = indexOfPort.value(it.key().first);
+        flow.to = indexOfPort.value(it.key().second);
+        flow.packets = it.value();
+        traffic.flowList.append(flow);
+        traffic.totalPackets += flow.packets;
+    }
+    std::stable_sort(traffic.flowList.begin(), traffic.flowList.end(), [](const Flow& a, const Flow& b) {
+        return a.packets > b.packets;
+    });
+    return traffic;
+}
+
+QByteArray PortTraffic::fingerprint() const
+{
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    for (const Port& port : portList) stream << port.id << port.node << port.component;
+    for (const Flow& flow : flowList) stream << flow.from << flow.to << flow.packets;
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
@@ -0,0 +1,49 @@
+#ifndef PORTTRAFFIC_H
+#define PORTTRAFFIC_H
+
+#include "../statistics/SetupModel.h"
+#include <QByteArray>
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+// 端口间的包数矩阵 (transmit_package_number_from_A_to_B)，只保留非零的端口对
+// 端口通过 setup.txt 的 port_id 解析为组件名，并按所在总线节点排序，同一节点的端口相邻
+class PortTraffic
+{
+public:
+    struct Port {
+        int id = -1;
+        int node = -1;              // 未映射到总线节点时为 -1
+        QString component;          // 端口上没有组件时为空
+        double sent = 0;
+        double received = 0;
+
+        QString label() const;      // "L3Cache0 (P1)"，没有组件时为 "Port 9"
+    };
+
+    struct Flow {
+        int from = 0;               // ports() 的下标
+        int to = 0;
+        double packets = 0;
+    };
+
+    // busCounters 为 StatsLoader::getPortTransmissions() 的格式
+    static PortTraffic fromCounters(const QMap<QString, QString>& busCounters, const SetupModel& setup);
+
+    const QVector<Port>& ports() const { return portList; }
+    const QVector<Flow>& flows() const { return flowList; }     // 按包数从大到小
+    double total() const { return totalPackets; }
+    bool isEmpty() const { return flowList.isEmpty(); }
+
+    // 矩阵与端口名称的摘要，相同的矩阵得到相同的值，供视图缓存几何
+    QByteArray fingerprint() const;
+
+private:
+    QVector<Port> portList;
+    QVector<Flow> flowList;
+    double totalPackets = 0;
+};
+
+#endif // PORTTRAFFIC_H
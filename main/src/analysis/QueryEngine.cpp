@@ -0,0 +1,682 @@
+#include "QueryEngine.h"
+#include "../concurrency/WorkStealingPool.h"
+#include <QRegularExpression>
+#include <QElapsedTimer>
+#include <QMap>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+namespace {
+
+// 块大小: 块摘要的粒度，也是并行任务的粒度
+const int kChunkRows = 2048;
+
+const double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+struct Token {
+    enum Type { Word, Number, Operator, Symbol, End };
+    Type type = End;
+    QString text;
+    double number = 0;
+};
+
+QVector<Token> tokenize(const QString& text, QString& error)
+{
+    static const QRegularExpression tokenRe(
+        "\\s*(?:"
+        "(?<number>[-+]?(?:\\d+\\.?\\d*|\\.\\d+)(?:[eE][-+]?\\d+)?)(?![\\w.*])|"
+        "(?<word>[A-Za-z0-9_*][A-Za-z0-9_.*]*)|"
+        "(?<op><=|>=|!=|<>|==|<|>|=)|"
+        "(?<symbol>[(),])"
+        ")");
+
+    QVector<Token> tokens;
+    int position = 0;
+    while (position < text.size()) {
+        if (text[position].isSpace()) {
+            position++;
+            continue;
+        }
+        QRegularExpressionMatch match = tokenRe.match(text, position, QRegularExpression::NormalMatch,
+                                                      QRegularExpression::AnchorAtOffsetMatchOption);
+        if (!match.hasMatch() || match.capturedLength() == 0) {
+            error = QString("Unexpected character '%1' at position %2").arg(text[position]).arg(position);
+            return {};
+        }
+
+        Token token;
+        if (!match.captured("number").isEmpty()) {
+            token.type = Token::Number;
+            token.text = match.captured("number");
+            token.number = token.text.toDouble();
+        } else if (!match.captured("word").isEmpty()) {
+            token.type = Token::Word;
+            token.text = match.captured("word");
+        } else if (!match.captured("op").isEmpty()) {
+            token.type = Token::Operator;
+            token.text = match.captured("op");
+        } else {
+            token.type = Token::Symbol;
+            token.text = match.captured("symbol");
+        }
+        tokens.append(token);
+        position = match.capturedEnd();
+    }
+    tokens.append(Token());
+    return tokens;
+}
+
+// 递归下降分析器
+class Parser
+{
+public:
+    Parser(const QVector<Token>& tokens, QueryEngine::ParsedQuery& query)
+        : tokens(tokens), query(query) {}
+
+    bool parse(QString& error);
+
+private:
+    const Token& peek() const { return tokens[position]; }
+    bool keyword(const char* word)
+    {
+        if (peek().type == Token::Word && peek().text.compare(word, Qt::CaseInsensitive) == 0) {
+            position++;
+            return true;
+        }
+        return false;
+    }
+    bool symbol(const char* text)
+    {
+        if (peek().type == Token::Symbol && peek().text == text) {
+            position++;
+            return true;
+        }
+        return false;
+    }
+    bool fail(const QString& message)
+    {
+        if (failure.isEmpty()) {
+            failure = peek().type == Token::End ? message + " at end of query"
+                                                : QString("%1 near '%2'").arg(message, peek().text);
+        }
+        return false;
+    }
+
+    bool parseSelectItem();
+    int parseOr();
+    int parseAnd();
+    int parsePrimary();
+
+    const QVector<Token>& tokens;
+    QueryEngine::ParsedQuery& query;
+    int position = 0;
+    QString failure;
+};
+
+bool Parser::parse(QString& error)
+{
+    if (!keyword("select")) {
+        error = "Query must start with 'select'";
+        return false;
+    }
+
+    bool ok = parseSelectItem();
+    while (ok && symbol(",")) ok = parseSelectItem();
+
+    if (ok && keyword("where")) {
+        query.root = parseOr();
+        ok = query.root >= 0;
+    }
+
+    if (ok && keyword("order")) {
+        if (!keyword("by") || peek().type != Token::Word) {
+            ok = fail("Expected 'order by <column>'");
+        } else {
+            query.orderBy = tokens[position++].text;
+            if (keyword("desc")) query.descending = true;
+            else keyword("asc");
+        }
+    }
+
+    if (ok && keyword("limit")) {
+        if (peek().type != Token::Number || peek().number < 0) {
+            ok = fail("Expected a row count after 'limit'");
+        } else {
+            query.limit = static_cast<int>(tokens[position++].number);
+        }
+    }
+
+    if (ok && peek().type != Token::End) ok = fail("Unexpected token");
+
+    if (!ok) error = failure;
+    return ok;
+}
+
+bool Parser::parseSelectItem()
+{
+    static const QMap<QString, QueryEngine::SelectItem::Function> functions = {
+        {"count", QueryEngine::SelectItem::Count}, {"avg", QueryEngine::SelectItem::Avg},
+        {"min", QueryEngine::SelectItem::Min}, {"max", QueryEngine::SelectItem::Max},
+        {"sum", QueryEngine::SelectItem::Sum}, {"stddev", QueryEngine::SelectItem::Stddev},
+    };
+
+    if (peek().type != Token::Word) return fail("Expected a column");
+
+    QueryEngine::SelectItem item;
+    QString word = tokens[position++].text;
+    QString lower = word.toLower();
+    if (functions.contains(lower) && symbol("(")) {
+        item.function = functions[lower];
+        if (peek().type != Token::Word) return fail("Expected a column inside the aggregate");
+        item.pattern = tokens[position++].text;
+        if (!symbol(")")) return fail("Expected ')'");
+        if (item.function == QueryEngine::SelectItem::Count && item.pattern != "*") {
+            return fail("Only count(*) is supported");
+        }
+    } else if (lower == "run") {
+        item.function = QueryEngine::SelectItem::Run;
+    } else {
+        item.pattern = word;
+    }
+    query.items.append(item);
+    return true;
+}
+
+int Parser::parseOr()
+{
+    int left = parseAnd();
+    while (left >= 0 && keyword("or")) {
+        int right = parseAnd();
+        if (right < 0) return -1;
+        QueryEngine::ConditionNode node;
+        node.kind = QueryEngine::ConditionNode::Or;
+        node.left = left;
+        node.right = right;
+        query.nodes.append(node);
+        left = query.nodes.size() - 1;
+    }
+    return left;
+}
+
+int Parser::parseAnd()
+{
+    int left = parsePrimary();
+    while (left >= 0 && keyword("and")) {
+        int right = parsePrimary();
+        if (right < 0) return -1;
+        QueryEngine::ConditionNode node;
+        node.kind = QueryEngine::ConditionNode::And;
+        node.left = left;
+        node.right = right;
+        query.nodes.append(node);
+        left = query.nodes.size() - 1;
+    }
+    return left;
+}
+
+int Parser::parsePrimary()
+{
+    static const QMap<QString, QueryEngine::Predicate::Op> operators = {
+        {"<", QueryEngine::Predicate::Less}, {"<=", QueryEngine::Predicate::LessEqual},
+        {">", QueryEngine::Predicate::Greater}, {">=", QueryEngine::Predicate::GreaterEqual},
+        {"=", QueryEngine::Predicate::Equal}, {"==", QueryEngine::Predicate::Equal},
+        {"!=", QueryEngine::Predicate::NotEqual}, {"<>", QueryEngine::Predicate::NotEqual},
+    };
+
+    if (symbol("(")) {
+        int inner = parseOr();
+        if (inner < 0) return -1;
+        if (!symbol(")")) {
+            fail("Expected ')'");
+            return -1;
+        }
+        return inner;
+    }
+
+    if (peek().type != Token::Word) {
+        fail("Expected a condition");
+        return -1;
+    }
+
+    QueryEngine::Predicate predicate;
+    predicate.pattern = tokens[position++].text;
+    if (peek().type != Token::Operator) {
+        fail("Expected a comparison operator");
+        return -1;
+    }
+    predicate.op = operators[tokens[position++].text];
+    if (peek().type != Token::Number) {
+        fail("Expected a number");
+        return -1;
+    }
+    predicate.value = tokens[position++].number;
+    query.predicates.append(predicate);
+
+    QueryEngine::ConditionNode node;
+    node.predicate = query.predicates.size() - 1;
+    query.nodes.append(node);
+    return query.nodes.size() - 1;
+}
+
+QString functionName(QueryEngine::SelectItem::Function function)
+{
+    switch (function) {
+    case QueryEngine::SelectItem::Avg: return "avg";
+    case QueryEngine::SelectItem::Min: return "min";
+    case QueryEngine::SelectItem::Max: return "max";
+    case QueryEngine::SelectItem::Sum: return "sum";
+    case QueryEngine::SelectItem::Stddev: return "stddev";
+    case QueryEngine::SelectItem::Count: return "count";
+    default: return QString();
+    }
+}
+
+}
+
+QueryEngine::QueryEngine(const CounterStore& store)
+    : store(store)
+    , rangesGeneration(store.generation())
+{
+}
+
+bool QueryEngine::parse(const QString& text, ParsedQuery& query, QString& error)
+{
+    query = ParsedQuery();
+    QVector<Token> tokens = tokenize(text, error);
+    if (tokens.isEmpty()) return false;
+    return Parser(tokens, query).parse(error);
+}
+
+QList<int> QueryEngine::resolve(const QString& pattern) const
+{
+    if (!pattern.contains('*')) {
+        int column = store.columnIndex(pattern);
+        return column >= 0 ? QList<int>{column} : QList<int>();
+    }
+
+    // * 不跨越组件与计数器之间的 '.'
+    QString regex = QRegularExpression::escape(pattern).replace("\\*", "[^.]*");
+    return store.columnsMatching(QRegularExpression(QRegularExpression::anchoredPattern(regex)));
+}
+
+const QueryEngine::RunRange& QueryEngine::runRange(const QString& pattern, const QList<int>& columns)
+{
+    auto cached = ranges.find(pattern);
+    if (cached != ranges.end()) return cached.value();
+
+    int rows = store.runCount();
+    int chunks = (rows + kChunkRows - 1) / kChunkRows;
+    RunRange range;
+
+    // 单列直接引用列数据 (隐式共享，不复制)
+    if (columns.size() == 1) {
+        range.low = store.column(columns.first());
+        range.high = range.low;
+    } else {
+        range.low.fill(kMissing, rows);
+        range.high.fill(kMissing, rows);
+    }
+    range.chunkLowMin.fill(kMissing, chunks);
+    range.chunkLowMax.fill(kMissing, chunks);
+    range.chunkHighMin.fill(kMissing, chunks);
+    range.chunkHighMax.fill(kMissing, chunks);
+    range.chunkMissing.fill(0, chunks);
+
+    double* low = columns.size() == 1 ? nullptr : range.low.data();
+    double* high = columns.size() == 1 ? nullptr : range.high.data();
+    const double* lowView = range.low.constData();
+    const double* highView = range.high.constData();
+    double* lowMinOut = range.chunkLowMin.data();
+    double* lowMaxOut = range.chunkLowMax.data();
+    double* highMinOut = range.chunkHighMin.data();
+    double* highMaxOut = range.chunkHighMax.data();
+    int* missingOut = range.chunkMissing.data();
+
+    WorkStealingPool::instance().parallelFor(chunks, [&](int chunk) {
+        int begin = chunk * kChunkRows;
+        int end = qMin(rows, begin + kChunkRows);
+
+        // 通配列: 先按列取每次运行的最小/最大值
+        if (low) {
+            for (int column : columns) {
+                const double* values = store.column(column).constData();
+                for (int row = begin; row < end; ++row) {
+                    double value = values[row];
+                    if (std::isnan(value)) continue;
+                    if (std::isnan(low[row]) || value < low[row]) low[row] = value;
+                    if (std::isnan(high[row]) || value > high[row]) high[row] = value;
+                }
+            }
+        }
+
+        double lowMin = HUGE_VAL, lowMax = -HUGE_VAL, highMin = HUGE_VAL, highMax = -HUGE_VAL;
+        int missing = 0;
+        for (int row = begin; row < end; ++row) {
+            if (std::isnan(lowView[row])) {
+                missing++;
+                continue;
+            }
+            lowMin = qMin(lowMin, lowView[row]);
+            lowMax = qMax(lowMax, lowView[row]);
+            highMin = qMin(highMin, highView[row]);
+            highMax = qMax(highMax, highView[row]);
+        }
+        missingOut[chunk] = missing;
+        if (missing < end - begin) {
+            lowMinOut[chunk] = lowMin;
+            lowMaxOut[chunk] = lowMax;
+            highMinOut[chunk] = highMin;
+            highMaxOut[chunk] = highMax;
+        }
+    });
+
+    return ranges.insert(pattern, range).value();
+}
+
+QueryEngine::Zone QueryEngine::zoneOf(const ParsedQuery& query, int node, int chunk) const
+{
+    const ConditionNode& condition = query.nodes[node];
+    if (condition.kind != ConditionNode::Leaf) {
+        Zone left = zoneOf(query, condition.left, chunk);
+        if (condition.kind == ConditionNode::And && left == NoRows) return NoRows;
+        if (condition.kind == ConditionNode::Or && left == AllRows) return AllRows;
+        Zone right = zoneOf(query, condition.right, chunk);
+        if (condition.kind == ConditionNode::And) {
+            return right == NoRows ? NoRows : (left == AllRows && right == AllRows ? AllRows : SomeRows);
+        }
+        return right == AllRows ? AllRows : (left == NoRows && right == NoRows ? NoRows : SomeRows);
+    }
+
+    const Predicate& predicate = query.predicates[condition.predicate];
+    const RunRange* range = predicateRanges[condition.predicate];
+    if (!range || std::isnan(range->chunkLowMin[chunk])) return NoRows;   // 整块都没有该列
+
+    // 通配条件为 "任一列满足": < 比较每次运行的最小值，> 比较最大值
+    bool complete = range->chunkMissing[chunk] == 0;
+    double x = predicate.value;
+    switch (predicate.op) {
+    case Predicate::Less:
+        if (range->chunkLowMin[chunk] >= x) return NoRows;
+        return complete && range->chunkLowMax[chunk] < x ? AllRows : SomeRows;
+    case Predicate::LessEqual:
+        if (range->chunkLowMin[chunk] > x) return NoRows;
+        return complete && range->chunkLowMax[chunk] <= x ? AllRows : SomeRows;
+    case Predicate::Greater:
+        if (range->chunkHighMax[chunk] <= x) return NoRows;
+        return complete && range->chunkHighMin[chunk] > x ? AllRows : SomeRows;
+    case Predicate::GreaterEqual:
+        if (range->chunkHighMax[chunk] < x) return NoRows;
+        return complete && range->chunkHighMin[chunk] >= x ? AllRows : SomeRows;
+    case Predicate::Equal:
+        if (x < range->chunkLowMin[chunk] || x > range->chunkHighMax[chunk]) return NoRows;
+        return SomeRows;
+    case Predicate::NotEqual:
+        if (complete && (x < range->chunkLowMin[chunk] || x > range->chunkHighMax[chunk])) return AllRows;
+        return SomeRows;
+    }
+    return SomeRows;
+}
+
+bool QueryEngine::matches(const Predicate& predicate, const QList<int>& columns, const RunRange& range, int row) const
+{
+    double x = predicate.value;
+    switch (predicate.op) {
+    case Predicate::Less: return range.low[row] < x;
+    case Predicate::LessEqual: return range.low[row] <= x;
+    case Predicate::Greater: return range.high[row] > x;
+    case Predicate::GreaterEqual: return range.high[row] >= x;
+    case Predicate::Equal:
+    case Predicate::NotEqual:
+        for (int column : columns) {
+            double value = store.column(column)[row];
+            if (std::isnan(value)) continue;
+            if ((predicate.op == Predicate::Equal) == (value == x)) return true;
+        }
+        return false;
+    }
+    return false;
+}
+
+void QueryEngine::evaluate(const ParsedQuery& query, int node, int begin, int end, char* mask) const
+{
+    const ConditionNode& condition = query.nodes[node];
+    int count = end - begin;
+
+    if (condition.kind != ConditionNode::Leaf) {
+        evaluate(query, condition.left, begin, end, mask);
+        QVector<char> right(count);
+        evaluate(query, condition.right, begin, end, right.data());
+        if (condition.kind == ConditionNode::And) {
+            for (int i = 0; i < count; ++i) mask[i] &= right[i];
+        } else {
+            for (int i = 0; i < count; ++i) mask[i] |= right[i];
+        }
+        return;
+    }
+
+    const RunRange* range = predicateRanges[condition.predicate];
+    if (!range) {
+        std::fill(mask, mask + count, 0);
+        return;
+    }
+
+    // 比较单列的紧凑循环，编译器可以向量化
+    const Predicate& predicate = query.predicates[condition.predicate];
+    const double* low = range->low.constData() + begin;
+    const double* high = range->high.constData() + begin;
+    double x = predicate.value;
+    switch (predicate.op) {
+    case Predicate::Less:
+        for (int i = 0; i < count; ++i) mask[i] = low[i] < x;
+        break;
+    case Predicate::LessEqual:
+        for (int i = 0; i < count; ++i) mask[i] = low[i] <= x;
+        break;
+    case Predicate::Greater:
+        for (int i = 0; i < count; ++i) mask[i] = high[i] > x;
+        break;
+    case Predicate::GreaterEqual:
+        for (int i = 0; i < count; ++i) mask[i] = high[i] >= x;
+        break;
+    default:
+        for (int i = 0; i < count; ++i) {
+            mask[i] = matches(predicate, predicateColumns[condition.predicate], *range, begin + i);
+        }
+        break;
+    }
+}
+
+QueryResult QueryEngine::execute(const QString& text)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QueryResult result;
+    ParsedQuery query;
+    if (!parse(text, query, result.error)) return result;
+
+    // 追加运行 (实时采集、批量导入) 或改写列之后，缓存的范围与块摘要已过期
+    if (rangesGeneration != store.generation()) {
+        ranges.clear();
+        rangesGeneration = store.generation();
+    }
+
+    int rows = store.runCount();
+    int chunks = (rows + kChunkRows - 1) / kChunkRows;
+    result.totalRuns = rows;
+    result.chunkCount = chunks;
+
+    // 检查选择列表
+    bool hasAggregate = false, hasColumn = false;
+    for (const SelectItem& item : query.items) {
+        if (item.function == SelectItem::Column || item.function == SelectItem::Run) hasColumn = true;
+        else hasAggregate = true;
+        if (!item.pattern.isEmpty() && item.pattern != "*" && resolve(item.pattern).isEmpty()) {
+            result.error = QString("No column matches '%1'").arg(item.pattern);
+            return result;
+        }
+    }
+    if (hasAggregate && hasColumn) {
+        result.error = "Cannot mix aggregates with per-run columns";
+        return result;
+    }
+    result.aggregate = hasAggregate;
+
+    int orderColumn = -1;
+    if (!query.orderBy.isEmpty() && query.orderBy.compare("run", Qt::CaseInsensitive) != 0) {
+        QList<int> columns = resolve(query.orderBy);
+        if (columns.size() != 1) {
+            result.error = QString("'order by %1' must name exactly one column").arg(query.orderBy);
+            return result;
+        }
+        orderColumn = columns.first();
+    }
+
+    // 条件列: 先建好所有块摘要，再取指针 (插入会使 QHash 中的引用失效)
+    predicateColumns.clear();
+    predicateRanges.clear();
+    for (const Predicate& predicate : query.predicates) {
+        QList<int> columns = resolve(predicate.pattern);
+        if (!columns.isEmpty()) runRange(predicate.pattern, columns);
+        predicateColumns.append(columns);
+    }
+    for (int i = 0; i < query.predicates.size(); ++i) {
+        predicateRanges.append(predicateColumns[i].isEmpty() ? nullptr : &ranges[query.predicates[i].pattern]);
+    }
+
+    // 过滤: 每块先看摘要，不能确定时再逐行比较
+    QVector<char> selected(rows, 1);
+    std::atomic<int> skipped(0);
+    if (query.root >= 0) {
+        char* mask = selected.data();
+        WorkStealingPool::instance().parallelFor(chunks, [&](int chunk) {
+            int begin = chunk * kChunkRows;
+            int end = qMin(rows, begin + kChunkRows);
+            Zone zone = zoneOf(query, query.root, chunk);
+            if (zone == SomeRows) {
+                evaluate(query, query.root, begin, end, mask + begin);
+            } else {
+                std::fill(mask + begin, mask + end, zone == AllRows ? 1 : 0);
+                skipped++;
+            }
+        });
+    }
+    result.skippedChunks = skipped;
+
+    QVector<int> matched;
+    matched.reserve(rows);
+    for (int row = 0; row < rows; ++row) {
+        if (selected[row]) matched.append(row);
+    }
+    result.matchedRuns = matched.size();
+
+    if (result.aggregate) {
+        // 每个 (函数, 列) 一列结果，各列并行计算
+        QVector<QPair<SelectItem::Function, int>> outputs;
+        for (const SelectItem& item : query.items) {
+            if (item.function == SelectItem::Count) {
+                outputs.append({item.function, -1});
+                result.columnNames.append("count(*)");
+                continue;
+            }
+            for (int column : resolve(item.pattern)) {
+                outputs.append({item.function, column});
+                result.columnNames.append(QString("%1(%2)").arg(functionName(item.function), store.columnName(column)));
+            }
+        }
+
+        QVector<double> aggregates(outputs.size(), kMissing);
+        double* output = aggregates.data();
+        WorkStealingPool::instance().parallelFor(outputs.size(), [&](int i) {
+            SelectItem::Function function = outputs[i].first;
+            if (function == SelectItem::Count) {
+                output[i] = matched.size();
+                return;
+            }
+
+            const double* values = store.column(outputs[i].second).constData();
+            // 均值与方差用 Welford 算法，与 RunAggregator 一致，周期数这类大而波动小的计数器不会相减抵消
+            double sum = 0, mean = 0, m2 = 0, low = HUGE_VAL, high = -HUGE_VAL;
+            int count = 0;
+            for (int row : matched) {
+                double value = values[row];
+                if (std::isnan(value)) continue;
+                count++;
+                sum += value;
+                double delta = value - mean;
+                mean += delta / count;
+                m2 += delta * (value - mean);
+                low = qMin(low, value);
+                high = qMax(high, value);
+            }
+            if (count == 0) return;
+
+            switch (function) {
+            case SelectItem::Avg: output[i] = mean; break;
+            case SelectItem::Min: output[i] = low; break;
+            case SelectItem::Max: output[i] = high; break;
+            case SelectItem::Sum: output[i] = sum; break;
+            case SelectItem::Stddev:
+                output[i] = count > 1 ? std::sqrt(m2 / (count - 1)) : 0.0;
+                break;
+            default: break;
+            }
+        });
+
+        for (double value : aggregates) {
+            result.columns.append(QVector<double>{value});
+        }
+        result.elapsedMs = timer.elapsed();
+        return result;
+    }
+
+    // 排序与截断: 有 limit 时只做部分排序
+    if (!query.orderBy.isEmpty()) {
+        auto less = [&](int a, int b) {
+            if (orderColumn < 0) {
+                int order = store.run(a).id.compare(store.run(b).id);
+                return query.descending ? order > 0 : order < 0;
+            }
+            double x = store.column(orderColumn)[a];
+            double y = store.column(orderColumn)[b];
+            if (std::isnan(x) || std::isnan(y)) return !std::isnan(x) && std::isnan(y);   // 缺失值排在最后
+            return query.descending ? x > y : x < y;
+        };
+        if (query.limit >= 0 && query.limit < matched.size()) {
+            std::partial_sort(matched.begin(), matched.begin() + query.limit, matched.end(), less);
+        } else {
+            std::stable_sort(matched.begin(), matched.end(), less);
+        }
+    }
+    if (query.limit >= 0 && query.limit < matched.size()) {
+        matched.resize(query.limit);
+    }
+
+    // 投影
+    QList<int> projected;
+    for (const SelectItem& item : query.items) {
+        if (item.function == SelectItem::Run) continue;
+        QList<int> columns = item.pattern == "*" ? resolve("*.*") : resolve(item.pattern);
+        for (int column : columns) {
+            if (!projected.contains(column)) projected.append(column);
+        }
+    }
+
+    for (int row : matched) {
+        result.runIds.append(store.run(row).id);
+    }
+    for (int column : projected) {
+        result.columnNames.append(store.columnName(column));
+        const QVector<double>& values = store.column(column);
+        QVector<double> output;
+        output.reserve(matched.size());
+        for (int row : matched) output.append(values[row]);
+        result.columns.append(output);
+    }
+
+    result.elapsedMs = timer.elapsed();
+    return result;
+}
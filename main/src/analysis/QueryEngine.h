@@ -0,0 +1,104 @@
+#ifndef QUERYENGINE_H
+#define QUERYENGINE_H
+
+#include "../statistics/CounterStore.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+
+// 查询结果，按列存放
+struct QueryResult {
+    QString error;                      // 解析或执行失败时的原因
+    bool aggregate = false;             // 聚合查询只有一行
+    QStringList columnNames;
+    QStringList runIds;                 // 每行对应的运行 (聚合查询为空)
+    QVector<QVector<double>> columns;   // columns[列][行]
+    int totalRuns = 0;
+    int matchedRuns = 0;
+    int chunkCount = 0;
+    int skippedChunks = 0;              // 仅凭块的最小/最大值就确定结果、未逐行扫描的块数
+    qint64 elapsedMs = 0;
+};
+
+// 列式计数器上的小型查询引擎
+//
+//   select run, CPU*.ipc where L3Cache*.llc_hit_rate < 0.4 and CPU0.ipc > 0.2
+//       order by MemoryNode0.busy_rate desc limit 20
+//   select avg(CPU*.ipc), max(Bus.avg_transmit_latency), count(*) where ...
+//
+// 列名中的 * 匹配组件编号等任意不含 '.' 的文本；条件中的通配列表示 "任一匹配列满足"。
+// 条件支持 < <= > >= = !=、and / or 与括号。
+// 运行按块划分，每个块为每个条件列保存最小/最大值 (zone map)；对通配列先算出每次运行在各匹配列上的
+// 最小/最大值，条件因此只比较一列。块的范围足以确定结果时整块跳过，否则逐行向量化比较；
+// 各块在工作窃取线程池上并行执行。块摘要在引擎对象内缓存，同一存储上的后续查询直接复用。
+class QueryEngine
+{
+public:
+    // 解析后的查询
+    struct Predicate {
+        enum Op { Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual };
+        QString pattern;
+        Op op = Less;
+        double value = 0;
+    };
+
+    struct ConditionNode {
+        enum Kind { Leaf, And, Or };
+        Kind kind = Leaf;
+        int predicate = -1;     // Leaf: 条件下标
+        int left = -1;          // And / Or: 子节点下标
+        int right = -1;
+    };
+
+    struct SelectItem {
+        enum Function { Column, Run, Count, Avg, Min, Max, Sum, Stddev };
+        Function function = Column;
+        QString pattern;
+    };
+
+    struct ParsedQuery {
+        QVector<SelectItem> items;
+        QVector<Predicate> predicates;
+        QVector<ConditionNode> nodes;
+        int root = -1;              // 没有 where 时为 -1
+        QString orderBy;
+        bool descending = false;
+        int limit = -1;
+    };
+
+    explicit QueryEngine(const CounterStore& store);
+
+    QueryResult execute(const QString& query);
+
+    // 只做语法分析，失败时返回 false 并给出原因
+    static bool parse(const QString& text, ParsedQuery& query, QString& error);
+
+private:
+    struct RunRange {
+        QVector<double> low;    // 每次运行在匹配列上的最小值 (全部缺失时为 NaN)
+        QVector<double> high;
+        QVector<double> chunkLowMin, chunkLowMax;   // 每块 low 的最小/最大值
+        QVector<double> chunkHighMin, chunkHighMax;
+        QVector<int> chunkMissing;                  // 每块中 low 为 NaN 的运行数
+    };
+
+    enum Zone { NoRows, SomeRows, AllRows };
+
+    QList<int> resolve(const QString& pattern) const;
+    const RunRange& runRange(const QString& pattern, const QList<int>& columns);
+
+    Zone zoneOf(const ParsedQuery& query, int node, int chunk) const;
+    void evaluate(const ParsedQuery& query, int node, int begin, int end, char* mask) const;
+    bool matches(const Predicate& predicate, const QList<int>& columns, const RunRange& range, int row) const;
+
+    const CounterStore& store;
+    QHash<QString, RunRange> ranges;            // 按列名模式缓存的运行范围与块摘要
+    quint64 rangesGeneration;                   // 建立 ranges 时 store 的 generation()，不同时整体失效
+
+    // 当前查询中每个条件解析出的列与范围
+    QVector<QList<int>> predicateColumns;
+    QVector<const RunRange*> predicateRanges;
+};
+
+#endif // QUERYENGINE_H
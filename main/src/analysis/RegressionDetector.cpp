@@ -0,0 +1,167 @@
+#include "RegressionDetector.h"
+#include "../concurrency/WorkStealingPool.h"
+#include <QRegularExpression>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+// 每个任务处理的列数
+const int kColumnsPerTask = 4;
+
+QVector<double> presentValues(const QVector<double>& column)
+{
+    QVector<double> values;
+    values.reserve(column.size());
+    for (double value : column) {
+        if (!std::isnan(value)) values.append(value);
+    }
+    return values;
+}
+
+double median(QVector<double> values)
+{
+    if (values.isEmpty()) return 0;
+    std::sort(values.begin(), values.end());
+    int middle = values.size() / 2;
+    return values.size() % 2 ? values[middle] : (values[middle - 1] + values[middle]) / 2;
+}
+
+}
+
+RegressionDetector::RegressionDetector(double falseDiscoveryRate, double minEffectSize)
+    : falseDiscoveryRate(falseDiscoveryRate)
+    , minEffectSize(minEffectSize)
+{
+}
+
+double RegressionDetector::mannWhitneyU(const QVector<double>& first, const QVector<double>& second, double* u)
+{
+    int n1 = first.size();
+    int n2 = second.size();
+    if (u) *u = 0;
+    if (n1 == 0 || n2 == 0) return 1.0;
+
+    // 合并排序，(值, 是否来自第一组)
+    QVector<QPair<double, bool>> pooled;
+    pooled.reserve(n1 + n2);
+    for (double value : first) pooled.append({value, true});
+    for (double value : second) pooled.append({value, false});
+    std::sort(pooled.begin(), pooled.end(),
+              [](const QPair<double, bool>& a, const QPair<double, bool>& b) { return a.first < b.first; });
+
+    // 同值取平均秩，并累计同秩校正项 Σ(t³ - t)
+    double rankSumFirst = 0;
+    double tieTerm = 0;
+    int n = pooled.size();
+    for (int i = 0; i < n;) {
+        int j = i;
+        while (j < n && pooled[j].first == pooled[i].first) j++;
+        double averageRank = (i + 1 + j) / 2.0;
+        for (int k = i; k < j; ++k) {
+            if (pooled[k].second) rankSumFirst += averageRank;
+        }
+        double t = j - i;
+        tieTerm += t * t * t - t;
+        i = j;
+    }
+
+    double u1 = rankSumFirst - n1 * (n1 + 1) / 2.0;
+    if (u) *u = u1;
+
+    double mean = n1 * static_cast<double>(n2) / 2.0;
+    double variance = n1 * static_cast<double>(n2) / 12.0 * ((n + 1) - tieTerm / (static_cast<double>(n) * (n - 1)));
+    if (variance <= 0) return 1.0;  // 所有值都相同
+
+    // 连续性校正后的正态近似
+    double z = (std::fabs(u1 - mean) - 0.5) / std::sqrt(variance);
+    if (z <= 0) return 1.0;
+    return std::erfc(z / std::sqrt(2.0));
+}
+
+void RegressionDetector::benjaminiHochberg(QVector<double>& pValues)
+{
+    int m = pValues.size();
+    QVector<int> order(m);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](int a, int b) { return pValues[a] < pValues[b]; });
+
+    // 从最大的 p 值向前取累计最小值，保证 q 值单调
+    double running = 1.0;
+    for (int rank = m; rank >= 1; --rank) {
+        int index = order[rank - 1];
+        running = qMin(running, pValues[index] * m / rank);
+        pValues[index] = running;
+    }
+}
+
+int RegressionDetector::worseWhenHigher(const QString& column)
+{
+    static const QRegularExpression higherIsBetter("(hit_rate|hit_count|ipc|finished_inst|bandwidth|throughput)",
+                                                   QRegularExpression::CaseInsensitiveOption);
+    static const QRegularExpression higherIsWorse("(miss|latency|tick|cycle|stall|conflict|evict|retry|_avg)",
+                                                  QRegularExpression::CaseInsensitiveOption);
+    QString counter = column.section('.', 1);
+    if (counter.contains(higherIsBetter)) return -1;
+    if (counter.contains(higherIsWorse)) return 1;
+    return 0;
+}
+
+QVector<CounterComparison> RegressionDetector::compare(const CounterStore& baseline, const CounterStore& candidate) const
+{
+    // 只比较两边都有的列
+    QVector<QPair<int, int>> pairs;
+    for (int column = 0; column < baseline.columnCount(); ++column) {
+        int other = candidate.columnIndex(baseline.columnName(column));
+        if (other >= 0) pairs.append({column, other});
+    }
+
+    QVector<CounterComparison> results(pairs.size());
+    CounterComparison* output = results.data();
+    WorkStealingPool::instance().parallelFor(pairs.size(), [&](int i) {
+        QVector<double> before = presentValues(baseline.column(pairs[i].first));
+        QVector<double> after = presentValues(candidate.column(pairs[i].second));
+
+        CounterComparison& result = output[i];
+        result.column = baseline.columnName(pairs[i].first);
+        result.baselineSamples = before.size();
+        result.candidateSamples = after.size();
+        if (before.isEmpty() || after.isEmpty()) return;
+
+        result.baselineMedian = median(before);
+        result.candidateMedian = median(after);
+        if (result.baselineMedian != 0) {
+            result.relativeChange = (result.candidateMedian - result.baselineMedian) / std::fabs(result.baselineMedian);
+        }
+
+        // U 统计量直接给出 Cliff's delta = 2U / (n1 n2) - 1 (以候选组为第一组)
+        double u = 0;
+        result.pValue = mannWhitneyU(after, before, &u);
+        result.effectSize = 2.0 * u / (static_cast<double>(after.size()) * before.size()) - 1.0;
+    }, kColumnsPerTask);
+
+    QVector<double> qValues(results.size());
+    for (int i = 0; i < results.size(); ++i) qValues[i] = results[i].pValue;
+    benjaminiHochberg(qValues);
+
+    for (int i = 0; i < results.size(); ++i) {
+        CounterComparison& result = results[i];
+        result.qValue = qValues[i];
+        if (result.qValue > falseDiscoveryRate || std::fabs(result.effectSize) < minEffectSize) continue;
+
+        int worse = worseWhenHigher(result.column);
+        int sign = result.effectSize > 0 ? 1 : -1;
+        result.direction = worse == 0 ? CounterComparison::Changed
+                         : worse == sign ? CounterComparison::Regression
+                         : CounterComparison::Improvement;
+    }
+
+    // 回归在前，其次改进与未知方向的变化；同类按 q 值再按效应量排序
+    std::sort(results.begin(), results.end(), [](const CounterComparison& a, const CounterComparison& b) {
+        if (a.direction != b.direction) return a.direction < b.direction;
+        if (a.qValue != b.qValue) return a.qValue < b.qValue;
+        return std::fabs(a.effectSize) > std::fabs(b.effectSize);
+    });
+    return results;
+}
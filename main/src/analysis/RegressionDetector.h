@@ -0,0 +1,57 @@
+#ifndef REGRESSIONDETECTOR_H
+#define REGRESSIONDETECTOR_H
+
+#include "../statistics/CounterStore.h"
+#include <QString>
+#include <QVector>
+
+// 一个计数器在基准与候选两组运行之间的比较结果
+struct CounterComparison {
+    enum Direction {
+        Regression,     // 向变差的方向显著变化
+        Improvement,    // 向变好的方向显著变化
+        Changed,        // 显著变化但无法判断好坏
+        Unchanged
+    };
+
+    QString column;             // "组件.计数器"
+    int baselineSamples = 0;
+    int candidateSamples = 0;
+    double baselineMedian = 0;
+    double candidateMedian = 0;
+    double relativeChange = 0;  // (候选中位数 - 基准中位数) / |基准中位数|
+    double effectSize = 0;      // Cliff's delta ∈ [-1, 1]，正值表示候选更大
+    double pValue = 1;          // Mann-Whitney U 双侧检验
+    double qValue = 1;          // Benjamini-Hochberg 校正后的 p 值
+    Direction direction = Unchanged;
+
+    QString component() const { return column.section('.', 0, 0); }
+};
+
+// 两组运行之间的统计显著性检验
+// 每个计数器做 Mann-Whitney U 检验 (秩和，正态近似并做同秩校正)，
+// 再用 Benjamini-Hochberg 控制全部计数器上的错误发现率
+class RegressionDetector
+{
+public:
+    explicit RegressionDetector(double falseDiscoveryRate = 0.05, double minEffectSize = 0.2);
+
+    // 比较两组运行中的同名列；各列在工作窃取线程池上并行检验
+    // 返回所有共有列的结果，显著变化在前，按 q 值与效应量排序
+    QVector<CounterComparison> compare(const CounterStore& baseline, const CounterStore& candidate) const;
+
+    // 两组样本的双侧 Mann-Whitney U 检验，返回 p 值，u 为第一组的 U 统计量
+    static double mannWhitneyU(const QVector<double>& first, const QVector<double>& second, double* u = nullptr);
+
+    // 就地把 p 值换算为 Benjamini-Hochberg q 值
+    static void benjaminiHochberg(QVector<double>& pValues);
+
+    // 计数器增大是否意味着变差: 1 变差，-1 变好，0 未知 (按名称判断)
+    static int worseWhenHigher(const QString& column);
+
+private:
+    double falseDiscoveryRate;
+    double minEffectSize;       // |Cliff's delta| 低于该值的变化即使显著也视为噪声
+};
+
+#endif // REGRESSIONDETECTOR_H
@@ -0,0 +1,83 @@
+#include "RunAggregator.h"
+#include "../concurrency/WorkStealingPool.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 每个任务处理的列数，列数多而运行少时减少调度开销
+const int kColumnsPerTask = 8;
+
+}
+
+double RunAggregator::quantile(const QVector<double>& sorted, double q)
+{
+    if (sorted.isEmpty()) return 0;
+    double position = q * (sorted.size() - 1);
+    int lower = static_cast<int>(std::floor(position));
+    int upper = qMin(lower + 1, static_cast<int>(sorted.size()) - 1);
+    double fraction = position - lower;
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+}
+
+CounterDistribution RunAggregator::describe(QVector<double>& values)
+{
+    CounterDistribution result;
+
+    // 去掉缺失值
+    auto end = std::remove_if(values.begin(), values.end(), [](double v) { return std::isnan(v); });
+    values.erase(end, values.end());
+    if (values.isEmpty()) return result;
+
+    std::sort(values.begin(), values.end());
+    result.samples = values.size();
+    result.min = values.first();
+    result.max = values.last();
+    result.p5 = quantile(values, 0.05);
+    result.p50 = quantile(values, 0.50);
+    result.p95 = quantile(values, 0.95);
+
+    // Welford 算法，避免大计数器相减时的精度损失
+    double mean = 0;
+    double m2 = 0;
+    int n = 0;
+    for (double value : values) {
+        n++;
+        double delta = value - mean;
+        mean += delta / n;
+        m2 += delta * (value - mean);
+    }
+    result.mean = mean;
+    result.stddev = n > 1 ? std::sqrt(m2 / (n - 1)) : 0.0;
+    return result;
+}
+
+int RunAggregator::aggregate(const CounterStore& store)
+{
+    runs = store.runCount();
+    names = store.columnNames();
+    indexByName.clear();
+    results.fill(CounterDistribution(), names.size());
+    for (int i = 0; i < names.size(); ++i) {
+        indexByName.insert(names[i], i);
+    }
+
+    CounterDistribution* output = results.data();
+    WorkStealingPool::instance().parallelFor(names.size(), [&](int column) {
+        // 每列复制一份再排序，存储本身保持只读
+        QVector<double> values = store.column(column);
+        output[column] = describe(values);
+    }, kColumnsPerTask);
+
+    int withData = 0;
+    for (const CounterDistribution& distribution : results) {
+        if (distribution.samples > 0) withData++;
+    }
+    return withData;
+}
+
+const CounterDistribution* RunAggregator::find(const QString& column) const
+{
+    auto it = indexByName.find(column);
+    return it == indexByName.end() ? nullptr : &results[it.value()];
+}
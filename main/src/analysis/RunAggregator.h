@@ -0,0 +1,49 @@
+#ifndef RUNAGGREGATOR_H
+#define RUNAGGREGATOR_H
+
+#include "../statistics/CounterStore.h"
+#include <QString>
+#include <QVector>
+#include <QHash>
+
+// 一个计数器在多次运行中的分布
+struct CounterDistribution {
+    int samples = 0;            // 有值 (非 NaN) 的运行数
+    double mean = 0;
+    double stddev = 0;          // 样本标准差
+    double min = 0;
+    double max = 0;
+    double p5 = 0;
+    double p50 = 0;
+    double p95 = 0;
+};
+
+// 多次运行的汇总: 对列式存储中的每一列 (计数器与派生指标) 计算均值、标准差、极值与分位数
+// 各列互相独立，在工作窃取线程池上并行计算
+class RunAggregator
+{
+public:
+    // 汇总存储中的所有列，返回有数据的列数
+    int aggregate(const CounterStore& store);
+
+    // 按列名 ("组件.计数器") 查找，不存在时返回 nullptr
+    const CounterDistribution* find(const QString& column) const;
+
+    int runCount() const { return runs; }
+    const QStringList& columnNames() const { return names; }
+    const QVector<CounterDistribution>& distributions() const { return results; }
+
+    // 计算一组样本的分布，忽略 NaN；会打乱 values 的顺序
+    static CounterDistribution describe(QVector<double>& values);
+
+    // 已排序样本的分位数 (线性插值)，q ∈ [0, 1]
+    static double quantile(const QVector<double>& sorted, double q);
+
+private:
+    int runs = 0;
+    QStringList names;
+    QHash<QString, int> indexByName;
+    QVector<CounterDistribution> results;
+};
+
+#endif // RUNAGGREGATOR_H
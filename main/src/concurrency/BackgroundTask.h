@@ -0,0 +1,45 @@
+#ifndef BACKGROUNDTASK_H
+#define BACKGROUNDTASK_H
+
+#include "WorkStealingPool.h"
+#include <QCoreApplication>
+#include <QObject>
+#include <QPointer>
+#include <type_traits>
+#include <utility>
+
+// 在线程池上执行 work()，完成后在界面线程调用 done(结果)
+// receiver 已销毁或任务已取消时不再调用 done；任务在排队期间被取消则不会执行 work。
+// 返回的句柄用于取消与等待 (例如析构前等待仍引用 receiver 成员的任务)
+template <typename Work, typename Done>
+TaskHandle runInBackground(WorkStealingPool::Priority priority, QObject* receiver, Work work, Done done)
+{
+    using Result = std::invoke_result_t<Work>;
+
+    TaskHandle handle = TaskHandle::create();
+    std::shared_ptr<TaskHandle::State> state = handle.sharedState();
+    QPointer<QObject> guard(receiver);
+
+    WorkStealingPool::instance().submit([state, guard, work = std::move(work), done = std::move(done)]() mutable {
+        // 结果投递到应用对象所在的界面线程，在那里再检查 receiver 是否仍然存在
+        if (!state->token->isCancelled()) {
+            if constexpr (std::is_void_v<Result>) {
+                work();
+                QMetaObject::invokeMethod(QCoreApplication::instance(), [state, guard, done]() mutable {
+                    if (guard && !state->token->isCancelled()) done();
+                }, Qt::QueuedConnection);
+            } else {
+                Result result = work();
+                QMetaObject::invokeMethod(QCoreApplication::instance(),
+                                          [state, guard, done, result = std::move(result)]() mutable {
+                    if (guard && !state->token->isCancelled()) done(std::move(result));
+                }, Qt::QueuedConnection);
+            }
+        }
+        TaskHandle::finish(*state);
+    }, priority, state->token);
+
+    return handle;
+}
+
+#endif // BACKGROUNDTASK_H
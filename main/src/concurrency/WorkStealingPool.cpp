@@ -0,0 +1,253 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+
+namespace {
+
+// 当前线程所属的线程池与队列下标，用于判断是否在工作线程内提交任务
+thread_local WorkStealingPool* currentPool = nullptr;
+thread_local int currentWorker = -1;
+
+// 当前线程正在执行的任务 (工作线程，或在 parallelFor 中帮忙执行任务的外部线程)
+thread_local WorkStealingPool* taskPool = nullptr;
+thread_local int taskPriority = -1;
+thread_local const std::shared_ptr<TaskToken>* taskToken = nullptr;
+
+}
+
+WorkStealingPool::WorkStealingPool(int threadCount)
+    : pendingTasks(0)
+    , nextQueue(0)
+    , stopping(false)
+{
+    if (threadCount <= 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (std::atomic<int>& pending : pendingByPriority) {
+        pending.store(0);
+    }
+
+    for (int i = 0; i < threadCount; ++i) {
+        queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    sleepCondition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+WorkStealingPool& WorkStealingPool::instance()
+{
+    static WorkStealingPool pool;
+    return pool;
+}
+
+int WorkStealingPool::resolve(Priority priority) const
+{
+    if (priority != Inherit) return priority;
+    return taskPool == this && taskPriority >= 0 ? taskPriority : Interactive;
+}
+
+void WorkStealingPool::submit(std::function<void()> task, Priority priority, std::shared_ptr<TaskToken> token)
+{
+    Task entry;
+    entry.run = std::move(task);
+    entry.priority = resolve(priority);
+    entry.token = token ? std::move(token) : (taskPool == this && taskToken ? *taskToken : nullptr);
+    const int level = entry.priority;
+
+    int index;
+    if (currentPool == this && currentWorker >= 0) {
+        index = currentWorker;
+    } else {
+        index = static_cast<int>(nextQueue.fetch_add(1) % queues.size());
+    }
+
+    {
+        // 计数在入队的同一把锁内增加，取出时再减少，因此不会小于实际任务数
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks[level].push_back(std::move(entry));
+        pendingByPriority[level].fetch_add(1);
+    }
+    pendingTasks.fetch_add(1);
+
+    {
+        // 持锁后再通知，避免工作线程在检查条件与进入等待之间错过唤醒
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    sleepCondition.notify_one();
+}
+
+void WorkStealingPool::parallelFor(int count, const std::function<void(int)>& body, int grainSize, Priority priority)
+{
+    if (count <= 0) return;
+    grainSize = std::max(1, grainSize);
+    const int level = resolve(priority);
+
+    int chunks = (count + grainSize - 1) / grainSize;
+    auto remaining = std::make_shared<std::atomic<int>>(chunks);
+
+    for (int chunk = 0; chunk < chunks; ++chunk) {
+        int begin = chunk * grainSize;
+        int end = std::min(count, begin + grainSize);
+        submit([&body, begin, end, remaining]() {
+            if (!isCancelled()) {
+                for (int i = begin; i < end; ++i) {
+                    body(i);
+                }
+            }
+            remaining->fetch_sub(1);
+        }, static_cast<Priority>(level));
+    }
+
+    // 等待期间帮忙执行任务，工作线程内嵌套调用也不会死锁；
+    // 只帮忙执行优先级不低于本次调用的任务，界面线程不会被批量任务拖住
+    int self = currentPool == this ? currentWorker : -1;
+    while (remaining->load() > 0) {
+        if (!tryRunOne(self, level)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+bool WorkStealingPool::isCancelled()
+{
+    return taskToken && *taskToken && (*taskToken)->isCancelled();
+}
+
+bool WorkStealingPool::checkpoint()
+{
+    WorkStealingPool* pool = taskPool;
+    if (!pool) return true;
+
+    int self = currentPool == pool ? currentWorker : -1;
+    int higher = taskPriority - 1;
+    while (higher >= 0 && pool->tryRunOne(self, higher)) {
+    }
+    return !isCancelled();
+}
+
+void WorkStealingPool::workerLoop(int index)
+{
+    currentPool = this;
+    currentWorker = index;
+
+    while (true) {
+        if (tryRunOne(index, kPriorityCount - 1)) continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait(lock, [this]() {
+            return stopping.load() || pendingTasks.load() > 0;
+        });
+        if (stopping.load() && pendingTasks.load() == 0) return;
+    }
+}
+
+bool WorkStealingPool::tryRunOne(int preferredQueue, int lowestPriority)
+{
+    for (int level = 0; level <= lowestPriority; ++level) {
+        if (pendingByPriority[level].load() <= 0) continue;
+
+        Task task;
+        if ((preferredQueue >= 0 && popLocal(preferredQueue, level, task)) || steal(preferredQueue, level, task)) {
+            pendingTasks.fetch_sub(1);
+            runTask(task);
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::runTask(Task& task)
+{
+    // 嵌套执行 (parallelFor 等待、checkpoint) 时恢复外层任务的上下文
+    WorkStealingPool* outerPool = taskPool;
+    int outerPriority = taskPriority;
+    const std::shared_ptr<TaskToken>* outerToken = taskToken;
+
+    taskPool = this;
+    taskPriority = task.priority;
+    taskToken = &task.token;
+    task.run();
+
+    taskPool = outerPool;
+    taskPriority = outerPriority;
+    taskToken = outerToken;
+}
+
+bool WorkStealingPool::popLocal(int index, int priority, Task& task)
+{
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    std::deque<Task>& tasks = queue.tasks[priority];
+    if (tasks.empty()) return false;
+
+    task = std::move(tasks.back());
+    tasks.pop_back();
+    pendingByPriority[priority].fetch_sub(1);
+    return true;
+}
+
+bool WorkStealingPool::steal(int thief, int priority, Task& task)
+{
+    int count = static_cast<int>(queues.size());
+    int start = thief >= 0 ? thief + 1 : 0;
+
+    for (int i = 0; i < count; ++i) {
+        WorkerQueue& queue = *queues[(start + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        std::deque<Task>& tasks = queue.tasks[priority];
+        if (tasks.empty()) continue;
+
+        task = std::move(tasks.front());
+        tasks.pop_front();
+        pendingByPriority[priority].fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+TaskHandle TaskHandle::create()
+{
+    TaskHandle handle;
+    handle.state = std::make_shared<State>();
+    return handle;
+}
+
+bool TaskHandle::isRunning() const
+{
+    if (!state) return false;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return !state->finished;
+}
+
+void TaskHandle::cancel()
+{
+    if (state) state->token->cancel();
+}
+
+void TaskHandle::wait()
+{
+    if (!state) return;
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finishedCondition.wait(lock, [this]() { return state->finished; });
+}
+
+void TaskHandle::finish(State& finishedState)
+{
+    {
+        std::lock_guard<std::mutex> lock(finishedState.mutex);
+        finishedState.finished = true;
+    }
+    finishedState.finishedCondition.notify_all();
+}
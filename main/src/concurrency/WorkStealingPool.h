@@ -0,0 +1,125 @@
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 取消标记，可在任意线程取消；任务在检查点处查询
+class TaskToken
+{
+public:
+    void cancel() { cancelled.store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return cancelled.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<bool> cancelled{false};
+};
+
+// 全应用共享的工作窃取线程池，按优先级调度
+// 每个工作线程对每个优先级有自己的双端队列: 本线程从队尾取任务 (LIFO，缓存友好)，
+// 空闲线程从其它队列的队首窃取 (FIFO，先拿走大块任务)。
+// 取任务时总是先取优先级更高的任务 (包括窃取)，因此交互任务不会排在批量分析之后。
+// 任务内提交的子任务 (含 parallelFor 的分块) 沿用当前任务的优先级与取消标记
+class WorkStealingPool
+{
+public:
+    enum Priority {
+        Interactive,    // 界面正在等待的结果，如点击后需要的数据、刚打开的运行
+        Prefetch,       // 即将显示的内容的预取
+        Batch,          // 大批量分析、导出与后台发布
+        Inherit         // 任务内沿用当前任务的优先级，任务外视为 Interactive
+    };
+    static const int kPriorityCount = 3;
+
+    explicit WorkStealingPool(int threadCount = 0);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // 全局共享的线程池
+    static WorkStealingPool& instance();
+
+    // 提交任务；在工作线程内提交时放入本线程队列
+    // 任务总会被执行，取消只是让任务在检查点提前返回 (便于调用方记账)
+    void submit(std::function<void()> task, Priority priority = Inherit,
+                std::shared_ptr<TaskToken> token = nullptr);
+
+    // 并行执行 body(i), i ∈ [0, count)，按 grainSize 切块，阻塞直到全部完成
+    // 等待期间调用线程也会执行队列中优先级不低于本次调用的任务，因此可以在任务内部嵌套调用。
+    // 当前任务已取消时，尚未开始的分块不再调用 body
+    void parallelFor(int count, const std::function<void(int)>& body, int grainSize = 1,
+                     Priority priority = Inherit);
+
+    int threadCount() const { return static_cast<int>(workers.size()); }
+
+    // 当前任务的取消状态 (不在任务中时为 false)
+    static bool isCancelled();
+
+    // 协作式让出: 长时间运行的任务在循环中调用，先执行排队中优先级更高的任务再返回
+    // 返回 false 表示当前任务已被取消
+    static bool checkpoint();
+
+private:
+    struct Task {
+        std::function<void()> run;
+        int priority = Interactive;
+        std::shared_ptr<TaskToken> token;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks[kPriorityCount];
+    };
+
+    int resolve(Priority priority) const;
+    void workerLoop(int index);
+    bool tryRunOne(int preferredQueue, int lowestPriority);
+    bool popLocal(int index, int priority, Task& task);
+    bool steal(int thief, int priority, Task& task);
+    void runTask(Task& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    std::vector<std::thread> workers;
+    std::atomic<int> pendingTasks;
+    std::atomic<int> pendingByPriority[kPriorityCount];
+    std::atomic<unsigned> nextQueue;
+    std::atomic<bool> stopping;
+    std::mutex sleepMutex;
+    std::condition_variable sleepCondition;
+};
+
+// 提交到线程池的任务的句柄，用于取消与等待
+class TaskHandle
+{
+public:
+    TaskHandle() = default;
+
+    bool isValid() const { return state != nullptr; }
+    bool isRunning() const;         // 排队中或正在执行
+    void cancel();
+    void wait();                    // 阻塞直到任务结束；已取消的任务会在检查点尽快结束
+    void reset() { state.reset(); }
+
+    // 供提交方使用
+    struct State {
+        std::shared_ptr<TaskToken> token = std::make_shared<TaskToken>();
+        std::mutex mutex;
+        std::condition_variable finishedCondition;
+        bool finished = false;
+    };
+    static TaskHandle create();
+    const std::shared_ptr<State>& sharedState() const { return state; }
+    static void finish(State& state);
+
+private:
+    std::shared_ptr<State> state;
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -0,0 +1,273 @@
+#include "ArrowExporter.h"
+#include "../statistics/RunSetLoader.h"
+#include <QDir>
+#include <QHash>
+#include <QRegularExpression>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+const QString kPortFileName = "ports.arrow";
+
+// 一批运行中某类组件的一个实例
+struct Instance {
+    QString name;
+    QHash<QString, int> columns;    // 计数器 -> 存储中的列
+};
+
+// 存储中的列按组件类型与端口对分组
+struct ChunkLayout {
+    QMap<QString, QMap<int, Instance>> types;   // 类型 -> 编号 -> 实例，没有编号的实例编号为 -1
+    QMap<QPair<int, int>, int> ports;           // (源端口, 目的端口) -> 列
+};
+
+ChunkLayout groupColumns(const CounterStore& store)
+{
+    static const QRegularExpression portPattern("\\.transmit_package_number_from_(\\d+)_to_(\\d+)$");
+    static const QRegularExpression numberedPattern("^(.*\\D)(\\d+)$");
+
+    ChunkLayout layout;
+    for (int column = 0; column < store.columnCount(); ++column) {
+        const QString& name = store.columnName(column);
+
+        QRegularExpressionMatch port = portPattern.match(name);
+        if (port.hasMatch()) {
+            layout.ports.insert(qMakePair(port.captured(1).toInt(), port.captured(2).toInt()), column);
+            continue;
+        }
+
+        int dot = name.indexOf('.');
+        if (dot <= 0) continue;
+        QString component = name.left(dot);
+
+        QString type = component;
+        int number = -1;
+        QRegularExpressionMatch numbered = numberedPattern.match(component);
+        if (numbered.hasMatch()) {
+            type = numbered.captured(1);
+            number = numbered.captured(2).toInt();
+        }
+
+        Instance& instance = layout.types[type][number];
+        instance.name = component;
+        instance.columns.insert(name.mid(dot + 1), column);
+    }
+    return layout;
+}
+
+QVector<ArrowIpcWriter::Field> keyFields()
+{
+    return {{"run_index", ArrowIpcWriter::Int32}, {"run", ArrowIpcWriter::Utf8}};
+}
+
+}
+
+ArrowExporter::ArrowExporter(int batchRuns)
+    : batchRuns(qMax(1, batchRuns))
+    , portFile(nullptr)
+    , schemaFixed(false)
+    , runsWritten(0)
+{
+}
+
+ArrowExporter::~ArrowExporter()
+{
+    // 未完成的导出: 写出器析构时丢弃临时文件
+    qDeleteAll(typeFiles);
+    delete portFile;
+}
+
+bool ArrowExporter::exportStore(const CounterStore& store, const QString& directory)
+{
+    if (!begin(directory)) return false;
+
+    for (int row = 0; row < store.runCount(); row += batchRuns) {
+        if (!writeChunk(store, row, qMin(batchRuns, store.runCount() - row))) return false;
+    }
+    return finish();
+}
+
+bool ArrowExporter::exportRuns(const QStringList& statisticFiles, const QString& directory)
+{
+    if (!begin(directory)) return false;
+
+    for (int first = 0; first < statisticFiles.size(); first += batchRuns) {
+        CounterStore chunk;
+        RunSetLoader loader;
+        loader.load(statisticFiles.mid(first, batchRuns), chunk);
+        failed += loader.failedFiles();
+
+        if (!writeChunk(chunk, 0, chunk.runCount())) return false;
+    }
+    return finish();
+}
+
+bool ArrowExporter::begin(const QString& directory)
+{
+    qDeleteAll(typeFiles);
+    typeFiles.clear();
+    delete portFile;
+    portFile = nullptr;
+    schemaFixed = false;
+    skipped.clear();
+    runsWritten = 0;
+    written.clear();
+    failed.clear();
+    error.clear();
+    outputDirectory = directory;
+
+    if (!QDir().mkpath(directory)) {
+        error = QString("Cannot create directory %1").arg(directory);
+        return false;
+    }
+    return true;
+}
+
+bool ArrowExporter::writeChunk(const CounterStore& store, int firstRow, int rowCount)
+{
+    if (rowCount == 0) return true;
+
+    ChunkLayout layout = groupColumns(store);
+    QDir output(outputDirectory);
+
+    // 文件的 schema 由第一批确定
+    if (!schemaFixed) {
+        for (auto type = layout.types.begin(); type != layout.types.end(); ++type) {
+            QSet<QString> counters;
+            for (const Instance& instance : type.value()) {
+                for (auto it = instance.columns.begin(); it != instance.columns.end(); ++it) counters.insert(it.key());
+            }
+
+            TypeFile* file = new TypeFile;
+            file->counters = QStringList(counters.begin(), counters.end());
+            file->counters.sort();
+            typeFiles.insert(type.key(), file);
+
+            QVector<ArrowIpcWriter::Field> fields = keyFields();
+            fields.append({"component", ArrowIpcWriter::Utf8});
+            for (const QString& counter : file->counters) fields.append({counter, ArrowIpcWriter::Float64});
+            if (!file->writer.open(output.filePath(type.key() + ".arrow"), fields)) {
+                error = file->writer.errorString();
+                return false;
+            }
+        }
+
+        if (!layout.ports.isEmpty()) {
+            portFile = new ArrowIpcWriter;
+            QVector<ArrowIpcWriter::Field> fields = keyFields();
+            fields.append({"source", ArrowIpcWriter::Int32});
+            fields.append({"destination", ArrowIpcWriter::Int32});
+            fields.append({"packets", ArrowIpcWriter::Float64});
+            if (!portFile->open(output.filePath(kPortFileName), fields)) {
+                error = portFile->errorString();
+                return false;
+            }
+        }
+        schemaFixed = true;
+    }
+
+    QVector<QByteArray> runIds(rowCount);
+    QVector<qint32> runIndex(rowCount);
+    for (int row = 0; row < rowCount; ++row) {
+        runIds[row] = store.run(firstRow + row).id.toUtf8();
+        runIndex[row] = static_cast<qint32>(runsWritten + row);
+    }
+
+    // 每类组件一个批次，按实例分段: 计数器列的每段直接指向存储中该实例的列
+    for (auto type = layout.types.begin(); type != layout.types.end(); ++type) {
+        TypeFile* file = typeFiles.value(type.key());
+        const QMap<int, Instance>& instances = type.value();
+
+        if (!file) {
+            for (const Instance& instance : instances) {
+                for (int column : instance.columns) skipped.insert(store.columnName(column));
+            }
+            continue;
+        }
+
+        qint64 rows = static_cast<qint64>(instances.size()) * rowCount;
+        QVector<qint32> indexValues;
+        indexValues.reserve(rows);
+        QVector<ArrowIpcWriter::Column> columns(3 + file->counters.size());
+        for (const Instance& instance : instances) {
+            indexValues += runIndex;
+            columns[1].strings += runIds;
+            columns[2].strings += QVector<QByteArray>(rowCount, instance.name.toUtf8());
+
+            for (auto it = instance.columns.begin(); it != instance.columns.end(); ++it) {
+                if (!file->counters.contains(it.key())) skipped.insert(store.columnName(it.value()));
+            }
+        }
+        columns[0].segments.append({indexValues.constData(), rows});
+
+        for (int c = 0; c < file->counters.size(); ++c) {
+            ArrowIpcWriter::Column& column = columns[3 + c];
+            for (const Instance& instance : instances) {
+                int index = instance.columns.value(file->counters[c], -1);
+                const double* data = index >= 0 ? store.column(index).constData() + firstRow : nullptr;
+                column.segments.append({data, rowCount});
+            }
+        }
+
+        if (!file->writer.writeBatch(rows, columns)) {
+            error = file->writer.errorString();
+            return false;
+        }
+    }
+
+    // 端口矩阵: 每对端口一段
+    if (!layout.ports.isEmpty()) {
+        if (!portFile) {
+            for (int column : layout.ports) skipped.insert(store.columnName(column));
+        } else {
+            qint64 rows = static_cast<qint64>(layout.ports.size()) * rowCount;
+            QVector<qint32> indexValues, sources, destinations;
+            indexValues.reserve(rows);
+            sources.reserve(rows);
+            destinations.reserve(rows);
+            QVector<ArrowIpcWriter::Column> columns(5);
+            for (auto it = layout.ports.begin(); it != layout.ports.end(); ++it) {
+                indexValues += runIndex;
+                columns[1].strings += runIds;
+                sources += QVector<qint32>(rowCount, it.key().first);
+                destinations += QVector<qint32>(rowCount, it.key().second);
+                columns[4].segments.append({store.column(it.value()).constData() + firstRow, rowCount});
+            }
+            columns[0].segments.append({indexValues.constData(), rows});
+            columns[2].segments.append({sources.constData(), rows});
+            columns[3].segments.append({destinations.constData(), rows});
+
+            if (!portFile->writeBatch(rows, columns)) {
+                error = portFile->errorString();
+                return false;
+            }
+        }
+    }
+
+    runsWritten += rowCount;
+    return true;
+}
+
+bool ArrowExporter::finish()
+{
+    QDir output(outputDirectory);
+    for (auto it = typeFiles.begin(); it != typeFiles.end(); ++it) {
+        if (!it.value()->writer.close()) {
+            error = it.value()->writer.errorString();
+            return false;
+        }
+        written.append(output.filePath(it.key() + ".arrow"));
+    }
+    if (portFile) {
+        if (!portFile->close()) {
+            error = portFile->errorString();
+            return false;
+        }
+        written.append(output.filePath(kPortFileName));
+    }
+
+    qDebug() << "Exported" << runsWritten << "runs to" << written.size() << "Arrow files in" << outputDirectory
+             << "(" << skipped.size() << "columns outside the schema)";
+    return true;
+}
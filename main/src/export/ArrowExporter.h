@@ -0,0 +1,60 @@
+#ifndef ARROWEXPORTER_H
+#define ARROWEXPORTER_H
+
+#include "ArrowIpcWriter.h"
+#include "../statistics/CounterStore.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QMap>
+#include <QSet>
+
+// 把计数器与派生指标导出为 Arrow IPC 文件，供 pandas (pyarrow) 与 Polars 直接读取
+// 每类组件 (去掉编号的组件名，如 L2Cache) 写一个 <类型>.arrow: 每行是一次运行中的一个组件实例，
+// 列为 run_index、run、component 与该类组件的各计数器 (float64，缺失为 null)；
+// 端口间的数据包矩阵写入 ports.arrow，每行是一次运行中的一对端口。
+// 按运行分批写出记录批次，多次运行按 run_index 排列即为跨运行的序列
+class ArrowExporter
+{
+public:
+    explicit ArrowExporter(int batchRuns = 1024);
+    ~ArrowExporter();
+
+    // 导出内存中的存储
+    bool exportStore(const CounterStore& store, const QString& directory);
+
+    // 每次只解析 batchRuns 个文件并写出，内存占用与运行总数无关
+    bool exportRuns(const QStringList& statisticFiles, const QString& directory);
+
+    const QStringList& writtenFiles() const { return written; }
+    const QStringList& failedFiles() const { return failed; }
+    qint64 exportedRuns() const { return runsWritten; }
+
+    // 第一批之后才出现、不在文件 schema 中的列
+    int skippedColumnCount() const { return skipped.size(); }
+
+    const QString& errorString() const { return error; }
+
+private:
+    struct TypeFile {
+        QStringList counters;       // schema 中的计数器，顺序与列一致
+        ArrowIpcWriter writer;
+    };
+
+    bool begin(const QString& directory);
+    bool writeChunk(const CounterStore& store, int firstRow, int rowCount);
+    bool finish();
+
+    int batchRuns;
+    QString outputDirectory;
+    QMap<QString, TypeFile*> typeFiles;
+    ArrowIpcWriter* portFile;
+    bool schemaFixed;
+    QSet<QString> skipped;
+    qint64 runsWritten;
+    QStringList written;
+    QStringList failed;
+    QString error;
+};
+
+#endif // ARROWEXPORTER_H
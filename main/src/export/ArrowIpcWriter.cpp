@@ -0,0 +1,429 @@
+#include "ArrowIpcWriter.h"
+#include <QtEndian>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+
+namespace {
+
+const quint32 kContinuation = 0xFFFFFFFF;
+const qint16 kMetadataV5 = 4;
+const quint8 kHeaderSchema = 1;
+const quint8 kHeaderRecordBatch = 3;
+const quint8 kTypeInt = 2;
+const quint8 kTypeFloatingPoint = 3;
+const quint8 kTypeUtf8 = 5;
+const qint16 kPrecisionDouble = 2;
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+const qint16 kEndianness = 0;
+#else
+const qint16 kEndianness = 1;
+#endif
+
+// 消息体中的每个缓冲区按 8 字节对齐
+qint64 padded(qint64 length)
+{
+    return (length + 7) & ~qint64(7);
+}
+
+int elementSize(ArrowIpcWriter::Type type)
+{
+    return type == ArrowIpcWriter::Int32 ? 4 : 8;
+}
+
+// flatbuffers 编码器
+// 按从前往后的顺序写: 先写父对象并为偏移字段占位，再写子对象并回填，所以偏移总是指向后方
+class FlatBufferBuilder
+{
+public:
+    FlatBufferBuilder() { reserve(4); }     // 根表偏移
+
+    // 写入一张表，slotSizes[i] 为第 i 个字段的字节数 (0 表示省略)，返回各字段的位置
+    QVector<int> addTable(const QVector<int>& slotSizes, int* tablePosition)
+    {
+        // vtable 紧挨在表之前，表头的 soffset 指回 vtable
+        align(2);
+        int vtable = buffer.size();
+        int vtableSize = 4 + 2 * slotSizes.size();
+        reserve(vtableSize);
+
+        align(8);
+        int table = buffer.size();
+        reserve(4);
+        patch<qint32>(table, table - vtable);
+
+        QVector<int> positions(slotSizes.size(), 0);
+        for (int i = 0; i < slotSizes.size(); ++i) {
+            if (slotSizes[i] == 0) continue;
+            align(slotSizes[i]);
+            positions[i] = buffer.size();
+            reserve(slotSizes[i]);
+            patch<quint16>(vtable + 4 + 2 * i, positions[i] - table);
+        }
+        patch<quint16>(vtable, vtableSize);
+        patch<quint16>(vtable + 2, buffer.size() - table);
+
+        *tablePosition = table;
+        return positions;
+    }
+
+    int addString(const QByteArray& text)
+    {
+        align(4);
+        int position = buffer.size();
+        reserve(4);
+        patch<quint32>(position, text.size());
+        buffer.append(text);
+        buffer.append('\0');
+        return position;
+    }
+
+    // 结构体或偏移的向量，元素按 alignment 对齐，长度字段紧挨在元素之前
+    int addVector(int count, int elementBytes, int alignment)
+    {
+        while ((buffer.size() + 4) % alignment) buffer.append('\0');
+        int position = buffer.size();
+        reserve(4 + count * elementBytes);
+        patch<quint32>(position, count);
+        return position;
+    }
+
+    static int element(int vector, int index, int elementBytes)
+    {
+        return vector + 4 + index * elementBytes;
+    }
+
+    void setOffset(int field, int target)
+    {
+        patch<quint32>(field, target - field);
+    }
+
+    template <typename T>
+    void patch(int position, T value)
+    {
+        T little = qToLittleEndian(value);
+        memcpy(buffer.data() + position, &little, sizeof(T));
+    }
+
+    QByteArray finish(int rootTable)
+    {
+        setOffset(0, rootTable);
+        align(8);
+        return buffer;
+    }
+
+private:
+    void reserve(int bytes) { buffer.append(QByteArray(bytes, '\0')); }
+    void align(int bytes) { while (buffer.size() % bytes) buffer.append('\0'); }
+
+    QByteArray buffer;
+};
+
+// Field: name, nullable, type_type, type, dictionary, children
+int addField(FlatBufferBuilder& fb, const ArrowIpcWriter::Field& field)
+{
+    int table;
+    QVector<int> slots = fb.addTable({4, 1, 1, 4, 0, 4}, &table);
+    // 数值列的空段 (以及 Float64 的 NaN) 会写出有效位图，两种数值类型都必须声明为可空
+    fb.patch<quint8>(slots[1], field.type != ArrowIpcWriter::Utf8 ? 1 : 0);
+
+    int typeTable;
+    switch (field.type) {
+    case ArrowIpcWriter::Float64: {
+        fb.patch<quint8>(slots[2], kTypeFloatingPoint);
+        QVector<int> type = fb.addTable({2}, &typeTable);
+        fb.patch<qint16>(type[0], kPrecisionDouble);
+        break;
+    }
+    case ArrowIpcWriter::Int32: {
+        fb.patch<quint8>(slots[2], kTypeInt);
+        QVector<int> type = fb.addTable({4, 1}, &typeTable);
+        fb.patch<qint32>(type[0], 32);
+        fb.patch<quint8>(type[1], 1);
+        break;
+    }
+    case ArrowIpcWriter::Utf8:
+        fb.patch<quint8>(slots[2], kTypeUtf8);
+        fb.addTable({}, &typeTable);
+        break;
+    }
+    fb.setOffset(slots[3], typeTable);
+    fb.setOffset(slots[0], fb.addString(field.name.toUtf8()));
+    fb.setOffset(slots[5], fb.addVector(0, 4, 4));
+    return table;
+}
+
+// Schema: endianness, fields
+int addSchema(FlatBufferBuilder& fb, const QVector<ArrowIpcWriter::Field>& fields)
+{
+    int table;
+    QVector<int> slots = fb.addTable({2, 4}, &table);
+    fb.patch<qint16>(slots[0], kEndianness);
+
+    int vector = fb.addVector(fields.size(), 4, 4);
+    fb.setOffset(slots[1], vector);
+    for (int i = 0; i < fields.size(); ++i) {
+        fb.setOffset(FlatBufferBuilder::element(vector, i, 4), addField(fb, fields[i]));
+    }
+    return table;
+}
+
+// Message: version, header_type, header, bodyLength
+QByteArray encodeMessage(quint8 headerType, qint64 bodyLength, const std::function<int(FlatBufferBuilder&)>& header)
+{
+    FlatBufferBuilder fb;
+    int table;
+    QVector<int> slots = fb.addTable({2, 1, 4, 8}, &table);
+    fb.patch<qint16>(slots[0], kMetadataV5);
+    fb.patch<quint8>(slots[1], headerType);
+    fb.patch<qint64>(slots[3], bodyLength);
+    fb.setOffset(slots[2], header(fb));
+    return fb.finish(table);
+}
+
+}
+
+ArrowIpcWriter::ArrowIpcWriter()
+    : position(0)
+    , rows(0)
+{
+}
+
+bool ArrowIpcWriter::open(const QString& path, const QVector<Field>& schema)
+{
+    fields = schema;
+    blocks.clear();
+    position = 0;
+    rows = 0;
+    error.clear();
+
+    file.setFileName(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return fail(QString("Cannot write %1: %2").arg(path, file.errorString()));
+    }
+
+    // 文件头: 魔数补齐到 8 字节，之后与流格式相同，从 schema 消息开始
+    if (!writeBytes("ARROW1\0\0", 8)) return false;
+
+    QByteArray message = encodeMessage(kHeaderSchema, 0, [this](FlatBufferBuilder& fb) {
+        return addSchema(fb, fields);
+    });
+    qint64 metadataLength;
+    return writeMessage(message, &metadataLength);
+}
+
+bool ArrowIpcWriter::writeBatch(qint64 rowCount, const QVector<Column>& columns)
+{
+    if (!error.isEmpty() || !file.isOpen()) return false;
+    if (columns.size() != fields.size()) {
+        return fail(QString("Batch has %1 columns, schema has %2").arg(columns.size()).arg(fields.size()));
+    }
+
+    // 先确定每列的 null 数与各缓冲区在消息体中的位置；数值列的数据之后直接从调用者的内存写出
+    struct Prepared {
+        qint64 nullCount = 0;
+        QByteArray validity;    // 无 null 时为空
+        QByteArray offsets;     // 字符串列
+        QByteArray values;
+    };
+    QVector<Prepared> prepared(columns.size());
+    QVector<QPair<qint64, qint64>> buffers;     // 偏移, 长度
+    qint64 bodyLength = 0;
+    auto addBuffer = [&](qint64 length) {
+        buffers.append(qMakePair(bodyLength, length));
+        bodyLength += padded(length);
+    };
+
+    for (int i = 0; i < columns.size(); ++i) {
+        const Column& column = columns[i];
+        Prepared& p = prepared[i];
+
+        if (fields[i].type == Utf8) {
+            if (column.strings.size() != rowCount) {
+                return fail(QString("Column %1 has %2 rows, expected %3").arg(fields[i].name).arg(column.strings.size()).arg(rowCount));
+            }
+            qint64 total = 0;
+            for (const QByteArray& text : column.strings) total += text.size();
+            if (total > std::numeric_limits<qint32>::max()) {
+                return fail(QString("Column %1 exceeds 2 GB in one batch").arg(fields[i].name));
+            }
+
+            p.offsets.resize((rowCount + 1) * sizeof(qint32));
+            p.values.reserve(total);
+            qint32* offsets = reinterpret_cast<qint32*>(p.offsets.data());
+            offsets[0] = 0;
+            for (qint64 row = 0; row < rowCount; ++row) {
+                p.values.append(column.strings[row]);
+                offsets[row + 1] = qToLittleEndian<qint32>(p.values.size());
+            }
+            addBuffer(0);
+            addBuffer(p.offsets.size());
+            addBuffer(p.values.size());
+            continue;
+        }
+
+        qint64 length = 0;
+        for (const Column::Segment& segment : column.segments) length += segment.length;
+        if (length != rowCount) {
+            return fail(QString("Column %1 has %2 rows, expected %3").arg(fields[i].name).arg(length).arg(rowCount));
+        }
+
+        // 有效位图 (低位在前): 空段与 NaN 记为 null
+        p.validity.fill('\xff', (rowCount + 7) / 8);
+        uchar* bits = reinterpret_cast<uchar*>(p.validity.data());
+        auto clearBit = [&](qint64 row) {
+            bits[row >> 3] &= ~(1u << (row & 7));
+            p.nullCount++;
+        };
+        qint64 row = 0;
+        for (const Column::Segment& segment : column.segments) {
+            if (!segment.data) {
+                for (qint64 k = 0; k < segment.length; ++k) clearBit(row + k);
+            } else if (fields[i].type == Float64) {
+                const double* values = static_cast<const double*>(segment.data);
+                for (qint64 k = 0; k < segment.length; ++k) {
+                    if (std::isnan(values[k])) clearBit(row + k);
+                }
+            }
+            row += segment.length;
+        }
+        if (p.nullCount == 0) p.validity.clear();
+
+        addBuffer(p.validity.size());
+        addBuffer(rowCount * elementSize(fields[i].type));
+    }
+
+    // RecordBatch: length, nodes, buffers
+    QByteArray message = encodeMessage(kHeaderRecordBatch, bodyLength, [&](FlatBufferBuilder& fb) {
+        int table;
+        QVector<int> slots = fb.addTable({8, 4, 4}, &table);
+        fb.patch<qint64>(slots[0], rowCount);
+
+        int nodes = fb.addVector(prepared.size(), 16, 8);
+        for (int i = 0; i < prepared.size(); ++i) {
+            int node = FlatBufferBuilder::element(nodes, i, 16);
+            fb.patch<qint64>(node, rowCount);
+            fb.patch<qint64>(node + 8, prepared[i].nullCount);
+        }
+        int spans = fb.addVector(buffers.size(), 16, 8);
+        for (int i = 0; i < buffers.size(); ++i) {
+            int span = FlatBufferBuilder::element(spans, i, 16);
+            fb.patch<qint64>(span, buffers[i].first);
+            fb.patch<qint64>(span + 8, buffers[i].second);
+        }
+        fb.setOffset(slots[1], nodes);
+        fb.setOffset(slots[2], spans);
+        return table;
+    });
+
+    Block block;
+    block.offset = position;
+    block.bodyLength = bodyLength;
+    qint64 metadataLength;
+    if (!writeMessage(message, &metadataLength)) return false;
+    block.metadataLength = static_cast<qint32>(metadataLength);
+
+    auto writePadded = [this](const QByteArray& bytes) {
+        return writeBytes(bytes.constData(), bytes.size()) && writeZeros(padded(bytes.size()) - bytes.size());
+    };
+    for (int i = 0; i < columns.size(); ++i) {
+        const Prepared& p = prepared[i];
+        if (fields[i].type == Utf8) {
+            if (!writePadded(p.offsets) || !writePadded(p.values)) return false;
+            continue;
+        }
+
+        if (!writePadded(p.validity)) return false;
+        const int size = elementSize(fields[i].type);
+        for (const Column::Segment& segment : columns[i].segments) {
+            bool ok = segment.data ? writeBytes(static_cast<const char*>(segment.data), segment.length * size)
+                                   : writeZeros(segment.length * size);
+            if (!ok) return false;
+        }
+        if (!writeZeros(padded(rowCount * size) - rowCount * size)) return false;
+    }
+
+    blocks.append(block);
+    rows += rowCount;
+    return true;
+}
+
+bool ArrowIpcWriter::close()
+{
+    if (!error.isEmpty() || !file.isOpen()) return false;
+
+    // 流结束标记，然后是文件尾: Footer 表、其长度与结尾魔数
+    const quint32 endOfStream[2] = {qToLittleEndian(kContinuation), 0};
+    if (!writeBytes(reinterpret_cast<const char*>(endOfStream), sizeof(endOfStream))) return false;
+
+    // Footer: version, schema, dictionaries, recordBatches
+    FlatBufferBuilder fb;
+    int table;
+    QVector<int> slots = fb.addTable({2, 4, 4, 4}, &table);
+    fb.patch<qint16>(slots[0], kMetadataV5);
+    fb.setOffset(slots[1], addSchema(fb, fields));
+    fb.setOffset(slots[2], fb.addVector(0, 24, 8));
+    int batches = fb.addVector(blocks.size(), 24, 8);
+    for (int i = 0; i < blocks.size(); ++i) {
+        int block = FlatBufferBuilder::element(batches, i, 24);
+        fb.patch<qint64>(block, blocks[i].offset);
+        fb.patch<qint32>(block + 8, blocks[i].metadataLength);
+        fb.patch<qint64>(block + 16, blocks[i].bodyLength);
+    }
+    fb.setOffset(slots[3], batches);
+    QByteArray footer = fb.finish(table);
+
+    const qint32 footerLength = qToLittleEndian<qint32>(footer.size());
+    if (!writeBytes(footer.constData(), footer.size())
+        || !writeBytes(reinterpret_cast<const char*>(&footerLength), sizeof(footerLength))
+        || !writeBytes("ARROW1", 6)) {
+        return false;
+    }
+
+    if (!file.commit()) {
+        return fail(QString("Cannot write %1: %2").arg(file.fileName(), file.errorString()));
+    }
+    return true;
+}
+
+bool ArrowIpcWriter::writeMessage(const QByteArray& metadata, qint64* metadataLength)
+{
+    // 封装格式: 续接标记、元数据长度、flatbuffer (已补齐到 8 字节)
+    const quint32 prefix[2] = {qToLittleEndian(kContinuation), qToLittleEndian<quint32>(metadata.size())};
+    if (!writeBytes(reinterpret_cast<const char*>(prefix), sizeof(prefix))
+        || !writeBytes(metadata.constData(), metadata.size())) {
+        return false;
+    }
+    *metadataLength = sizeof(prefix) + metadata.size();
+    return true;
+}
+
+bool ArrowIpcWriter::writeBytes(const char* data, qint64 length)
+{
+    if (length == 0) return true;
+    if (file.write(data, length) != length) {
+        return fail(QString("Cannot write %1: %2").arg(file.fileName(), file.errorString()));
+    }
+    position += length;
+    return true;
+}
+
+bool ArrowIpcWriter::writeZeros(qint64 length)
+{
+    static const char zeros[4096] = {};
+    while (length > 0) {
+        qint64 chunk = qMin<qint64>(length, sizeof(zeros));
+        if (!writeBytes(zeros, chunk)) return false;
+        length -= chunk;
+    }
+    return true;
+}
+
+bool ArrowIpcWriter::fail(const QString& message)
+{
+    error = message;
+    // 未提交的临时文件在析构时删除
+    if (file.isOpen()) file.cancelWriting();
+    return false;
+}
@@ -0,0 +1,77 @@
+#ifndef ARROWIPCWRITER_H
+#define ARROWIPCWRITER_H
+
+#include <QString>
+#include <QVector>
+#include <QByteArray>
+#include <QSaveFile>
+
+// Apache Arrow IPC 文件格式 (.arrow / Feather V2) 的最小写出器
+// 只支持本项目用到的 float64、int32 与 utf8 列，元数据按 flatbuffers 布局直接编码，不依赖 Arrow 库。
+// 记录批次逐个写入文件，内存中只保留当前批次的有效位图与字符串列
+class ArrowIpcWriter
+{
+public:
+    enum Type {
+        Float64,    // NaN 写为 null
+        Int32,
+        Utf8
+    };
+
+    struct Field {
+        QString name;
+        Type type = Float64;
+    };
+
+    // 一列在一个批次中的数据
+    struct Column {
+        // 数值列: 依次拼接的连续内存段，写出时直接从这里写入文件；data 为空表示该段全部为 null
+        struct Segment {
+            const void* data = nullptr;
+            qint64 length = 0;
+        };
+        QVector<Segment> segments;
+
+        // 字符串列
+        QVector<QByteArray> strings;
+    };
+
+    ArrowIpcWriter();
+
+    ArrowIpcWriter(const ArrowIpcWriter&) = delete;
+    ArrowIpcWriter& operator=(const ArrowIpcWriter&) = delete;
+
+    // 创建文件并写入 schema
+    bool open(const QString& path, const QVector<Field>& schema);
+
+    // 写入一个记录批次，columns 与 schema 一一对应，每列共 rowCount 行
+    bool writeBatch(qint64 rowCount, const QVector<Column>& columns);
+
+    // 写入文件尾 (schema 与各批次的位置) 并提交文件；未调用时文件被丢弃
+    bool close();
+
+    const QVector<Field>& schema() const { return fields; }
+    qint64 rowCount() const { return rows; }
+    const QString& errorString() const { return error; }
+
+private:
+    struct Block {
+        qint64 offset;
+        qint32 metadataLength;
+        qint64 bodyLength;
+    };
+
+    bool writeMessage(const QByteArray& metadata, qint64* metadataLength);
+    bool writeBytes(const char* data, qint64 length);
+    bool writeZeros(qint64 length);
+    bool fail(const QString& message);
+
+    QSaveFile file;
+    QVector<Field> fields;
+    QVector<Block> blocks;
+    qint64 position;
+    qint64 rows;
+    QString error;
+};
+
+#endif // ARROWIPCWRITER_H
@@ -0,0 +1,184 @@
+#include "SnapshotDocuments.h"
+#include "../concurrency/WorkStealingPool.h"
+#include <QCryptographicHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QSet>
+#include <algorithm>
+
+namespace {
+
+const QString kApiRoot = "/api";
+const QString kRunsPath = "/api/runs";
+
+typedef QVector<QPair<QString, SnapshotDocuments::Document>> DocumentList;
+
+SnapshotDocuments::Document makeDocument(const QJsonDocument& json)
+{
+    SnapshotDocuments::Document document;
+    document.body = json.toJson(QJsonDocument::Compact);
+    document.etag = '"' + QCryptographicHash::hash(document.body, QCryptographicHash::Sha1).toHex().left(20) + '"';
+    return document;
+}
+
+// 数值计数器输出为数字，便于看板直接计算
+QJsonValue counterValue(const QString& text)
+{
+    bool ok = false;
+    double value = text.toDouble(&ok);
+    return ok ? QJsonValue(value) : QJsonValue(text);
+}
+
+QJsonObject derivedObject(const ComponentStats& stats)
+{
+    QJsonObject derived;
+    for (auto it = stats.percentages.begin(); it != stats.percentages.end(); ++it) {
+        derived.insert(it.key(), it.value());
+    }
+    return derived;
+}
+
+QJsonObject componentObject(const ComponentStats& stats)
+{
+    QJsonObject counters;
+    for (auto it = stats.data.begin(); it != stats.data.end(); ++it) {
+        counters.insert(it.key(), counterValue(it.value()));
+    }
+    QJsonObject component;
+    component.insert("name", stats.name);
+    component.insert("counters", counters);
+    component.insert("derived", derivedObject(stats));
+    return component;
+}
+
+// 端口矩阵: matrix[i][j] 为 ports[i] 发往 ports[j] 的数据包数
+QJsonObject portObject(const QMap<QString, QString>& portTransmissions)
+{
+    static const QRegularExpression re("transmit_package_number_from_(\\d+)_to_(\\d+)$");
+
+    QMap<QPair<int, int>, double> packets;
+    QSet<int> portSet;
+    for (auto it = portTransmissions.begin(); it != portTransmissions.end(); ++it) {
+        QRegularExpressionMatch match = re.match(it.key());
+        if (!match.hasMatch()) continue;
+        int from = match.captured(1).toInt();
+        int to = match.captured(2).toInt();
+        packets[qMakePair(from, to)] += it.value().toDouble();
+        portSet.insert(from);
+        portSet.insert(to);
+    }
+
+    QVector<int> ports(portSet.begin(), portSet.end());
+    std::sort(ports.begin(), ports.end());
+
+    QJsonArray portArray;
+    QJsonArray matrix;
+    QJsonArray links;
+    for (int from : ports) {
+        portArray.append(from);
+        QJsonArray row;
+        for (int to : ports) {
+            double value = packets.value(qMakePair(from, to), 0);
+            row.append(value);
+            if (packets.contains(qMakePair(from, to))) {
+                links.append(QJsonObject{{"source", from}, {"destination", to}, {"packets", value}});
+            }
+        }
+        matrix.append(row);
+    }
+
+    QJsonObject result;
+    result.insert("ports", portArray);
+    result.insert("matrix", matrix);
+    result.insert("links", links);
+    return result;
+}
+
+DocumentList buildRun(const PublishedRun& run)
+{
+    DocumentList documents;
+    const QString base = kRunsPath + "/" + run.id;
+    const QMap<QString, ComponentStats>& statsData = run.stats->getStatsData();
+
+    QJsonArray names;
+    QJsonObject components;
+    QJsonObject derived;
+    int counterCount = 0;
+    for (auto it = statsData.begin(); it != statsData.end(); ++it) {
+        QJsonObject component = componentObject(it.value());
+        documents.append(qMakePair(base + "/components/" + it.key(), makeDocument(QJsonDocument(component))));
+        names.append(it.key());
+        components.insert(it.key(), component);
+        derived.insert(it.key(), derivedObject(it.value()));
+        counterCount += it.value().data.size();
+    }
+
+    QJsonObject summary;
+    summary.insert("id", run.id);
+    summary.insert("path", run.path);
+    summary.insert("state", run.state);
+    summary.insert("counters", counterCount);
+    summary.insert("malformedLines", run.stats->getMalformedLineCount());
+    summary.insert("conflictingKeys", QJsonArray::fromStringList(run.stats->getConflictingKeys()));
+    summary.insert("components", names);
+
+    documents.append(qMakePair(base, makeDocument(QJsonDocument(summary))));
+    documents.append(qMakePair(base + "/components", makeDocument(QJsonDocument(components))));
+    documents.append(qMakePair(base + "/derived", makeDocument(QJsonDocument(derived))));
+    documents.append(qMakePair(base + "/ports", makeDocument(QJsonDocument(portObject(run.stats->getPortTransmissions())))));
+    return documents;
+}
+
+}
+
+std::shared_ptr<const SnapshotDocuments> SnapshotDocuments::build(const QVector<PublishedRun>& runs)
+{
+    QVector<DocumentList> perRun(runs.size());
+    DocumentList* output = perRun.data();
+    WorkStealingPool::instance().parallelFor(runs.size(), [&runs, output](int i) {
+        if (runs[i].stats) output[i] = buildRun(runs[i]);
+    });
+
+    auto result = std::make_shared<SnapshotDocuments>();
+    QJsonArray runList;
+    for (int i = 0; i < runs.size(); ++i) {
+        const PublishedRun& run = runs[i];
+        QJsonObject entry;
+        entry.insert("id", run.id);
+        entry.insert("path", run.path);
+        entry.insert("state", run.state);
+        entry.insert("loaded", run.stats != nullptr);
+        if (run.stats) entry.insert("components", run.stats->getStatsData().size());
+        runList.append(entry);
+
+        for (const auto& document : perRun[i]) {
+            result->add(document.first, document.second);
+        }
+    }
+    result->add(kRunsPath, makeDocument(QJsonDocument(runList)));
+
+    QJsonObject index;
+    index.insert("runs", kRunsPath);
+    index.insert("routes", QJsonArray{
+        kRunsPath + "/{run}",
+        kRunsPath + "/{run}/components",
+        kRunsPath + "/{run}/components/{component}",
+        kRunsPath + "/{run}/derived",
+        kRunsPath + "/{run}/ports"});
+    result->add(kApiRoot, makeDocument(QJsonDocument(index)));
+    return result;
+}
+
+const SnapshotDocuments::Document* SnapshotDocuments::find(const QString& path) const
+{
+    auto it = entries.constFind(path);
+    return it == entries.constEnd() ? nullptr : &it.value();
+}
+
+void SnapshotDocuments::add(const QString& path, const Document& document)
+{
+    entries.insert(path, document);
+    bytes += document.body.size();
+}
@@ -0,0 +1,52 @@
+#ifndef SNAPSHOTDOCUMENTS_H
+#define SNAPSHOTDOCUMENTS_H
+
+#include "../statistics/StatsLoader.h"
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <memory>
+
+// 对外发布的一次运行
+struct PublishedRun {
+    QString id;
+    QString path;
+    QString state;                              // 驻留状态，仅用于展示
+    std::shared_ptr<const StatsLoader> stats;   // 未加载时为空，只出现在运行列表中
+};
+
+// 预先序列化好的 JSON 文档，按请求路径索引，供 HTTP 服务直接返回
+// 路径 (运行标识与组件名为未转义的原文):
+//   /api                                     路径说明
+//   /api/runs                                运行列表
+//   /api/runs/<运行>                          运行概要与组件名
+//   /api/runs/<运行>/components               全部组件的计数器与派生指标
+//   /api/runs/<运行>/components/<组件>         单个组件
+//   /api/runs/<运行>/derived                  各组件的派生指标 (命中率、IPC 等)
+//   /api/runs/<运行>/ports                    端口间数据包矩阵
+// 能解析为数字的计数器输出为 JSON 数字，其余保留字符串。ETag 由内容哈希得到，内容不变时重新发布也不变
+class SnapshotDocuments
+{
+public:
+    struct Document {
+        QByteArray body;
+        QByteArray etag;        // 含引号，可直接写入响应头
+    };
+
+    // 各运行的文档在线程池上并行生成
+    static std::shared_ptr<const SnapshotDocuments> build(const QVector<PublishedRun>& runs);
+
+    const Document* find(const QString& path) const;
+    const QHash<QString, Document>& documents() const { return entries; }
+    qint64 totalBytes() const { return bytes; }
+
+private:
+    void add(const QString& path, const Document& document);
+
+    QHash<QString, Document> entries;
+    qint64 bytes = 0;
+};
+
+#endif // SNAPSHOTDOCUMENTS_H
@@ -0,0 +1,227 @@
+#include "ChipItems.h"
+#include "ChipPainter.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+
+namespace {
+
+// 屏幕上每个场景单位对应的像素数低于这些值时省略对应的细节
+const double kShadowScale = 0.35;
+const double kLabelScale = 0.5;
+
+// 概览文字小于这个像素高度时不画
+const double kMinimumTitlePixels = 7;
+
+// 选中时的虚线框画在主体外侧这个距离处；边界再多留一个单位给线宽
+const double kSelectionMargin = 3;
+
+double levelOfDetail(const QStyleOptionGraphicsItem* option, const QPainter* painter)
+{
+    return option->levelOfDetailFromTransform(painter->worldTransform());
+}
+
+QStaticText staticText(const QString& text, const QFont& font)
+{
+    QStaticText result(text);
+    result.setTextFormat(Qt::PlainText);
+    result.prepare(QTransform(), font);
+    return result;
+}
+
+void paintSelection(QPainter* painter, const QStyleOptionGraphicsItem* option, const QRectF& rect)
+{
+    if (!(option->state & QStyle::State_Selected)) return;
+    QPen pen(QColor(40, 40, 40), 0, Qt::DashLine);
+    painter->setPen(pen);
+    painter->setBrush(Qt::NoBrush);
+    painter->drawRect(rect);
+}
+
+}
+
+// ==================== ComponentItem ====================
+
+ComponentItem::ComponentItem(const LayoutComponent& component, QGraphicsItem* parent)
+    : ClickableRectItem(component.rect.x(), component.rect.y(), component.rect.width(), component.rect.height(),
+                        component.id, parent)
+    , shadowOffset(ChipPainter::componentStyle(component.kind).shadowOffset)
+{
+    // 各类组件的配色与字号与命令行出图相同
+    ChipPainter::ComponentStyle style = ChipPainter::componentStyle(component.kind);
+    setPen(QPen(style.border, 2));
+    setBrush(style.fill);
+    labelColor = style.text;
+
+    // 名称居中，有端口号时略微上移
+    const QRectF& r = component.rect;
+    labelFont = QFont("Arial", style.fontSize, QFont::Bold);
+    label = staticText(component.label, labelFont);
+    QSizeF labelSize = label.size();
+    double labelY = r.y() + (r.height() - labelSize.height()) / 2;
+    if (component.port >= 0 && component.kind != LayoutComponent::Cpu) labelY -= 5;
+    labelPos = QPointF(r.x() + (r.width() - labelSize.width()) / 2, labelY);
+
+    if (component.port >= 0) {
+        portTagFont = QFont("Arial", 6, QFont::Bold);
+        portTag = staticText(QString("P%1").arg(component.port), portTagFont);
+        portTagPos = QPointF(r.x() + 3, r.bottom() - portTag.size().height() - 2);
+    }
+}
+
+QRectF ComponentItem::boundingRect() const
+{
+    // 阴影向右下偏移，选中框四周都超出主体，边界需同时包含两者，否则取消选中时残留虚线
+    QRectF body = QGraphicsRectItem::boundingRect();
+    double margin = kSelectionMargin + 1;
+    return (body | body.translated(shadowOffset, shadowOffset)).adjusted(-margin, -margin, margin, margin);
+}
+
+void ComponentItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(widget);
+    double lod = levelOfDetail(option, painter);
+
+    if (lod >= kShadowScale) {
+        painter->fillRect(rect().translated(shadowOffset, shadowOffset), QColor(0, 0, 0, 45));
+    }
+    painter->setPen(pen());
+    painter->setBrush(brush());
+    painter->drawRect(rect());
+
+    if (lod >= kLabelScale) {
+        painter->setFont(labelFont);
+        painter->setPen(labelColor);
+        painter->drawStaticText(labelPos, label);
+        if (!portTag.text().isEmpty()) {
+            painter->setFont(portTagFont);
+            painter->setPen(QColor(255, 100, 0));
+            painter->drawStaticText(portTagPos, portTag);
+        }
+    }
+
+    paintSelection(painter, option, rect().adjusted(-kSelectionMargin, -kSelectionMargin, kSelectionMargin, kSelectionMargin));
+}
+
+// ==================== BusNodeItem ====================
+
+BusNodeItem::BusNodeItem(int nodeId, const QPointF& center, QGraphicsItem* parent)
+    : ClickableEllipseItem(0, 0, 0, 0, QString("node_%1").arg(nodeId), parent)
+    , center(center)
+{
+    // 主体与编号的配色与命令行出图共用
+    ChipPainter::BusNodeStyle style = ChipPainter::busNodeStyle();
+    QPointF corner(style.radius, style.radius);
+    setRect(QRectF(center - corner, center + corner));
+    setPen(QPen(style.border, style.borderWidth));
+    setBrush(style.fill);
+    textColor = style.text;
+
+    numberFont = QFont("Arial", style.fontSize, QFont::Bold);
+    number = staticText(QString::number(nodeId), numberFont);
+    QSizeF size = number.size();
+    numberPos = center - QPointF(size.width() / 2, size.height() / 2);
+}
+
+QRectF BusNodeItem::boundingRect() const
+{
+    // 外层光晕半径 12，阴影向右下偏移 2
+    return QRectF(center - QPointF(13, 13), QSizeF(26, 26));
+}
+
+void BusNodeItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(widget);
+    double lod = levelOfDetail(option, painter);
+
+    if (lod >= kShadowScale) {
+        // 外层发光、阴影与装饰性外环
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(QColor(255, 215, 0, 30));
+        painter->drawEllipse(center, 12, 12);
+        painter->setBrush(QColor(0, 0, 0, 80));
+        painter->drawEllipse(rect().translated(2, 2));
+        painter->setPen(QPen(QColor(180, 140, 0), 1));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawEllipse(center, 10, 10);
+    }
+
+    painter->setPen(pen());
+    painter->setBrush(brush());
+    painter->drawEllipse(rect());
+
+    if (lod >= kLabelScale) {
+        // 内部高亮点 (3D效果) 与加粗的节点编号
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(QColor(255, 255, 255, 120));
+        painter->drawEllipse(QRectF(center.x() - 5, center.y() - 6, 4, 4));
+        painter->setFont(numberFont);
+        painter->setPen(textColor);
+        painter->drawStaticText(numberPos, number);
+    }
+
+    paintSelection(painter, option, rect().adjusted(-kSelectionMargin, -kSelectionMargin, kSelectionMargin, kSelectionMargin));
+}
+
+// ==================== ClusterItem ====================
+
+ClusterItem::ClusterItem(const LayoutCluster& cluster, const QPointF& nodeCenter, QGraphicsItem* parent)
+    : ClickableRectItem(cluster.rect.x(), cluster.rect.y(), cluster.rect.width(), cluster.rect.height(),
+                        QString("node_%1").arg(cluster.node), parent)
+    , nodeCenter(nodeCenter)
+{
+    setPen(QPen(QColor(110, 120, 140), 0));
+    setBrush(QColor(228, 234, 244));
+
+    QStringList parts;
+    if (cluster.cores > 0) parts.append(QString("%1 CPU").arg(cluster.cores));
+    if (cluster.caches > 0) parts.append(QString("%1 $").arg(cluster.caches));
+    if (cluster.memories > 0) parts.append(QString("%1 DDR").arg(cluster.memories));
+    if (cluster.others > 0) parts.append(QString("%1 other").arg(cluster.others));
+
+    // 文字约为单元宽度的六分之一高，在能看清时才画
+    titleFont = QFont("Arial");
+    titleFont.setPixelSize(qMax(8, static_cast<int>(cluster.rect.width() / 6)));
+    titleFont.setBold(true);
+    title = staticText(QString("N%1").arg(cluster.node), titleFont);
+    summary = staticText(parts.join("  "), titleFont);
+}
+
+void ClusterItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(widget);
+    double lod = levelOfDetail(option, painter);
+    const QRectF r = rect();
+
+    painter->setPen(pen());
+    painter->setBrush(brush());
+    double radius = qMin(r.width(), r.height()) * 0.08;
+    painter->drawRoundedRect(r, radius, radius);
+
+    // 总线节点位置的标记，尽量保持几个像素大小，但不超出单元
+    double nodeRadius = qBound(8.0, 3.0 / qMax(lod, 1e-6), qMax(8.0, qMin(r.width(), r.height()) / 4));
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(QColor(255, 215, 0));
+    painter->drawEllipse(nodeCenter, nodeRadius, nodeRadius);
+
+    if (titleFont.pixelSize() * lod >= kMinimumTitlePixels) {
+        painter->setFont(titleFont);
+        painter->setPen(QColor(50, 60, 80));
+        QPointF origin = r.topLeft() + QPointF(titleFont.pixelSize() * 0.5, titleFont.pixelSize() * 0.3);
+        painter->drawStaticText(origin, title);
+        // 组成说明放在单元底部，宽度不够时省略
+        if (summary.size().width() <= r.width() - titleFont.pixelSize()) {
+            QPointF bottom(origin.x(), r.bottom() - summary.size().height() - titleFont.pixelSize() * 0.3);
+            painter->drawStaticText(bottom, summary);
+        }
+    }
+
+    paintSelection(painter, option, r);
+}
+
+// ==================== ClusterDetailItem ====================
+
+ClusterDetailItem::ClusterDetailItem(QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+{
+    setFlag(QGraphicsItem::ItemHasNoContents, true);
+}
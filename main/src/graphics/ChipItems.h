@@ -0,0 +1,77 @@
+#ifndef CHIPITEMS_H
+#define CHIPITEMS_H
+
+#include "../components/ClickableItems.h"
+#include "ChipLayout.h"
+#include <QColor>
+#include <QFont>
+#include <QStaticText>
+
+// 芯片视图中的组件、总线节点与网格单元概览
+// 每个对象只是一个图元，阴影、外环与文字都在 paint() 中画出；
+// 文字用 QStaticText 缓存排版结果，平移时不重新排版。
+// 缩放到一定程度以下时 (按绘制时的变换计算) 省略阴影与文字
+
+// 组件: 阴影、主体、名称与端口号
+class ComponentItem : public ClickableRectItem
+{
+public:
+    explicit ComponentItem(const LayoutComponent& component, QGraphicsItem* parent = nullptr);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+private:
+    double shadowOffset;
+    QStaticText label;
+    QPointF labelPos;
+    QFont labelFont;
+    QColor labelColor;
+    QStaticText portTag;        // 没有端口时为空
+    QPointF portTagPos;
+    QFont portTagFont;
+};
+
+// 总线节点: 光晕、阴影、外环、主体、高光与编号
+class BusNodeItem : public ClickableEllipseItem
+{
+public:
+    BusNodeItem(int nodeId, const QPointF& center, QGraphicsItem* parent = nullptr);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+private:
+    QPointF center;
+    QStaticText number;
+    QPointF numberPos;
+    QFont numberFont;
+    QColor textColor;
+};
+
+// 缩小后代替整个网格单元的概览图形，点击时与点击其总线节点相同
+class ClusterItem : public ClickableRectItem
+{
+public:
+    ClusterItem(const LayoutCluster& cluster, const QPointF& nodeCenter, QGraphicsItem* parent = nullptr);
+
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+private:
+    QPointF nodeCenter;
+    QFont titleFont;            // 字号以场景单位计，随缩放变化
+    QStaticText title;
+    QStaticText summary;
+};
+
+// 一个网格单元中所有细节图元的父图元，自身不绘制；隐藏它即隐藏整个单元的细节
+class ClusterDetailItem : public QGraphicsItem
+{
+public:
+    explicit ClusterDetailItem(QGraphicsItem* parent = nullptr);
+
+    QRectF boundingRect() const override { return QRectF(); }
+    void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget* = nullptr) override {}
+};
+
+#endif // CHIPITEMS_H
@@ -0,0 +1,404 @@
+#include "ChipLayout.h"
+#include "../concurrency/WorkStealingPool.h"
+#include <QCache>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSet>
+#include <algorithm>
+
+namespace {
+
+// 组件尺寸与原先手工布局一致，内存节点改为较短的竖条以免撑高所有网格单元
+const double kCpuWidth = 100;
+const double kCpuHeight = 70;
+const double kL2Width = 60;
+const double kL2Height = 35;
+const double kL3Width = 80;
+const double kL3Height = 50;
+const double kMemoryWidth = 50;
+const double kMemoryHeight = 120;
+const double kOtherWidth = 100;
+const double kOtherHeight = 50;
+const double kNodeSize = 16;
+
+const double kCoreGap = 30;         // CPU 与 L2 之间
+const double kPortGap = 50;         // 组件与总线节点之间
+const double kSpacing = 20;         // 同一单元内并排的组件之间
+const double kGutter = 80;          // 网格单元之间的通道，绕行的边走在这里
+const double kLaneSpacing = 6;      // 同一通道中相邻绕行线的间距
+const int kLaneCount = 9;
+const int kSingleRowNodes = 8;      // 节点不多时排成一行
+const int kCachedLayouts = 8;
+
+LayoutComponent::Kind kindOf(const QString& id)
+{
+    if (id.startsWith("CPU")) return LayoutComponent::Cpu;
+    if (id.startsWith("L2Cache")) return LayoutComponent::L2Cache;
+    if (id.startsWith("L3Cache")) return LayoutComponent::L3Cache;
+    if (id.startsWith("MemoryNode")) return LayoutComponent::Memory;
+    return LayoutComponent::Other;
+}
+
+QSizeF sizeOf(LayoutComponent::Kind kind)
+{
+    switch (kind) {
+    case LayoutComponent::Cpu: return QSizeF(kCpuWidth, kCpuHeight);
+    case LayoutComponent::L2Cache: return QSizeF(kL2Width, kL2Height);
+    case LayoutComponent::L3Cache: return QSizeF(kL3Width, kL3Height);
+    case LayoutComponent::Memory: return QSizeF(kMemoryWidth, kMemoryHeight);
+    case LayoutComponent::Other: break;
+    }
+    return QSizeF(kOtherWidth, kOtherHeight);
+}
+
+QString labelOf(const QString& id, LayoutComponent::Kind kind)
+{
+    switch (kind) {
+    case LayoutComponent::L2Cache: return "L2";
+    case LayoutComponent::L3Cache: return "L3";
+    case LayoutComponent::Memory: return "DDR";
+    default: break;
+    }
+    return id;
+}
+
+// 名称末尾的编号，如 L2Cache12 -> 12；没有编号时返回 -1
+int trailingNumber(const QString& id)
+{
+    int begin = id.size();
+    while (begin > 0 && id[begin - 1].isDigit()) begin--;
+    if (begin == id.size()) return -1;
+    return id.mid(begin).toInt();
+}
+
+// 前缀相同时按编号排序，CPU2 排在 CPU10 之前
+bool naturalLess(const QString& a, const QString& b)
+{
+    int numberA = trailingNumber(a);
+    int numberB = trailingNumber(b);
+    QString prefixA = numberA < 0 ? a : a.left(a.size() - QString::number(numberA).size());
+    QString prefixB = numberB < 0 ? b : b.left(b.size() - QString::number(numberB).size());
+    if (prefixA != prefixB) return prefixA < prefixB;
+    if (numberA != numberB) return numberA < numberB;
+    return a < b;
+}
+
+// 一个总线节点所在的网格单元
+struct Tile {
+    int node = 0;
+    QStringList upper;          // 私有 L2 等，CPU 放在其上方
+    QStringList lower;          // L3、内存节点等
+    QPointF origin;
+    int row = 0;
+    int column = 0;
+};
+
+double laneOffset(int lane)
+{
+    return ((lane % kLaneCount) - kLaneCount / 2) * kLaneSpacing;
+}
+
+}
+
+ChipLayout ChipLayout::compute(const SetupModel& setup)
+{
+    ChipLayout layout;
+
+    // 端口 -> 组件，总线节点 -> 端口
+    QMap<int, QString> portComponent;
+    QHash<int, QString> cpuByIndex;
+    for (auto it = setup.components.begin(); it != setup.components.end(); ++it) {
+        int port = setup.portOf(it.key());
+        if (port >= 0) portComponent.insert(port, it.key());
+        if (kindOf(it.key()) == LayoutComponent::Cpu && trailingNumber(it.key()) >= 0) {
+            cpuByIndex.insert(trailingNumber(it.key()), it.key());
+        }
+    }
+    QMap<int, QList<int>> nodePorts;
+    for (auto it = setup.portToNode.begin(); it != setup.portToNode.end(); ++it) {
+        nodePorts[it.value()].append(it.key());
+    }
+    for (const auto& edge : setup.edges) {
+        nodePorts[edge.first];
+        nodePorts[edge.second];
+    }
+
+    // 组件分配到节点；CPU 跟随同编号的 L2
+    QVector<Tile> tiles;
+    QHash<int, int> tileOfNode;
+    QSet<QString> placed;
+    for (auto it = nodePorts.begin(); it != nodePorts.end(); ++it) {
+        Tile tile;
+        tile.node = it.key();
+        for (int port : it.value()) {
+            QString id = portComponent.value(port);
+            if (id.isEmpty()) continue;
+            LayoutComponent::Kind kind = kindOf(id);
+            if (kind == LayoutComponent::L2Cache || kind == LayoutComponent::Cpu) {
+                tile.upper.append(id);
+            } else {
+                tile.lower.append(id);
+            }
+            placed.insert(id);
+        }
+        std::sort(tile.upper.begin(), tile.upper.end(), naturalLess);
+        std::sort(tile.lower.begin(), tile.lower.end(), naturalLess);
+        tileOfNode.insert(tile.node, tiles.size());
+        tiles.append(tile);
+    }
+    QHash<QString, QString> coreAbove;      // L2 -> 放在其上方的 CPU (CPU 自己没有端口时)
+    for (const Tile& tile : tiles) {
+        for (const QString& id : tile.upper) {
+            if (kindOf(id) != LayoutComponent::L2Cache) continue;
+            QString cpu = cpuByIndex.value(trailingNumber(id));
+            if (cpu.isEmpty() || placed.contains(cpu)) continue;
+            coreAbove.insert(id, cpu);
+            placed.insert(cpu);
+        }
+    }
+
+    // 未连接总线的 CPU 与端口不在任何节点上的组件放在网格上方的一行
+    QStringList extras;
+    for (auto it = setup.components.begin(); it != setup.components.end(); ++it) {
+        if (placed.contains(it.key())) continue;
+        if (kindOf(it.key()) == LayoutComponent::Cpu || setup.portOf(it.key()) >= 0) extras.append(it.key());
+    }
+    std::sort(extras.begin(), extras.end(), naturalLess);
+
+    if (tiles.isEmpty() && extras.isEmpty()) return layout;
+
+    auto addComponent = [&layout](const QString& id, const QPointF& topLeft, int port, int cluster) {
+        LayoutComponent component;
+        component.id = id;
+        component.kind = kindOf(id);
+        component.label = labelOf(id, component.kind);
+        component.rect = QRectF(topLeft, sizeOf(component.kind));
+        component.port = port;
+        component.cluster = cluster;
+        layout.components.append(component);
+        if (cluster >= 0) {
+            LayoutCluster& owner = layout.clusters[cluster];
+            switch (component.kind) {
+            case LayoutComponent::Cpu: owner.cores++; break;
+            case LayoutComponent::L2Cache:
+            case LayoutComponent::L3Cache: owner.caches++; break;
+            case LayoutComponent::Memory: owner.memories++; break;
+            case LayoutComponent::Other: owner.others++; break;
+            }
+        }
+        return component.rect;
+    };
+
+    double extrasHeight = 0;
+    double x = 0;
+    for (const QString& id : extras) {
+        QRectF rect = addComponent(id, QPointF(x, 0), setup.portOf(id), -1);
+        x = rect.right() + kSpacing;
+        extrasHeight = qMax(extrasHeight, rect.height());
+    }
+
+    // 统一的单元尺寸
+    double upperHeight = 0;
+    double lowerHeight = 0;
+    double tileWidth = kCpuWidth;
+    for (const Tile& tile : tiles) {
+        for (const QString& id : tile.upper) {
+            double height = sizeOf(kindOf(id)).height();
+            if (coreAbove.contains(id)) height += kCoreGap + kCpuHeight;
+            upperHeight = qMax(upperHeight, height);
+        }
+        double lowerWidth = 0;
+        for (const QString& id : tile.lower) {
+            QSizeF size = sizeOf(kindOf(id));
+            lowerWidth += size.width() + kSpacing;
+            lowerHeight = qMax(lowerHeight, size.height());
+        }
+        double upperWidth = tile.upper.size() * (kCpuWidth + kSpacing);
+        tileWidth = qMax(tileWidth, qMax(upperWidth, lowerWidth) - kSpacing);
+    }
+    double nodeOffset = upperHeight + (upperHeight > 0 ? kPortGap : 0) + kNodeSize / 2;
+    double lowerOffset = nodeOffset + kNodeSize / 2 + kPortGap;
+    double tileHeight = lowerOffset + lowerHeight;
+
+    // 总线边: 往返两条边合并为一条连线
+    QMap<QPair<int, int>, bool> busEdges;
+    QSet<QPair<int, int>> declared;
+    for (const auto& edge : setup.edges) declared.insert(edge);
+    for (const auto& edge : setup.edges) {
+        if (edge.first == edge.second) continue;
+        QPair<int, int> key(qMin(edge.first, edge.second), qMax(edge.first, edge.second));
+        if (busEdges.contains(key)) continue;
+        busEdges.insert(key, declared.contains(qMakePair(edge.second, edge.first)));
+    }
+
+    // 节点放到网格单元上: 环与 mesh 规则排布，其它拓扑用力导向布局
+    std::vector<std::pair<int, int>> graphEdges;
+    graphEdges.reserve(busEdges.size());
+    for (auto it = busEdges.begin(); it != busEdges.end(); ++it) {
+        graphEdges.emplace_back(tileOfNode.value(it.key().first), tileOfNode.value(it.key().second));
+    }
+    int tileCount = tiles.size();
+    GraphLayout::Result placement = GraphLayout::compute(tileCount, graphEdges,
+                                                         (tileHeight + kGutter) / (tileWidth + kGutter),
+                                                         kSingleRowNodes);
+    layout.topology = placement.kind;
+    // 任务被取消时 GraphLayout 的迭代提前结束，位置只是中间结果
+    layout.complete = !WorkStealingPool::isCancelled();
+    double gridTop = extras.isEmpty() ? 0 : extrasHeight + kGutter;
+
+    for (int i = 0; i < tileCount; ++i) {
+        Tile& tile = tiles[i];
+        tile.row = placement.row[i];
+        tile.column = placement.column[i];
+        tile.origin = QPointF(tile.column * (tileWidth + kGutter), gridTop + tile.row * (tileHeight + kGutter));
+        QPointF node(tile.origin.x() + tileWidth / 2, tile.origin.y() + nodeOffset);
+
+        LayoutBusNode busNode;
+        busNode.id = tile.node;
+        busNode.center = node;
+        layout.busNodes.append(busNode);
+        LayoutCluster cluster;
+        cluster.node = tile.node;
+        cluster.rect = QRectF(tile.origin, QSizeF(tileWidth, tileHeight));
+        layout.clusters.append(cluster);
+
+        // 连到节点的折线: 先竖直到节点所在高度，再水平到节点
+        auto addPortLink = [&](const QString& id, const QPointF& from) {
+            LayoutLink link;
+            link.kind = LayoutLink::PortLink;
+            link.from = setup.portOf(id);
+            link.to = tile.node;
+            link.cluster = i;
+            link.points.append(from);
+            if (qAbs(from.x() - node.x()) > 0.5) link.points.append(QPointF(from.x(), node.y()));
+            link.points.append(node);
+            layout.links.append(link);
+        };
+
+        double upperWidth = tile.upper.size() * (kCpuWidth + kSpacing) - kSpacing;
+        double columnX = tile.origin.x() + (tileWidth - upperWidth) / 2;
+        for (const QString& id : tile.upper) {
+            double centerX = columnX + kCpuWidth / 2;
+            QSizeF size = sizeOf(kindOf(id));
+            QRectF rect = addComponent(id, QPointF(centerX - size.width() / 2,
+                                                   tile.origin.y() + upperHeight - size.height()),
+                                       setup.portOf(id), i);
+            addPortLink(id, QPointF(centerX, rect.bottom()));
+
+            QString cpu = coreAbove.value(id);
+            if (!cpu.isEmpty()) {
+                QRectF cpuRect = addComponent(cpu, QPointF(columnX, rect.top() - kCoreGap - kCpuHeight), -1, i);
+                LayoutLink link;
+                link.kind = LayoutLink::CoreLink;
+                link.cluster = i;
+                link.points = {QPointF(centerX, cpuRect.bottom()), QPointF(centerX, rect.top())};
+                layout.links.append(link);
+            }
+            columnX += kCpuWidth + kSpacing;
+        }
+
+        double lowerWidth = -kSpacing;
+        for (const QString& id : tile.lower) lowerWidth += sizeOf(kindOf(id)).width() + kSpacing;
+        double lowerX = tile.origin.x() + (tileWidth - lowerWidth) / 2;
+        for (const QString& id : tile.lower) {
+            QRectF rect = addComponent(id, QPointF(lowerX, tile.origin.y() + lowerOffset), setup.portOf(id), i);
+            addPortLink(id, QPointF(rect.center().x(), rect.top()));
+            lowerX = rect.right() + kSpacing;
+        }
+    }
+
+    // 正交布线，只经过单元之间的通道，不穿过组件:
+    //   同一行相邻的节点直接相连；
+    //   同一列或相邻两列的节点经两者之间 (同一列时为左侧) 的纵向通道相连；
+    //   其余的边从各自朝向对方一侧的纵向通道走到两行之间 (同一行时为该行下方) 的横向通道。
+    // 同一通道中的多条边错开一定间距
+    QHash<int, int> gutterLanes;
+    QHash<int, int> channelLanes;
+    auto gutterX = [&](int gutter) { return gutter * (tileWidth + kGutter) - kGutter / 2; };
+    auto channelY = [&](int row) { return gridTop + row * (tileHeight + kGutter) + tileHeight + kGutter / 2; };
+
+    for (auto it = busEdges.begin(); it != busEdges.end(); ++it) {
+        bool directed = !it.value();
+        // 单向边保留声明的方向
+        int from = it.key().first;
+        int to = it.key().second;
+        if (directed && !declared.contains(it.key())) std::swap(from, to);
+
+        const Tile& a = tiles[tileOfNode.value(from)];
+        const Tile& b = tiles[tileOfNode.value(to)];
+        QPointF pointA(a.origin.x() + tileWidth / 2, a.origin.y() + nodeOffset);
+        QPointF pointB(b.origin.x() + tileWidth / 2, b.origin.y() + nodeOffset);
+
+        LayoutLink link;
+        link.kind = LayoutLink::BusLink;
+        link.from = from;
+        link.to = to;
+        link.bidirectional = it.value();
+        if (a.row == b.row && qAbs(a.column - b.column) == 1) {
+            link.points = {pointA, pointB};
+        } else if (qAbs(a.column - b.column) <= 1) {
+            int gutter = qMax(a.column, b.column);
+            double x = gutterX(gutter) + laneOffset(gutterLanes[gutter]++);
+            link.points = {pointA, QPointF(x, pointA.y()), QPointF(x, pointB.y()), pointB};
+        } else {
+            int gutterA = a.column < b.column ? a.column + 1 : a.column;
+            int gutterB = a.column < b.column ? b.column : b.column + 1;
+            int channel = qMin(a.row, b.row);
+            double xA = gutterX(gutterA) + laneOffset(gutterLanes[gutterA]++);
+            double xB = gutterX(gutterB) + laneOffset(gutterLanes[gutterB]++);
+            double y = channelY(channel) + laneOffset(channelLanes[channel]++);
+            link.points = {pointA, QPointF(xA, pointA.y()), QPointF(xA, y),
+                           QPointF(xB, y), QPointF(xB, pointB.y()), pointB};
+        }
+        layout.links.append(link);
+    }
+
+    // 场景范围
+    QRectF bounds;
+    for (const LayoutComponent& component : layout.components) bounds |= component.rect;
+    for (const LayoutBusNode& node : layout.busNodes) {
+        bounds |= QRectF(node.center - QPointF(kNodeSize, kNodeSize), QSizeF(2 * kNodeSize, 2 * kNodeSize));
+    }
+    for (const LayoutLink& link : layout.links) {
+        for (const QPointF& point : link.points) bounds |= QRectF(point, QSizeF(1, 1));
+    }
+    layout.bounds = bounds;
+    return layout;
+}
+
+QByteArray ChipLayout::topologyHash(const SetupModel& setup)
+{
+    // 只包含影响布局的内容: 组件名及其端口、端口到节点的映射与边
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    for (auto it = setup.components.begin(); it != setup.components.end(); ++it) {
+        stream << it.key() << setup.portOf(it.key());
+    }
+    stream << setup.portToNode;
+    for (const auto& edge : setup.edges) stream << edge.first << edge.second;
+    return QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+}
+
+ChipLayout ChipLayout::cached(const SetupModel& setup)
+{
+    static QMutex mutex;
+    static QCache<QByteArray, ChipLayout> cache(kCachedLayouts);
+
+    QByteArray key = topologyHash(setup);
+    {
+        QMutexLocker locker(&mutex);
+        if (ChipLayout* layout = cache.object(key)) return *layout;
+    }
+
+    // 计算期间不持有锁；同一拓扑并发计算时结果相同，后写入的覆盖先写入的
+    // 被取消的计算不缓存，否则之后该拓扑一直得到未收敛的布局
+    ChipLayout layout = compute(setup);
+    if (!layout.complete) return layout;
+    QMutexLocker locker(&mutex);
+    cache.insert(key, new ChipLayout(layout));
+    return layout;
+}
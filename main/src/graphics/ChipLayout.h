@@ -0,0 +1,85 @@
+#ifndef CHIPLAYOUT_H
+#define CHIPLAYOUT_H
+
+#include "../statistics/SetupModel.h"
+#include "GraphLayout.h"
+#include <QByteArray>
+#include <QPointF>
+#include <QRectF>
+#include <QString>
+#include <QVector>
+
+// 芯片上的一个组件 (CPU、缓存、内存节点等)
+struct LayoutComponent {
+    enum Kind {
+        Cpu,
+        L2Cache,
+        L3Cache,
+        Memory,
+        Other
+    };
+
+    QString id;                 // 组件名，如 L2Cache3
+    QString label;              // 框内显示的文字
+    Kind kind = Other;
+    QRectF rect;
+    int port = -1;              // 连接的总线端口，没有时为 -1
+    int cluster = -1;           // 所在的 LayoutCluster，不在任何网格单元中时为 -1
+};
+
+struct LayoutBusNode {
+    int id = 0;
+    QPointF center;
+};
+
+// 连线按折线存储
+struct LayoutLink {
+    enum Kind {
+        CoreLink,               // CPU 到私有 L2 的专属通道
+        PortLink,               // 组件到其端口所在的总线节点
+        BusLink                 // 总线节点之间的边
+    };
+
+    Kind kind = PortLink;
+    QVector<QPointF> points;
+    int from = -1;              // BusLink: 发送节点; PortLink: 端口
+    int to = -1;                // BusLink: 接收节点; PortLink: 总线节点
+    bool bidirectional = false; // BusLink: setup.txt 同时声明了 to -> from
+    int cluster = -1;           // CoreLink、PortLink 所在的 LayoutCluster
+};
+
+// 一个总线节点的网格单元 (节点及其端口上的组件)，缩小到看不清细节时整体画成一个图形
+struct LayoutCluster {
+    int node = 0;
+    QRectF rect;
+    int cores = 0;
+    int caches = 0;
+    int memories = 0;
+    int others = 0;
+};
+
+// 由 setup.txt 的拓扑计算芯片视图的几何: 每个总线节点占一个网格单元，单元的位置由 GraphLayout 决定，
+// 端口上的组件围绕节点排列 (私有 L2 及其 CPU 在上方，L3、内存节点等在下方)，
+// 节点之间的边正交布线，经单元间的通道绕行，不穿过组件。
+// 只做几何计算，不依赖图形界面，可以在线程池上运行；ChipRenderer 在界面线程按结果创建图元
+class ChipLayout
+{
+public:
+    static ChipLayout compute(const SetupModel& setup);
+
+    // 按拓扑哈希缓存的 compute()，可在任意线程调用；所在任务被取消时返回的布局 complete 为 false 且不缓存
+    static ChipLayout cached(const SetupModel& setup);
+    static QByteArray topologyHash(const SetupModel& setup);
+
+    bool isEmpty() const { return components.isEmpty() && busNodes.isEmpty(); }
+
+    QVector<LayoutComponent> components;
+    QVector<LayoutBusNode> busNodes;
+    QVector<LayoutLink> links;
+    QVector<LayoutCluster> clusters;                    // 与 busNodes 一一对应
+    QRectF bounds;
+    GraphLayout::Kind topology = GraphLayout::Empty;    // 识别出的总线拓扑
+    bool complete = true;                               // 所在任务被取消、布局未完成迭代时为 false
+};
+
+#endif // CHIPLAYOUT_H
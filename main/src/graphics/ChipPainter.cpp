@@ -0,0 +1,305 @@
+#include "ChipPainter.h"
+#include <QFont>
+#include <QLineF>
+#include <QPen>
+#include <QSet>
+#include <QSvgGenerator>
+#include <QtMath>
+
+namespace {
+
+const double kMargin = 40;
+const double kTitlePixels = 16;
+const double kLabelScale = 0.3;         // 图像比例低于这个值时不画文字
+
+}
+
+ChipPainter::ComponentStyle ChipPainter::componentStyle(LayoutComponent::Kind kind)
+{
+    ComponentStyle style;
+    style.border = QColor(60, 60, 60);
+    style.fill = QColor(220, 220, 220);
+    style.text = QColor(40, 40, 40);
+    switch (kind) {
+    case LayoutComponent::L2Cache:
+        style.border = QColor(30, 100, 180);
+        style.fill = QColor(173, 216, 230);
+        style.text = QColor(20, 60, 120);
+        style.fontSize = 8;
+        break;
+    case LayoutComponent::L3Cache:
+        style.border = QColor(34, 139, 34);
+        style.fill = QColor(144, 238, 144);
+        style.text = QColor(20, 80, 20);
+        style.fontSize = 10;
+        break;
+    case LayoutComponent::Memory:
+        style.border = QColor(180, 50, 50);
+        style.fill = QColor(255, 192, 203);
+        style.text = QColor(120, 30, 30);
+        style.shadowOffset = 3;
+        break;
+    case LayoutComponent::Other:
+        style.border = QColor(110, 80, 150);
+        style.fill = QColor(225, 215, 240);
+        style.text = QColor(60, 40, 90);
+        style.fontSize = 9;
+        break;
+    case LayoutComponent::Cpu:
+        style.shadowOffset = 3;
+        break;
+    }
+    return style;
+}
+
+ChipPainter::BusNodeStyle ChipPainter::busNodeStyle()
+{
+    BusNodeStyle style;
+    style.border = QColor(200, 150, 0);
+    style.fill = QColor(255, 215, 0);
+    style.text = QColor(80, 50, 0);
+    return style;
+}
+
+QPen ChipPainter::linkPen(LayoutLink::Kind kind, bool memoryPort)
+{
+    QPen pen;
+    pen.setCapStyle(Qt::RoundCap);
+    pen.setJoinStyle(Qt::RoundJoin);
+    switch (kind) {
+    case LayoutLink::CoreLink:
+        // CPU 到私有缓存的专属通道: 黑色粗线
+        pen.setColor(QColor(40, 40, 40));
+        pen.setWidth(5);
+        break;
+    case LayoutLink::BusLink:
+        // 总线主干: 蓝色粗线
+        pen.setColor(QColor(30, 100, 200));
+        pen.setWidth(4);
+        break;
+    case LayoutLink::PortLink:
+        // 组件到总线节点: 深灰色细线，内存节点用红色
+        pen.setColor(memoryPort ? QColor(200, 50, 50) : QColor(80, 80, 80));
+        pen.setWidth(memoryPort ? 3 : 2);
+        break;
+    }
+    return pen;
+}
+
+QHash<QPair<int, int>, QPolygonF> ChipPainter::edgeLanes(const ChipLayout& layout)
+{
+    QHash<QPair<int, int>, QPolygonF> lanes;
+    for (const LayoutLink& link : layout.links) {
+        if (link.kind != LayoutLink::BusLink || link.points.size() < 2) continue;
+        QPolygonF lane;
+        if (link.bidirectional) {
+            QVector<QPointF> reversed(link.points.rbegin(), link.points.rend());
+            lane = offsetPolyline(link.points, kLaneOffset);
+            if (!lane.isEmpty()) lanes.insert(qMakePair(link.from, link.to), lane);
+            lane = offsetPolyline(reversed, kLaneOffset);
+            if (!lane.isEmpty()) lanes.insert(qMakePair(link.to, link.from), lane);
+        } else {
+            lane = offsetPolyline(link.points, 0);
+            if (!lane.isEmpty()) lanes.insert(qMakePair(link.from, link.to), lane);
+        }
+    }
+    return lanes;
+}
+
+QPolygonF ChipPainter::offsetPolyline(const QVector<QPointF>& points, double offset)
+{
+    // 去掉重合的点，避免零长度线段没有法向
+    QVector<QPointF> vertices;
+    for (const QPointF& point : points) {
+        if (vertices.isEmpty() || QLineF(vertices.last(), point).length() > 1e-6) vertices.append(point);
+    }
+    if (vertices.size() < 2) return QPolygonF();
+
+    // 各线段行进方向右侧的单位法向 (场景坐标 y 轴向下)
+    QVector<QPointF> normals;
+    for (int i = 0; i + 1 < vertices.size(); ++i) {
+        QPointF d = vertices[i + 1] - vertices[i];
+        double length = qSqrt(QPointF::dotProduct(d, d));
+        normals.append(QPointF(-d.y() / length, d.x() / length));
+    }
+
+    QPolygonF lane;
+    lane.append(vertices.first() + normals.first() * offset);
+    for (int i = 1; i + 1 < vertices.size(); ++i) {
+        // 拐点处沿角平分线斜接，使两侧线段都保持 offset 的距离
+        const QPointF& n1 = normals[i - 1];
+        const QPointF& n2 = normals[i];
+        double denominator = 1 + QPointF::dotProduct(n1, n2);
+        QPointF shift = denominator > 1e-3 ? (n1 + n2) / denominator : n2;
+        lane.append(vertices[i] + shift * offset);
+    }
+    lane.append(vertices.last() + normals.last() * offset);
+    return lane;
+}
+
+QColor ChipPainter::heatColor(double t)
+{
+    static const struct { double at; QColor color; } stops[] = {
+        {0.0, QColor(30, 100, 200)},
+        {0.4, QColor(255, 193, 7)},
+        {0.7, QColor(253, 126, 20)},
+        {1.0, QColor(220, 53, 69)},
+    };
+    t = qBound(0.0, t, 1.0);
+    for (int i = 1; i < 4; ++i) {
+        if (t > stops[i].at) continue;
+        double f = (t - stops[i - 1].at) / (stops[i].at - stops[i - 1].at);
+        const QColor& a = stops[i - 1].color;
+        const QColor& b = stops[i].color;
+        return QColor(qRound(a.red() + (b.red() - a.red()) * f),
+                      qRound(a.green() + (b.green() - a.green()) * f),
+                      qRound(a.blue() + (b.blue() - a.blue()) * f));
+    }
+    return stops[3].color;
+}
+
+void ChipPainter::paint(QPainter& painter, const ChipLayout& layout, const BusUtilization::Values* values, bool labels)
+{
+    painter.save();
+
+    // 连线在最下层，与界面中的配色相同；有利用率时总线主干改为浅色底，上面画各方向的车道
+    QSet<int> memoryPorts;
+    for (const LayoutComponent& component : layout.components) {
+        if (component.kind == LayoutComponent::Memory && component.port >= 0) memoryPorts.insert(component.port);
+    }
+    painter.setBrush(Qt::NoBrush);
+    for (const LayoutLink& link : layout.links) {
+        if (link.points.size() < 2) continue;
+        QPen pen = linkPen(link.kind, memoryPorts.contains(link.from));
+        if (values && link.kind == LayoutLink::BusLink) pen.setColor(QColor(200, 210, 225));
+        painter.setPen(pen);
+        painter.drawPolyline(link.points.constData(), link.points.size());
+    }
+
+    if (values) {
+        QHash<QPair<int, int>, QPolygonF> lanes = edgeLanes(layout);
+        for (auto it = lanes.begin(); it != lanes.end(); ++it) {
+            auto value = values->edges.constFind(it.key());
+            if (value == values->edges.constEnd() || *value < 0) continue;
+            double t = values->edgeScale > 0 ? qMin(1.0, *value / values->edgeScale) : 0;
+            QPen pen(heatColor(t), 2 + 5 * t);
+            pen.setCapStyle(Qt::FlatCap);
+            pen.setJoinStyle(Qt::MiterJoin);
+            painter.setPen(pen);
+            painter.drawPolyline(it.value());
+        }
+    }
+
+    // 组件
+    for (const LayoutComponent& component : layout.components) {
+        ComponentStyle style = componentStyle(component.kind);
+        const QRectF& r = component.rect;
+        painter.fillRect(r.translated(style.shadowOffset, style.shadowOffset), QColor(0, 0, 0, 45));
+        painter.setPen(QPen(style.border, 2));
+        painter.setBrush(style.fill);
+        painter.drawRect(r);
+        if (!labels) continue;
+
+        // 有端口号时名称略微上移
+        bool tagged = component.port >= 0 && component.kind != LayoutComponent::Cpu;
+        painter.setFont(QFont("Arial", style.fontSize, QFont::Bold));
+        painter.setPen(style.text);
+        painter.drawText(tagged ? r.adjusted(0, 0, 0, -10) : r, Qt::AlignCenter, component.label);
+        if (component.port >= 0) {
+            painter.setFont(QFont("Arial", 6, QFont::Bold));
+            painter.setPen(QColor(255, 100, 0));
+            painter.drawText(r.adjusted(3, 0, 0, -2), Qt::AlignLeft | Qt::AlignBottom, QString("P%1").arg(component.port));
+        }
+    }
+
+    // 总线节点，有利用率时外加按节点值着色的光晕
+    const BusNodeStyle nodeStyle = busNodeStyle();
+    for (const LayoutBusNode& node : layout.busNodes) {
+        if (values && values->nodes.contains(node.id)) {
+            double t = values->nodeScale > 0 ? qMin(1.0, values->nodes.value(node.id) / values->nodeScale) : 0;
+            QColor halo = heatColor(t);
+            halo.setAlpha(140);
+            painter.setPen(Qt::NoPen);
+            painter.setBrush(halo);
+            double radius = 12 + 8 * t;
+            painter.drawEllipse(node.center, radius, radius);
+        }
+        painter.setPen(QPen(nodeStyle.border, nodeStyle.borderWidth));
+        painter.setBrush(nodeStyle.fill);
+        painter.drawEllipse(node.center, nodeStyle.radius, nodeStyle.radius);
+        if (labels) {
+            painter.setFont(QFont("Arial", nodeStyle.fontSize, QFont::Bold));
+            painter.setPen(nodeStyle.text);
+            QPointF corner(nodeStyle.radius, nodeStyle.radius);
+            painter.drawText(QRectF(node.center - corner, node.center + corner), Qt::AlignCenter,
+                             QString::number(node.id));
+        }
+    }
+
+    painter.restore();
+}
+
+QRectF ChipPainter::pageRect(const ChipLayout& layout, double titleHeight)
+{
+    QRectF bounds = layout.isEmpty() ? QRectF(0, 0, 400, 100) : layout.bounds;
+    return bounds.adjusted(-kMargin, -kMargin - titleHeight, kMargin, kMargin);
+}
+
+void ChipPainter::paintTitle(QPainter& painter, const QRectF& page, const QString& title, double pixelSize)
+{
+    if (title.isEmpty()) return;
+    QFont font("Arial");
+    font.setPixelSize(qMax(1, qRound(pixelSize)));
+    painter.setFont(font);
+    painter.setPen(QColor(40, 40, 40));
+    painter.drawText(QRectF(page.left() + pixelSize, page.top() + pixelSize / 2, page.width() - 2 * pixelSize,
+                            pixelSize * 1.5),
+                     Qt::AlignLeft | Qt::AlignVCenter, title);
+}
+
+QImage ChipPainter::renderImage(const ChipLayout& layout, const BusUtilization::Values* values, double scale,
+                                const QString& title, int maxSide)
+{
+    // 标题留白按像素计，换算成场景单位；图像太大时整体缩小
+    QRectF page = pageRect(layout, 0);
+    scale = qMin(scale, maxSide / qMax(page.width(), page.height()));
+    double titlePixels = title.isEmpty() ? 0 : kTitlePixels;
+    page = pageRect(layout, 2 * titlePixels / scale);
+    QSize size(qMax(1, qCeil(page.width() * scale)), qMax(1, qCeil(page.height() * scale)));
+    if (size.width() > maxSide || size.height() > maxSide) {
+        scale *= static_cast<double>(maxSide) / qMax(size.width(), size.height());
+        size = QSize(qMax(1, qMin(maxSide, qCeil(page.width() * scale))),
+                     qMax(1, qMin(maxSide, qCeil(page.height() * scale))));
+    }
+
+    QImage image(size, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::white);
+    QPainter painter(&image);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setRenderHint(QPainter::TextAntialiasing);
+    painter.scale(scale, scale);
+    painter.translate(-page.topLeft());
+    paint(painter, layout, values, scale >= kLabelScale);
+    paintTitle(painter, page, title, titlePixels / scale);
+    painter.end();
+    return image;
+}
+
+bool ChipPainter::renderSvg(const QString& path, const ChipLayout& layout, const BusUtilization::Values* values,
+                            const QString& title)
+{
+    QRectF page = pageRect(layout, title.isEmpty() ? 0 : 2 * kTitlePixels);
+    QSvgGenerator generator;
+    generator.setFileName(path);
+    generator.setSize(page.size().toSize());
+    generator.setViewBox(QRectF(QPointF(0, 0), page.size()));
+    generator.setTitle(title);
+    generator.setDescription("Chip view rendered by ppv-cli");
+
+    QPainter painter;
+    if (!painter.begin(&generator)) return false;
+    painter.translate(-page.topLeft());
+    paint(painter, layout, values, true);
+    paintTitle(painter, page, title, kTitlePixels);
+    return painter.end();
+}
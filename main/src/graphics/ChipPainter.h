@@ -0,0 +1,70 @@
+#ifndef CHIPPAINTER_H
+#define CHIPPAINTER_H
+
+#include "../analysis/BusUtilization.h"
+#include "ChipLayout.h"
+#include <QColor>
+#include <QHash>
+#include <QImage>
+#include <QPainter>
+#include <QPen>
+#include <QPolygonF>
+#include <QString>
+
+// 不经过 QGraphicsScene 直接用 QPainter 画出芯片，只依赖 Qt6::Gui (与 Qt6::Svg)
+// 可以在工作线程中画到 QImage 或 QSvgGenerator 上，用于命令行的批量出图；
+// 配色、热力颜色与总线车道的几何也由界面中的图元共用
+class ChipPainter
+{
+public:
+    struct ComponentStyle {
+        QColor border;
+        QColor fill;
+        QColor text;
+        int fontSize = 11;
+        double shadowOffset = 2;
+    };
+
+    // 总线节点的主体与编号，界面中的光晕、外环等装饰不在其中
+    struct BusNodeStyle {
+        QColor border;
+        QColor fill;
+        QColor text;
+        double borderWidth = 2;
+        double radius = 8;
+        int fontSize = 8;
+    };
+
+    // 双向边每个方向偏离中线的距离，界面与出图相同
+    static constexpr double kLaneOffset = 3.5;
+
+    static ComponentStyle componentStyle(LayoutComponent::Kind kind);
+    static BusNodeStyle busNodeStyle();
+
+    // 连线的画笔；memoryPort 表示 PortLink 连接的是内存节点
+    static QPen linkPen(LayoutLink::Kind kind, bool memoryPort);
+
+    // 归一化值 (0-1) 对应的颜色，蓝 -> 黄 -> 橙 -> 红
+    static QColor heatColor(double t);
+
+    // 各有向总线边的折线 (发送节点, 接收节点) -> 折线，双向边的两个方向各向行进方向右侧偏移
+    static QHash<QPair<int, int>, QPolygonF> edgeLanes(const ChipLayout& layout);
+
+    // 以场景坐标画出整个芯片；values 不为空时按利用率给总线边与节点着色
+    static void paint(QPainter& painter, const ChipLayout& layout, const BusUtilization::Values* values = nullptr,
+                      bool labels = true);
+
+    // 整个芯片按 scale (每个场景单位的像素数) 画到图像上，title 写在左上角；图像边长不超过 maxSide
+    static QImage renderImage(const ChipLayout& layout, const BusUtilization::Values* values, double scale,
+                              const QString& title = QString(), int maxSide = 16384);
+    static bool renderSvg(const QString& path, const ChipLayout& layout, const BusUtilization::Values* values,
+                          const QString& title = QString());
+
+private:
+    static QPolygonF offsetPolyline(const QVector<QPointF>& points, double offset);
+    // 芯片范围加上边距与顶部 titleHeight (场景单位) 的标题留白
+    static QRectF pageRect(const ChipLayout& layout, double titleHeight);
+    static void paintTitle(QPainter& painter, const QRectF& page, const QString& title, double pixelSize);
+};
+
+#endif // CHIPPAINTER_H
@@ -2,11 +2,19 @@
 #define CHIPRENDERER_H
 
 #include "../components/ClickableItems.h"
+#include "ChipItems.h"
+#include "ChipLayout.h"
+#include "PacketFlow.h"
+#include "UtilizationOverlay.h"
 #include <QGraphicsScene>
 #include <QPen>
 #include <QBrush>
 #include <QFont>
 #include <QObject>
+#include <QMap>
+#include <QList>
+#include <QSet>
+#include <QVector>
 
 class ChipRenderer : public QObject
 {
@@ -15,23 +23,43 @@ class ChipRenderer : public QObject
 public:
     ChipRenderer(QGraphicsScene* scene, QObject* parent = nullptr);
     
-    // 绘制芯片架构的主方法
-    void drawChipArchitecture();
+    // 按布局结果创建图元，替换场景中原有的内容；布局为空时显示提示文字
+    // 布局计算较慢，应在后台完成，这里只在界面线程创建图元
+    void drawChipArchitecture(const ChipLayout& layout);
+    
+    // 用彩色外框高亮组件 (组件名 -> 颜色)，tooltips 为可选的说明文字
+    void highlightComponents(const QMap<QString, QColor>& highlights,
+                             const QMap<QString, QString>& tooltips = QMap<QString, QString>());
+    void clearHighlights();
+    
+    // 组件主体在场景中的范围，未绘制的组件返回空矩形
+    QRectF componentRect(const QString& componentId) const;
+    
+    // 按视图的缩放比例 (每个场景单位的像素数) 切换细节程度:
+    // 缩小到一定程度以下时每个网格单元只画一个概览图形；阴影与文字由各图元在绘制时自行省略
+    void setLevelOfDetail(double scale);
+    
+    // 总线利用率热力叠加层，重新绘制芯片后需要再次设置
+    void showUtilization(const BusUtilization::Values& values);
+    void hideUtilization();
+    
+    // 沿总线边流动的光点，values 为最近一个采样间隔内各边的包数 (BusUtilization::Traffic)
+    void showPacketFlow(const BusUtilization::Values& values);
+    void hidePacketFlow();
+    PacketFlowAnimator* packetFlow() const { return flowAnimator; }
 
 private:
     QGraphicsScene* scene;
+    QMap<QString, ClickableRectItem*> componentItems;  // 组件名 -> 可点击的主体
+    QList<QGraphicsItem*> highlightItems;
+    UtilizationOverlay* utilizationOverlay;            // 属于场景，scene->clear() 时一并删除
+    QVector<ClusterDetailItem*> clusterDetails;        // 按 LayoutCluster 下标
+    QVector<ClusterItem*> clusterGlyphs;
+    bool collapsed;                                    // 当前显示的是网格单元概览
+    PacketFlowAnimator* flowAnimator;                  // 只持有图元指针，重新绘制前清空
     
-    // 绘制各类组件的方法
-    ClickableRectItem* drawCPU(double x, double y, const QString& name, const QString& componentId);
-    ClickableRectItem* drawL2Cache(double x, double y, const QString& name, const QString& componentId);
-    ClickableRectItem* drawL3Cache(double x, double y, const QString& name, const QString& componentId);
-    ClickableRectItem* drawDDR(double x, double y, const QString& componentId);
-    ClickableEllipseItem* drawBusNode(double x, double y, int nodeId);
-    
-    // 绘制连接线的方法
-    void drawThickLine(double x1, double y1, double x2, double y2);
-    void drawNormalLine(double x1, double y1, double x2, double y2);
-    void drawBusLine(double x1, double y1, double x2, double y2);
+    // 绘制连接线的方法 (一条折线一个图元)，memoryPorts 上的端口连线用红色
+    void drawLink(const LayoutLink& link, const QSet<int>& memoryPorts, QGraphicsItem* parent);
 };
 
 #endif // CHIPRENDERER_H 
\ No newline at end of file
@@ -0,0 +1,640 @@
+#include "GraphLayout.h"
+#include "../concurrency/WorkStealingPool.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace {
+
+// 力导向布局参数 (Hu, "Efficient and high quality force-directed graph drawing")
+const double kSpringLength = 1.0;       // K
+const double kRepulsion = 0.2;          // C
+const double kTheta = 1.2;              // Barnes-Hut 张角阈值
+const double kCooling = 0.9;            // 自适应步长的缩放系数
+const double kTolerance = 0.01;         // 最大位移小于 K 的这一比例时停止
+const double kGravity = 0.01;           // 指向重心的常量拉力，防止不连通的部分无限远离
+const int kMaxIterations = 300;          // 最粗一层
+const int kRefineIterations = 30;        // 展开后的每一层
+const int kCoarsestSize = 50;
+const double kMinCoarsening = 0.8;       // 一轮合并后节点数仍超过这一比例时停止粗化
+const int kMaxTreeDepth = 32;
+const int kForceGrain = 128;
+const double kGridSlack = 1.3;          // 吸附时网格单元数与节点数之比
+const double kRingAspectSlack = 2.0;    // 环排满偶数行时，列数与理想列数之比允许的偏差
+
+// 平面四叉树，节点存放在一个数组中，孩子连续存放
+struct QuadCell {
+    double x = 0;           // 左上角
+    double y = 0;
+    double size = 0;
+    double mass = 0;
+    double massX = 0;       // 质量加权坐标之和
+    double massY = 0;
+    int child = -1;         // 第一个孩子的下标，-1 表示叶子
+    int body = -1;
+};
+
+class QuadTree
+{
+public:
+    QuadTree(const std::vector<double>& xs, const std::vector<double>& ys)
+        : xs(xs), ys(ys)
+    {
+        double minX = *std::min_element(xs.begin(), xs.end());
+        double maxX = *std::max_element(xs.begin(), xs.end());
+        double minY = *std::min_element(ys.begin(), ys.end());
+        double maxY = *std::max_element(ys.begin(), ys.end());
+        QuadCell root;
+        root.x = minX;
+        root.y = minY;
+        root.size = std::max(std::max(maxX - minX, maxY - minY), 1e-9) * 1.0001;
+        cells.reserve(xs.size() * 2 + 1);
+        cells.push_back(root);
+        for (int i = 0; i < static_cast<int>(xs.size()); ++i) insert(i);
+    }
+
+    // 节点 i 受到的斥力
+    void repulsion(int i, double& forceX, double& forceY) const
+    {
+        const double x = xs[i];
+        const double y = ys[i];
+        int stack[4 * kMaxTreeDepth + 4];
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            const QuadCell& cell = cells[stack[--top]];
+            if (cell.mass == 0) continue;
+            double mass = cell.mass;
+            double centerX = cell.massX / mass;
+            double centerY = cell.massY / mass;
+            if (cell.child < 0 && cell.body == i) {
+                // 与自身重合的其它节点 (树的最深层) 才计入
+                mass -= 1;
+                if (mass <= 0) continue;
+            }
+            double dx = x - centerX;
+            double dy = y - centerY;
+            double distance2 = dx * dx + dy * dy;
+            if (cell.child < 0 || cell.size * cell.size < kTheta * kTheta * distance2) {
+                if (distance2 < 1e-12) {
+                    // 重合的点沿由下标决定的方向推开
+                    dx = std::cos(i * 2.399963);
+                    dy = std::sin(i * 2.399963);
+                    distance2 = 1e-4;
+                }
+                double scale = kRepulsion * kSpringLength * kSpringLength * mass / distance2;
+                forceX += dx * scale;
+                forceY += dy * scale;
+            } else {
+                for (int k = 0; k < 4; ++k) stack[top++] = cell.child + k;
+            }
+        }
+    }
+
+private:
+    int quadrant(const QuadCell& cell, int body) const
+    {
+        double half = cell.size / 2;
+        return (xs[body] >= cell.x + half ? 1 : 0) + (ys[body] >= cell.y + half ? 2 : 0);
+    }
+
+    void accumulate(QuadCell& cell, int body)
+    {
+        cell.mass += 1;
+        cell.massX += xs[body];
+        cell.massY += ys[body];
+    }
+
+    void insert(int body)
+    {
+        int index = 0;
+        for (int depth = 0;; ++depth) {
+            if (cells[index].child < 0) {
+                if (cells[index].mass == 0) {
+                    cells[index].body = body;
+                    accumulate(cells[index], body);
+                    return;
+                }
+                if (depth >= kMaxTreeDepth) {
+                    accumulate(cells[index], body);
+                    return;
+                }
+                // 分裂叶子，原有的节点下移到对应的孩子
+                int first = static_cast<int>(cells.size());
+                double half = cells[index].size / 2;
+                for (int k = 0; k < 4; ++k) {
+                    QuadCell child;
+                    child.x = cells[index].x + (k & 1 ? half : 0);
+                    child.y = cells[index].y + (k & 2 ? half : 0);
+                    child.size = half;
+                    cells.push_back(child);
+                }
+                QuadCell& cell = cells[index];
+                cell.child = first;
+                QuadCell& moved = cells[first + quadrant(cell, cell.body)];
+                moved.body = cell.body;
+                moved.mass = cell.mass;
+                moved.massX = cell.massX;
+                moved.massY = cell.massY;
+                cell.body = -1;
+            }
+            accumulate(cells[index], body);
+            index = cells[index].child + quadrant(cells[index], body);
+        }
+    }
+
+    const std::vector<double>& xs;
+    const std::vector<double>& ys;
+    std::vector<QuadCell> cells;
+};
+
+bool adjacent(const std::vector<std::vector<int>>& adjacency, int a, int b)
+{
+    const std::vector<int>& neighbours = adjacency[a];
+    return std::find(neighbours.begin(), neighbours.end(), b) != neighbours.end();
+}
+
+}
+
+const char* GraphLayout::kindName(Kind kind)
+{
+    switch (kind) {
+    case Empty: return "empty";
+    case Grid: return "grid";
+    case Line: return "line";
+    case Ring: return "ring";
+    case Mesh: return "mesh";
+    case ForceDirected: return "force-directed";
+    }
+    return "";
+}
+
+GraphLayout::Result GraphLayout::compute(int nodeCount, const std::vector<std::pair<int, int>>& edges,
+                                         double cellAspect, int singleRowLimit)
+{
+    Result result;
+    if (nodeCount <= 0) return result;
+
+    // 去掉重复边与自环
+    std::vector<std::pair<int, int>> unique;
+    unique.reserve(edges.size());
+    for (const auto& edge : edges) {
+        if (edge.first == edge.second) continue;
+        if (edge.first < 0 || edge.second < 0 || edge.first >= nodeCount || edge.second >= nodeCount) continue;
+        unique.emplace_back(std::min(edge.first, edge.second), std::max(edge.first, edge.second));
+    }
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+
+    Adjacency adjacency(nodeCount);
+    for (const auto& edge : unique) {
+        adjacency[edge.first].push_back(edge.second);
+        adjacency[edge.second].push_back(edge.first);
+    }
+
+    if (unique.empty()) {
+        std::vector<int> order(nodeCount);
+        for (int i = 0; i < nodeCount; ++i) order[i] = i;
+        serpentine(order, false, cellAspect, singleRowLimit, result);
+        // 没有边时不需要蛇形，按编号从左到右
+        for (int i = 0; i < nodeCount; ++i) result.column[i] = i % result.columns;
+        result.kind = Grid;
+        return result;
+    }
+
+    // 连通的图才识别规则结构
+    std::vector<char> seen(nodeCount, 0);
+    std::vector<int> queue{0};
+    seen[0] = 1;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        for (int next : adjacency[queue[head]]) {
+            if (!seen[next]) {
+                seen[next] = 1;
+                queue.push_back(next);
+            }
+        }
+    }
+    bool connected = static_cast<int>(queue.size()) == nodeCount;
+
+    if (connected) {
+        std::vector<int> order;
+        bool closed = false;
+        if (ringOrder(adjacency, order, closed)) {
+            serpentine(order, closed, cellAspect, singleRowLimit, result);
+            result.kind = closed ? Ring : Line;
+            return result;
+        }
+
+        std::vector<std::vector<int>> grid;
+        if (meshOrder(adjacency, grid)) {
+            int gridRows = static_cast<int>(grid.size());
+            int gridColumns = static_cast<int>(grid[0].size());
+            // 选择更接近正方形的方向
+            bool transpose = std::abs(gridColumns * cellAspect - gridRows) < std::abs(gridRows * cellAspect - gridColumns);
+            result.kind = Mesh;
+            result.rows = transpose ? gridColumns : gridRows;
+            result.columns = transpose ? gridRows : gridColumns;
+            result.row.assign(nodeCount, 0);
+            result.column.assign(nodeCount, 0);
+            for (int r = 0; r < gridRows; ++r) {
+                for (int c = 0; c < gridColumns; ++c) {
+                    result.row[grid[r][c]] = transpose ? c : r;
+                    result.column[grid[r][c]] = transpose ? r : c;
+                }
+            }
+            return result;
+        }
+    }
+
+    std::vector<std::pair<double, double>> positions = forceDirected(adjacency);
+    snapToGrid(positions, adjacency, cellAspect, result);
+    result.kind = ForceDirected;
+    return result;
+}
+
+bool GraphLayout::ringOrder(const Adjacency& adjacency, std::vector<int>& order, bool& closed)
+{
+    const int count = static_cast<int>(adjacency.size());
+    int start = 0;
+    int ends = 0;
+    for (int i = 0; i < count; ++i) {
+        int degree = static_cast<int>(adjacency[i].size());
+        if (degree > 2) return false;
+        if (degree == 1) {
+            if (ends == 0) start = i;
+            ends++;
+        }
+    }
+    if (ends != 0 && ends != 2) return false;
+    closed = ends == 0;
+
+    // 从端点 (链) 或 0 号节点 (环) 出发沿边走一遍
+    order.clear();
+    order.reserve(count);
+    int previous = -1;
+    int current = start;
+    while (static_cast<int>(order.size()) < count) {
+        order.push_back(current);
+        int next = -1;
+        for (int neighbour : adjacency[current]) {
+            if (neighbour != previous) {
+                next = neighbour;
+                break;
+            }
+        }
+        if (next < 0 || next == start) break;
+        previous = current;
+        current = next;
+    }
+    return static_cast<int>(order.size()) == count;
+}
+
+bool GraphLayout::meshOrder(const Adjacency& adjacency, std::vector<std::vector<int>>& grid)
+{
+    // 二维网格: 恰好 4 个度为 2 的角，其余节点度为 3 (边) 或 4 (内部)
+    const int count = static_cast<int>(adjacency.size());
+    if (count < 4) return false;
+    int corner = -1;
+    int corners = 0;
+    for (int i = 0; i < count; ++i) {
+        int degree = static_cast<int>(adjacency[i].size());
+        if (degree < 2 || degree > 4) return false;
+        if (degree == 2) {
+            if (corner < 0) corner = i;
+            corners++;
+        }
+    }
+    if (corners != 4) return false;
+
+    // 从一个角出发: 一个邻居确定第 0 行的方向，另一个是第 1 行的开头。
+    // 第 1 行的第 j 个节点是第 0 行第 j 个与第 1 行第 j-1 个的公共邻居 (不是第 0 行第 j-1 个)
+    std::vector<int> top{corner, adjacency[corner][0]};
+    std::vector<int> second{adjacency[corner][1]};
+    for (int j = 1;; ++j) {
+        int below = -1;
+        for (int candidate : adjacency[top[j]]) {
+            if (candidate != top[j - 1] && adjacent(adjacency, candidate, second[j - 1])) {
+                below = candidate;
+                break;
+            }
+        }
+        if (below < 0) return false;
+        second.push_back(below);
+
+        std::vector<int> next;
+        for (int candidate : adjacency[top[j]]) {
+            if (candidate != top[j - 1] && candidate != below) next.push_back(candidate);
+        }
+        if (next.empty()) break;
+        if (next.size() != 1) return false;
+        top.push_back(next[0]);
+    }
+    const int columns = static_cast<int>(top.size());
+    if (count % columns != 0) return false;
+
+    grid.clear();
+    grid.push_back(top);
+    grid.push_back(second);
+    while (static_cast<int>(grid.size()) * columns < count) {
+        const std::vector<int>& previous = grid[grid.size() - 2];
+        const std::vector<int>& last = grid.back();
+        std::vector<int> row(columns, -1);
+        for (int j = 0; j < columns; ++j) {
+            for (int candidate : adjacency[last[j]]) {
+                if (candidate == previous[j]) continue;
+                if (j > 0 && candidate == last[j - 1]) continue;
+                if (j + 1 < columns && candidate == last[j + 1]) continue;
+                if (row[j] >= 0) return false;
+                row[j] = candidate;
+            }
+            if (row[j] < 0) return false;
+        }
+        grid.push_back(row);
+    }
+
+    // 校验: 每个节点出现一次，所有边都连接网格上相邻的位置
+    const int rows = static_cast<int>(grid.size());
+    if (rows * columns != count) return false;
+    std::vector<int> rowOf(count, -1), columnOf(count, -1);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < columns; ++c) {
+            int node = grid[r][c];
+            if (rowOf[node] >= 0) return false;
+            rowOf[node] = r;
+            columnOf[node] = c;
+        }
+    }
+    int edgeCount = 0;
+    for (int i = 0; i < count; ++i) {
+        for (int neighbour : adjacency[i]) {
+            if (std::abs(rowOf[i] - rowOf[neighbour]) + std::abs(columnOf[i] - columnOf[neighbour]) != 1) return false;
+            edgeCount++;
+        }
+    }
+    return edgeCount / 2 == rows * (columns - 1) + columns * (rows - 1);
+}
+
+void GraphLayout::serpentine(const std::vector<int>& order, bool closed, double cellAspect, int singleRowLimit,
+                             Result& result)
+{
+    // 蛇形: 偶数行从左到右，奇数行从右到左，相邻节点总是同行相邻或上下相邻。
+    // 环的节点数能分解为偶数行且排满、列数与理想列数相差不到 kRingAspectSlack 倍时按这样排列，
+    // 最后一个节点回到第 0 列，闭合边沿左侧通道直上；否则 (例如奇数个节点，网格上不可能首尾相邻)
+    // 与链相同排列，闭合边经通道绕行
+    const int count = static_cast<int>(order.size());
+    int columns = count;
+    if (count > singleRowLimit) {
+        double ideal = std::sqrt(count * cellAspect);
+        columns = std::max(1, static_cast<int>(std::ceil(ideal)));
+        if (closed) {
+            double best = std::log(kRingAspectSlack);
+            for (int rows = 2; rows <= count; rows += 2) {
+                if (count % rows != 0) continue;
+                double distance = std::abs(std::log(count / rows / ideal));
+                if (distance <= best) {
+                    best = distance;
+                    columns = count / rows;
+                }
+            }
+        }
+    }
+    result.columns = columns;
+    result.rows = (count + columns - 1) / columns;
+    result.row.assign(count, 0);
+    result.column.assign(count, 0);
+    for (int i = 0; i < count; ++i) {
+        int r = i / columns;
+        int c = i % columns;
+        result.row[order[i]] = r;
+        result.column[order[i]] = r % 2 == 0 ? c : columns - 1 - c;
+    }
+}
+
+std::vector<std::pair<double, double>> GraphLayout::forceDirected(const Adjacency& adjacency)
+{
+    // 多层: 反复用极大匹配合并相邻节点得到粗图，先布局最粗的图，再逐层展开并细化。
+    // 大图在细层只需少量迭代，整体布局也不容易陷入扭曲的局部最优
+    std::vector<Adjacency> graphs{adjacency};
+    std::vector<std::vector<int>> parents;
+    while (static_cast<int>(graphs.back().size()) > kCoarsestSize) {
+        const Adjacency& fine = graphs.back();
+        const int count = static_cast<int>(fine.size());
+        std::vector<int> order(count);
+        for (int i = 0; i < count; ++i) order[i] = i;
+        std::stable_sort(order.begin(), order.end(), [&fine](int a, int b) { return fine[a].size() < fine[b].size(); });
+
+        // 优先与度小的邻居合并，避免枢纽节点吞掉大片区域
+        std::vector<int> parent(count, -1);
+        int coarseCount = 0;
+        for (int node : order) {
+            if (parent[node] >= 0) continue;
+            int partner = -1;
+            for (int neighbour : fine[node]) {
+                if (parent[neighbour] < 0 && (partner < 0 || fine[neighbour].size() < fine[partner].size())) {
+                    partner = neighbour;
+                }
+            }
+            parent[node] = coarseCount;
+            if (partner >= 0) parent[partner] = coarseCount;
+            coarseCount++;
+        }
+        if (coarseCount > count * kMinCoarsening) break;
+
+        Adjacency coarse(coarseCount);
+        for (int i = 0; i < count; ++i) {
+            for (int neighbour : fine[i]) {
+                if (parent[i] != parent[neighbour]) coarse[parent[i]].push_back(parent[neighbour]);
+            }
+        }
+        for (std::vector<int>& neighbours : coarse) {
+            std::sort(neighbours.begin(), neighbours.end());
+            neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        }
+        parents.push_back(parent);
+        graphs.push_back(coarse);
+    }
+
+    std::mt19937 random(12345);
+    const int coarsest = static_cast<int>(graphs.back().size());
+    std::uniform_real_distribution<double> uniform(0.0, std::sqrt(static_cast<double>(coarsest)) * kSpringLength);
+    std::vector<double> xs(coarsest), ys(coarsest);
+    for (int i = 0; i < coarsest; ++i) {
+        xs[i] = uniform(random);
+        ys[i] = uniform(random);
+    }
+    relax(graphs.back(), xs, ys, kSpringLength * std::max(1.0, std::sqrt(static_cast<double>(coarsest)) / 10),
+          kMaxIterations);
+
+    // 逐层展开: 细图节点从父节点位置出发 (加少许扰动分开合并的两点)，按节点数放大坐标保持密度
+    std::uniform_real_distribution<double> jitter(-0.1 * kSpringLength, 0.1 * kSpringLength);
+    for (int level = static_cast<int>(parents.size()) - 1; level >= 0; --level) {
+        if (WorkStealingPool::isCancelled()) break;
+        const std::vector<int>& parent = parents[level];
+        const int count = static_cast<int>(parent.size());
+        double scale = std::sqrt(static_cast<double>(count) / graphs[level + 1].size());
+        std::vector<double> fineXs(count), fineYs(count);
+        for (int i = 0; i < count; ++i) {
+            fineXs[i] = xs[parent[i]] * scale + jitter(random);
+            fineYs[i] = ys[parent[i]] * scale + jitter(random);
+        }
+        xs.swap(fineXs);
+        ys.swap(fineYs);
+        relax(graphs[level], xs, ys, kSpringLength, kRefineIterations);
+    }
+
+    const int count = static_cast<int>(adjacency.size());
+    std::vector<std::pair<double, double>> positions(count);
+    for (int i = 0; i < count; ++i) positions[i] = std::make_pair(xs[i], ys[i]);
+    return positions;
+}
+
+void GraphLayout::relax(const Adjacency& adjacency, std::vector<double>& xs, std::vector<double>& ys,
+                        double step, int maxIterations)
+{
+    const int count = static_cast<int>(adjacency.size());
+    std::vector<double> nextXs(count), nextYs(count), energies(count);
+    double previousEnergy = std::numeric_limits<double>::max();
+    int progress = 0;
+
+    for (int iteration = 0; iteration < maxIterations; ++iteration) {
+        if (WorkStealingPool::isCancelled()) break;
+
+        double centerX = 0, centerY = 0;
+        for (int i = 0; i < count; ++i) {
+            centerX += xs[i];
+            centerY += ys[i];
+        }
+        centerX /= count;
+        centerY /= count;
+
+        // 四叉树串行构建，各节点的受力并行计算
+        QuadTree tree(xs, ys);
+        WorkStealingPool::instance().parallelFor(count, [&](int i) {
+            double forceX = 0, forceY = 0;
+            tree.repulsion(i, forceX, forceY);
+            for (int neighbour : adjacency[i]) {
+                double dx = xs[i] - xs[neighbour];
+                double dy = ys[i] - ys[neighbour];
+                double distance = std::sqrt(dx * dx + dy * dy);
+                forceX -= dx * distance / kSpringLength;
+                forceY -= dy * distance / kSpringLength;
+            }
+            double toCenterX = centerX - xs[i];
+            double toCenterY = centerY - ys[i];
+            double centerDistance = std::sqrt(toCenterX * toCenterX + toCenterY * toCenterY);
+            if (centerDistance > 1e-9) {
+                forceX += kGravity * toCenterX / centerDistance;
+                forceY += kGravity * toCenterY / centerDistance;
+            }
+
+            double magnitude = std::sqrt(forceX * forceX + forceY * forceY);
+            energies[i] = magnitude * magnitude;
+            nextXs[i] = xs[i];
+            nextYs[i] = ys[i];
+            if (magnitude > 1e-12) {
+                nextXs[i] += step * forceX / magnitude;
+                nextYs[i] += step * forceY / magnitude;
+            }
+        }, kForceGrain);
+        xs.swap(nextXs);
+        ys.swap(nextYs);
+
+        // 自适应步长: 能量连续下降时放大，否则缩小；步长足够小时停止
+        double energy = 0;
+        for (int i = 0; i < count; ++i) energy += energies[i];
+        if (energy < previousEnergy) {
+            if (++progress >= 5) {
+                progress = 0;
+                step /= kCooling;
+            }
+        } else {
+            progress = 0;
+            step *= kCooling;
+        }
+        previousEnergy = energy;
+        if (step < kTolerance * kSpringLength) break;
+    }
+}
+
+void GraphLayout::snapToGrid(const std::vector<std::pair<double, double>>& positions, const Adjacency& adjacency,
+                             double cellAspect, Result& result)
+{
+    // 网格比节点数略多，位置按比例映射到网格，度大的节点优先选择最近的空闲单元
+    const int count = static_cast<int>(positions.size());
+    int columns = std::max(1, static_cast<int>(std::ceil(std::sqrt(count * kGridSlack * cellAspect))));
+    int rows = std::max(1, static_cast<int>(std::ceil(count * kGridSlack / columns)));
+
+    double minX = std::numeric_limits<double>::max(), maxX = -minX;
+    double minY = minX, maxY = -minX;
+    for (const auto& position : positions) {
+        minX = std::min(minX, position.first);
+        maxX = std::max(maxX, position.first);
+        minY = std::min(minY, position.second);
+        maxY = std::max(maxY, position.second);
+    }
+    double scaleX = maxX > minX ? (columns - 1) / (maxX - minX) : 0;
+    double scaleY = maxY > minY ? (rows - 1) / (maxY - minY) : 0;
+
+    std::vector<int> order(count);
+    for (int i = 0; i < count; ++i) order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&adjacency](int a, int b) {
+        return adjacency[a].size() > adjacency[b].size();
+    });
+
+    std::vector<char> occupied(static_cast<size_t>(rows) * columns, 0);
+    result.row.assign(count, 0);
+    result.column.assign(count, 0);
+    for (int node : order) {
+        double targetColumn = (positions[node].first - minX) * scaleX;
+        double targetRow = (positions[node].second - minY) * scaleY;
+        int baseColumn = static_cast<int>(std::lround(targetColumn));
+        int baseRow = static_cast<int>(std::lround(targetRow));
+
+        // 按切比雪夫距离逐圈向外找空闲单元，同一圈中取欧氏距离最近的
+        for (int radius = 0; radius <= rows + columns; ++radius) {
+            int bestRow = -1, bestColumn = -1;
+            double bestDistance = std::numeric_limits<double>::max();
+            for (int dr = -radius; dr <= radius; ++dr) {
+                int r = baseRow + dr;
+                if (r < 0 || r >= rows) continue;
+                int stride = std::abs(dr) == radius ? 1 : 2 * radius;
+                for (int dc = -radius; dc <= radius; dc += std::max(1, stride)) {
+                    int c = baseColumn + dc;
+                    if (c < 0 || c >= columns || occupied[static_cast<size_t>(r) * columns + c]) continue;
+                    double distance = (r - targetRow) * (r - targetRow) + (c - targetColumn) * (c - targetColumn);
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        bestRow = r;
+                        bestColumn = c;
+                    }
+                }
+            }
+            if (bestRow >= 0) {
+                occupied[static_cast<size_t>(bestRow) * columns + bestColumn] = 1;
+                result.row[node] = bestRow;
+                result.column[node] = bestColumn;
+                break;
+            }
+        }
+    }
+
+    // 去掉空行空列
+    std::vector<int> rowIndex(rows, -1), columnIndex(columns, -1);
+    for (int i = 0; i < count; ++i) {
+        rowIndex[result.row[i]] = 0;
+        columnIndex[result.column[i]] = 0;
+    }
+    result.rows = 0;
+    for (int r = 0; r < rows; ++r) {
+        if (rowIndex[r] >= 0) rowIndex[r] = result.rows++;
+    }
+    result.columns = 0;
+    for (int c = 0; c < columns; ++c) {
+        if (columnIndex[c] >= 0) columnIndex[c] = result.columns++;
+    }
+    for (int i = 0; i < count; ++i) {
+        result.row[i] = rowIndex[result.row[i]];
+        result.column[i] = columnIndex[result.column[i]];
+    }
+}
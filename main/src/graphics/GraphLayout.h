@@ -0,0 +1,55 @@
+#ifndef GRAPHLAYOUT_H
+#define GRAPHLAYOUT_H
+
+#include <utility>
+#include <vector>
+
+// 总线拓扑的自动布局: 把图的节点放到网格单元上，单元之间留出走线通道
+// 先识别规则结构并给出规则排布:
+//   环 (每个节点度为 2 且连通) 与链按蛇形逐行排列，相邻节点总在同一行相邻或上下相邻；
+//   环的节点数能分解为偶数行时排满，闭合边也连接上下对齐的首尾两个节点，否则闭合边经通道绕行；
+//   二维网格 (mesh) 按行列原样排列。
+// 其它图用多层力导向布局 (弹簧-电荷模型，斥力用 Barnes-Hut 四叉树近似，各节点受力在线程池上并行计算)，
+// 再按位置吸附到最近的空闲单元并去掉空行空列
+class GraphLayout
+{
+public:
+    enum Kind {
+        Empty,
+        Grid,               // 没有边，按编号逐行排列
+        Line,
+        Ring,
+        Mesh,
+        ForceDirected
+    };
+
+    struct Result {
+        Kind kind = Empty;
+        std::vector<int> row;           // 按节点下标
+        std::vector<int> column;
+        int rows = 0;
+        int columns = 0;
+    };
+
+    // edges 为无向边 (节点下标，重复与自环会被忽略)
+    // cellAspect 为单元 (含通道) 的高宽比，用于选择列数使整体接近正方形；节点数不超过 singleRowLimit 时排成一行
+    static Result compute(int nodeCount, const std::vector<std::pair<int, int>>& edges,
+                          double cellAspect = 1.0, int singleRowLimit = 8);
+
+    static const char* kindName(Kind kind);
+
+private:
+    using Adjacency = std::vector<std::vector<int>>;
+
+    static bool ringOrder(const Adjacency& adjacency, std::vector<int>& order, bool& closed);
+    static bool meshOrder(const Adjacency& adjacency, std::vector<std::vector<int>>& grid);
+    static void serpentine(const std::vector<int>& order, bool closed, double cellAspect, int singleRowLimit,
+                           Result& result);
+    static std::vector<std::pair<double, double>> forceDirected(const Adjacency& adjacency);
+    static void relax(const Adjacency& adjacency, std::vector<double>& xs, std::vector<double>& ys,
+                      double step, int maxIterations);
+    static void snapToGrid(const std::vector<std::pair<double, double>>& positions, const Adjacency& adjacency,
+                           double cellAspect, Result& result);
+};
+
+#endif // GRAPHLAYOUT_H
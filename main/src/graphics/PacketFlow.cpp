@@ -0,0 +1,240 @@
+#include "PacketFlow.h"
+#include "ChipPainter.h"
+#include <QDebug>
+#include <QGraphicsView>
+#include <QLineF>
+#include <QPainter>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double kDotSpacing = 48;          // 相邻光点的间距 (场景单位)
+const double kDotRadius = 2.5;
+const double kDotGrowth = 2.5;          // 满流量时半径增加的量
+const double kMinSpeed = 20;            // 场景单位每秒
+const double kMaxSpeed = 240;
+const double kRateEpsilon = 0.01;       // 小于这个变化不重绘
+const double kMaxStep = 0.5;            // 长时间未推进 (不可见、被分组跳过) 后一次最多前进的秒数
+
+const int kFrameIntervalMs = 33;        // 30 fps
+const qint64 kFrameBudgetNs = 8000000;  // 每帧推进加绘制的预算
+const int kMaxStride = 8;
+const int kFramesBeforeDecimating = 3;
+const int kFramesBeforeRecovering = 60;
+
+}
+
+// ==================== PacketFlowItem ====================
+
+PacketFlowItem::PacketFlowItem(const QPolygonF& lane, QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+    , lane(lane)
+    , totalLength(0)
+    , currentRate(0)
+    , phase(0)
+    , lastAdvance(-1)
+{
+    lengths.append(0);
+    for (int i = 1; i < lane.size(); ++i) {
+        totalLength += QLineF(lane[i - 1], lane[i]).length();
+        lengths.append(totalLength);
+    }
+    double margin = kDotRadius + kDotGrowth + 1;
+    bounds = lane.boundingRect().adjusted(-margin, -margin, margin, margin);
+
+    setAcceptedMouseButtons(Qt::NoButton);
+    setZValue(0.75);
+    hide();
+}
+
+bool PacketFlowItem::setRate(double rate)
+{
+    rate = qBound(0.0, rate, 1.0);
+    bool appearing = currentRate <= 0 && rate > 0;
+    bool disappearing = currentRate > 0 && rate <= 0;
+    if (!appearing && !disappearing && qAbs(rate - currentRate) < kRateEpsilon) return false;
+
+    currentRate = rate;
+    if (disappearing) {
+        hide();
+        lastAdvance = -1;
+        return true;
+    }
+    placeDots();
+    if (appearing) show();
+    update();
+    return true;
+}
+
+void PacketFlowItem::advance(double now)
+{
+    if (currentRate <= 0 || totalLength <= 0) return;
+    if (lastAdvance < 0) {
+        lastAdvance = now;
+        return;
+    }
+    double seconds = qMin(now - lastAdvance, kMaxStep);
+    lastAdvance = now;
+    double speed = kMinSpeed + (kMaxSpeed - kMinSpeed) * currentRate;
+    phase = std::fmod(phase + speed * seconds, kDotSpacing);
+
+    // 只重绘光点移动前后的位置
+    for (const QPointF& dot : dots) update(dotRect(dot));
+    placeDots();
+    for (const QPointF& dot : dots) update(dotRect(dot));
+}
+
+QPointF PacketFlowItem::pointAt(double distance) const
+{
+    int segment = static_cast<int>(std::upper_bound(lengths.begin(), lengths.end(), distance) - lengths.begin());
+    segment = qBound(1, segment, static_cast<int>(lane.size()) - 1);
+    double length = lengths[segment] - lengths[segment - 1];
+    double t = length > 0 ? (distance - lengths[segment - 1]) / length : 0;
+    return lane[segment - 1] + (lane[segment] - lane[segment - 1]) * t;
+}
+
+void PacketFlowItem::placeDots()
+{
+    dots.clear();
+    for (double distance = phase; distance <= totalLength; distance += kDotSpacing) {
+        dots.append(pointAt(distance));
+    }
+}
+
+QRectF PacketFlowItem::dotRect(const QPointF& center) const
+{
+    double radius = kDotRadius + kDotGrowth * currentRate + 1;
+    return QRectF(center.x() - radius, center.y() - radius, 2 * radius, 2 * radius);
+}
+
+QRectF PacketFlowItem::boundingRect() const
+{
+    return bounds;
+}
+
+void PacketFlowItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    double radius = kDotRadius + kDotGrowth * currentRate;
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(ChipPainter::heatColor(currentRate));
+    for (const QPointF& dot : dots) {
+        painter->drawEllipse(dot, radius, radius);
+    }
+}
+
+// ==================== PacketFlowAnimator ====================
+
+PacketFlowAnimator::PacketFlowAnimator(QGraphicsScene* scene, QObject* parent)
+    : QObject(parent)
+    , scene(scene)
+    , timer(new QTimer(this))
+    , frame(0)
+    , currentStride(1)
+    , overBudgetFrames(0)
+    , underBudgetFrames(0)
+    , lastPaintNs(0)
+{
+    timer->setInterval(kFrameIntervalMs);
+    connect(timer, &QTimer::timeout, this, &PacketFlowAnimator::tick);
+    clock.start();
+}
+
+void PacketFlowAnimator::setItems(const QHash<QPair<int, int>, PacketFlowItem*>& items)
+{
+    clear();
+    flowItems = items;
+}
+
+void PacketFlowAnimator::clear()
+{
+    timer->stop();
+    flowItems.clear();
+    activeItems.clear();
+    currentStride = 1;
+    overBudgetFrames = 0;
+    underBudgetFrames = 0;
+}
+
+void PacketFlowAnimator::setRates(const BusUtilization::Values& values)
+{
+    activeItems.clear();
+    for (auto it = flowItems.begin(); it != flowItems.end(); ++it) {
+        double value = values.edges.value(it.key(), 0);
+        it.value()->setRate(values.edgeScale > 0 ? value / values.edgeScale : 0);
+        if (it.value()->rate() > 0) activeItems.append(it.value());
+    }
+
+    if (activeItems.isEmpty()) {
+        timer->stop();
+    } else if (!timer->isActive()) {
+        timer->start();
+    }
+}
+
+void PacketFlowAnimator::stop()
+{
+    timer->stop();
+    for (PacketFlowItem* item : flowItems) item->setRate(0);
+    activeItems.clear();
+}
+
+void PacketFlowAnimator::recordPaintTime(qint64 nanoseconds)
+{
+    lastPaintNs = qMax(lastPaintNs, nanoseconds);
+}
+
+QRectF PacketFlowAnimator::visibleSceneRect() const
+{
+    QRectF visible;
+    for (QGraphicsView* view : scene->views()) {
+        if (!view->isVisible() || view->window()->isMinimized()) continue;
+        visible |= view->mapToScene(view->viewport()->rect()).boundingRect();
+    }
+    return visible;
+}
+
+void PacketFlowAnimator::tick()
+{
+    // 没有可见的视图时不推进，下一次 setRates() 会重新启动
+    QRectF visible = visibleSceneRect();
+    if (activeItems.isEmpty() || visible.isEmpty()) {
+        timer->stop();
+        return;
+    }
+
+    QElapsedTimer work;
+    work.start();
+    double now = clock.nsecsElapsed() / 1e9;
+    frame++;
+    for (int i = static_cast<int>(frame % currentStride); i < activeItems.size(); i += currentStride) {
+        PacketFlowItem* item = activeItems[i];
+        if (visible.intersects(item->boundingRect())) item->advance(now);
+    }
+
+    // 推进的耗时加上视图上一次绘制的耗时 (绘制在本次推进之后才发生，用上一帧的代替)
+    qint64 cost = work.nsecsElapsed() + lastPaintNs;
+    lastPaintNs = 0;
+    if (cost > kFrameBudgetNs) {
+        underBudgetFrames = 0;
+        if (++overBudgetFrames >= kFramesBeforeDecimating && currentStride < kMaxStride) {
+            currentStride *= 2;
+            overBudgetFrames = 0;
+            qDebug() << "Packet flow: frame cost" << cost / 1000000.0 << "ms over budget, advancing 1 of every"
+                     << currentStride << "edges per frame";
+        }
+    } else if (cost < kFrameBudgetNs / 3) {
+        overBudgetFrames = 0;
+        if (++underBudgetFrames >= kFramesBeforeRecovering && currentStride > 1) {
+            currentStride /= 2;
+            underBudgetFrames = 0;
+        }
+    } else {
+        overBudgetFrames = 0;
+        underBudgetFrames = 0;
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef PACKETFLOW_H
+#define PACKETFLOW_H
+
+#include "../analysis/BusUtilization.h"
+#include <QElapsedTimer>
+#include <QGraphicsItem>
+#include <QGraphicsScene>
+#include <QHash>
+#include <QObject>
+#include <QPolygonF>
+#include <QTimer>
+#include <QVector>
+
+// 一条有向总线边上的流动光点: 光点沿折线等距排列，速度、大小与颜色随该边在最近一个采样间隔内的包数变化
+// advance() 只重绘光点移动前后覆盖的小矩形，不重绘整条边
+class PacketFlowItem : public QGraphicsItem
+{
+public:
+    explicit PacketFlowItem(const QPolygonF& lane, QGraphicsItem* parent = nullptr);
+
+    // 归一化的流量 (0-1)；为 0 时不绘制。返回值是否有变化
+    bool setRate(double rate);
+    double rate() const { return currentRate; }
+
+    // 推进到 now 秒 (单调时钟)
+    void advance(double now);
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+private:
+    QPointF pointAt(double distance) const;
+    void placeDots();
+    QRectF dotRect(const QPointF& center) const;
+
+    QPolygonF lane;
+    QVector<double> lengths;    // 到各顶点的累计长度
+    double totalLength;
+    QRectF bounds;
+    double currentRate;
+    double phase;               // 第一个光点距起点的距离
+    double lastAdvance;
+    QVector<QPointF> dots;
+};
+
+// 驱动所有光点的动画: 只推进有流量且在视图可见范围内的边，没有可推进的边时停止计时器。
+// 每帧的开销 (推进耗时加上视图上一帧的绘制耗时) 超过预算时把边分成 stride 组轮流推进，
+// 开销长期低于预算时再减少分组，使长时间运行时的 CPU 占用保持在较低水平
+class PacketFlowAnimator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit PacketFlowAnimator(QGraphicsScene* scene, QObject* parent = nullptr);
+
+    // 芯片重新绘制后交给动画的图元 (有向边 -> 图元)，图元属于场景
+    void setItems(const QHash<QPair<int, int>, PacketFlowItem*>& items);
+    void clear();
+
+    // 各边在最近一个间隔内的流量，按最大值归一化；只重绘流量变化的边
+    void setRates(const BusUtilization::Values& values);
+    void stop();
+
+    int stride() const { return currentStride; }
+
+public slots:
+    // 视图完成一帧绘制的耗时
+    void recordPaintTime(qint64 nanoseconds);
+
+private slots:
+    void tick();
+
+private:
+    QRectF visibleSceneRect() const;
+
+    QGraphicsScene* scene;
+    QHash<QPair<int, int>, PacketFlowItem*> flowItems;
+    QVector<PacketFlowItem*> activeItems;
+    QTimer* timer;
+    QElapsedTimer clock;
+    qint64 frame;
+    int currentStride;
+    int overBudgetFrames;
+    int underBudgetFrames;
+    qint64 lastPaintNs;
+};
+
+#endif // PACKETFLOW_H
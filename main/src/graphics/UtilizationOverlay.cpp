@@ -0,0 +1,104 @@
+#include "UtilizationOverlay.h"
+#include "ChipPainter.h"
+#include <QPainter>
+#include <QPen>
+#include <QtMath>
+
+namespace {
+
+const int kBuckets = 10;
+const double kNodeRadius = 12;          // 节点光晕的最小半径，刚好露出节点外环
+const double kNodeRadiusGrowth = 8;
+
+int bucketOf(double value, double maximum)
+{
+    if (maximum <= 0) return 0;
+    return qBound(0, static_cast<int>(value / maximum * kBuckets), kBuckets - 1);
+}
+
+}
+
+UtilizationOverlay::UtilizationOverlay(const ChipLayout& layout, QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+    , edgeBuckets(kBuckets)
+    , nodeBuckets(kBuckets)
+{
+    QHash<QPair<int, int>, QPolygonF> lanes = ChipPainter::edgeLanes(layout);
+    for (auto it = lanes.begin(); it != lanes.end(); ++it) {
+        QPainterPath path;
+        path.addPolygon(it.value());
+        edgeGeometry.insert(it.key(), path);
+    }
+    for (const LayoutBusNode& node : layout.busNodes) {
+        nodeCenters.insert(node.id, node.center);
+    }
+
+    double margin = kNodeRadius + kNodeRadiusGrowth + ChipPainter::kLaneOffset;
+    bounds = layout.bounds.adjusted(-margin, -margin, margin, margin);
+
+    // 只是覆盖在连线上的颜色，点击仍交给下面的节点与组件
+    setAcceptedMouseButtons(Qt::NoButton);
+    setZValue(0.5);
+}
+
+void UtilizationOverlay::setValues(const BusUtilization::Values& values)
+{
+    QVector<QPainterPath> edges(kBuckets);
+    for (auto it = values.edges.begin(); it != values.edges.end(); ++it) {
+        auto geometry = edgeGeometry.constFind(it.key());
+        if (geometry == edgeGeometry.constEnd() || it.value() < 0) continue;
+        edges[bucketOf(it.value(), values.edgeScale)].addPath(*geometry);
+    }
+
+    QVector<QPainterPath> nodes(kBuckets);
+    for (QPainterPath& path : nodes) path.setFillRule(Qt::WindingFill);
+    for (auto it = values.nodes.begin(); it != values.nodes.end(); ++it) {
+        auto center = nodeCenters.constFind(it.key());
+        if (center == nodeCenters.constEnd() || it.value() < 0) continue;
+        int bucket = bucketOf(it.value(), values.nodeScale);
+        double radius = kNodeRadius + kNodeRadiusGrowth * (bucket + 1) / kBuckets;
+        nodes[bucket].addEllipse(*center, radius, radius);
+    }
+
+    edgeBuckets = edges;
+    nodeBuckets = nodes;
+    update();
+}
+
+void UtilizationOverlay::clearValues()
+{
+    edgeBuckets = QVector<QPainterPath>(kBuckets);
+    nodeBuckets = QVector<QPainterPath>(kBuckets);
+    update();
+}
+
+QRectF UtilizationOverlay::boundingRect() const
+{
+    return bounds;
+}
+
+void UtilizationOverlay::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    Q_UNUSED(option);
+    Q_UNUSED(widget);
+
+    // 节点光晕在下，边在上；越热的桶越晚画，重叠处热的一方在上
+    painter->setPen(Qt::NoPen);
+    for (int bucket = 0; bucket < kBuckets; ++bucket) {
+        if (nodeBuckets[bucket].isEmpty()) continue;
+        QColor color = ChipPainter::heatColor((bucket + 0.5) / kBuckets);
+        color.setAlpha(140);
+        painter->setBrush(color);
+        painter->drawPath(nodeBuckets[bucket]);
+    }
+
+    painter->setBrush(Qt::NoBrush);
+    for (int bucket = 0; bucket < kBuckets; ++bucket) {
+        if (edgeBuckets[bucket].isEmpty()) continue;
+        QPen pen(ChipPainter::heatColor((bucket + 0.5) / kBuckets), 2 + 0.5 * bucket);
+        pen.setCapStyle(Qt::FlatCap);
+        pen.setJoinStyle(Qt::MiterJoin);
+        painter->setPen(pen);
+        painter->drawPath(edgeBuckets[bucket]);
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef UTILIZATIONOVERLAY_H
+#define UTILIZATIONOVERLAY_H
+
+#include "../analysis/BusUtilization.h"
+#include "ChipLayout.h"
+#include <QGraphicsItem>
+#include <QHash>
+#include <QPainterPath>
+#include <QPointF>
+#include <QVector>
+
+// 总线利用率热力叠加层: 整张图只用这一个图元绘制
+// 每条有向边的折线 (ChipPainter::edgeLanes) 在构造时算好；
+// setValues() 只把这些折线按颜色分桶合并成每桶一条 QPainterPath，paint() 每桶一次 drawPath，
+// 切换指标或刷新数据时不创建、不删除任何图元
+class UtilizationOverlay : public QGraphicsItem
+{
+public:
+    explicit UtilizationOverlay(const ChipLayout& layout, QGraphicsItem* parent = nullptr);
+
+    // 按各自的最大值归一化后着色；值为空时叠加层不绘制任何内容
+    void setValues(const BusUtilization::Values& values);
+    void clearValues();
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+private:
+    QHash<QPair<int, int>, QPainterPath> edgeGeometry;     // (发送节点, 接收节点) -> 折线
+    QHash<int, QPointF> nodeCenters;
+    QVector<QPainterPath> edgeBuckets;
+    QVector<QPainterPath> nodeBuckets;
+    QRectF bounds;
+};
+
+#endif // UTILIZATIONOVERLAY_H
@@ -0,0 +1,271 @@
+#include "SnapshotServer.h"
+#include "../concurrency/WorkStealingPool.h"
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QHostAddress>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QUrl>
+#include <QDebug>
+
+namespace {
+
+const int kMaxRequestBytes = 16 * 1024;     // 请求头上限，超出时断开
+const QString kIndexPath = "/api";
+
+QByteArray commonHeaders()
+{
+    return "Cache-Control: no-cache\r\n"
+           "Access-Control-Allow-Origin: *\r\n"
+           "Access-Control-Expose-Headers: ETag\r\n";
+}
+
+QByteArray errorResponse(int status, const QByteArray& reason, const QString& message)
+{
+    QByteArray body = QJsonDocument(QJsonObject{{"error", message}}).toJson(QJsonDocument::Compact);
+    return "HTTP/1.1 " + QByteArray::number(status) + " " + reason + "\r\n"
+           "Content-Type: application/json; charset=utf-8\r\n"
+           "Content-Length: " + QByteArray::number(body.size()) + "\r\n"
+           + commonHeaders() + "\r\n" + body;
+}
+
+// If-None-Match 可以是逗号分隔的多个 ETag，也可以是 *
+bool etagMatches(const QByteArray& ifNoneMatch, const QByteArray& etag)
+{
+    if (ifNoneMatch.isEmpty()) return false;
+    for (const QByteArray& candidate : ifNoneMatch.split(',')) {
+        QByteArray tag = candidate.trimmed();
+        if (tag.startsWith("W/")) tag = tag.mid(2);
+        if (tag == "*" || tag == etag) return true;
+    }
+    return false;
+}
+
+}
+
+SnapshotServer::SnapshotServer(QObject* parent)
+    : QObject(parent)
+    , thread(nullptr)
+    , tcpServer(nullptr)
+    , listenPort(0)
+    , table(std::make_shared<Table>())
+    , publishCount(0)
+    , installedGeneration(0)
+    , pendingBuilds(0)
+    , requestCount(0)
+    , notModifiedCount(0)
+    , notFoundCount(0)
+{
+}
+
+SnapshotServer::~SnapshotServer()
+{
+    stop();
+
+    // 等待仍在线程池上的发布任务
+    QMutexLocker locker(&tableMutex);
+    while (pendingBuilds > 0) {
+        buildsFinished.wait(&tableMutex);
+    }
+}
+
+bool SnapshotServer::start(quint16 port)
+{
+    stop();
+
+    // 服务对象在网络线程中创建连接、收发数据，线程结束时删除
+    thread = new QThread;
+    tcpServer = new QTcpServer;
+    tcpServer->moveToThread(thread);
+    connect(thread, &QThread::finished, tcpServer, &QObject::deleteLater);
+    connect(tcpServer, &QTcpServer::newConnection, tcpServer, [this]() { acceptConnections(); });
+    thread->start();
+
+    bool listening = false;
+    QMetaObject::invokeMethod(tcpServer, [this, port, &listening]() {
+        listening = tcpServer->listen(QHostAddress::LocalHost, port);
+        if (listening) {
+            listenPort = tcpServer->serverPort();
+        } else {
+            error = tcpServer->errorString();
+        }
+    }, Qt::BlockingQueuedConnection);
+
+    if (!listening) {
+        stop();
+        return false;
+    }
+    qDebug() << "Snapshot server listening on 127.0.0.1:" << listenPort;
+    return true;
+}
+
+void SnapshotServer::stop()
+{
+    if (!thread) return;
+    thread->quit();
+    thread->wait();
+    delete thread;
+    thread = nullptr;
+    tcpServer = nullptr;
+    listenPort = 0;
+}
+
+void SnapshotServer::publish(const QVector<PublishedRun>& runs)
+{
+    quint64 generation = 0;
+    {
+        QMutexLocker locker(&tableMutex);
+        generation = ++publishCount;
+        pendingBuilds++;
+    }
+
+    WorkStealingPool::instance().submit([this, runs, generation]() {
+        std::shared_ptr<const SnapshotDocuments> documents = SnapshotDocuments::build(runs);
+
+        // 响应头与正文拼成一个缓冲区，请求时直接写出
+        auto built = std::make_shared<Table>();
+        const QHash<QString, SnapshotDocuments::Document>& entries = documents->documents();
+        built->responses.reserve(entries.size());
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            const SnapshotDocuments::Document& document = it.value();
+            Response response;
+            QByteArray header = "HTTP/1.1 200 OK\r\n"
+                                "Content-Type: application/json; charset=utf-8\r\n"
+                                "Content-Length: " + QByteArray::number(document.body.size()) + "\r\n"
+                                "ETag: " + document.etag + "\r\n"
+                                + commonHeaders() + "\r\n";
+            response.headerBytes = header.size();
+            response.full = header + document.body;
+            response.notModified = "HTTP/1.1 304 Not Modified\r\n"
+                                   "ETag: " + document.etag + "\r\n"
+                                   + commonHeaders() + "\r\n";
+            response.etag = document.etag;
+            built->responses.insert(it.key(), response);
+        }
+        built->documents = entries.size();
+        built->bytes = documents->totalBytes();
+
+        bool installed = false;
+        {
+            QMutexLocker locker(&tableMutex);
+            if (generation > installedGeneration) {
+                table = built;
+                installedGeneration = generation;
+                installed = true;
+            }
+        }
+        if (installed) emit published(built->documents, built->bytes);
+
+        QMutexLocker locker(&tableMutex);
+        pendingBuilds--;
+        buildsFinished.wakeAll();
+    }, WorkStealingPool::Batch);
+}
+
+std::shared_ptr<const SnapshotServer::Table> SnapshotServer::currentTable() const
+{
+    QMutexLocker locker(&tableMutex);
+    return table;
+}
+
+SnapshotServer::Statistics SnapshotServer::statistics() const
+{
+    Statistics result;
+    result.requests = requestCount.load();
+    result.notModified = notModifiedCount.load();
+    result.notFound = notFoundCount.load();
+    std::shared_ptr<const Table> current = currentTable();
+    result.documents = current->documents;
+    result.bytes = current->bytes;
+    return result;
+}
+
+void SnapshotServer::acceptConnections()
+{
+    while (QTcpSocket* socket = tcpServer->nextPendingConnection()) {
+        auto buffer = std::make_shared<QByteArray>();
+        connect(socket, &QTcpSocket::readyRead, socket, [this, socket, buffer]() { serve(socket, *buffer); });
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    }
+}
+
+void SnapshotServer::serve(QTcpSocket* socket, QByteArray& buffer)
+{
+    buffer.append(socket->readAll());
+
+    // 同一连接上可能连续发来多个请求 (keep-alive)
+    while (true) {
+        int end = buffer.indexOf("\r\n\r\n");
+        if (end < 0) {
+            if (buffer.size() > kMaxRequestBytes) {
+                socket->write(errorResponse(431, "Request Header Fields Too Large", "Request header too large"));
+                socket->disconnectFromHost();
+                buffer.clear();
+            }
+            return;
+        }
+        QList<QByteArray> lines = buffer.left(end).split('\n');
+        buffer.remove(0, end + 4);
+        requestCount++;
+
+        QList<QByteArray> requestLine = lines.first().trimmed().split(' ');
+        if (requestLine.size() != 3 || !requestLine[2].startsWith("HTTP/1.")) {
+            socket->write(errorResponse(400, "Bad Request", "Malformed request line"));
+            socket->disconnectFromHost();
+            return;
+        }
+        const QByteArray& method = requestLine[0];
+        const QByteArray& target = requestLine[1];
+
+        bool closeAfter = requestLine[2] == "HTTP/1.0";
+        bool hasBody = false;
+        QByteArray ifNoneMatch;
+        for (int i = 1; i < lines.size(); ++i) {
+            int colon = lines[i].indexOf(':');
+            if (colon <= 0) continue;
+            QByteArray name = lines[i].left(colon).trimmed().toLower();
+            QByteArray value = lines[i].mid(colon + 1).trimmed();
+            if (name == "if-none-match") {
+                ifNoneMatch = value;
+            } else if (name == "connection") {
+                QByteArray option = value.toLower();
+                if (option == "close") closeAfter = true;
+                if (option == "keep-alive") closeAfter = false;
+            } else if ((name == "content-length" && value.toLongLong() > 0) || name == "transfer-encoding") {
+                hasBody = true;
+            }
+        }
+
+        if ((method != "GET" && method != "HEAD") || hasBody) {
+            // 只读服务，不接收请求体；连接上的剩余数据无法再分帧，直接断开
+            socket->write(errorResponse(405, "Method Not Allowed", "Only GET and HEAD are supported"));
+            socket->disconnectFromHost();
+            return;
+        }
+
+        // 路径中的运行标识与组件名按百分号编码解码，忽略查询参数
+        int query = target.indexOf('?');
+        QString path = QUrl::fromPercentEncoding(query < 0 ? target : target.left(query));
+        while (path.size() > 1 && path.endsWith('/')) path.chop(1);
+        if (path == "/") path = kIndexPath;
+
+        std::shared_ptr<const Table> current = currentTable();
+        auto it = current->responses.constFind(path);
+        if (it == current->responses.constEnd()) {
+            notFoundCount++;
+            socket->write(errorResponse(404, "Not Found", QString("No document at %1").arg(path)));
+        } else if (etagMatches(ifNoneMatch, it.value().etag)) {
+            notModifiedCount++;
+            socket->write(it.value().notModified);
+        } else if (method == "HEAD") {
+            socket->write(it.value().full.constData(), it.value().headerBytes);
+        } else {
+            socket->write(it.value().full);
+        }
+
+        if (closeAfter) {
+            socket->disconnectFromHost();
+            return;
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#ifndef SNAPSHOTSERVER_H
+#define SNAPSHOTSERVER_H
+
+#include "../export/SnapshotDocuments.h"
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QHash>
+#include <atomic>
+#include <memory>
+
+class QTcpServer;
+class QTcpSocket;
+
+// 只监听本机地址的 HTTP/JSON 服务，向看板提供已加载运行的计数器、派生指标与端口矩阵
+// 网络收发在独立线程的事件循环中进行，不占用界面线程。
+// publish() 把文档的序列化作为批量任务放到线程池上，完成后连同响应头一次性生成完整响应并原子替换；
+// 请求只做一次查表和一次写入，If-None-Match 与 ETag 相同时返回 304
+class SnapshotServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Statistics {
+        qint64 requests = 0;
+        qint64 notModified = 0;     // 304
+        qint64 notFound = 0;
+        int documents = 0;
+        qint64 bytes = 0;           // 已发布文档的总大小
+    };
+
+    explicit SnapshotServer(QObject* parent = nullptr);
+    ~SnapshotServer();
+
+    bool start(quint16 port);
+    void stop();
+    bool isRunning() const { return thread != nullptr; }
+    quint16 port() const { return listenPort; }
+    const QString& errorString() const { return error; }
+
+    // 可在任意线程调用；较早的发布晚于较新的发布完成时被丢弃
+    void publish(const QVector<PublishedRun>& runs);
+
+    Statistics statistics() const;
+
+signals:
+    // 在线程池线程中发出
+    void published(int documents, qint64 bytes);
+
+private:
+    // 预先拼好的响应
+    struct Response {
+        QByteArray full;            // 200 响应头 + 正文
+        int headerBytes = 0;        // HEAD 请求只写出前 headerBytes 字节
+        QByteArray notModified;     // 304 响应
+        QByteArray etag;
+    };
+
+    struct Table {
+        QHash<QString, Response> responses;
+        int documents = 0;
+        qint64 bytes = 0;
+    };
+
+    void acceptConnections();
+    void serve(QTcpSocket* socket, QByteArray& buffer);
+    std::shared_ptr<const Table> currentTable() const;
+
+    QString error;
+    QThread* thread;
+    QTcpServer* tcpServer;          // 属于 thread
+    quint16 listenPort;
+
+    mutable QMutex tableMutex;
+    QWaitCondition buildsFinished;
+    std::shared_ptr<const Table> table;
+    quint64 publishCount;           // 已提交的发布次数
+    quint64 installedGeneration;    // 当前表对应的发布序号
+    int pendingBuilds;
+
+    std::atomic<qint64> requestCount;
+    std::atomic<qint64> notModifiedCount;
+    std::atomic<qint64> notFoundCount;
+};
+
+#endif // SNAPSHOTSERVER_H
@@ -0,0 +1,126 @@
+#include "CounterStore.h"
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+const double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+}
+
+CounterStore::CounterStore()
+    : reservedRuns(0)
+    , changes(0)
+{
+}
+
+void CounterStore::clear()
+{
+    runs.clear();
+    names.clear();
+    columnByName.clear();
+    columns.clear();
+    changes++;
+}
+
+void CounterStore::reserveRuns(int count)
+{
+    reservedRuns = count;
+    runs.reserve(count);
+    for (QVector<double>& values : columns) {
+        values.reserve(count);
+    }
+}
+
+int CounterStore::ensureColumn(const QString& name)
+{
+    int index = columnByName.value(name, -1);
+    if (index >= 0) return index;
+
+    // 新列: 之前的运行都缺失该计数器
+    index = columns.size();
+    columnByName.insert(name, index);
+    names.append(name);
+    columns.append(QVector<double>());
+    columns.last().reserve(qMax(reservedRuns, runs.size() + 1));
+    columns.last().fill(kMissing, runs.size());
+    return index;
+}
+
+int CounterStore::addRun(const QString& id, const QString& path, const StatsLoader& loader)
+{
+    int row = runs.size();
+
+    RunInfo info;
+    info.id = id;
+    info.path = path;
+    info.duplicateKeys = loader.getDuplicateKeys();
+    info.conflictingKeys = loader.getConflictingKeys();
+    info.malformedLines = loader.getMalformedLineCount();
+
+    // 先为这一行补齐所有已有列
+    for (QVector<double>& values : columns) {
+        values.append(kMissing);
+    }
+
+    const QMap<QString, ComponentStats>& statsData = loader.getStatsData();
+    for (auto component = statsData.begin(); component != statsData.end(); ++component) {
+        for (auto it = component.value().data.begin(); it != component.value().data.end(); ++it) {
+            bool ok = false;
+            double value = it.value().toDouble(&ok);
+            if (!ok) continue;
+
+            int index = ensureColumn(columnKey(component.key(), it.key()));
+            if (columns[index].size() == row) columns[index].append(kMissing);
+            columns[index][row] = value;
+        }
+
+        // 派生指标中的命中率是百分比，这里换算为比例
+        for (auto it = component.value().percentages.begin(); it != component.value().percentages.end(); ++it) {
+            double value = it.key().endsWith("_rate") ? it.value() / 100.0 : it.value();
+            int index = ensureColumn(columnKey(component.key(), it.key()));
+            if (columns[index].size() == row) columns[index].append(kMissing);
+            columns[index][row] = value;
+        }
+    }
+
+    runs.append(info);
+    changes++;
+    return row;
+}
+
+int CounterStore::addRuns(const QVector<RunInfo>& infos)
+{
+    int firstRow = runs.size();
+    int total = firstRow + infos.size();
+    for (QVector<double>& values : columns) {
+        values.resize(total, kMissing);
+    }
+    runs += infos;
+    changes++;
+    return firstRow;
+}
+
+void CounterStore::setColumnValues(const QString& name, int firstRow, const QVector<double>& values)
+{
+    QVector<double>& column = columns[ensureColumn(name)];
+    column.resize(runs.size(), kMissing);
+    int count = qMin(static_cast<int>(values.size()), static_cast<int>(runs.size()) - firstRow);
+    std::copy(values.begin(), values.begin() + count, column.begin() + firstRow);
+    changes++;
+}
+
+QList<int> CounterStore::columnsMatching(const QRegularExpression& pattern) const
+{
+    QList<int> result;
+    for (int i = 0; i < names.size(); ++i) {
+        if (pattern.match(names[i]).hasMatch()) result.append(i);
+    }
+    return result;
+}
+
+double CounterStore::value(int row, const QString& name) const
+{
+    int index = columnIndex(name);
+    return index >= 0 ? columns[index][row] : kMissing;
+}
@@ -0,0 +1,72 @@
+#ifndef COUNTERSTORE_H
+#define COUNTERSTORE_H
+
+#include "StatsLoader.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QRegularExpression>
+
+// 一次运行在解析时发现的问题
+struct RunInfo {
+    QString id;                     // 运行标识 (通常是 statistic.txt 所在目录)
+    QString path;
+    QStringList duplicateKeys;      // "组件.键"
+    QStringList conflictingKeys;
+    int malformedLines = 0;
+};
+
+// 按列存储多次运行的计数器: 每个 "组件.计数器" 是一列，每次运行是一行
+// 缺失的值为 NaN；派生的 *_rate 指标统一换算到 [0, 1]
+class CounterStore
+{
+public:
+    CounterStore();
+
+    // 追加一次运行，返回行号
+    int addRun(const QString& id, const QString& path, const StatsLoader& loader);
+
+    // 批量导入 (如从运行目录索引): 先追加若干空行，再逐列写入，返回第一行的行号
+    int addRuns(const QVector<RunInfo>& infos);
+    void setColumnValues(const QString& name, int firstRow, const QVector<double>& values);
+
+    void clear();
+    void reserveRuns(int count);
+
+    int runCount() const { return runs.size(); }
+
+    // 每次追加、写入或清空时递增，供缓存了派生结果的读取者判断数据是否变化
+    quint64 generation() const { return changes; }
+    int columnCount() const { return columns.size(); }
+
+    const RunInfo& run(int row) const { return runs[row]; }
+
+    // 列下标，不存在时返回 -1
+    int columnIndex(const QString& name) const { return columnByName.value(name, -1); }
+    const QString& columnName(int index) const { return names[index]; }
+    const QStringList& columnNames() const { return names; }
+    const QVector<double>& column(int index) const { return columns[index]; }
+
+    // 名称匹配的所有列
+    QList<int> columnsMatching(const QRegularExpression& pattern) const;
+
+    double value(int row, const QString& name) const;
+
+    static QString columnKey(const QString& component, const QString& counter)
+    {
+        return component + "." + counter;
+    }
+
+private:
+    int ensureColumn(const QString& name);
+
+    QVector<RunInfo> runs;
+    QStringList names;
+    QHash<QString, int> columnByName;
+    QVector<QVector<double>> columns;
+    int reservedRuns;
+    quint64 changes;
+};
+
+#endif // COUNTERSTORE_H
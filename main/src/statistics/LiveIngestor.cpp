@@ -0,0 +1,232 @@
+#include "LiveIngestor.h"
+#include <QDebug>
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+namespace {
+
+const int kDrainBatch = 4096;
+const int kLatencyWindow = 4096;    // 统计延迟分位数的最近样本数
+const int kSpinRounds = 64;         // 环空时先让出时间片，之后再睡眠
+const int kReattachMs = 50;         // 生产者重启后等待新共享内存出现的间隔
+
+const double kMissing = std::numeric_limits<double>::quiet_NaN();
+
+void recordLatency(QVector<qint64>& window, int& next, qint64 nanoseconds)
+{
+    if (window.size() < kLatencyWindow) {
+        window.append(nanoseconds);
+    } else {
+        window[next] = nanoseconds;
+    }
+    next = (next + 1) % kLatencyWindow;
+}
+
+qint64 percentile(QVector<qint64> values, double fraction)
+{
+    if (values.isEmpty()) return 0;
+    int index = qMin(values.size() - 1, static_cast<int>(fraction * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+}
+
+LiveIngestor::LiveIngestor(QObject* parent)
+    : QObject(parent)
+    , thread(nullptr)
+    , stopRequested(false)
+    , notifyPending(false)
+    , recordCount(0)
+    , dumpCount(0)
+    , unknownCount(0)
+    , ingestNext(0)
+    , viewNext(0)
+{
+}
+
+LiveIngestor::~LiveIngestor()
+{
+    stop();
+}
+
+bool LiveIngestor::start(const QString& ringName)
+{
+    stop();
+    name = ringName;
+    if (!ring.attach(ringName)) {
+        error = ring.errorString();
+        return false;
+    }
+
+    {
+        QWriteLocker locker(&storeLock);
+        store.clear();
+    }
+    {
+        QMutexLocker locker(&latestMutex);
+        latestSnapshot = Snapshot();
+    }
+    {
+        QMutexLocker locker(&statisticsMutex);
+        recordCount = 0;
+        dumpCount = 0;
+        unknownCount = 0;
+        ingestLatencies.clear();
+        viewLatencies.clear();
+        ingestNext = 0;
+        viewNext = 0;
+        runningTime.start();
+    }
+
+    stopRequested = false;
+    notifyPending = false;
+    thread = QThread::create([this]() { drainLoop(); });
+    thread->start();
+    qDebug() << "Live ingestion started from" << ringName << "capacity" << ring.capacity();
+    return true;
+}
+
+void LiveIngestor::stop()
+{
+    if (!thread) return;
+    stopRequested = true;
+    thread->wait();
+    delete thread;
+    thread = nullptr;
+    ring.detach();
+}
+
+void LiveIngestor::drainLoop()
+{
+    QVector<ShmCounterRecord> batch(kDrainBatch);
+    QVector<int> columnOf;          // 环中的计数器编号 -> 存储中的列
+    QVector<double> current;        // 各列的最新值
+    int idleRounds = 0;
+
+    while (!stopRequested.load(std::memory_order_relaxed)) {
+        int count = ring.pop(batch.data(), batch.size());
+        if (count == 0 && (ring.isRetired() || !ring.isAttached())) {
+            // 生产者已重启: 按名称映射新的共享内存，计数器编号重新登记，存储中的列按名称沿用
+            if (!ring.attach(name)) {
+                QThread::msleep(kReattachMs);
+                continue;
+            }
+            columnOf.clear();
+            idleRounds = 0;
+            qDebug() << "Live ingestion re-attached to" << name << "capacity" << ring.capacity();
+            continue;
+        }
+        if (count == 0) {
+            if (++idleRounds < kSpinRounds) {
+                std::this_thread::yield();
+            } else {
+                QThread::usleep(100);
+            }
+            continue;
+        }
+        idleRounds = 0;
+
+        qint64 unknown = 0;
+        for (int i = 0; i < count; ++i) {
+            const ShmCounterRecord& record = batch[i];
+
+            // 新编号: 名称已登记时建立到存储列的映射
+            int column = -1;
+            if (record.counter < static_cast<quint32>(columnOf.size())) {
+                column = columnOf[record.counter];
+            } else if (record.counter < ring.counterCount()) {
+                int oldSize = columnOf.size();
+                columnOf.resize(record.counter + 1);
+                std::fill(columnOf.begin() + oldSize, columnOf.end(), -1);
+            }
+            if (column < 0 && record.counter < static_cast<quint32>(columnOf.size())) {
+                QString counterName = ring.counterName(record.counter);
+                if (!counterName.isEmpty()) {
+                    QWriteLocker locker(&storeLock);
+                    column = store.ensureColumn(counterName);
+                    columnOf[record.counter] = column;
+                }
+            }
+
+            if (column >= 0) {
+                if (column >= current.size()) {
+                    int oldSize = current.size();
+                    current.resize(column + 1);
+                    std::fill(current.begin() + oldSize, current.end(), kMissing);
+                }
+                current[column] = record.value;
+            } else {
+                unknown++;
+            }
+
+            if (!(record.flags & kShmEndOfDump)) continue;
+
+            // 一次转储结束: 追加到存储并发布快照
+            {
+                QWriteLocker locker(&storeLock);
+                store.append(record.tick, current);
+            }
+            {
+                QMutexLocker locker(&latestMutex);
+                latestSnapshot.tick = record.tick;
+                latestSnapshot.sendNs = record.sendNs;
+                latestSnapshot.names = store.columnNames();
+                latestSnapshot.values = current;
+            }
+            {
+                QMutexLocker locker(&statisticsMutex);
+                dumpCount++;
+                recordLatency(ingestLatencies, ingestNext, SharedMemoryRing::monotonicNs() - record.sendNs);
+            }
+            if (!notifyPending.exchange(true)) {
+                QMetaObject::invokeMethod(this, [this]() {
+                    notifyPending = false;
+                    emit snapshotReady();
+                }, Qt::QueuedConnection);
+            }
+        }
+
+        QMutexLocker locker(&statisticsMutex);
+        recordCount += count;
+        unknownCount += unknown;
+    }
+}
+
+LiveIngestor::Snapshot LiveIngestor::latest() const
+{
+    QMutexLocker locker(&latestMutex);
+    return latestSnapshot;
+}
+
+void LiveIngestor::recordViewLatency(qint64 nanoseconds)
+{
+    QMutexLocker locker(&statisticsMutex);
+    recordLatency(viewLatencies, viewNext, nanoseconds);
+}
+
+LiveIngestor::Statistics LiveIngestor::statistics() const
+{
+    QMutexLocker locker(&statisticsMutex);
+    Statistics result;
+    result.records = recordCount;
+    result.dumps = dumpCount;
+    result.unknownCounters = unknownCount;
+    double seconds = runningTime.isValid() ? runningTime.nsecsElapsed() / 1e9 : 0;
+    if (seconds > 0) {
+        result.recordsPerSecond = recordCount / seconds;
+        result.dumpsPerSecond = dumpCount / seconds;
+    }
+    result.ingestP50Ns = percentile(ingestLatencies, 0.5);
+    result.ingestP99Ns = percentile(ingestLatencies, 0.99);
+    result.viewP50Ns = percentile(viewLatencies, 0.5);
+    result.viewP99Ns = percentile(viewLatencies, 0.99);
+    return result;
+}
+
+void LiveIngestor::readStore(const std::function<void(const TimeSeriesStore&)>& reader) const
+{
+    QReadLocker locker(&storeLock);
+    reader(store);
+}
@@ -0,0 +1,91 @@
+#ifndef LIVEINGESTOR_H
+#define LIVEINGESTOR_H
+
+#include "SharedMemoryRing.h"
+#include "TimeSeriesStore.h"
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QReadWriteLock>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+#include <functional>
+
+// 实时采集: 专用线程不断取出共享内存环中的记录，按转储追加到时间序列存储
+// 转储中没有出现的计数器沿用上一次的值。每完成一次转储更新最新快照，并通过事件循环通知界面 (未处理前不重复通知)
+// 生产者重启后自动映射同名的新共享内存
+class LiveIngestor : public QObject
+{
+    Q_OBJECT
+
+public:
+    // 最近一次完整的转储
+    struct Snapshot {
+        quint64 tick = 0;
+        qint64 sendNs = 0;          // 该转储最后一条记录的写入时刻
+        QStringList names;
+        QVector<double> values;
+    };
+
+    struct Statistics {
+        qint64 records = 0;
+        qint64 dumps = 0;
+        qint64 unknownCounters = 0; // 编号未登记的记录
+        double recordsPerSecond = 0;
+        double dumpsPerSecond = 0;
+        qint64 ingestP50Ns = 0;     // 生产者写入 -> 写入存储
+        qint64 ingestP99Ns = 0;
+        qint64 viewP50Ns = 0;       // 生产者写入 -> 界面显示 (由界面通过 recordViewLatency 报告)
+        qint64 viewP99Ns = 0;
+    };
+
+    explicit LiveIngestor(QObject* parent = nullptr);
+    ~LiveIngestor();
+
+    bool start(const QString& ringName);
+    void stop();
+    bool isRunning() const { return thread != nullptr; }
+    const QString& ringName() const { return name; }
+    const QString& errorString() const { return error; }
+
+    Snapshot latest() const;
+    Statistics statistics() const;
+    void recordViewLatency(qint64 nanoseconds);
+
+    // 在读锁内访问时间序列存储
+    void readStore(const std::function<void(const TimeSeriesStore&)>& reader) const;
+
+signals:
+    void snapshotReady();
+
+private:
+    void drainLoop();
+
+    SharedMemoryRing ring;
+    QString name;
+    QString error;
+    QThread* thread;
+    std::atomic<bool> stopRequested;
+    std::atomic<bool> notifyPending;
+
+    mutable QReadWriteLock storeLock;
+    TimeSeriesStore store;
+
+    mutable QMutex latestMutex;
+    Snapshot latestSnapshot;
+
+    // 计数与最近若干次延迟 (环形保存)
+    mutable QMutex statisticsMutex;
+    QElapsedTimer runningTime;
+    qint64 recordCount;
+    qint64 dumpCount;
+    qint64 unknownCount;
+    QVector<qint64> ingestLatencies;
+    QVector<qint64> viewLatencies;
+    int ingestNext;
+    int viewNext;
+};
+
+#endif // LIVEINGESTOR_H
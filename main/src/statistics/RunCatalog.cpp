@@ -0,0 +1,280 @@
+#include "RunCatalog.h"
+#include "RunSetLoader.h"
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include <QSet>
+#include <QDebug>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+const quint32 kCatalogMagic = 0x50505643;  // "PPVC"
+const quint16 kCatalogVersion = 1;
+
+// 每次最多同时解析的运行数，限制临时列式存储的大小
+const int kParseChunk = 4096;
+
+const float kMissingSummary = std::numeric_limits<float>::quiet_NaN();
+
+bool isUnderRoot(const QString& absolutePath, const QStringList& absoluteRoots)
+{
+    for (const QString& root : absoluteRoots) {
+        if (absolutePath == root || absolutePath.startsWith(root + "/")) return true;
+    }
+    return false;
+}
+
+}
+
+RunCatalog::RunCatalog()
+    : summaryPattern(defaultSummaryPattern())
+{
+}
+
+QRegularExpression RunCatalog::defaultSummaryPattern()
+{
+    return QRegularExpression("^(?!Bus\\.transmit_package_number_from_)");
+}
+
+QString RunCatalog::defaultCatalogPath(const QStringList& roots)
+{
+    QString root = roots.isEmpty() ? QDir::currentPath() : roots.first();
+    QFileInfo info(root);
+    return (info.isDir() ? QDir(root) : info.dir()).filePath(".ppv-catalog");
+}
+
+int RunCatalog::ensureColumn(const QString& name)
+{
+    int index = columnByName.value(name, -1);
+    if (index >= 0) return index;
+    index = columns.size();
+    columns.append(name);
+    columnByName.insert(name, index);
+    return index;
+}
+
+double RunCatalog::value(int index, const QString& column) const
+{
+    int columnIndex = columnByName.value(column, -1);
+    const QVector<float>& summary = entries[index].summary;
+    if (columnIndex < 0 || columnIndex >= summary.size()) return std::nan("");
+    return summary[columnIndex];
+}
+
+bool RunCatalog::load(const QString& catalogPath)
+{
+    QFile file(catalogPath);
+    if (!file.open(QIODevice::ReadOnly)) return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    in.setFloatingPointPrecision(QDataStream::SinglePrecision);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != kCatalogMagic || version != kCatalogVersion) {
+        qDebug() << "Ignoring run catalog with unknown format:" << catalogPath;
+        return false;
+    }
+
+    QString pattern;
+    QStringList names;
+    quint32 count = 0;
+    in >> pattern >> names >> count;
+
+    QVector<CatalogEntry> loaded;
+    loaded.reserve(count);
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        CatalogEntry entry;
+        in >> entry.id >> entry.path >> entry.modified >> entry.size >> entry.setupHash >> entry.summary;
+        loaded.append(entry);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        qDebug() << "Run catalog is truncated:" << catalogPath;
+        return false;
+    }
+
+    summaryPattern = QRegularExpression(pattern);
+    columns = names;
+    columnByName.clear();
+    for (int i = 0; i < columns.size(); ++i) {
+        columnByName.insert(columns[i], i);
+    }
+    entries = loaded;
+    return true;
+}
+
+bool RunCatalog::save(const QString& catalogPath) const
+{
+    // 先写临时文件再替换，中途失败不会损坏已有索引
+    QSaveFile file(catalogPath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qDebug() << "Cannot write run catalog:" << catalogPath;
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out.setFloatingPointPrecision(QDataStream::SinglePrecision);   // 摘要按 4 字节存放
+    out << kCatalogMagic << kCatalogVersion << summaryPattern.pattern() << columns
+        << static_cast<quint32>(entries.size());
+    for (const CatalogEntry& entry : entries) {
+        out << entry.id << entry.path << entry.modified << entry.size << entry.setupHash << entry.summary;
+    }
+    return file.commit();
+}
+
+QByteArray RunCatalog::setupHashFor(const QString& statisticPath, const QStringList& roots)
+{
+    // 从运行目录向上查找 setup.txt，最远到所在的根目录
+    QDir dir = QFileInfo(statisticPath).absoluteDir();
+    QStringList visited;
+    QByteArray hash;
+    while (true) {
+        QString key = dir.absolutePath();
+        auto cached = setupHashByDir.find(key);
+        if (cached != setupHashByDir.end()) {
+            hash = cached.value();
+            break;
+        }
+        visited.append(key);
+
+        QFile setup(dir.filePath("setup.txt"));
+        if (setup.open(QIODevice::ReadOnly)) {
+            hash = QCryptographicHash::hash(setup.readAll(), QCryptographicHash::Sha1);
+            break;
+        }
+        if (roots.contains(key) || !dir.cdUp()) break;
+    }
+
+    for (const QString& key : visited) {
+        setupHashByDir.insert(key, hash);
+    }
+    return hash;
+}
+
+int RunCatalog::update(const QStringList& roots)
+{
+    removed = 0;
+    unchanged = 0;
+    setupHashByDir.clear();
+
+    QStringList absoluteRoots;
+    for (const QString& root : roots) {
+        absoluteRoots.append(QFileInfo(root).absoluteFilePath());
+    }
+
+    QHash<QString, int> existing;
+    for (int i = 0; i < entries.size(); ++i) {
+        existing.insert(entries[i].path, i);
+    }
+
+    // 根目录以外的记录原样保留
+    QVector<CatalogEntry> next;
+    for (const CatalogEntry& entry : entries) {
+        if (!isUnderRoot(QFileInfo(entry.path).absoluteFilePath(), absoluteRoots)) next.append(entry);
+    }
+
+    QStringList files = RunSetLoader::discoverRuns(roots);
+    QStringList stale;
+    QHash<QString, int> slotByPath;
+    QSet<QString> present;
+    next.reserve(next.size() + files.size());
+    for (const QString& path : files) {
+        QFileInfo info(path);
+        CatalogEntry entry;
+        entry.id = info.path();
+        entry.path = path;
+        entry.modified = info.lastModified().toMSecsSinceEpoch();
+        entry.size = info.size();
+        entry.setupHash = setupHashFor(path, absoluteRoots);
+        present.insert(path);
+
+        int old = existing.value(path, -1);
+        if (old >= 0 && entries[old].modified == entry.modified && entries[old].size == entry.size &&
+            entries[old].setupHash == entry.setupHash) {
+            next.append(entries[old]);
+            unchanged++;
+            continue;
+        }
+
+        slotByPath.insert(path, next.size());
+        next.append(entry);
+        stale.append(path);
+    }
+
+    for (const CatalogEntry& entry : entries) {
+        if (!present.contains(entry.path) &&
+            isUnderRoot(QFileInfo(entry.path).absoluteFilePath(), absoluteRoots)) {
+            removed++;
+        }
+    }
+
+    // 新增或修改过的运行分块并行解析，只保留摘要列
+    QVector<bool> parsed(next.size(), false);
+    for (int begin = 0; begin < stale.size(); begin += kParseChunk) {
+        CounterStore batch;
+        RunSetLoader loader;
+        loader.load(stale.mid(begin, kParseChunk), batch);
+
+        QVector<int> targetColumn(batch.columnCount(), -1);
+        for (int column = 0; column < batch.columnCount(); ++column) {
+            if (summaryPattern.match(batch.columnName(column)).hasMatch()) {
+                targetColumn[column] = ensureColumn(batch.columnName(column));
+            }
+        }
+
+        for (int row = 0; row < batch.runCount(); ++row) {
+            int slot = slotByPath.value(batch.run(row).path, -1);
+            if (slot < 0) continue;
+            QVector<float>& summary = next[slot].summary;
+            summary.fill(kMissingSummary, columns.size());
+            for (int column = 0; column < batch.columnCount(); ++column) {
+                if (targetColumn[column] >= 0) {
+                    summary[targetColumn[column]] = static_cast<float>(batch.column(column)[row]);
+                }
+            }
+            parsed[slot] = true;
+        }
+    }
+
+    // 解析失败的运行不写入索引，下次更新时重试
+    entries.clear();
+    entries.reserve(next.size());
+    for (int i = 0; i < next.size(); ++i) {
+        if (!slotByPath.contains(next[i].path) || parsed[i]) entries.append(next[i]);
+    }
+
+    setupHashByDir.clear();
+    return stale.size();
+}
+
+void RunCatalog::toCounterStore(CounterStore& store) const
+{
+    QVector<RunInfo> infos;
+    infos.reserve(entries.size());
+    for (const CatalogEntry& entry : entries) {
+        RunInfo info;
+        info.id = entry.id;
+        info.path = entry.path;
+        infos.append(info);
+    }
+    int firstRow = store.addRuns(infos);
+
+    QVector<double> values(entries.size());
+    for (int column = 0; column < columns.size(); ++column) {
+        for (int row = 0; row < entries.size(); ++row) {
+            const QVector<float>& summary = entries[row].summary;
+            values[row] = column < summary.size() ? summary[column] : std::nan("");
+        }
+        store.setColumnValues(columns[column], firstRow, values);
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef RUNCATALOG_H
+#define RUNCATALOG_H
+
+#include "CounterStore.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QRegularExpression>
+
+// 运行目录索引中的一条记录
+struct CatalogEntry {
+    QString id;                 // 运行标识 (statistic.txt 所在目录)
+    QString path;               // statistic.txt 的路径
+    qint64 modified = 0;        // 文件修改时间 (ms since epoch)，与大小一起判断是否需要重新解析
+    qint64 size = 0;
+    QByteArray setupHash;       // 所用 setup.txt 的 SHA-1，找不到时为空
+    QVector<float> summary;     // 按索引的列顺序存放的摘要值，缺失为 NaN
+};
+
+// 持久化的运行目录索引
+// 为每次运行记录路径、setup 哈希与关键计数器/派生指标的摘要向量，保存为二进制文件；
+// 更新时只重新解析新增或修改过的 statistic.txt，查询与列表显示不需要再读原始文本
+class RunCatalog
+{
+public:
+    RunCatalog();
+
+    // 默认摘要列: 除端口间传输矩阵以外的所有计数器与派生指标
+    static QRegularExpression defaultSummaryPattern();
+
+    // 索引文件的默认位置: 第一个根目录下的 .ppv-catalog
+    static QString defaultCatalogPath(const QStringList& roots);
+
+    bool load(const QString& catalogPath);
+    bool save(const QString& catalogPath) const;
+
+    // 摘要包含哪些列，随索引一起保存；只影响之后重新解析的运行
+    void setSummaryPattern(const QRegularExpression& pattern) { summaryPattern = pattern; }
+    const QRegularExpression& getSummaryPattern() const { return summaryPattern; }
+
+    // 扫描根目录并增量更新，返回重新解析的运行数
+    // 根目录下已经不存在或无法解析的运行会被移除，根目录以外的记录保持不变
+    int update(const QStringList& roots);
+
+    int size() const { return entries.size(); }
+    const CatalogEntry& entry(int index) const { return entries[index]; }
+    const QStringList& summaryColumns() const { return columns; }
+
+    // 某次运行的摘要值，列不存在时为 NaN
+    double value(int index, const QString& column) const;
+
+    // 转为列式存储，供查询与汇总使用
+    void toCounterStore(CounterStore& store) const;
+
+    // 上次 update 的统计
+    int removedCount() const { return removed; }
+    int unchangedCount() const { return unchanged; }
+
+private:
+    int ensureColumn(const QString& name);
+    QByteArray setupHashFor(const QString& statisticPath, const QStringList& roots);
+
+    QRegularExpression summaryPattern;
+    QStringList columns;
+    QHash<QString, int> columnByName;
+    QVector<CatalogEntry> entries;
+    QHash<QString, QByteArray> setupHashByDir;  // 一次 update 内按目录缓存 setup.txt 的哈希
+    int removed = 0;
+    int unchanged = 0;
+};
+
+#endif // RUNCATALOG_H
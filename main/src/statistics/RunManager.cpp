@@ -0,0 +1,258 @@
+#include "RunManager.h"
+#include "../concurrency/WorkStealingPool.h"
+#include <QFileInfo>
+#include <QDir>
+#include <QMutexLocker>
+#include <QDebug>
+#include <algorithm>
+
+RunManager::RunManager(qint64 budgetBytes, QObject* parent)
+    : QObject(parent)
+    , pendingTasks(0)
+    , clock(0)
+    , budgetBytes(budgetBytes)
+{
+}
+
+RunManager::~RunManager()
+{
+    // 后台任务引用本对象，析构前等待它们结束
+    QMutexLocker locker(&mutex);
+    while (pendingTasks > 0) {
+        tasksFinished.wait(&mutex);
+    }
+}
+
+QString RunManager::stateName(State state)
+{
+    switch (state) {
+    case Loaded: return "Loaded";
+    case Compact: return "Compressed";
+    case Unloaded: return "On Disk";
+    case Loading: return "Loading";
+    }
+    return QString();
+}
+
+QString RunManager::open(const QString& statisticPath)
+{
+    QMutexLocker locker(&mutex);
+
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it.value().path == statisticPath) return it.key();
+    }
+
+    // 以所在目录命名，重名时加序号
+    QString base = QFileInfo(statisticPath).dir().dirName();
+    QString id = base;
+    for (int suffix = 2; entries.contains(id); ++suffix) {
+        id = QString("%1 (%2)").arg(base).arg(suffix);
+    }
+
+    Entry entry;
+    entry.path = statisticPath;
+    entry.lastUsed = ++clock;
+    entries.insert(id, entry);
+    startLoad(id);
+    return id;
+}
+
+void RunManager::close(const QString& id)
+{
+    {
+        QMutexLocker locker(&mutex);
+        entries.remove(id);
+    }
+    notifyUsage();
+}
+
+std::shared_ptr<const StatsLoader> RunManager::acquire(const QString& id)
+{
+    QMutexLocker locker(&mutex);
+    auto it = entries.find(id);
+    if (it == entries.end()) return nullptr;
+
+    it.value().lastUsed = ++clock;
+    if (!it.value().snapshot) {
+        startLoad(id);
+    }
+    return it.value().snapshot;
+}
+
+std::shared_ptr<const StatsLoader> RunManager::peek(const QString& id) const
+{
+    QMutexLocker locker(&mutex);
+    auto it = entries.constFind(id);
+    return it == entries.constEnd() ? nullptr : it.value().snapshot;
+}
+
+void RunManager::startLoad(const QString& id)
+{
+    Entry& entry = entries[id];
+    if (entry.loading) return;
+    entry.loading = true;
+    pendingTasks++;
+
+    // 有压缩快照时解压，否则重新解析文本；界面在等待该运行，按交互优先级调度
+    QString path = entry.path;
+    QByteArray compact = entry.compact;
+    WorkStealingPool::instance().submit([this, id, path, compact]() {
+        auto loader = std::make_shared<StatsLoader>();
+        bool ok = !compact.isEmpty() ? loader->deserialize(qUncompress(compact))
+                                     : loader->loadStatistics(path);
+        qint64 bytes = ok ? loader->memoryFootprint() : 0;
+
+        {
+            QMutexLocker locker(&mutex);
+            auto it = entries.find(id);
+            if (it != entries.end()) {
+                it.value().loading = false;
+                if (ok) {
+                    it.value().snapshot = loader;
+                    it.value().loadedBytes = bytes;
+                    it.value().compact.clear();
+                    enforceBudget();
+                }
+            }
+
+            // 结果通过事件循环交给主线程；对象已销毁时 Qt 丢弃该调用
+            QMetaObject::invokeMethod(this, [this, id, ok]() {
+                if (ok) emit runReady(id);
+                else emit runFailed(id);
+                notifyUsage();
+            }, Qt::QueuedConnection);
+
+            pendingTasks--;
+            tasksFinished.wakeAll();
+        }
+    }, WorkStealingPool::Interactive);
+}
+
+void RunManager::enforceBudget()
+{
+    // 按最近最少使用的顺序淘汰，跳过界面仍在使用的运行
+    QStringList order = entries.keys();
+    std::sort(order.begin(), order.end(), [this](const QString& a, const QString& b) {
+        return entries[a].lastUsed < entries[b].lastUsed;
+    });
+
+    // 正在压缩的运行按已经释放计算，避免同一段超额重复淘汰
+    qint64 projected = usageLocked();
+    for (const Entry& entry : entries) {
+        if (entry.compressing) projected -= entry.loadedBytes;
+    }
+
+    // 第一轮: 完整形式 -> 压缩快照。序列化与压缩较慢，持锁时只挑选对象，压缩交给后台
+    for (const QString& id : order) {
+        if (projected <= budgetBytes) return;
+        Entry& entry = entries[id];
+        if (!entry.snapshot || entry.compressing || entry.snapshot.use_count() > 1) continue;
+        projected -= entry.loadedBytes;
+        startCompress(id);
+    }
+
+    // 第二轮: 丢弃压缩快照，之后从文件重新解析
+    for (const QString& id : order) {
+        if (projected <= budgetBytes) return;
+        Entry& entry = entries[id];
+        projected -= entry.compact.size();
+        entry.compact.clear();
+    }
+}
+
+void RunManager::startCompress(const QString& id)
+{
+    Entry& entry = entries[id];
+    entry.compressing = true;
+    pendingTasks++;
+
+    // 后台持有快照的副本；完成时该运行若已被再次取用 (最近使用时间变化或仍有外部引用) 则放弃结果
+    std::shared_ptr<const StatsLoader> snapshot = entry.snapshot;
+    quint64 stamp = entry.lastUsed;
+    WorkStealingPool::instance().submit([this, id, snapshot, stamp]() {
+        QByteArray compact = qCompress(snapshot->serialize());
+
+        QMutexLocker locker(&mutex);
+        auto it = entries.find(id);
+        if (it != entries.end() && it.value().snapshot == snapshot) {
+            Entry& entry = it.value();
+            entry.compressing = false;
+            if (entry.lastUsed == stamp && entry.snapshot.use_count() <= 2) {
+                entry.compact = compact;
+                entry.snapshot.reset();
+                entry.loadedBytes = 0;
+            }
+            enforceBudget();
+            QMetaObject::invokeMethod(this, [this]() { notifyUsage(); }, Qt::QueuedConnection);
+        }
+
+        pendingTasks--;
+        tasksFinished.wakeAll();
+    }, WorkStealingPool::Batch);
+}
+
+qint64 RunManager::usageLocked() const
+{
+    qint64 total = 0;
+    for (const Entry& entry : entries) {
+        total += entry.snapshot ? entry.loadedBytes : entry.compact.size();
+    }
+    return total;
+}
+
+void RunManager::setBudget(qint64 bytes)
+{
+    {
+        QMutexLocker locker(&mutex);
+        budgetBytes = bytes;
+        enforceBudget();
+    }
+    notifyUsage();
+}
+
+qint64 RunManager::budget() const
+{
+    QMutexLocker locker(&mutex);
+    return budgetBytes;
+}
+
+qint64 RunManager::usage() const
+{
+    QMutexLocker locker(&mutex);
+    return usageLocked();
+}
+
+void RunManager::notifyUsage()
+{
+    qint64 used, limit;
+    {
+        QMutexLocker locker(&mutex);
+        used = usageLocked();
+        limit = budgetBytes;
+    }
+    emit usageChanged(used, limit);
+}
+
+QVector<RunManager::RunStatus> RunManager::runs() const
+{
+    QMutexLocker locker(&mutex);
+
+    QVector<QPair<quint64, RunStatus>> ordered;
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        const Entry& entry = it.value();
+        RunStatus status;
+        status.id = it.key();
+        status.path = entry.path;
+        status.state = entry.loading ? Loading : entry.snapshot ? Loaded : !entry.compact.isEmpty() ? Compact : Unloaded;
+        status.bytes = entry.snapshot ? entry.loadedBytes : entry.compact.size();
+        status.pinned = entry.snapshot && entry.snapshot.use_count() > (entry.compressing ? 2 : 1);
+        ordered.append({entry.lastUsed, status});
+    }
+    std::sort(ordered.begin(), ordered.end(), [](const QPair<quint64, RunStatus>& a, const QPair<quint64, RunStatus>& b) {
+        return a.first > b.first;
+    });
+
+    QVector<RunStatus> result;
+    for (const auto& item : ordered) result.append(item.second);
+    return result;
+}
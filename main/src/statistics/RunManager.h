@@ -0,0 +1,90 @@
+#ifndef RUNMANAGER_H
+#define RUNMANAGER_H
+
+#include "StatsLoader.h"
+#include <QObject>
+#include <QString>
+#include <QVector>
+#include <QMap>
+#include <QMutex>
+#include <QWaitCondition>
+#include <memory>
+
+// 打开的运行及其内存预算
+// 每次运行有三种驻留形式: 完整解析结果、压缩的二进制快照、只保留路径。
+// 总占用超过预算时，按最近最少使用的顺序先把运行压缩，仍然超出时再丢弃压缩快照；
+// 正在被界面使用 (有外部引用) 的运行不会被淘汰。被淘汰的运行在下次访问时于后台恢复。
+class RunManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum State {
+        Loaded,     // 完整解析结果在内存中
+        Compact,    // 只保留压缩快照
+        Unloaded,   // 只保留路径，需要重新解析
+        Loading     // 正在后台恢复
+    };
+
+    struct RunStatus {
+        QString id;
+        QString path;
+        State state = Unloaded;
+        qint64 bytes = 0;       // 当前形式的内存占用
+        bool pinned = false;    // 界面正在使用
+    };
+
+    explicit RunManager(qint64 budgetBytes = 512ll * 1024 * 1024, QObject* parent = nullptr);
+    ~RunManager();
+
+    // 登记并在后台加载一次运行，返回其标识；同一路径重复打开时返回已有标识
+    QString open(const QString& statisticPath);
+    void close(const QString& id);
+
+    // 取已加载的运行并更新最近使用时间；未加载时返回空指针并在后台恢复，完成后发送 runReady
+    // 持有返回的指针期间该运行不会被淘汰
+    std::shared_ptr<const StatsLoader> acquire(const QString& id);
+    
+    // 只取已加载的运行，不更新最近使用时间也不触发恢复 (供后台读取者使用)
+    std::shared_ptr<const StatsLoader> peek(const QString& id) const;
+
+    void setBudget(qint64 bytes);
+    qint64 budget() const;
+    qint64 usage() const;
+
+    // 所有运行，最近使用的在前
+    QVector<RunStatus> runs() const;
+
+    static QString stateName(State state);
+
+signals:
+    void runReady(const QString& id);
+    void runFailed(const QString& id);
+    void usageChanged(qint64 usage, qint64 budget);
+
+private:
+    struct Entry {
+        QString path;
+        std::shared_ptr<const StatsLoader> snapshot;
+        QByteArray compact;         // qCompress 后的二进制快照
+        qint64 loadedBytes = 0;     // 完整形式的估算占用
+        quint64 lastUsed = 0;
+        bool loading = false;
+        bool compressing = false;   // 后台正在压缩 snapshot
+    };
+
+    void startLoad(const QString& id);      // 调用时持有 mutex
+    void enforceBudget();                   // 调用时持有 mutex，只挑选淘汰对象，压缩在后台进行
+    void startCompress(const QString& id);  // 调用时持有 mutex
+    qint64 usageLocked() const;
+    void notifyUsage();
+
+    mutable QMutex mutex;
+    QWaitCondition tasksFinished;
+    int pendingTasks;                       // 尚未结束的加载与压缩任务
+    QMap<QString, Entry> entries;
+    quint64 clock;
+    qint64 budgetBytes;
+};
+
+#endif // RUNMANAGER_H
@@ -0,0 +1,67 @@
+#include "RunSetLoader.h"
+#include "../concurrency/WorkStealingPool.h"
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QDebug>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// 每批同时驻留内存的解析结果数量
+const int kBatchSize = 256;
+
+}
+
+QStringList RunSetLoader::discoverRuns(const QStringList& paths)
+{
+    QStringList files;
+    for (const QString& path : paths) {
+        QFileInfo info(path);
+        if (info.isFile()) {
+            files.append(info.filePath());
+        } else if (info.isDir()) {
+            QDirIterator it(path, {"statistic.txt"}, QDir::Files, QDirIterator::Subdirectories);
+            QStringList found;
+            while (it.hasNext()) {
+                found.append(it.next());
+            }
+            found.sort();
+            files += found;
+        } else {
+            qDebug() << "Run path does not exist:" << path;
+        }
+    }
+    return files;
+}
+
+int RunSetLoader::load(const QStringList& statisticFiles, CounterStore& store)
+{
+    failed.clear();
+    store.reserveRuns(store.runCount() + statisticFiles.size());
+
+    int loaded = 0;
+    for (int begin = 0; begin < statisticFiles.size() && !WorkStealingPool::isCancelled(); begin += kBatchSize) {
+        int count = qMin(kBatchSize, static_cast<int>(statisticFiles.size()) - begin);
+        std::vector<std::unique_ptr<StatsLoader>> loaders(count);
+        std::vector<char> ok(count, 0);
+
+        WorkStealingPool::instance().parallelFor(count, [&](int i) {
+            loaders[i] = std::make_unique<StatsLoader>();
+            ok[i] = loaders[i]->loadStatistics(statisticFiles[begin + i]);
+        });
+
+        for (int i = 0; i < count; ++i) {
+            const QString& path = statisticFiles[begin + i];
+            if (!ok[i]) {
+                failed.append(path);
+                continue;
+            }
+            // 运行以所在目录命名
+            store.addRun(QFileInfo(path).path(), path, *loaders[i]);
+            loaded++;
+        }
+    }
+
+    return loaded;
+}
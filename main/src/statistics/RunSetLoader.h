@@ -0,0 +1,25 @@
+#ifndef RUNSETLOADER_H
+#define RUNSETLOADER_H
+
+#include "CounterStore.h"
+#include <QString>
+#include <QStringList>
+
+// 批量加载多次运行的 statistic.txt 到列式存储
+// 文件分批在工作窃取线程池上并行解析，解析完的一批按输入顺序写入存储
+class RunSetLoader
+{
+public:
+    // 展开输入: 文件直接使用，目录递归查找 statistic.txt，结果按路径排序
+    static QStringList discoverRuns(const QStringList& paths);
+
+    // 加载所有文件，返回成功加载的运行数
+    int load(const QStringList& statisticFiles, CounterStore& store);
+
+    const QStringList& failedFiles() const { return failed; }
+
+private:
+    QStringList failed;
+};
+
+#endif // RUNSETLOADER_H
@@ -0,0 +1,111 @@
+#include "SetStatsLoader.h"
+#include <QFile>
+#include <QDir>
+#include <QRegularExpression>
+#include <QDebug>
+#include <cctype>
+
+SetStatsLoader::SetStatsLoader(const SetupModel& setup)
+    : setup(setup)
+{
+}
+
+QString SetStatsLoader::locateFile()
+{
+    // 与 statistic.txt 相同的查找顺序
+    QStringList possiblePaths = {
+        "files/set_statistic.txt",
+        "../files/set_statistic.txt",
+        "../../files/set_statistic.txt",
+        QDir::currentPath() + "/files/set_statistic.txt",
+        QDir::currentPath() + "/../files/set_statistic.txt"
+    };
+
+    for (const QString& path : possiblePaths) {
+        if (QFile::exists(path)) return path;
+    }
+    return QString();
+}
+
+bool SetStatsLoader::resolveGeometry(const QString& component, int& setCount, int& wayCount) const
+{
+    // L2Cache 的参数带 l2_ 前缀
+    QString prefix = setup.components.value(component).contains("l2_set_count") ? "l2_" : "";
+    if (setCount <= 0) setCount = setup.intParam(component, prefix + "set_count");
+    if (wayCount <= 0) wayCount = setup.intParam(component, prefix + "way_count");
+    return setCount > 0 && wayCount > 0;
+}
+
+bool SetStatsLoader::load(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Cannot open set_statistic.txt at" << path;
+        return false;
+    }
+
+    caches.clear();
+    QRegularExpression headerRe("^([A-Za-z]\\w*)(?:\\s+sets:(\\d+))?(?:\\s+ways:(\\d+))?$");
+    CacheSetStats* current = nullptr;
+    int lineNumber = 0;
+    int skipped = 0;
+
+    // 文件可能有几十万行，按字节解析数字
+    while (!file.atEnd()) {
+        QByteArray line = file.readLine();
+        lineNumber++;
+        int comment = line.indexOf('#');
+        if (comment >= 0) line.truncate(comment);
+        line = line.trimmed();
+        if (line.isEmpty()) continue;
+
+        if (!isdigit(static_cast<unsigned char>(line[0]))) {
+            QRegularExpressionMatch match = headerRe.match(QString::fromLatin1(line));
+            int setCount = match.captured(2).toInt();
+            int wayCount = match.captured(3).toInt();
+            if (!match.hasMatch() || !resolveGeometry(match.captured(1), setCount, wayCount)) {
+                qDebug() << "set_statistic.txt line" << lineNumber << ": unknown cache geometry, section skipped";
+                current = nullptr;
+                continue;
+            }
+
+            CacheSetStats& stats = caches[match.captured(1)];
+            stats.componentId = match.captured(1);
+            stats.setCount = setCount;
+            stats.wayCount = wayCount;
+            stats.accesses.fill(0, setCount);
+            stats.misses.fill(0, setCount);
+            stats.evictions.fill(0, setCount);
+            stats.wayHits.clear();
+            current = &stats;
+            continue;
+        }
+
+        if (!current) continue;
+
+        QList<QByteArray> fields = line.simplified().split(' ');
+        bool ok = fields.size() >= 4;
+        int set = ok ? fields[0].toInt(&ok) : -1;
+        if (!ok || set < 0 || set >= current->setCount) {
+            skipped++;
+            continue;
+        }
+
+        current->accesses[set] = fields[1].toUInt();
+        current->misses[set] = fields[2].toUInt();
+        current->evictions[set] = fields[3].toUInt();
+
+        int ways = qMin(current->wayCount, static_cast<int>(fields.size()) - 4);
+        if (ways > 0) {
+            if (current->wayHits.isEmpty()) current->wayHits.fill(0, current->setCount * current->wayCount);
+            quint32* row = current->wayHits.data() + static_cast<qsizetype>(set) * current->wayCount;
+            for (int way = 0; way < ways; ++way) {
+                row[way] = fields[4 + way].toUInt();
+            }
+        }
+    }
+
+    qDebug() << "Parsed set_statistic.txt from" << path << ":" << caches.size() << "caches,"
+             << skipped << "lines skipped";
+    return true;
+}
@@ -0,0 +1,44 @@
+#ifndef SETSTATSLOADER_H
+#define SETSTATSLOADER_H
+
+#include "SetupModel.h"
+#include <QString>
+#include <QVector>
+#include <QMap>
+
+// 一个缓存的逐组统计，按组号紧凑存放
+struct CacheSetStats {
+    QString componentId;
+    int setCount = 0;
+    int wayCount = 0;
+    QVector<quint32> accesses;      // [set]
+    QVector<quint32> misses;        // [set]
+    QVector<quint32> evictions;     // [set]
+    QVector<quint32> wayHits;       // [set * wayCount + way]，模拟器未输出时为空
+
+    bool hasWayHits() const { return !wayHits.isEmpty(); }
+};
+
+// 读取模拟器输出的逐组统计 (set_statistic.txt)
+// 每个缓存一段，段头为 "<组件> sets:<组数> ways:<路数>"，组数与路数省略时取 setup.txt 的配置；
+// 之后每行一组: "<组号> <访问> <缺失> <替换> [<第 0 路命中> ... <第 N-1 路命中>]"，未出现的组记为 0
+class SetStatsLoader
+{
+public:
+    explicit SetStatsLoader(const SetupModel& setup = SetupModel());
+
+    // 在默认位置查找 set_statistic.txt，找不到时返回空字符串
+    static QString locateFile();
+
+    bool load(const QString& path);
+
+    const QMap<QString, CacheSetStats>& getSetStats() const { return caches; }
+
+private:
+    bool resolveGeometry(const QString& component, int& setCount, int& wayCount) const;
+
+    SetupModel setup;
+    QMap<QString, CacheSetStats> caches;
+};
+
+#endif // SETSTATSLOADER_H
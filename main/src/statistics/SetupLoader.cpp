@@ -0,0 +1,95 @@
+#include "SetupLoader.h"
+#include <QFile>
+#include <QTextStream>
+#include <QRegularExpression>
+#include <QDir>
+
+SetupLoader::SetupLoader()
+{
+}
+
+bool SetupLoader::loadSetup()
+{
+    // 与 statistic.txt 相同的查找顺序
+    QStringList possiblePaths = {
+        "files/setup.txt",
+        "../files/setup.txt",
+        "../../files/setup.txt",
+        QDir::currentPath() + "/files/setup.txt",
+        QDir::currentPath() + "/../files/setup.txt"
+    };
+
+    for (const QString& path : possiblePaths) {
+        if (QFile::exists(path)) {
+            return loadSetup(path);
+        }
+    }
+
+    qDebug() << "Cannot find setup.txt in any of the expected locations";
+    return false;
+}
+
+bool SetupLoader::loadSetup(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        qDebug() << "Cannot open setup.txt at" << path;
+        return false;
+    }
+
+    setup = SetupModel();
+
+    QRegularExpression headerRe("^(\\S+)\\s+@\\d+tick");
+    QRegularExpression portRe("^node_id_of_port_(\\d+)$");
+    QRegularExpression edgeRe("^(\\d+)\\s+to\\s+(\\d+)$");
+
+    QTextStream in(&file);
+    QString currentComponent;
+
+    while (!in.atEnd()) {
+        QString line = in.readLine();
+
+        // 去掉行尾注释
+        int commentPos = line.indexOf("//");
+        if (commentPos >= 0) line.truncate(commentPos);
+        line = line.trimmed();
+        if (line.isEmpty()) continue;
+
+        // 检测组件开始
+        QRegularExpressionMatch header = headerRe.match(line);
+        if (header.hasMatch()) {
+            currentComponent = header.captured(1);
+            setup.components[currentComponent];
+            continue;
+        }
+
+        int colonPos = line.indexOf(':');
+        if (colonPos < 0 || currentComponent.isEmpty()) continue;
+
+        QString key = line.left(colonPos).trimmed();
+        QString value = line.mid(colonPos + 1).trimmed();
+
+        // 总线拓扑: 端口映射与边
+        QRegularExpressionMatch portMatch = portRe.match(key);
+        if (portMatch.hasMatch()) {
+            setup.portToNode[portMatch.captured(1).toInt()] = value.toInt();
+            continue;
+        }
+        if (key == "edge") {
+            QRegularExpressionMatch edgeMatch = edgeRe.match(value);
+            if (edgeMatch.hasMatch()) {
+                setup.edges.append(qMakePair(edgeMatch.captured(1).toInt(), edgeMatch.captured(2).toInt()));
+            }
+            continue;
+        }
+        if (key == "node_number") {
+            setup.portCount = value.toInt();
+        }
+
+        setup.components[currentComponent][key] = value;
+    }
+
+    qDebug() << "Parsed setup.txt from" << path << ":" << setup.components.size() << "components,"
+             << setup.portToNode.size() << "ports," << setup.edges.size() << "edges";
+    return true;
+}
@@ -0,0 +1,26 @@
+#ifndef SETUPLOADER_H
+#define SETUPLOADER_H
+
+#include "SetupModel.h"
+#include <QString>
+#include <QDebug>
+
+class SetupLoader
+{
+public:
+    SetupLoader();
+
+    // 在默认位置查找并加载 setup.txt
+    bool loadSetup();
+
+    // 从指定路径加载 setup.txt
+    bool loadSetup(const QString& path);
+
+    // 获取解析后的配置模型
+    const SetupModel& getSetup() const { return setup; }
+
+private:
+    SetupModel setup;
+};
+
+#endif // SETUPLOADER_H
@@ -0,0 +1,65 @@
+#ifndef SETUPMODEL_H
+#define SETUPMODEL_H
+
+#include <QString>
+#include <QStringList>
+#include <QMap>
+#include <QList>
+#include <QPair>
+
+// setup.txt 解析后的硬件配置模型
+struct SetupModel {
+    QMap<QString, QMap<QString, QString>> components; // 组件名 -> 配置参数
+    QMap<int, int> portToNode;                         // 端口 -> 总线节点 (node_id_of_port_X)
+    QList<QPair<int, int>> edges;                      // 总线有向边 (edge: a to b)
+    int portCount = 0;                                 // Bus 的 node_number (实为端口数量)
+
+    bool isEmpty() const { return components.isEmpty(); }
+
+    // 读取整数配置参数
+    int intParam(const QString& component, const QString& key, int defaultValue = 0) const
+    {
+        bool ok = false;
+        int value = components.value(component).value(key).toInt(&ok);
+        return ok ? value : defaultValue;
+    }
+
+    // 组件连接的端口，未连接总线时返回 -1
+    int portOf(const QString& component) const
+    {
+        return intParam(component, "port_id", -1);
+    }
+
+    // 端口上连接的组件，找不到时返回空字符串
+    QString componentOfPort(int port) const
+    {
+        for (auto it = components.begin(); it != components.end(); ++it) {
+            if (it.value().value("port_id") == QString::number(port)) {
+                return it.key();
+            }
+        }
+        return QString();
+    }
+
+    // 映射到某个总线节点的所有端口
+    QList<int> portsOfNode(int node) const
+    {
+        QList<int> ports;
+        for (auto it = portToNode.begin(); it != portToNode.end(); ++it) {
+            if (it.value() == node) ports.append(it.key());
+        }
+        return ports;
+    }
+
+    // 指定前缀的组件 (如 "L3Cache")，按名称排序
+    QStringList componentsWithPrefix(const QString& prefix) const
+    {
+        QStringList result;
+        for (auto it = components.begin(); it != components.end(); ++it) {
+            if (it.key().startsWith(prefix)) result.append(it.key());
+        }
+        return result;
+    }
+};
+
+#endif // SETUPMODEL_H
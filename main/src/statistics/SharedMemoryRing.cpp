@@ -0,0 +1,293 @@
+#include "SharedMemoryRing.h"
+#include <QElapsedTimer>
+#include <cstring>
+#include <new>
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+qint64 layoutSize(quint32 capacity, quint32 maxCounters)
+{
+    return static_cast<qint64>(sizeof(ShmRingHeader)) + static_cast<qint64>(maxCounters) * kShmNameBytes
+           + static_cast<qint64>(capacity) * sizeof(ShmCounterRecord);
+}
+
+QByteArray shmKey(const QString& name)
+{
+    // shm_open 要求名称以 '/' 开头且不含其它 '/'
+    QByteArray key = name.toLocal8Bit();
+    if (!key.startsWith('/')) key.prepend('/');
+    return key;
+}
+
+#ifdef Q_OS_UNIX
+QString systemError()
+{
+    return QString::fromLocal8Bit(strerror(errno));
+}
+
+// 把同名的旧共享内存标记为已废弃，仍映射着它的消费者据此重新 attach
+void retire(const QByteArray& key)
+{
+    int fd = shm_open(key.constData(), O_RDWR, 0600);
+    if (fd < 0) return;
+    struct stat info;
+    if (fstat(fd, &info) == 0 && info.st_size >= static_cast<off_t>(sizeof(ShmRingHeader))) {
+        void* memory = mmap(nullptr, sizeof(ShmRingHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (memory != MAP_FAILED) {
+            ShmRingHeader* old = static_cast<ShmRingHeader*>(memory);
+            if (old->magic == kShmRingMagic && old->version == kShmRingVersion) {
+                old->epoch.store(0, std::memory_order_release);
+            }
+            munmap(memory, sizeof(ShmRingHeader));
+        }
+    }
+    ::close(fd);
+}
+#endif
+
+}
+
+SharedMemoryRing::SharedMemoryRing()
+    : header(nullptr)
+    , names(nullptr)
+    , records(nullptr)
+    , mappedSize(0)
+    , cachedHead(0)
+    , cachedTail(0)
+    , epoch(0)
+{
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    detach();
+}
+
+bool SharedMemoryRing::create(const QString& name, quint32 capacity, quint32 maxCounters)
+{
+    detach();
+#ifdef Q_OS_UNIX
+    // 容量取 2 的幂，下标用掩码回绕
+    quint32 rounded = 1;
+    while (rounded < capacity && rounded < (1u << 30)) rounded <<= 1;
+
+    // 不在消费者仍映射着的共享内存上重新初始化 (会重置 head/tail，改变大小时消费者还会 SIGBUS)，
+    // 而是废弃旧的并删除名称，再独占地创建新的
+    QByteArray key = shmKey(name);
+    retire(key);
+    shm_unlink(key.constData());
+    int fd = shm_open(key.constData(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) return fail(QString("shm_open %1: %2").arg(name, systemError()));
+
+    qint64 size = layoutSize(rounded, maxCounters);
+    if (ftruncate(fd, size) != 0) {
+        QString message = systemError();
+        ::close(fd);
+        return fail(QString("ftruncate %1: %2").arg(name, message));
+    }
+    if (!map(fd, size)) return false;
+
+    // 先初始化其余字段，最后写入魔数，消费者以魔数判断是否已就绪
+    header = new (header) ShmRingHeader;
+    header->magic = 0;
+    header->version = kShmRingVersion;
+    header->capacity = rounded;
+    header->maxCounters = maxCounters;
+    epoch = qMax<qint64>(1, monotonicNs());
+    header->epoch.store(epoch, std::memory_order_relaxed);
+    header->counterCount.store(0, std::memory_order_relaxed);
+    header->head.store(0, std::memory_order_relaxed);
+    header->tail.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = kShmRingMagic;
+
+    names = reinterpret_cast<char*>(header) + sizeof(ShmRingHeader);
+    records = reinterpret_cast<ShmCounterRecord*>(names + static_cast<qint64>(maxCounters) * kShmNameBytes);
+    cachedHead = 0;
+    cachedTail = 0;
+    return true;
+#else
+    Q_UNUSED(name);
+    Q_UNUSED(capacity);
+    Q_UNUSED(maxCounters);
+    return fail("Shared-memory ingestion needs a POSIX system");
+#endif
+}
+
+bool SharedMemoryRing::attach(const QString& name)
+{
+    detach();
+#ifdef Q_OS_UNIX
+    QByteArray key = shmKey(name);
+    int fd = shm_open(key.constData(), O_RDWR, 0600);
+    if (fd < 0) return fail(QString("shm_open %1: %2").arg(name, systemError()));
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(ShmRingHeader))) {
+        ::close(fd);
+        return fail(QString("%1 is not a counter ring").arg(name));
+    }
+    if (!map(fd, info.st_size)) return false;
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (header->magic != kShmRingMagic || header->version != kShmRingVersion
+        || layoutSize(header->capacity, header->maxCounters) > mappedSize
+        || (header->capacity & (header->capacity - 1)) != 0
+        || header->epoch.load(std::memory_order_acquire) == 0) {
+        detach();
+        return fail(QString("%1 is not a version %2 counter ring").arg(name).arg(kShmRingVersion));
+    }
+
+    names = reinterpret_cast<char*>(header) + sizeof(ShmRingHeader);
+    records = reinterpret_cast<ShmCounterRecord*>(names + static_cast<qint64>(header->maxCounters) * kShmNameBytes);
+    cachedHead = header->head.load(std::memory_order_acquire);
+    cachedTail = header->tail.load(std::memory_order_acquire);
+    epoch = header->epoch.load(std::memory_order_acquire);
+    return true;
+#else
+    Q_UNUSED(name);
+    return fail("Shared-memory ingestion needs a POSIX system");
+#endif
+}
+
+bool SharedMemoryRing::map(int fd, qint64 size)
+{
+#ifdef Q_OS_UNIX
+    void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    QString message = memory == MAP_FAILED ? systemError() : QString();
+    ::close(fd);
+    if (memory == MAP_FAILED) return fail(QString("mmap: %1").arg(message));
+
+    header = static_cast<ShmRingHeader*>(memory);
+    mappedSize = size;
+    return true;
+#else
+    Q_UNUSED(fd);
+    Q_UNUSED(size);
+    return false;
+#endif
+}
+
+void SharedMemoryRing::detach()
+{
+#ifdef Q_OS_UNIX
+    if (header) munmap(header, mappedSize);
+#endif
+    header = nullptr;
+    names = nullptr;
+    records = nullptr;
+    mappedSize = 0;
+    epoch = 0;
+}
+
+bool SharedMemoryRing::unlink(const QString& name)
+{
+#ifdef Q_OS_UNIX
+    return shm_unlink(shmKey(name).constData()) == 0;
+#else
+    Q_UNUSED(name);
+    return false;
+#endif
+}
+
+bool SharedMemoryRing::isRetired() const
+{
+    return header && header->epoch.load(std::memory_order_acquire) != epoch;
+}
+
+int SharedMemoryRing::registerCounter(const QString& name)
+{
+    if (!header) return -1;
+    quint32 id = header->counterCount.load(std::memory_order_relaxed);
+    if (id >= header->maxCounters) return -1;
+
+    QByteArray utf8 = name.toUtf8().left(kShmNameBytes - 1);
+    char* slot = names + static_cast<qint64>(id) * kShmNameBytes;
+    memset(slot, 0, kShmNameBytes);
+    memcpy(slot, utf8.constData(), utf8.size());
+
+    // 名称写完后才发布编号
+    header->counterCount.store(id + 1, std::memory_order_release);
+    return static_cast<int>(id);
+}
+
+int SharedMemoryRing::push(const ShmCounterRecord* input, int count)
+{
+    if (!header || count <= 0) return 0;
+    const quint64 capacity = header->capacity;
+    const quint64 mask = capacity - 1;
+    const quint64 head = header->head.load(std::memory_order_relaxed);
+
+    // 只在缓存的 tail 显示空间不足时才读取消费者的位置
+    if (head - cachedTail + count > capacity) {
+        cachedTail = header->tail.load(std::memory_order_acquire);
+    }
+    int writable = static_cast<int>(qMin<quint64>(count, capacity - (head - cachedTail)));
+    for (int i = 0; i < writable; ++i) {
+        records[(head + i) & mask] = input[i];
+    }
+    header->head.store(head + writable, std::memory_order_release);
+    return writable;
+}
+
+int SharedMemoryRing::pop(ShmCounterRecord* output, int maxCount)
+{
+    if (!header || maxCount <= 0 || isRetired()) return 0;
+    const quint64 mask = header->capacity - 1;
+    const quint64 tail = header->tail.load(std::memory_order_relaxed);
+
+    if (cachedHead == tail) {
+        cachedHead = header->head.load(std::memory_order_acquire);
+    }
+    int readable = static_cast<int>(qMin<quint64>(maxCount, cachedHead - tail));
+    for (int i = 0; i < readable; ++i) {
+        output[i] = records[(tail + i) & mask];
+    }
+    header->tail.store(tail + readable, std::memory_order_release);
+    return readable;
+}
+
+QString SharedMemoryRing::counterName(quint32 counter) const
+{
+    if (!header || counter >= header->counterCount.load(std::memory_order_acquire)) return QString();
+    const char* slot = names + static_cast<qint64>(counter) * kShmNameBytes;
+    return QString::fromUtf8(slot, static_cast<int>(strnlen(slot, kShmNameBytes)));
+}
+
+quint32 SharedMemoryRing::counterCount() const
+{
+    return header ? header->counterCount.load(std::memory_order_acquire) : 0;
+}
+
+quint32 SharedMemoryRing::capacity() const
+{
+    return header ? header->capacity : 0;
+}
+
+qint64 SharedMemoryRing::monotonicNs()
+{
+#ifdef Q_OS_UNIX
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<qint64>(now.tv_sec) * 1000000000 + now.tv_nsec;
+#else
+    static QElapsedTimer clock;
+    if (!clock.isValid()) clock.start();
+    return clock.nsecsElapsed();
+#endif
+}
+
+bool SharedMemoryRing::fail(const QString& message)
+{
+    error = message;
+    return false;
+}
@@ -0,0 +1,99 @@
+#ifndef SHAREDMEMORYRING_H
+#define SHAREDMEMORYRING_H
+
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+
+// 模拟器与本工具之间的 POSIX 共享内存环形缓冲区 (单生产者/单消费者，无锁)
+// 布局: ShmRingHeader | 计数器名称表 (maxCounters × kShmNameBytes) | 记录环 (capacity × ShmCounterRecord)
+// 生产者先登记计数器名称得到编号，再按转储写入记录；一次转储的最后一条记录带 kShmEndOfDump 标志。
+// 生产者重启时把旧共享内存的 epoch 置 0 并删除其名称，再以同名创建新的共享内存；仍映射着旧共享内存的消费者
+// 由 epoch 的变化得知需要重新映射，旧共享内存的其余内容不会被改动。
+// 模拟器可以直接包含本头文件，按同样的布局写入
+
+const quint32 kShmRingMagic = 0x50505652;   // "PPVR"
+const quint32 kShmRingVersion = 2;
+const int kShmNameBytes = 64;               // 含结尾的 '\0'
+const quint32 kShmEndOfDump = 1;
+
+struct ShmCounterRecord {
+    quint64 tick;           // 模拟时刻
+    qint64 sendNs;          // 生产者写入时的 CLOCK_MONOTONIC 纳秒，用于测量端到端延迟
+    quint32 counter;        // 计数器编号 (名称表下标)
+    quint32 flags;
+    double value;
+};
+
+struct ShmRingHeader {
+    quint32 magic;
+    quint32 version;
+    quint32 capacity;                       // 记录数，2 的幂
+    quint32 maxCounters;
+    std::atomic<quint64> epoch;             // 创建时刻 (非零)，被新的生产者取代时置 0
+    std::atomic<quint32> counterCount;      // 已登记的名称数 (生产者 release，消费者 acquire)
+    alignas(64) std::atomic<quint64> head;  // 生产者写到的位置
+    alignas(64) std::atomic<quint64> tail;  // 消费者读到的位置
+};
+
+static_assert(sizeof(ShmCounterRecord) == 32, "record layout is shared with the simulator");
+static_assert(std::atomic<quint64>::is_always_lock_free, "ring indices must be lock-free across processes");
+
+class SharedMemoryRing
+{
+public:
+    SharedMemoryRing();
+    ~SharedMemoryRing();
+
+    SharedMemoryRing(const SharedMemoryRing&) = delete;
+    SharedMemoryRing& operator=(const SharedMemoryRing&) = delete;
+
+    // 生产者: 创建共享内存，name 形如 "/ppv-live"；同名的已存在时将其废弃并删除名称后重新创建
+    bool create(const QString& name, quint32 capacity = 1u << 16, quint32 maxCounters = 8192);
+
+    // 消费者: 映射已有的共享内存
+    bool attach(const QString& name);
+
+    void detach();
+
+    // 删除共享内存的名称，已映射的进程不受影响
+    static bool unlink(const QString& name);
+
+    bool isAttached() const { return header != nullptr; }
+
+    // 消费者: 映射的共享内存已被重启的生产者废弃，需要按名称重新 attach
+    bool isRetired() const;
+
+    // 生产者: 登记计数器，返回编号；名称表已满时返回 -1
+    int registerCounter(const QString& name);
+
+    // 生产者: 写入最多 count 条记录，返回实际写入数 (环满时少于 count)
+    int push(const ShmCounterRecord* records, int count);
+
+    // 消费者: 取出最多 maxCount 条记录，返回取出数；共享内存已被废弃时返回 0
+    int pop(ShmCounterRecord* records, int maxCount);
+
+    QString counterName(quint32 counter) const;
+    quint32 counterCount() const;
+    quint32 capacity() const;
+
+    // 与生产者共用的单调时钟
+    static qint64 monotonicNs();
+
+    const QString& errorString() const { return error; }
+
+private:
+    bool map(int fd, qint64 size);
+    bool fail(const QString& message);
+
+    ShmRingHeader* header;
+    char* names;
+    ShmCounterRecord* records;
+    qint64 mappedSize;
+    quint64 cachedHead;     // 消费者缓存的 head，减少对生产者缓存行的读取
+    quint64 cachedTail;     // 生产者缓存的 tail
+    quint64 epoch;          // 映射时共享内存的 epoch
+    QString error;
+};
+
+#endif // SHAREDMEMORYRING_H
@@ -1,6 +1,7 @@
 #include "StatsDisplayer.h"
 #include <QLabel>
 #include <QPushButton>
+#include <cmath>
 
 StatsDisplayer::StatsDisplayer(DataVisualizer* visualizer, QObject* parent)
     : QObject(parent), visualizer(visualizer)
@@ -14,6 +15,34 @@ void StatsDisplayer::setStatsData(const QMap<QString, ComponentStats>& statsData
     this->portTransmissions = portTransmissions;
 }
 
+void StatsDisplayer::setMissRatioCurves(const QMap<QString, MissRatioCurve>& curves)
+{
+    missRatioCurves = curves;
+}
+
+void StatsDisplayer::setSetup(const SetupModel& setup)
+{
+    this->setup = setup;
+}
+
+void StatsDisplayer::setSetStats(const QMap<QString, CacheSetStats>& setStats)
+{
+    this->setStats = setStats;
+}
+
+void StatsDisplayer::setRunAggregate(const RunAggregator& aggregate, const CounterStore& currentRun)
+{
+    runAggregate = aggregate;
+    
+    // Values of the loaded run, in the same units as the aggregate (rates in [0, 1])
+    currentRunValues.clear();
+    if (currentRun.runCount() > 0) {
+        for (int column = 0; column < currentRun.columnCount(); ++column) {
+            currentRunValues.insert(currentRun.columnName(column), currentRun.column(column)[0]);
+        }
+    }
+}
+
 void StatsDisplayer::showComponentData(const QString& componentId, QVBoxLayout* layout)
 {
     visualizer->clearDataPanel(layout);
@@ -43,9 +72,38 @@ void StatsDisplayer::showComponentData(const QString& componentId, QVBoxLayout*
         showBusNodeData(componentId, layout);
     }
     
+    if (runAggregate.runCount() > 0) {
+        showRunDistribution(componentId, layout);
+    }
+    
     layout->addStretch();
 }
 
+void StatsDisplayer::showRunDistribution(const QString& componentId, QVBoxLayout* layout)
+{
+    QStringList counters;
+    QVector<double> current;
+    QVector<CounterDistribution> distributions;
+    
+    // Column names are "<component>.<counter>"
+    const QString prefix = componentId + ".";
+    const QStringList& columns = runAggregate.columnNames();
+    for (int i = 0; i < columns.size(); ++i) {
+        if (!columns[i].startsWith(prefix)) continue;
+        const CounterDistribution& distribution = runAggregate.distributions()[i];
+        if (distribution.samples == 0) continue;
+        
+        counters.append(columns[i].mid(prefix.size()));
+        current.append(currentRunValues.value(columns[i], std::nan("")));
+        distributions.append(distribution);
+    }
+    
+    if (counters.isEmpty()) return;
+    
+    layout->addWidget(visualizer->createDistributionGroup(
+        QString("Across %1 Runs").arg(runAggregate.runCount()), counters, current, distributions));
+}
+
 void StatsDisplayer::showCPUData(const ComponentStats& stats, QVBoxLayout* layout)
 {
     // Basic performance metrics
@@ -174,4 +232,12 @@ void StatsDisplayer::showL2CacheData(const ComponentStats& stats, QVBoxLayout* l
         layout->addWidget(visualizer->createPercentageBar("L2 Hit Rate", 
                                  stats.percentages["l2_hit_rate"], QColor(255, 193, 7)));
     }
+    
+    if (missRatioCurves.contains(stats.name)) {
+        layout->addWidget(visualizer->createMissRatioChart(missRatioCurves[stats.name]));
+    }
+    
+    if (setStats.contains(stats.name)) {
+        layout->addWidget(visualizer->createCacheHeatmap(setStats[stats.name]));
+    }
 } 
\ No newline at end of file
@@ -2,6 +2,17 @@
 #define STATSDISPLAYER_H
 
 #include "ComponentStats.h"
+#include "../analysis/MissRatioCurve.h"
+#include "../analysis/DesignSpaceExplorer.h"
+#include "../analysis/ConservationValidator.h"
+#include "../analysis/NucaBalance.h"
+#include "../analysis/RunAggregator.h"
+#include "../analysis/RegressionDetector.h"
+#include "../analysis/QueryEngine.h"
+#include "SetupModel.h"
+#include "SetStatsLoader.h"
+#include "RunCatalog.h"
+#include "RunManager.h"
 #include "../ui/DataVisualizer.h"
 #include <QVBoxLayout>
 #include <QMap>
@@ -19,6 +30,18 @@ public:
     void setStatsData(const QMap<QString, ComponentStats>& statsData, 
                       const QMap<QString, QString>& portTransmissions);
     
+    // 设置缓存的缺失率曲线 (来自地址 trace)
+    void setMissRatioCurves(const QMap<QString, MissRatioCurve>& curves);
+    
+    // 设置硬件配置 (setup.txt)
+    void setSetup(const SetupModel& setup);
+    
+    // 设置缓存的逐组统计 (set_statistic.txt)
+    void setSetStats(const QMap<QString, CacheSetStats>& setStats);
+    
+    // 设置多次运行的汇总，组件面板在单次运行的数据后显示其分布
+    void setRunAggregate(const RunAggregator& aggregate, const CounterStore& currentRun);
+    
     // 显示组件数据
     void showComponentData(const QString& componentId, QVBoxLayout* layout);
     
@@ -36,13 +59,56 @@ public:
     // 端口传输概览
     void showPortTransmissionOverview(QVBoxLayout* layout);
     
+    // 缓存事件的逐段延迟分解
+    void showLatencyBreakdown(QVBoxLayout* layout);
+    
+    // 守恒关系校验结果
+    void showValidationReport(const CounterStore& store, const QVector<ValidationIssue>& issues,
+                              int ruleInstances, QVBoxLayout* layout);
+    
+    // L3 分片负载均衡
+    void showNucaBalance(const NucaSnapshot& snapshot, const QStringList& slices, QVBoxLayout* layout);
+    
+    // 两组运行之间显著变化的计数器
+    void showRegressionReport(const QVector<CounterComparison>& comparisons, int baselineRuns,
+                              int candidateRuns, QVBoxLayout* layout);
+    
+    // 打开的运行与内存预算
+    void showOpenRuns(const QVector<RunManager::RunStatus>& runs, qint64 usage, qint64 budget,
+                      const QString& activeId, QVBoxLayout* layout);
+    
+    // 计数器搜索结果，elapsedMicroseconds 为索引查询耗时
+    void showSearchResults(const QString& query, const QVector<CounterSearch::Match>& matches,
+                           int documentCount, double elapsedMicroseconds, QVBoxLayout* layout);
+    
+    // 查询结果，sourceLabel 说明查询的是哪组运行
+    void showQueryResult(const QString& query, const QueryResult& result, const QString& sourceLabel,
+                         QVBoxLayout* layout);
+    
+    // 运行目录索引: 更新统计与运行列表
+    void showRunCatalog(const RunCatalog& catalog, int reparsed, QVBoxLayout* layout);
+    
+    // 多次运行汇总的概览
+    void showRunAggregateSummary(int failedRuns, QVBoxLayout* layout);
+    
+    // 设计空间探索: 帕累托散点图 + 选中配置的预测统计
+    void showDesignSpaceExploration(DesignSpaceExplorer* explorer, QVBoxLayout* layout);
+    
     // 重置面板到初始状态
     void resetDataPanel(QVBoxLayout* layout);
 
 private:
+    // 组件各计数器在多次运行中的分布
+    void showRunDistribution(const QString& componentId, QVBoxLayout* layout);
+    
     DataVisualizer* visualizer;
     QMap<QString, ComponentStats> statsData;
     QMap<QString, QString> portTransmissions;
+    QMap<QString, MissRatioCurve> missRatioCurves;
+    QMap<QString, CacheSetStats> setStats;
+    RunAggregator runAggregate;
+    QHash<QString, double> currentRunValues;    // 列名 -> 当前运行的值，与汇总使用相同单位
+    SetupModel setup;
 };
 
 #endif // STATSDISPLAYER_H 
\ No newline at end of file
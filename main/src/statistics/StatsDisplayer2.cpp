@@ -1,7 +1,12 @@
 #include "StatsDisplayer.h"
 #include <QLabel>
 #include <QPushButton>
+#include <QProgressBar>
+#include <QSet>
+#include "../ui/ParetoScatterChart.h"
 #include <algorithm>
+#include <cmath>
+#include <functional>
 
 void StatsDisplayer::showL3CacheData(const ComponentStats& stats, QVBoxLayout* layout)
 {
@@ -56,6 +61,14 @@ void StatsDisplayer::showL3CacheData(const ComponentStats& stats, QVBoxLayout* l
         layout->addWidget(visualizer->createPercentageBar("LLC Hit Rate", 
                                  stats.percentages["llc_hit_rate"], QColor(108, 117, 125)));
     }
+    
+    if (missRatioCurves.contains(stats.name)) {
+        layout->addWidget(visualizer->createMissRatioChart(missRatioCurves[stats.name]));
+    }
+    
+    if (setStats.contains(stats.name)) {
+        layout->addWidget(visualizer->createCacheHeatmap(setStats[stats.name]));
+    }
 }
 
 void StatsDisplayer::showMemoryData(const ComponentStats& stats, QVBoxLayout* layout)
@@ -324,77 +337,46 @@ void StatsDisplayer::showPortTransmissionOverview(QVBoxLayout* layout)
     QLabel* titleLabel = visualizer->createTitleLabel("Port Transmission Overview");
     layout->addWidget(titleLabel);
     
-    // Create port mapping description
-    QMap<QString, QString> portMapping;
-    portMapping["Port 0"] = "L2Cache0";
-    portMapping["Port 1"] = "L3Cache0";
-    portMapping["Port 2"] = "L2Cache1";
-    portMapping["Port 3"] = "L3Cache1";
-    portMapping["Port 4"] = "MemoryNode0 (Primary)";
-    portMapping["Port 5"] = "L2Cache2";
-    portMapping["Port 6"] = "L3Cache2";
-    portMapping["Port 7"] = "L2Cache3";
-    portMapping["Port 8"] = "L3Cache3";
-    portMapping["Port 9"] = "MemoryNode0 (Secondary)";
-    
-    layout->addWidget(visualizer->createDataGroup("Port Mapping", portMapping));
-    
-    // Collect all transmission data
-    QMap<int, int> portSentTotal;
-    QMap<int, int> portReceivedTotal;
-    QMap<QString, QString> topTransmissions;
+    // Ports are named after the component on them (port_id in setup.txt) and grouped by bus node
+    PortTraffic traffic = PortTraffic::fromCounters(portTransmissions, setup);
+    const QVector<PortTraffic::Port>& ports = traffic.ports();
+    layout->addWidget(visualizer->createPortChordChart(traffic));
     
-    for (auto it = portTransmissions.begin(); it != portTransmissions.end(); ++it) {
-        QString key = it.key();
-        QString value = it.value();
-        
-        QRegularExpression re("transmit_package_number_from_(\\d+)_to_(\\d+)");
-        QRegularExpressionMatch match = re.match(key);
-        if (match.hasMatch()) {
-            int fromPort = match.captured(1).toInt();
-            int toPort = match.captured(2).toInt();
-            int packageCount = value.toInt();
-            
-            portSentTotal[fromPort] += packageCount;
-            portReceivedTotal[toPort] += packageCount;
-            
-            // Collect important transmissions (>200 packages)
-            if (packageCount > 200) {
-                QString desc = QString("Port %1 → Port %2").arg(fromPort).arg(toPort);
-                topTransmissions[desc] = QString::number(packageCount);
-            }
-        }
+    // Largest flows, ranked so the group keeps their order
+    QMap<QString, QString> topTransmissions;
+    const QVector<PortTraffic::Flow>& flows = traffic.flows();
+    for (int i = 0; i < qMin(10, flows.size()); ++i) {
+        const PortTraffic::Flow& flow = flows[i];
+        QString desc = QString("#%1 %2 → %3").arg(i + 1, 2, 10, QChar('0'))
+                           .arg(ports[flow.from].label(), ports[flow.to].label());
+        topTransmissions[desc] = QString("%1 (%2%)").arg(flow.packets, 0, 'f', 0)
+                                     .arg(flow.packets / traffic.total() * 100, 0, 'f', 1);
+    }
+    if (!topTransmissions.isEmpty()) {
+        layout->addWidget(visualizer->createDataGroup("Largest Transmissions", topTransmissions));
     }
-    
-    // Show important transmissions
-    layout->addWidget(visualizer->createDataGroup("Major Transmissions (>200 packages)", topTransmissions));
     
     // Show send/receive statistics for each port
     QMap<QString, QString> portStats;
-    for (int i = 0; i <= 9; ++i) {
-        int sent = portSentTotal.value(i, 0);
-        int received = portReceivedTotal.value(i, 0);
-        if (sent > 0 || received > 0) {
-            portStats[QString("Port %1").arg(i)] = QString("Sent: %1, Received: %2").arg(sent).arg(received);
-        }
+    for (const PortTraffic::Port& port : ports) {
+        portStats[port.label()] = QString("Sent: %1, Received: %2").arg(port.sent, 0, 'f', 0).arg(port.received, 0, 'f', 0);
     }
     
     layout->addWidget(visualizer->createDataGroup("Port Traffic Summary", portStats));
     
     // Sort and show most active ports by transmission volume
-    QList<QPair<int, int>> activePortsSent;
-    for (auto it = portSentTotal.begin(); it != portSentTotal.end(); ++it) {
-        if (it.value() > 0) {
-            activePortsSent.append(qMakePair(it.value(), it.key()));
+    QList<QPair<double, int>> activePortsSent;
+    for (int i = 0; i < ports.size(); ++i) {
+        if (ports[i].sent > 0) {
+            activePortsSent.append(qMakePair(ports[i].sent, i));
         }
     }
-    std::sort(activePortsSent.begin(), activePortsSent.end(), std::greater<QPair<int, int>>());
+    std::sort(activePortsSent.begin(), activePortsSent.end(), std::greater<QPair<double, int>>());
     
     QMap<QString, QString> activePorts;
     for (int i = 0; i < qMin(5, activePortsSent.size()); ++i) {
-        int packages = activePortsSent[i].first;
-        int portId = activePortsSent[i].second;
-        activePorts[QString("Port %1").arg(portId)] = QString("%1 packages sent").arg(packages);
+        const PortTraffic::Port& port = ports[activePortsSent[i].second];
+        activePorts[port.label()] = QString("%1 packages sent").arg(port.sent, 0, 'f', 0);
     }
     
     if (!activePorts.isEmpty()) {
@@ -403,6 +385,7 @@ void StatsDisplayer::showPortTransmissionOverview(QVBoxLayout* layout)
     
     // Add back button
     QPushButton* backBtn = visualizer->createStyledButton("← Back to Component View", "#28a745", false);
+    backBtn->setObjectName("backBtn");
     // Note: Connection must be made in ChipWindow class
     layout->addWidget(backBtn);
     
@@ -415,14 +398,521 @@ void StatsDisplayer::resetDataPanel(QVBoxLayout* layout)
     
     // Re-add Port Transmission Overview button
     QPushButton* portOverviewBtn = visualizer->createStyledButton("Port Transmission Overview", "#007bff");
+    portOverviewBtn->setObjectName("portOverviewBtn");
     // Note: Connection must be made in ChipWindow class
     layout->addWidget(portOverviewBtn);
     
+    QPushButton* latencyBtn = visualizer->createStyledButton("Miss Latency Breakdown", "#fd7e14");
+    latencyBtn->setObjectName("latencyBtn");
+    layout->addWidget(latencyBtn);
+    
+    QPushButton* nucaBtn = visualizer->createStyledButton("L3 Slice Balance", "#20c997");
+    nucaBtn->setObjectName("nucaBtn");
+    layout->addWidget(nucaBtn);
+    
+    QPushButton* validateBtn = visualizer->createStyledButton("Validate Data", "#dc3545");
+    validateBtn->setObjectName("validateBtn");
+    layout->addWidget(validateBtn);
+    
+    QPushButton* dseBtn = visualizer->createStyledButton("Design Space Exploration", "#6f42c1");
+    dseBtn->setObjectName("dseBtn");
+    layout->addWidget(dseBtn);
+    
+    QPushButton* aggregateBtn = visualizer->createStyledButton("Aggregate Run Directory...", "#17a2b8");
+    aggregateBtn->setObjectName("aggregateBtn");
+    layout->addWidget(aggregateBtn);
+    
+    QPushButton* compareBtn = visualizer->createStyledButton("Compare Run Sets...", "#e83e8c");
+    compareBtn->setObjectName("compareBtn");
+    layout->addWidget(compareBtn);
+    
+    QPushButton* catalogBtn = visualizer->createStyledButton("Run Catalog...", "#6610f2");
+    catalogBtn->setObjectName("catalogBtn");
+    layout->addWidget(catalogBtn);
+    
+    QPushButton* runsBtn = visualizer->createStyledButton("Open Runs", "#17a2b8");
+    runsBtn->setObjectName("runsBtn");
+    layout->addWidget(runsBtn);
+    
+    QPushButton* exportBtn = visualizer->createStyledButton("Export Arrow Files...", "#343a40");
+    exportBtn->setObjectName("exportBtn");
+    layout->addWidget(exportBtn);
+    
+    QPushButton* liveBtn = visualizer->createStyledButton("Live Ingestion (Start/Stop)...", "#198754");
+    liveBtn->setObjectName("liveBtn");
+    layout->addWidget(liveBtn);
+    
+    QPushButton* serverBtn = visualizer->createStyledButton("HTTP Server (Start/Stop)...", "#6f42c1");
+    serverBtn->setObjectName("serverBtn");
+    layout->addWidget(serverBtn);
+    
+    layout->addWidget(visualizer->createQueryBox());
+    
     // Initialize hint
-    QLabel* hintLabel = new QLabel("Click on any component to view its statistics\n\nOr click the button above to see port transmission overview");
+    QLabel* hintLabel = new QLabel("Click on any component to view its statistics\n\nOr use the buttons above for port traffic, miss latency and cache design space analysis");
     hintLabel->setStyleSheet("color: #6c757d; font-size: 14px; font-style: italic; text-align: center;");
     hintLabel->setAlignment(Qt::AlignCenter);
     hintLabel->setWordWrap(true);
     layout->addWidget(hintLabel);
     layout->addStretch();
-} 
\ No newline at end of file
+}
+
+void StatsDisplayer::showLatencyBreakdown(QVBoxLayout* layout)
+{
+    visualizer->clearDataPanel(layout);
+    
+    layout->addWidget(visualizer->createTitleLabel("Miss Latency Breakdown"));
+    
+    LatencyDecomposer decomposer(setup, statsData, portTransmissions);
+    QVector<EventLatency> events = decomposer.decompose();
+    
+    layout->addWidget(visualizer->createLatencyWaterfall(events));
+    
+    // Where the cycles of each event class go
+    for (const EventLatency& event : events) {
+        if (event.avgCycles <= 0) continue;
+        
+        QMap<QString, QString> breakdown;
+        breakdown["Events"] = QString::number(event.count);
+        breakdown["Avg Latency"] = QString::number(event.avgCycles, 'f', 2) + " cycles";
+        breakdown["Cache Lookup"] = QString::number(event.lookupCycles(), 'f', 2) + " cycles";
+        breakdown["Bus Transit"] = QString::number(event.busCycles(), 'f', 2) + " cycles";
+        breakdown["DRAM"] = QString::number(event.memoryCycles(), 'f', 2) + " cycles";
+        breakdown["Queue/Other"] = QString::number(event.otherCycles(), 'f', 2) + " cycles";
+        layout->addWidget(visualizer->createDataGroup(event.label, breakdown));
+        
+        layout->addWidget(visualizer->createPercentageBar(event.label + " Bus Share",
+                                 event.busCycles() / event.avgCycles * 100, QColor(253, 126, 20)));
+        if (event.memoryCycles() > 0) {
+            layout->addWidget(visualizer->createPercentageBar(event.label + " DRAM Share",
+                                     event.memoryCycles() / event.avgCycles * 100, QColor(220, 53, 69)));
+        }
+    }
+    
+    // Bus transit = topology hops x cycles per hop, calibrated from avg_transmit_latency
+    QMap<QString, QString> model;
+    model["Bus Cycles per Hop"] = QString::number(decomposer.cyclesPerBusHop(), 'f', 2);
+    model["Bus Avg Transmit Latency"] = statsData.value("Bus").data.value("avg_transmit_latency", "N/A") + " cycles";
+    layout->addWidget(visualizer->createDataGroup("Bus Model", model));
+    
+    QPushButton* backBtn = visualizer->createStyledButton("← Back to Component View", "#28a745", false);
+    backBtn->setObjectName("backBtn");
+    layout->addWidget(backBtn);
+    
+    layout->addStretch();
+}
+
+void StatsDisplayer::showValidationReport(const CounterStore& store, const QVector<ValidationIssue>& issues,
+                                          int ruleInstances, QVBoxLayout* layout)
+{
+    visualizer->clearDataPanel(layout);
+    
+    layout->addWidget(visualizer->createTitleLabel("Data Validation"));
+    
+    int errors = 0;
+    for (const ValidationIssue& issue : issues) {
+        if (issue.severity == ValidationIssue::Error) errors++;
+    }
+    
+    QMap<QString, QString> summary;
+    summary["Runs Checked"] = QString::number(store.runCount());
+    summary["Counters"] = QString::number(store.columnCount());
+    summary["Rule Instances"] = QString::number(ruleInstances);
+    summary["Errors"] = QString::number(errors);
+    summary["Warnings"] = QString::number(issues.size() - errors);
+    layout->addWidget(visualizer->createDataGroup("Summary", summary));
+    
+    if (issues.isEmpty()) {
+        QLabel* okLabel = new QLabel("All conservation laws hold");
+        okLabel->setStyleSheet("color: #28a745; font-size: 14px; font-weight: bold;");
+        okLabel->setAlignment(Qt::AlignCenter);
+        layout->addWidget(okLabel);
+    }
+    
+    // Group offending counters by run, errors before warnings
+    for (int index = 0; index < issues.size();) {
+        int run = issues[index].run;
+        QStringList errorItems, warningItems;
+        for (; index < issues.size() && issues[index].run == run; ++index) {
+            const ValidationIssue& issue = issues[index];
+            QString item = QString("<b>%1</b>: %2").arg(issue.rule.toHtmlEscaped(), issue.message.toHtmlEscaped());
+            if (!issue.counters.isEmpty()) {
+                item += "<br><span style='color: #6c757d;'>" + issue.counters.join(", ").toHtmlEscaped() + "</span>";
+            }
+            (issue.severity == ValidationIssue::Error ? errorItems : warningItems).append(item);
+        }
+        
+        QString runName = store.runCount() > 1 ? store.run(run).id + " - " : QString();
+        if (!errorItems.isEmpty()) {
+            layout->addWidget(visualizer->createIssueGroup(runName + "Errors", errorItems, QColor(220, 53, 69)));
+        }
+        if (!warningItems.isEmpty()) {
+            layout->addWidget(visualizer->createIssueGroup(runName + "Warnings", warningItems, QColor(255, 193, 7)));
+        }
+    }
+    
+    QPushButton* backBtn = visualizer->createStyledButton("← Back to Component View", "#28a745", false);
+    backBtn->setObjectName("backBtn");
+    layout->addWidget(backBtn);
+    
+    layout->addStretch();
+}
+
+void StatsDisplayer::showNucaBalance(const NucaSnapshot& snapshot, const QStringList& slices, QVBoxLayout* layout)
+{
+    visualizer->clearDataPanel(layout);
+    
+    layout->addWidget(visualizer->createTitleLabel("L3 Slice Balance"));
+    
+    auto describe = [](const ImbalanceMetric& metric) {
+        return QString("max/mean %1, CV %2").arg(metric.maxOverMean, 0, 'f', 3).arg(metric.cv, 0, 'f', 3);
+    };
+    
+    QMap<QString, QString> summary;
+    summary["Slices"] = QString::number(slices.size());
+    summary["Accesses"] = describe(snapshot.accessBalance);
+    summary["Misses"] = describe(snapshot.missBalance);
+    summary["Port Traffic"] = describe(snapshot.trafficBalance);
+    layout->addWidget(visualizer->createDataGroup("Imbalance", summary));
+    
+    // Load of each slice relative to the busiest one
+    double maxAccesses = 0;
+    for (double accesses : snapshot.accesses) maxAccesses = qMax(maxAccesses, accesses);
+    for (int i = 0; i < slices.size(); ++i) {
+        bool hot = snapshot.hotSlices.contains(i);
+        double share = maxAccesses > 0 ? snapshot.accesses[i] / maxAccesses * 100 : 0;
+        layout->addWidget(visualizer->createPercentageBar(
+            QString("%1 Accesses (of busiest)%2").arg(slices[i], hot ? " - HOT" : ""),
+            share, hot ? QColor(220, 53, 69) : QColor(40, 167, 69)));
+    }
+    
+    QMap<QString, QString> perSlice;
+    for (int i = 0; i < slices.size(); ++i) {
+        perSlice[slices[i]] = QString("%1 acc, %2 miss, %3 pkts")
+                                  .arg(snapshot.accesses[i], 0, 'f', 0)
+                                  .arg(snapshot.misses[i], 0, 'f', 0)
+                                  .arg(snapshot.traffic[i], 0, 'f', 0);
+    }
+    layout->addWidget(visualizer->createDataGroup("Slice Load", perSlice));
+    
+    QPushButton* backBtn = visualizer->createStyledButton("← Back to Component View", "#28a745", false);
+    backBtn->setObjectName("backBtn");
+    layout->addWidget(backBtn);
+    
+    layout->addStretch();
+}
+
+void StatsDisplayer::showRegressionReport(const QVector<CounterComparison>& comparisons, int baselineRuns,
+                                          int candidateRuns, QVBoxLayout* layout)
+{
+    visualizer->clearDataPanel(layout);
+    
+    layout->addWidget(visualizer->createTitleLabel("Regression Detection"));
+    
+    // Comparisons arrive sorted: regressions, improvements, other changes, then unchanged
+    QStringList regressions, improvements, changes;
+    for (const CounterComparison& comparison : comparisons) {
+        QStringList* items = comparison.direction == CounterComparison::Regression ? &regressions
+                           : comparison.direction == CounterComparison::Improvement ? &improvements
+                           : comparison.direction == CounterComparison::Changed ? &changes
+                           : nullptr;
+        if (!items) continue;
+        
+        items->append(QString("<b>%1</b>: median %2 → %3 (%4%5%)<br>"
+                              "<span style='color: #6c757d;'>Cliff's δ %6, q = %7</span>")
+                          .arg(comparison.column.toHtmlEscaped())
+                          .arg(comparison.baselineMedian, 0, 'g', 6)
+                          .arg(comparison.candidateMedian, 0, 'g', 6)
+                          .arg(comparison.relativeChange >= 0 ? "+" : "")
+                          .arg(comparison.relativeChange * 100, 0, 'f', 2)
+                          .arg(comparison.effectSize, 0, 'f', 2)
+                          .arg(comparison.qValue, 0, 'g', 3));
+    }
+    
+    QMap<QString, QString> summary;
+    summary["Baseline Runs"] = QString::number(baselineRuns);
+    summary["Candidate Runs"] = QString::number(candidateRuns);
+    summary["Counters Compared"] = QString::number(comparisons.size());
+    summary["Regressions"] = QString::number(regressions.size());
+    summary["Improvements"] = QString::number(improvements.size());
+    summary["Other Changes"] = QString::number(changes.size());
+    layout->addWidget(visualizer->createDataGroup("Mann-Whitney U, Benjamini-Hochberg FDR", summary));
+    
+    if (regressions.isEmpty() && improvements.isEmpty() && changes.isEmpty()) {
+        QLabel* okLabel = new QLabel("No counter moved beyond seed noise");
+        okLabel->setStyleSheet("color: #28a745; font-size: 14px; font-weight: bold;");
+        okLabel->setAlignment(Qt::AlignCenter);
+        layout->addWidget(okLabel);
+    }
+    
+    const int maxItems = 50;
+    if (!regressions.isEmpty()) {
+        layout->addWidget(visualizer->createIssueGroup("Regressions", regressions.mid(0, maxItems), QColor(220, 53, 69)));
+    }
+    if (!improvements.isEmpty()) {
+        layout->addWidget(visualizer->createIssueGroup("Improvements", improvements.mid(0, maxItems), QColor(40, 167, 69)));
+    }
+    if (!changes.isEmpty()) {
+        layout->addWidget(visualizer->createIssueGroup("Other Significant Changes", changes.mid(0, maxItems), QColor(108, 117, 125)));
+    }
+    
+    QPushButton* backBtn = visualizer->createStyledButton("← Back to Component View", "#28a745", false);
+    backBtn->setObjectName("backBtn");
+    layout->addWidget(backBtn);
+    
+    layout->addStretch();
+}
+
+void StatsDisplayer::showOpenRuns(const QVector<RunManager::RunStatus>& runs, qint64 usage, qint64 budget,
+                                  const QString& activeId, QVBoxLayout* layout)
+{
+    visualizer->clearDataPanel(layout);
+    
+    layout->addWidget(visualizer->createTitleLabel("Open Runs"));
+    
+    const double megabyte = 1024.0 * 1024.0;
+    layout->addWidget(visualizer->createPercentageBar(
+        QString("Memory Used (%1 of %2 MB)").arg(usage / megabyte, 0, 'f', 1).arg(budget / megabyte, 0, 'f', 0),
+        budget > 0 ? qMin(100.0, usage * 100.0 / budget) : 0, usage > budget ? QColor(220, 53, 69) : QColor(23, 162, 184)));
+    layout->addWidget(visualizer->createBudgetControl(static_cast<int>(budget / megabyte)));
+    
+    QPushButton* openRunBtn = visualizer->createStyledButton("Open Run...", "#17a2b8");
+    openRunBtn->setObjectName("openRunBtn");
+    layout->addWidget(openRunBtn);
+    
+    layout->addWidget(visualizer->createOpenRunList(runs, activeId));
+    
+    QLabel* hintLabel = new QLabel("Least recently used runs are compressed, then dropped, when the budget is exceeded. "
+                                   "They reload in the background when shown again.");
+    hintLabel->setStyleSheet("color: #6c757d; font-size: 12px; font-style: italic;");
+    hintLabel->setWordWrap(true);
+    layout->addWidget(hintLabel);
+    
+    QPushButton* backBtn = visualizer->createStyledButton("← Back to Component View", "#28a745", false);
+    backBtn->setObjectName("backBtn");
+    layout->addWidget(backBtn);
+    
+    layout->addStretch();
+}
+
+void StatsDisplayer::showQueryResult(const QString& query, const QueryResult& result, const QString& sourceLabel,
+                                     QVBoxLayout* layout)
+{
+    visualizer->clearDataPanel(layout);
+    
+    layout->addWidget(visualizer->createTitleLabel("Query Results"));
+    layout->addWidget(visualizer->createQueryBox(query));
+    
+    if (!result.error.isEmpty()) {
+        layout->addWidget(visualizer->createIssueGroup("Query Error", {result.error.toHtmlEscaped()}, QColor(220, 53, 69)));
+    } else {
+        QMap<QString, QString> summary;
+        summary["Source"] = sourceLabel;
+        summary["Matched Runs"] = QString("%1 of %2").arg(result.matchedRuns).arg(result.totalRuns);
+        summary["Chunks Skipped"] = QString("%1 of %2").arg(result.skippedChunks).arg(result.chunkCount);
+        summary["Time"] = QString("%1 ms").arg(result.elapsedMs);
+        layout->addWidget(visualizer->createDataGroup("Execution", summary));
+        
+        if (result.aggregate) {
+            QMap<QString, QString> values;
+            for (int i = 0; i < result.columnNames.size(); ++i) {
+                double value = result.columns[i][0];
+                values[result.columnNames[i]] = std::isnan(value) ? QString("-") : QString::number(value, 'g', 6);
+            }
+            layout->addWidget(visualizer->createDataGroup("Aggregates", values));
+        } else {
+            layout->addWidget(visualizer->createRunTable("Matching Runs", result.runIds, result.columnNames, result.columns));
+        }
+    }
+    
+    QPushButton* backBtn = visualizer->createStyledButton("← Back to Component View", "#28a745", false);
+    backBtn->setObjectName("backBtn");
+    layout->addWidget(backBtn);
+    
+    layout->addStretch();
+}
+
+void StatsDisplayer::showRunCatalog(const RunCatalog& catalog, int reparsed, QVBoxLayout* layout)
+{
+    visualizer->clearDataPanel(layout);
+    
+    layout->addWidget(visualizer->createTitleLabel("Run Catalog"));
+    
+    QSet<QByteArray> setups;
+    for (int i = 0; i < catalog.size(); ++i) {
+        setups.insert(catalog.entry(i).setupHash);
+    }
+    
+    QMap<QString, QString> summary;
+    summary["Runs Indexed"] = QString::number(catalog.size());
+    summary["Parsed This Update"] = QString::number(reparsed);
+    summary["Unchanged"] = QString::number(catalog.unchangedCount());
+    summary["Removed"] = QString::number(catalog.removedCount());
+    summary["Distinct Setups"] = QString::number(setups.size());
+    summary["Summary Columns"] = QString::number(catalog.summaryColumns().size());
+    layout->addWidget(visualizer->createDataGroup("Catalog", summary));
+    
+    // Headline metrics; everything else is reachable through queries
+    const QStringList preferred = {"CPU0.ipc", "L2Cache0.l2_hit_rate", "L3Cache0.llc_hit_rate",
+                                   "Bus.avg_transmit_latency"};
+    QStringList columnNames;
+    for (const QString& column : preferred) {
+        if (catalog.summaryColumns().contains(column)) columnNames.append(column);
+    }
+    
+    QStringList runIds;
+    QVector<QVector<double>> columns(columnNames.size());
+    runIds.reserve(catalog.size());
+    for (int i = 0; i < catalog.size(); ++i) {
+        runIds.append(catalog.entry(i).id);
+        for (int column = 0; column < columnNames.size(); ++column) {
+            columns[column].append(catalog.value(i, columnNames[column]));
+        }
+    }
+    layout->addWidget(visualizer->createRunTable("Runs", runIds, columnNames, columns));
+    
+    QPushButton* backBtn = visualizer->createStyledButton("← Back to Component View", "#28a745", false);
+    backBtn->setObjectName("backBtn");
+    layout->addWidget(backBtn);
+    
+    layout->addStretch();
+}
+
+void StatsDisplayer::showRunAggregateSummary(int failedRuns, QVBoxLayout* layout)
+{
+    visualizer->clearDataPanel(layout);
+    
+    layout->addWidget(visualizer->createTitleLabel("Run Set Summary"));
+    
+    QMap<QString, QString> summary;
+    summary["Runs Aggregated"] = QString::number(runAggregate.runCount());
+    summary["Failed Files"] = QString::number(failedRuns);
+    summary["Counters"] = QString::number(runAggregate.columnNames().size());
+    layout->addWidget(visualizer->createDataGroup("Run Set", summary));
+    
+    // Counters that vary the most between seeds, by coefficient of variation
+    QVector<QPair<double, int>> variability;
+    const QVector<CounterDistribution>& distributions = runAggregate.distributions();
+    for (int i = 0; i < distributions.size(); ++i) {
+        const CounterDistribution& distribution = distributions[i];
+        if (distribution.samples < 2 || distribution.mean == 0) continue;
+        variability.append({distribution.stddev / std::fabs(distribution.mean), i});
+    }
+    std::sort(variability.begin(), variability.end(), std::greater<QPair<double, int>>());
+    
+    QStringList counters;
+    QVector<double> current;
+    QVector<CounterDistribution> selected;
+    for (int i = 0; i < variability.size() && i < 15; ++i) {
+        int column = variability[i].second;
+        counters.append(runAggregate.columnNames()[column]);
+        current.append(currentRunValues.value(counters.last(), std::nan("")));
+        selected.append(distributions[column]);
+    }
+    if (!counters.isEmpty()) {
+        layout->addWidget(visualizer->createDistributionGroup("Most Variable Counters", counters, current, selected));
+    }
+    
+    QLabel* hintLabel = new QLabel("Click on any component to compare the loaded run with the distribution");
+    hintLabel->setStyleSheet("color: #6c757d; font-size: 12px; font-style: italic;");
+    hintLabel->setWordWrap(true);
+    layout->addWidget(hintLabel);
+    
+    QPushButton* backBtn = visualizer->createStyledButton("← Back to Component View", "#28a745", false);
+    backBtn->setObjectName("backBtn");
+    layout->addWidget(backBtn);
+    
+    layout->addStretch();
+}
+
+void StatsDisplayer::showDesignSpaceExploration(DesignSpaceExplorer* explorer, QVBoxLayout* layout)
+{
+    visualizer->clearDataPanel(layout);
+    
+    layout->addWidget(visualizer->createTitleLabel("Cache Design Space Exploration"));
+    
+    QMap<QString, QString> summary;
+    DesignPoint baseline = explorer->baselinePoint();
+    summary["Grid Size"] = QString::number(explorer->gridSize()) + " configurations";
+    summary["Current Capacity"] = QString::number(baseline.capacityBytes / 1024.0, 'f', 0) + " KB";
+    summary["Current AMAT"] = QString::number(baseline.amat, 'f', 3) + " cycles";
+    summary["Miss Ratio Curves"] = missRatioCurves.isEmpty() ? "Not available (√2 rule)" : "From address trace";
+    layout->addWidget(visualizer->createDataGroup("Baseline", summary));
+    
+    // Sweep progress
+    QProgressBar* progressBar = new QProgressBar();
+    progressBar->setRange(0, 1);
+    progressBar->setValue(0);
+    progressBar->setFormat("Evaluated %v / %m");
+    progressBar->setStyleSheet("QProgressBar { border: 1px solid #dee2e6; border-radius: 3px; text-align: center; }"
+                               "QProgressBar::chunk { background-color: #6f42c1; }");
+    layout->addWidget(progressBar);
+    
+    // Scatter plot, refreshed whenever the Pareto front changes
+    ParetoScatterChart* chart = new ParetoScatterChart();
+    chart->setData(explorer->evaluatedPoints(), explorer->paretoFront(), baseline);
+    layout->addWidget(chart);
+    
+    QObject::connect(explorer, &DesignSpaceExplorer::progressChanged, progressBar, [progressBar](int done, int total) {
+        progressBar->setRange(0, total);
+        progressBar->setValue(done);
+    });
+    QObject::connect(explorer, &DesignSpaceExplorer::frontUpdated, chart, [chart, explorer]() {
+        chart->setData(explorer->evaluatedPoints(), explorer->paretoFront(), explorer->baselinePoint());
+    });
+    
+    // Predicted statistics of the selected configuration
+    QWidget* detailsWidget = new QWidget();
+    QVBoxLayout* detailsLayout = new QVBoxLayout(detailsWidget);
+    detailsLayout->setContentsMargins(0, 0, 0, 0);
+    QLabel* hintLabel = new QLabel("Click a point to view its predicted statistics");
+    hintLabel->setStyleSheet("color: #6c757d; font-size: 12px; font-style: italic;");
+    hintLabel->setAlignment(Qt::AlignCenter);
+    detailsLayout->addWidget(hintLabel);
+    layout->addWidget(detailsWidget);
+    
+    QObject::connect(chart, &ParetoScatterChart::pointSelected, detailsWidget,
+                     [this, explorer, detailsLayout](const DesignPoint& point) {
+        visualizer->clearDataPanel(detailsLayout);
+        QMap<QString, QMap<QString, QString>> details = explorer->predictComponents(point);
+        
+        // Summary first, then each cache
+        detailsLayout->addWidget(visualizer->createDataGroup("Selected Configuration", details.take("Summary")));
+        for (auto it = details.begin(); it != details.end(); ++it) {
+            detailsLayout->addWidget(visualizer->createDataGroup(it.key() + " (predicted)", it.value()));
+        }
+    });
+    
+    QPushButton* backBtn = visualizer->createStyledButton("← Back to Component View", "#28a745", false);
+    backBtn->setObjectName("backBtn");
+    layout->addWidget(backBtn);
+    
+    layout->addStretch();
+}
+
+void StatsDisplayer::showSearchResults(const QString& query, const QVector<CounterSearch::Match>& matches,
+                                       int documentCount, double elapsedMicroseconds, QVBoxLayout* layout)
+{
+    visualizer->clearDataPanel(layout);
+    
+    layout->addWidget(visualizer->createTitleLabel(QString("Search: %1").arg(query)));
+    
+    QLabel* summaryLabel = new QLabel(QString("%1 components and counters indexed, searched in %2 us")
+                                          .arg(documentCount).arg(elapsedMicroseconds, 0, 'f', 0));
+    summaryLabel->setStyleSheet("color: #6c757d; font-size: 12px;");
+    layout->addWidget(summaryLabel);
+    
+    layout->addWidget(visualizer->createSearchResultList(matches));
+    
+    QLabel* hintLabel = new QLabel("Matches component names, counter names and their fragments such as "
+                                   "l3, miss or busy; prefixes and single typos also match.");
+    hintLabel->setStyleSheet("color: #6c757d; font-size: 12px; font-style: italic;");
+    hintLabel->setWordWrap(true);
+    layout->addWidget(hintLabel);
+    
+    QPushButton* backBtn = visualizer->createStyledButton("← Back to Component View", "#28a745", false);
+    backBtn->setObjectName("backBtn");
+    layout->addWidget(backBtn);
+    
+    layout->addStretch();
+}
@@ -3,6 +3,7 @@
 #include <QTextStream>
 #include <QRegularExpression>
 #include <QDir>
+#include <QDataStream>
 
 StatsLoader::StatsLoader()
 {
@@ -19,34 +20,37 @@ bool StatsLoader::loadStatistics()
         QDir::currentPath() + "/../files/statistic.txt" // 上级目录
     };
     
-    QFile file;
-    QString usedPath;
-    
     // 尝试每个路径
     for (const QString& path : possiblePaths) {
-        file.setFileName(path);
-        if (file.exists()) {
-            usedPath = path;
+        if (QFile::exists(path)) {
             qDebug() << "Found statistic.txt at:" << path;
-            break;
+            return loadStatistics(path);
         }
     }
     
-    if (usedPath.isEmpty()) {
-        qDebug() << "Cannot find statistic.txt in any of the expected locations:";
-        for (const QString& path : possiblePaths) {
-            qDebug() << "  Tried:" << path;
-        }
-        qDebug() << "Current working directory:" << QDir::currentPath();
-        return false;
+    qDebug() << "Cannot find statistic.txt in any of the expected locations:";
+    for (const QString& path : possiblePaths) {
+        qDebug() << "  Tried:" << path;
     }
-    
+    qDebug() << "Current working directory:" << QDir::currentPath();
+    return false;
+}
+
+bool StatsLoader::loadStatistics(const QString& path)
+{
+    QFile file(path);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        qDebug() << "Cannot open statistic.txt at" << usedPath;
+        qDebug() << "Cannot open statistic.txt at" << path;
         return false;
     }
     
-    qDebug() << "Successfully opened statistic.txt from:" << usedPath;
+    qDebug() << "Successfully opened statistic.txt from:" << path;
+    
+    statsData.clear();
+    portTransmissions.clear();
+    duplicateKeys.clear();
+    conflictingKeys.clear();
+    malformedLines = 0;
     
     QTextStream in(&file);
     QString currentComponent;
@@ -83,12 +87,29 @@ bool StatsLoader::loadStatistics()
                     value = value.split("//").first().trimmed();
                 }
                 
+                // 截断的行没有值
+                if (key.isEmpty() || value.isEmpty()) {
+                    malformedLines++;
+                    continue;
+                }
+                
                 if (!currentComponent.isEmpty()) {
+                    // 同一组件内重复的键: 值相同只是冗余，值不同说明数据损坏
+                    if (currentStats.data.contains(key)) {
+                        QString qualified = currentComponent + "." + key;
+                        if (currentStats.data.value(key) == value) {
+                            duplicateKeys.append(qualified);
+                        } else {
+                            conflictingKeys.append(qualified);
+                        }
+                    }
                     currentStats.data[key] = value;
                 }
                 
                 portTransmissions[key] = value;
             }
+        } else {
+            malformedLines++;
         }
     }
     
@@ -102,12 +123,9 @@ bool StatsLoader::loadStatistics()
     qDebug() << "Total components parsed:" << componentCount;
     qDebug() << "Port transmissions found:" << portTransmissions.size();
     qDebug() << "Components found:" << statsData.keys();
-    
-    // 检查特定组件
-    if (statsData.contains("MemoryNode0")) {
-        qDebug() << "MemoryNode0 data:" << statsData["MemoryNode0"].data;
-    } else {
-        qDebug() << "MemoryNode0 not found in parsed data";
+    if (!duplicateKeys.isEmpty() || !conflictingKeys.isEmpty() || malformedLines > 0) {
+        qDebug() << "Parse issues:" << duplicateKeys.size() << "duplicate keys,"
+                 << conflictingKeys.size() << "conflicting keys," << malformedLines << "malformed lines";
     }
     
     // 计算衍生数据
@@ -117,78 +135,111 @@ bool StatsLoader::loadStatistics()
 
 void StatsLoader::calculateDerivedStats()
 {
-    // 为CPU计算衍生统计
-    for (int i = 0; i < 4; i++) {
-        QString cpuId = QString("CPU%1").arg(i);
-        if (statsData.contains(cpuId)) {
-            ComponentStats& stats = statsData[cpuId];
-            
-            // 计算命中率
-            if (stats.data.contains("ld_cache_hit_count") && stats.data.contains("ld_cache_miss_count")) {
-                int hits = stats.data["ld_cache_hit_count"].toInt();
-                int misses = stats.data["ld_cache_miss_count"].toInt();
-                double hitRate = hits > 0 ? (double)hits / (hits + misses) * 100 : 0;
-                stats.percentages["ld_hit_rate"] = hitRate;
-            }
-            
-            if (stats.data.contains("st_cache_hit_count") && stats.data.contains("st_cache_miss_count")) {
-                int hits = stats.data["st_cache_hit_count"].toInt();
-                int misses = stats.data["st_cache_miss_count"].toInt();
-                double hitRate = hits > 0 ? (double)hits / (hits + misses) * 100 : 0;
-                stats.percentages["st_hit_rate"] = hitRate;
-            }
+    // 命中率 (百分比)，分母为 0 时记为 0
+    auto hitRate = [](ComponentStats& stats, const QString& hitKey, const QString& missKey, const QString& rateKey) {
+        if (stats.data.contains(hitKey) && stats.data.contains(missKey)) {
+            double hits = stats.data[hitKey].toDouble();
+            double misses = stats.data[missKey].toDouble();
+            stats.percentages[rateKey] = hits > 0 ? hits / (hits + misses) * 100 : 0;
+        }
+    };
+    
+    for (auto it = statsData.begin(); it != statsData.end(); ++it) {
+        ComponentStats& stats = it.value();
+        
+        // 为CPU计算衍生统计
+        if (it.key().startsWith("CPU")) {
+            hitRate(stats, "ld_cache_hit_count", "ld_cache_miss_count", "ld_hit_rate");
+            hitRate(stats, "st_cache_hit_count", "st_cache_miss_count", "st_hit_rate");
             
             // 计算IPC
             if (stats.data.contains("finished_inst_count") && stats.data.contains("total_tick_processed")) {
-                double ipc = (double)stats.data["finished_inst_count"].toInt() / stats.data["total_tick_processed"].toInt();
-                stats.percentages["ipc"] = ipc;
+                double ticks = stats.data["total_tick_processed"].toDouble();
+                stats.percentages["ipc"] = ticks > 0 ? stats.data["finished_inst_count"].toDouble() / ticks : 0;
             }
         }
-    }
-    
-    // 为缓存计算命中率
-    for (int i = 0; i < 4; i++) {
-        QString l2Id = QString("L2Cache%1").arg(i);
-        QString l3Id = QString("L3Cache%1").arg(i);
         
-        if (statsData.contains(l2Id)) {
-            ComponentStats& stats = statsData[l2Id];
-            
-            // L2命中率
-            if (stats.data.contains("l2_hit_count") && stats.data.contains("l2_miss_count")) {
-                int hits = stats.data["l2_hit_count"].toInt();
-                int misses = stats.data["l2_miss_count"].toInt();
-                double hitRate = hits > 0 ? (double)hits / (hits + misses) * 100 : 0;
-                stats.percentages["l2_hit_rate"] = hitRate;
-            }
-            
-            // L1D命中率
-            if (stats.data.contains("l1d_hit_count") && stats.data.contains("l1d_miss_count")) {
-                int hits = stats.data["l1d_hit_count"].toInt();
-                int misses = stats.data["l1d_miss_count"].toInt();
-                double hitRate = hits > 0 ? (double)hits / (hits + misses) * 100 : 0;
-                stats.percentages["l1d_hit_rate"] = hitRate;
-            }
-            
-            // L1I命中率
-            if (stats.data.contains("l1i_hit_count") && stats.data.contains("l1i_miss_count")) {
-                int hits = stats.data["l1i_hit_count"].toInt();
-                int misses = stats.data["l1i_miss_count"].toInt();
-                double hitRate = hits > 0 ? (double)hits / (hits + misses) * 100 : 0;
-                stats.percentages["l1i_hit_rate"] = hitRate;
-            }
+        // 为缓存计算命中率
+        if (it.key().startsWith("L2Cache")) {
+            hitRate(stats, "l2_hit_count", "l2_miss_count", "l2_hit_rate");
+            hitRate(stats, "l1d_hit_count", "l1d_miss_count", "l1d_hit_rate");
+            hitRate(stats, "l1i_hit_count", "l1i_miss_count", "l1i_hit_rate");
         }
         
-        if (statsData.contains(l3Id)) {
-            ComponentStats& stats = statsData[l3Id];
-            
-            // L3命中率
-            if (stats.data.contains("llc_hit_count") && stats.data.contains("llc_miss_count")) {
-                int hits = stats.data["llc_hit_count"].toInt();
-                int misses = stats.data["llc_miss_count"].toInt();
-                double hitRate = hits > 0 ? (double)hits / (hits + misses) * 100 : 0;
-                stats.percentages["llc_hit_rate"] = hitRate;
-            }
+        if (it.key().startsWith("L3Cache")) {
+            hitRate(stats, "llc_hit_count", "llc_miss_count", "llc_hit_rate");
         }
     }
-} 
\ No newline at end of file
+}
+
+QByteArray StatsLoader::serialize() const
+{
+    QByteArray bytes;
+    QDataStream out(&bytes, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    
+    out << static_cast<qint32>(statsData.size());
+    for (auto it = statsData.begin(); it != statsData.end(); ++it) {
+        out << it.key() << it.value().name << it.value().data << it.value().percentages;
+    }
+    out << portTransmissions << duplicateKeys << conflictingKeys << static_cast<qint32>(malformedLines);
+    return bytes;
+}
+
+bool StatsLoader::deserialize(const QByteArray& bytes)
+{
+    QDataStream in(bytes);
+    in.setVersion(QDataStream::Qt_6_0);
+    
+    qint32 componentCount = 0;
+    in >> componentCount;
+    
+    QMap<QString, ComponentStats> components;
+    for (qint32 i = 0; i < componentCount && in.status() == QDataStream::Ok; ++i) {
+        QString id;
+        ComponentStats stats;
+        in >> id >> stats.name >> stats.data >> stats.percentages;
+        components.insert(id, stats);
+    }
+    
+    QMap<QString, QString> transmissions;
+    QStringList duplicates, conflicts;
+    qint32 malformed = 0;
+    in >> transmissions >> duplicates >> conflicts >> malformed;
+    if (in.status() != QDataStream::Ok) return false;
+    
+    statsData = components;
+    portTransmissions = transmissions;
+    duplicateKeys = duplicates;
+    conflictingKeys = conflicts;
+    malformedLines = malformed;
+    return true;
+}
+
+qint64 StatsLoader::memoryFootprint() const
+{
+    // QString: 对象本身 + 堆上的头部与 UTF-16 数据 (按 16 字节对齐的分配)
+    auto stringBytes = [](const QString& text) -> qint64 {
+        qint64 heap = text.capacity() > 0 ? ((16 + 2 * (text.capacity() + 1) + 15) / 16) * 16 : 0;
+        return sizeof(QString) + heap;
+    };
+    // QMap 的每个节点: 红黑树的指针与颜色，外加键值
+    const qint64 mapNode = 32;
+    
+    qint64 total = sizeof(StatsLoader);
+    for (auto it = statsData.begin(); it != statsData.end(); ++it) {
+        total += mapNode + stringBytes(it.key()) + sizeof(ComponentStats) + stringBytes(it.value().name);
+        for (auto entry = it.value().data.begin(); entry != it.value().data.end(); ++entry) {
+            total += mapNode + stringBytes(entry.key()) + stringBytes(entry.value());
+        }
+        for (auto entry = it.value().percentages.begin(); entry != it.value().percentages.end(); ++entry) {
+            total += mapNode + stringBytes(entry.key()) + sizeof(double);
+        }
+    }
+    for (auto it = portTransmissions.begin(); it != portTransmissions.end(); ++it) {
+        total += mapNode + stringBytes(it.key()) + stringBytes(it.value());
+    }
+    for (const QString& key : duplicateKeys) total += stringBytes(key);
+    for (const QString& key : conflictingKeys) total += stringBytes(key);
+    return total;
+}
@@ -4,6 +4,7 @@
 #include "ComponentStats.h"
 #include <QMap>
 #include <QString>
+#include <QStringList>
 #include <QDebug>
 
 class StatsLoader
@@ -11,9 +12,12 @@ class StatsLoader
 public:
     StatsLoader();
     
-    // 加载统计数据
+    // 在默认位置查找并加载统计数据
     bool loadStatistics();
     
+    // 从指定路径加载统计数据
+    bool loadStatistics(const QString& path);
+    
     // 计算派生统计指标
     void calculateDerivedStats();
     
@@ -22,10 +26,25 @@ public:
     
     // 获取端口传输数据
     const QMap<QString, QString>& getPortTransmissions() const { return portTransmissions; }
+    
+    // 解析时发现的问题 ("组件.键")
+    const QStringList& getDuplicateKeys() const { return duplicateKeys; }     // 重复出现且值相同
+    const QStringList& getConflictingKeys() const { return conflictingKeys; } // 重复出现且值不同
+    int getMalformedLineCount() const { return malformedLines; }              // 无法解析的行 (如截断)
+    
+    // 二进制快照，用于在内存中压缩保存已加载的运行，恢复时不必重新解析文本
+    QByteArray serialize() const;
+    bool deserialize(const QByteArray& bytes);
+    
+    // 按实际的容器与字符串分配估算的内存占用 (字节)
+    qint64 memoryFootprint() const;
 
 private:
     QMap<QString, ComponentStats> statsData;        // 所有组件的统计数据
     QMap<QString, QString> portTransmissions;       // 端口传输数据
+    QStringList duplicateKeys;
+    QStringList conflictingKeys;
+    int malformedLines = 0;
 };
 
 #endif // STATSLOADER_H 
\ No newline at end of file
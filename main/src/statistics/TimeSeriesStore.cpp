@@ -0,0 +1,433 @@
+#include "TimeSeriesStore.h"
+#include "../concurrency/WorkStealingPool.h"
+#include <QtAlgorithms>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+const double kMissing = std::numeric_limits<double>::quiet_NaN();
+const double kMaxExactInteger = 9007199254740992.0;    // 2^53
+
+quint64 zigzag(qint64 value)
+{
+    return (static_cast<quint64>(value) << 1) ^ static_cast<quint64>(value >> 63);
+}
+
+qint64 unzigzag(quint64 value)
+{
+    return static_cast<qint64>(value >> 1) ^ -static_cast<qint64>(value & 1);
+}
+
+quint64 bitsOf(double value)
+{
+    quint64 bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+double doubleOf(quint64 bits)
+{
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+// delta-of-delta: 每个样本写入 (本次差分 - 上次差分) 的 zigzag 变长整数，等间隔时刻与匀速增长的计数器只占 1 字节
+void encodeDeltaOfDelta(const qint64* values, int count, QByteArray& out)
+{
+    out.reserve(count * 2);
+    qint64 previous = 0;
+    qint64 previousDelta = 0;
+    for (int i = 0; i < count; ++i) {
+        qint64 delta = values[i] - previous;
+        quint64 encoded = zigzag(delta - previousDelta);
+        while (encoded >= 0x80) {
+            out.append(static_cast<char>(encoded | 0x80));
+            encoded >>= 7;
+        }
+        out.append(static_cast<char>(encoded));
+        previous = values[i];
+        previousDelta = delta;
+    }
+}
+
+template <typename Output>
+void decodeDeltaOfDelta(const QByteArray& bytes, int count, Output* out)
+{
+    const uchar* data = reinterpret_cast<const uchar*>(bytes.constData());
+    qint64 previous = 0;
+    qint64 previousDelta = 0;
+    for (int i = 0; i < count; ++i) {
+        quint64 encoded = 0;
+        int shift = 0;
+        uchar byte;
+        do {
+            byte = *data++;
+            encoded |= static_cast<quint64>(byte & 0x7f) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+
+        previousDelta += unzigzag(encoded);
+        previous += previousDelta;
+        out[i] = static_cast<Output>(previous);
+    }
+}
+
+// 高位在前的位流
+class BitWriter
+{
+public:
+    explicit BitWriter(QByteArray& out) : out(out), buffer(0), used(0) {}
+
+    // 写入 value 的低 bits 位 (1..64)
+    void write(quint64 value, int bits)
+    {
+        if (bits < 64) value &= (quint64(1) << bits) - 1;
+        int free = 64 - used;
+        if (bits <= free) {
+            buffer |= value << (free - bits);
+            used += bits;
+            if (used == 64) flush(8);
+        } else {
+            int rest = bits - free;
+            buffer |= value >> rest;
+            used = 64;
+            flush(8);
+            buffer = value << (64 - rest);
+            used = rest;
+        }
+    }
+
+    void finish() { flush((used + 7) / 8); }
+
+private:
+    void flush(int bytes)
+    {
+        for (int i = 0; i < bytes; ++i) out.append(static_cast<char>(buffer >> (56 - 8 * i)));
+        buffer = 0;
+        used = 0;
+    }
+
+    QByteArray& out;
+    quint64 buffer;
+    int used;
+};
+
+class BitReader
+{
+public:
+    explicit BitReader(const QByteArray& bytes)
+        : data(reinterpret_cast<const uchar*>(bytes.constData()))
+        , end(data + bytes.size())
+        , window(0)
+        , available(0)
+    {
+    }
+
+    // 读取 bits 位 (1..64)
+    quint64 read(int bits)
+    {
+        if (bits > 56) {
+            quint64 high = read(bits - 32);
+            return (high << 32) | read(32);
+        }
+        if (available < bits) refill();
+        quint64 value = window >> (64 - bits);
+        window <<= bits;
+        available -= bits;
+        return value;
+    }
+
+private:
+    void refill()
+    {
+        while (available <= 56) {
+            quint64 byte = data < end ? *data++ : 0;
+            window |= byte << (56 - available);
+            available += 8;
+        }
+    }
+
+    const uchar* data;
+    const uchar* end;
+    quint64 window;         // 未读的位，高位对齐
+    int available;
+};
+
+// Gorilla: 与上一个值的 XOR 为 0 时写 1 位；否则只写有效位，前导/后缀零位数与上次相容时沿用上次的窗口
+void encodeGorilla(const double* values, int count, QByteArray& out)
+{
+    BitWriter bits(out);
+    quint64 previous = bitsOf(values[0]);
+    bits.write(previous, 64);
+
+    int previousLeading = -1;
+    int previousTrailing = 0;
+    for (int i = 1; i < count; ++i) {
+        quint64 current = bitsOf(values[i]);
+        quint64 x = current ^ previous;
+        previous = current;
+
+        if (x == 0) {
+            bits.write(0, 1);
+            continue;
+        }
+
+        int leading = qMin(static_cast<int>(qCountLeadingZeroBits(x)), 31);
+        int trailing = qCountTrailingZeroBits(x);
+        if (previousLeading >= 0 && leading >= previousLeading && trailing >= previousTrailing) {
+            bits.write(0b10, 2);
+            bits.write(x >> previousTrailing, 64 - previousLeading - previousTrailing);
+        } else {
+            int meaningful = 64 - leading - trailing;
+            bits.write(0b11, 2);
+            bits.write(leading, 5);
+            bits.write(meaningful & 63, 6);     // 64 记为 0
+            bits.write(x >> trailing, meaningful);
+            previousLeading = leading;
+            previousTrailing = trailing;
+        }
+    }
+    bits.finish();
+}
+
+void decodeGorilla(const QByteArray& bytes, int count, double* out)
+{
+    BitReader bits(bytes);
+    quint64 previous = bits.read(64);
+    out[0] = doubleOf(previous);
+
+    int leading = 0;
+    int trailing = 0;
+    for (int i = 1; i < count; ++i) {
+        if (bits.read(1)) {
+            if (bits.read(1)) {
+                leading = static_cast<int>(bits.read(5));
+                int meaningful = static_cast<int>(bits.read(6));
+                if (meaningful == 0) meaningful = 64;
+                trailing = 64 - leading - meaningful;
+            }
+            previous ^= bits.read(64 - leading - trailing) << trailing;
+        }
+        out[i] = doubleOf(previous);
+    }
+}
+
+bool isExactInteger(double value)
+{
+    return std::fabs(value) <= kMaxExactInteger && value == std::trunc(value);
+}
+
+}
+
+TimeSeriesStore::TimeSeriesStore()
+    : sealedSamples(0)
+{
+}
+
+void TimeSeriesStore::clear()
+{
+    names.clear();
+    columnByName.clear();
+    columns.clear();
+    tickBlocks.clear();
+    openTicks.clear();
+    sealedSamples = 0;
+}
+
+int TimeSeriesStore::ensureColumn(const QString& name)
+{
+    int index = columnByName.value(name, -1);
+    if (index >= 0) return index;
+
+    // 新列: 已封存的块没有数据，当前块之前的样本记为缺失
+    index = columns.size();
+    columnByName.insert(name, index);
+    names.append(name);
+    columns.append(Column());
+    columns.last().firstBlock = tickBlocks.size();
+    columns.last().open.reserve(kBlockSamples);
+    columns.last().open.fill(kMissing, openTicks.size());
+    return index;
+}
+
+void TimeSeriesStore::append(quint64 tick, const QVector<double>& values)
+{
+    if (openTicks.isEmpty()) openTicks.reserve(kBlockSamples);
+    openTicks.append(tick);
+    for (int i = 0; i < columns.size(); ++i) {
+        columns[i].open.append(i < values.size() ? values[i] : kMissing);
+    }
+    if (openTicks.size() == kBlockSamples) sealBlock();
+}
+
+void TimeSeriesStore::appendSnapshot(quint64 tick, const StatsLoader& loader)
+{
+    QVector<double> values(columns.size(), kMissing);
+    auto set = [&](const QString& name, double value) {
+        int index = ensureColumn(name);
+        if (index >= values.size()) values.resize(index + 1);
+        values[index] = value;
+    };
+
+    const QMap<QString, ComponentStats>& statsData = loader.getStatsData();
+    for (auto component = statsData.begin(); component != statsData.end(); ++component) {
+        for (auto it = component.value().data.begin(); it != component.value().data.end(); ++it) {
+            bool ok = false;
+            double value = it.value().toDouble(&ok);
+            if (ok) set(component.key() + "." + it.key(), value);
+        }
+        for (auto it = component.value().percentages.begin(); it != component.value().percentages.end(); ++it) {
+            set(component.key() + "." + it.key(), it.key().endsWith("_rate") ? it.value() / 100.0 : it.value());
+        }
+    }
+
+    // 新列在 ensureColumn 时已为当前块补齐缺失值，append 再追加本次的值
+    append(tick, values);
+}
+
+void TimeSeriesStore::sealBlock()
+{
+    if (openTicks.isEmpty()) return;
+    const int count = openTicks.size();
+
+    TickBlock tickBlock;
+    tickBlock.first = openTicks.first();
+    tickBlock.last = openTicks.last();
+    tickBlock.count = count;
+    encodeDeltaOfDelta(reinterpret_cast<const qint64*>(openTicks.constData()), count, tickBlock.bytes);
+    tickBlocks.append(tickBlock);
+
+    // 各列独立压缩，在线程池上并行
+    Column* data = columns.data();
+    WorkStealingPool::instance().parallelFor(columns.size(), [data, count](int c) {
+        Column& column = data[c];
+        const double* values = column.open.constData();
+
+        ValueBlock block;
+        bool integral = true;
+        for (int i = 0; i < count && integral; ++i) integral = isExactInteger(values[i]);
+        if (integral) {
+            QVector<qint64> integers(count);
+            for (int i = 0; i < count; ++i) integers[i] = static_cast<qint64>(values[i]);
+            block.encoding = DeltaOfDelta;
+            encodeDeltaOfDelta(integers.constData(), count, block.bytes);
+        } else {
+            block.encoding = Gorilla;
+            encodeGorilla(values, count, block.bytes);
+        }
+        block.bytes.squeeze();
+        column.blocks.append(block);
+        column.open.resize(0);
+    }, 16);
+
+    sealedSamples += count;
+    openTicks.resize(0);
+}
+
+quint64 TimeSeriesStore::firstTick() const
+{
+    if (!tickBlocks.isEmpty()) return tickBlocks.first().first;
+    return openTicks.isEmpty() ? 0 : openTicks.first();
+}
+
+quint64 TimeSeriesStore::lastTick() const
+{
+    if (!openTicks.isEmpty()) return openTicks.last();
+    return tickBlocks.isEmpty() ? 0 : tickBlocks.last().last;
+}
+
+void TimeSeriesStore::decodeTicks(int block, quint64* ticks) const
+{
+    const TickBlock& tickBlock = tickBlocks[block];
+    decodeDeltaOfDelta(tickBlock.bytes, tickBlock.count, reinterpret_cast<qint64*>(ticks));
+}
+
+void TimeSeriesStore::decodeBlock(int column, int block, double* values) const
+{
+    const Column& data = columns[column];
+    const int count = tickBlocks[block].count;
+    if (block < data.firstBlock) {
+        std::fill(values, values + count, kMissing);
+        return;
+    }
+
+    const ValueBlock& encoded = data.blocks[block - data.firstBlock];
+    if (encoded.encoding == DeltaOfDelta) {
+        decodeDeltaOfDelta(encoded.bytes, count, values);
+    } else {
+        decodeGorilla(encoded.bytes, count, values);
+    }
+}
+
+int TimeSeriesStore::range(int column, quint64 from, quint64 to, QVector<quint64>& ticks, QVector<double>& values) const
+{
+    ticks.clear();
+    values.clear();
+    if (column < 0 || column >= columns.size() || from > to) return 0;
+
+    // 第一个末尾时刻不早于 from 的块
+    auto block = std::lower_bound(tickBlocks.begin(), tickBlocks.end(), from,
+                                  [](const TickBlock& b, quint64 tick) { return b.last < tick; });
+
+    int decoded = 0;
+    QVector<quint64> blockTicks(kBlockSamples);
+    QVector<double> blockValues(kBlockSamples);
+    for (; block != tickBlocks.end() && block->first <= to; ++block) {
+        int index = static_cast<int>(block - tickBlocks.begin());
+        decodeTicks(index, blockTicks.data());
+        decodeBlock(column, index, blockValues.data());
+        decoded++;
+
+        for (int i = 0; i < block->count; ++i) {
+            if (blockTicks[i] < from || blockTicks[i] > to) continue;
+            ticks.append(blockTicks[i]);
+            values.append(blockValues[i]);
+        }
+    }
+
+    const QVector<double>& open = columns[column].open;
+    for (int i = 0; i < openTicks.size(); ++i) {
+        if (openTicks[i] < from || openTicks[i] > to) continue;
+        ticks.append(openTicks[i]);
+        values.append(open[i]);
+    }
+    return decoded;
+}
+
+TimeSeriesStore::Footprint TimeSeriesStore::footprint() const
+{
+    Footprint result;
+    result.samples = sampleCount();
+    result.tickRawBytes = result.samples * static_cast<qint64>(sizeof(quint64));
+    result.tickEncodedBytes = openTicks.size() * static_cast<qint64>(sizeof(quint64));
+    for (const TickBlock& block : tickBlocks) result.tickEncodedBytes += block.bytes.size() + sizeof(TickBlock);
+
+    result.rawBytes = result.tickRawBytes;
+    result.encodedBytes = result.tickEncodedBytes;
+    for (const Column& column : columns) {
+        for (int b = 0; b < column.blocks.size(); ++b) {
+            const ValueBlock& block = column.blocks[b];
+            qint64 raw = tickBlocks[column.firstBlock + b].count * static_cast<qint64>(sizeof(double));
+            qint64 encoded = block.bytes.size() + sizeof(ValueBlock);
+            if (block.encoding == DeltaOfDelta) {
+                result.integerBlocks++;
+                result.integerRawBytes += raw;
+                result.integerEncodedBytes += encoded;
+            } else {
+                result.floatBlocks++;
+                result.floatRawBytes += raw;
+                result.floatEncodedBytes += encoded;
+            }
+            result.rawBytes += raw;
+            result.encodedBytes += encoded;
+        }
+        qint64 open = column.open.size() * static_cast<qint64>(sizeof(double));
+        result.rawBytes += open;
+        result.encodedBytes += open;
+    }
+    return result;
+}
@@ -0,0 +1,100 @@
+#ifndef TIMESERIESSTORE_H
+#define TIMESERIESSTORE_H
+
+#include "StatsLoader.h"
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <QHash>
+#include <QByteArray>
+
+// 压缩的计数器时间序列
+// 所有列共享同一组采样时刻 (周期性转储)。样本按 kBlockSamples 个一块封存并压缩:
+// 时刻与整数值的块用 delta-of-delta + zigzag 变长整数编码，含小数或缺失值的块用 Gorilla 的 XOR 编码。
+// 每块记录首尾时刻，范围查询只解压与范围重叠的块；最后一块未满时以原始形式保存
+class TimeSeriesStore
+{
+public:
+    static const int kBlockSamples = 1024;
+
+    enum Encoding : quint8 {
+        DeltaOfDelta,   // 块内全部为 |v| <= 2^53 的整数
+        Gorilla         // 其余 (比例、平均值、NaN)
+    };
+
+    // 内存占用统计，raw 为按 double 存储时的字节数
+    struct Footprint {
+        qint64 samples = 0;
+        qint64 rawBytes = 0;
+        qint64 encodedBytes = 0;        // 含未封存的原始块
+        qint64 integerBlocks = 0;
+        qint64 integerRawBytes = 0;
+        qint64 integerEncodedBytes = 0;
+        qint64 floatBlocks = 0;
+        qint64 floatRawBytes = 0;
+        qint64 floatEncodedBytes = 0;
+        qint64 tickRawBytes = 0;
+        qint64 tickEncodedBytes = 0;
+    };
+
+    TimeSeriesStore();
+
+    int ensureColumn(const QString& name);
+
+    // 追加一个采样时刻，values[i] 对应第 i 列，超出 values 的列记为缺失；时刻不能小于上一次
+    void append(quint64 tick, const QVector<double>& values);
+
+    // 追加一次统计转储，列名与 CounterStore 相同 ("组件.计数器"，比例换算到 [0, 1])
+    void appendSnapshot(quint64 tick, const StatsLoader& loader);
+
+    void clear();
+
+    int columnCount() const { return names.size(); }
+    const QStringList& columnNames() const { return names; }
+    int columnIndex(const QString& name) const { return columnByName.value(name, -1); }
+
+    qint64 sampleCount() const { return sealedSamples + openTicks.size(); }
+    quint64 firstTick() const;
+    quint64 lastTick() const;
+
+    // [from, to] 内某列的样本，返回解压的块数
+    int range(int column, quint64 from, quint64 to, QVector<quint64>& ticks, QVector<double>& values) const;
+
+    // 按块顺序访问已封存的数据
+    int blockCount() const { return tickBlocks.size(); }
+    int blockLength(int block) const { return tickBlocks[block].count; }
+    void decodeTicks(int block, quint64* ticks) const;
+    void decodeBlock(int column, int block, double* values) const;
+
+    Footprint footprint() const;
+
+private:
+    struct TickBlock {
+        quint64 first = 0;
+        quint64 last = 0;
+        int count = 0;
+        QByteArray bytes;
+    };
+
+    struct ValueBlock {
+        Encoding encoding = Gorilla;
+        QByteArray bytes;
+    };
+
+    struct Column {
+        int firstBlock = 0;             // 该列出现之前的块没有数据
+        QVector<ValueBlock> blocks;
+        QVector<double> open;           // 未封存的样本
+    };
+
+    void sealBlock();
+
+    QStringList names;
+    QHash<QString, int> columnByName;
+    QVector<Column> columns;
+    QVector<TickBlock> tickBlocks;
+    QVector<quint64> openTicks;
+    qint64 sealedSamples;
+};
+
+#endif // TIMESERIESSTORE_H
@@ -0,0 +1,350 @@
+#include "CacheHeatmapView.h"
+#include <QPainter>
+#include <QToolTip>
+#include <cmath>
+
+namespace {
+const int kTileWidth = 256;
+const int kTileCacheKB = 16 * 1024;     // 图块缓存上限
+const double kMaxPixelsPerSet = 48.0;
+const int kGridMinPixels = 8;           // 单元格达到该宽度时绘制网格线
+}
+
+CacheHeatmapView::CacheHeatmapView(const CacheSetStats& stats, QWidget* parent)
+    : QWidget(parent)
+    , stats(stats)
+    , currentMode(stats.hasWayHits() ? WayHits : Accesses)
+    , maxValue(0)
+    , zoomLevel(0)
+    , maxZoomLevel(0)
+    , offset(0)
+    , tiles(kTileCacheKB)
+    , dragging(false)
+    , dragOffset(0)
+{
+    setMinimumHeight(200);
+    setMouseTracking(true);
+    setStyleSheet("background-color: white;");
+    rebuildLevels();
+}
+
+void CacheHeatmapView::setMode(Mode mode)
+{
+    if (mode == WayHits && !stats.hasWayHits()) return;
+    if (mode == currentMode) return;
+    currentMode = mode;
+    rebuildLevels();
+    update();
+}
+
+int CacheHeatmapView::rowCount() const
+{
+    return currentMode == WayHits ? stats.wayCount : 1;
+}
+
+QRectF CacheHeatmapView::plotRect() const
+{
+    return QRectF(32, 22, width() - 42, height() - 52);
+}
+
+double CacheHeatmapView::pixelsPerSet() const
+{
+    double fit = plotRect().width() / qMax(1, stats.setCount);
+    return fit * std::pow(2.0, zoomLevel / 2.0);
+}
+
+double CacheHeatmapView::contentWidth() const
+{
+    return pixelsPerSet() * stats.setCount;
+}
+
+void CacheHeatmapView::clampOffset()
+{
+    offset = qBound(0.0, offset, qMax(0.0, contentWidth() - plotRect().width()));
+}
+
+QRgb CacheHeatmapView::heatColor(double fraction)
+{
+    // 白 -> 黄 -> 橙 -> 红
+    static const QColor stops[] = {
+        QColor(248, 249, 250), QColor(255, 193, 7), QColor(253, 126, 20), QColor(220, 53, 69)
+    };
+    double position = qBound(0.0, fraction, 1.0) * 3.0;
+    int index = qMin(2, static_cast<int>(position));
+    double t = position - index;
+    const QColor& a = stops[index];
+    const QColor& b = stops[index + 1];
+    return qRgb(a.red() + (b.red() - a.red()) * t,
+                a.green() + (b.green() - a.green()) * t,
+                a.blue() + (b.blue() - a.blue()) * t);
+}
+
+void CacheHeatmapView::rebuildLevels()
+{
+    levels.clear();
+    tiles.clear();
+    maxValue = 0;
+
+    int rows = rowCount();
+    int sets = stats.setCount;
+    if (sets <= 0 || rows <= 0) return;
+
+    const QVector<quint32>& source = currentMode == WayHits ? stats.wayHits
+                                   : currentMode == Accesses ? stats.accesses
+                                   : currentMode == Misses ? stats.misses
+                                   : stats.evictions;
+
+    // 第 0 级为原始计数，之后每级两两取最大值
+    QVector<QVector<quint32>> values;
+    QVector<quint32> base(sets * rows);
+    for (int set = 0; set < sets; ++set) {
+        for (int row = 0; row < rows; ++row) {
+            quint32 value = source[set * rows + row];
+            base[row * sets + set] = value;
+            maxValue = qMax(maxValue, value);
+        }
+    }
+    values.append(base);
+
+    int width = sets;
+    while (width > 1) {
+        int half = (width + 1) / 2;
+        const QVector<quint32>& previous = values.last();
+        QVector<quint32> reduced(half * rows);
+        for (int row = 0; row < rows; ++row) {
+            for (int x = 0; x < half; ++x) {
+                quint32 left = previous[row * width + 2 * x];
+                quint32 right = 2 * x + 1 < width ? previous[row * width + 2 * x + 1] : 0;
+                reduced[row * half + x] = qMax(left, right);
+            }
+        }
+        values.append(reduced);
+        width = half;
+    }
+
+    double logMax = std::log1p(static_cast<double>(maxValue));
+    for (const QVector<quint32>& level : values) {
+        int levelWidth = level.size() / rows;
+        QImage image(levelWidth, rows, QImage::Format_RGB32);
+        for (int row = 0; row < rows; ++row) {
+            QRgb* line = reinterpret_cast<QRgb*>(image.scanLine(row));
+            for (int x = 0; x < levelWidth; ++x) {
+                double fraction = logMax > 0 ? std::log1p(static_cast<double>(level[row * levelWidth + x])) / logMax : 0.0;
+                line[x] = heatColor(fraction);
+            }
+        }
+        levels.append(image);
+    }
+
+    updateZoomRange();
+}
+
+void CacheHeatmapView::updateZoomRange()
+{
+    // 最大缩放级别使每组宽度不超过 kMaxPixelsPerSet
+    double fit = plotRect().width() / qMax(1, stats.setCount);
+    maxZoomLevel = qMax(0, static_cast<int>(std::floor(2.0 * std::log2(qMax(1.0, kMaxPixelsPerSet / qMax(fit, 1e-6))))));
+    zoomLevel = qMin(zoomLevel, maxZoomLevel);
+    clampOffset();
+}
+
+const QPixmap& CacheHeatmapView::tile(int tileIndex)
+{
+    // 键包含缩放级别；模式与尺寸变化时整个缓存失效
+    int key = zoomLevel * 65536 + tileIndex;
+    if (QPixmap* cached = tiles.object(key)) return *cached;
+
+    QRectF plot = plotRect();
+    int tileHeight = qMax(1, static_cast<int>(plot.height()));
+    QPixmap* pixmap = new QPixmap(kTileWidth, tileHeight);
+    pixmap->fill(Qt::white);
+
+    double perSet = pixelsPerSet();
+    // 缩小时选择每像素覆盖不少于一个组的降采样级别
+    int level = 0;
+    while (level + 1 < levels.size() && perSet * (1 << level) < 1.0) level++;
+    double perCell = perSet * (1 << level);
+    const QImage& image = levels[level];
+
+    double x0 = tileIndex * kTileWidth;
+    int first = qMax(0, static_cast<int>(std::floor(x0 / perCell)));
+    int last = qMin(image.width(), static_cast<int>(std::ceil((x0 + kTileWidth) / perCell)));
+
+    QPainter painter(pixmap);
+    if (last > first) {
+        QRectF target(first * perCell - x0, 0, (last - first) * perCell, tileHeight);
+        painter.drawImage(target, image, QRectF(first, 0, last - first, image.height()));
+    }
+
+    // 单元格足够大时画出格线
+    double rowHeight = static_cast<double>(tileHeight) / image.height();
+    painter.setPen(QPen(QColor(255, 255, 255, 160), 1));
+    if (perCell >= kGridMinPixels) {
+        for (int x = first; x <= last; ++x) {
+            double px = x * perCell - x0;
+            painter.drawLine(QPointF(px, 0), QPointF(px, tileHeight));
+        }
+    }
+    if (rowHeight >= kGridMinPixels) {
+        for (int row = 1; row < image.height(); ++row) {
+            painter.drawLine(QPointF(0, row * rowHeight), QPointF(kTileWidth, row * rowHeight));
+        }
+    }
+    painter.end();
+
+    tiles.insert(key, pixmap, kTileWidth * tileHeight * 4 / 1024);
+    return *tiles.object(key);
+}
+
+void CacheHeatmapView::drawAxes(QPainter& painter, const QRectF& plot)
+{
+    painter.setFont(QFont("Arial", 7));
+    painter.setPen(QColor(108, 117, 125));
+
+    // 纵轴: 路号
+    int rows = rowCount();
+    double rowHeight = plot.height() / rows;
+    if (currentMode == WayHits) {
+        int step = qMax(1, static_cast<int>(std::ceil(12.0 / rowHeight)));
+        for (int row = 0; row < rows; row += step) {
+            painter.drawText(QRectF(0, plot.top() + row * rowHeight, plot.left() - 4, rowHeight),
+                             Qt::AlignRight | Qt::AlignVCenter, QString("W%1").arg(row));
+        }
+    }
+
+    // 横轴: 可见范围内的组号
+    double perSet = pixelsPerSet();
+    double firstSet = offset / perSet;
+    double lastSet = (offset + plot.width()) / perSet;
+    double rawStep = (lastSet - firstSet) / 5.0;
+    double magnitude = std::pow(10.0, std::floor(std::log10(qMax(1.0, rawStep))));
+    double step = qMax(1.0, std::ceil(rawStep / magnitude) * magnitude);
+    for (double set = std::ceil(firstSet / step) * step; set < lastSet; set += step) {
+        double x = plot.left() + (set + 0.5) * perSet - offset;
+        painter.drawText(QRectF(x - 25, plot.bottom() + 3, 50, 12), Qt::AlignCenter,
+                         QString::number(static_cast<int>(set)));
+    }
+
+    painter.drawText(QRectF(plot.left(), height() - 14, plot.width(), 14), Qt::AlignCenter,
+                     QString("set %1 - %2 of %3, log color scale, max %4")
+                         .arg(static_cast<int>(firstSet))
+                         .arg(qMin(stats.setCount, static_cast<int>(std::ceil(lastSet))) - 1)
+                         .arg(stats.setCount)
+                         .arg(maxValue));
+
+    painter.setPen(QPen(QColor(73, 80, 87), 1));
+    painter.drawRect(plot);
+}
+
+void CacheHeatmapView::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::white);
+
+    static const char* modeNames[] = {"Way Hits", "Accesses", "Misses", "Evictions"};
+    painter.setPen(QColor(44, 62, 80));
+    painter.setFont(QFont("Arial", 9, QFont::Bold));
+    painter.drawText(QRectF(0, 2, width(), 18), Qt::AlignCenter,
+                     QString("%1 per Set (%2 sets x %3 ways)")
+                         .arg(modeNames[currentMode]).arg(stats.setCount).arg(stats.wayCount));
+
+    QRectF plot = plotRect();
+    if (levels.isEmpty() || plot.width() <= 0 || plot.height() <= 0) {
+        painter.drawText(plot, Qt::AlignCenter, "No per-set data");
+        return;
+    }
+
+    // 只绘制与可见区域相交的图块
+    painter.save();
+    painter.setClipRect(plot);
+    int firstTile = static_cast<int>(offset / kTileWidth);
+    int lastTile = static_cast<int>((offset + plot.width()) / kTileWidth);
+    for (int index = firstTile; index <= lastTile; ++index) {
+        painter.drawPixmap(QPointF(plot.left() + index * kTileWidth - offset, plot.top()), tile(index));
+    }
+    painter.restore();
+
+    drawAxes(painter, plot);
+}
+
+void CacheHeatmapView::wheelEvent(QWheelEvent* event)
+{
+    int steps = event->angleDelta().y() / 120;
+    if (steps == 0 || levels.isEmpty()) {
+        event->ignore();
+        return;
+    }
+
+    int newLevel = qBound(0, zoomLevel + steps, maxZoomLevel);
+    if (newLevel == zoomLevel) {
+        event->accept();
+        return;
+    }
+
+    // 保持光标下的组不动
+    QRectF plot = plotRect();
+    double cursorX = qBound(0.0, event->position().x() - plot.left(), plot.width());
+    double setUnderCursor = (offset + cursorX) / pixelsPerSet();
+    zoomLevel = newLevel;
+    offset = setUnderCursor * pixelsPerSet() - cursorX;
+    clampOffset();
+
+    event->accept();
+    update();
+}
+
+void CacheHeatmapView::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton) {
+        dragging = true;
+        dragStart = event->position();
+        dragOffset = offset;
+        setCursor(Qt::ClosedHandCursor);
+    }
+}
+
+void CacheHeatmapView::mouseMoveEvent(QMouseEvent* event)
+{
+    if (dragging) {
+        offset = dragOffset - (event->position().x() - dragStart.x());
+        clampOffset();
+        update();
+        return;
+    }
+
+    QRectF plot = plotRect();
+    if (levels.isEmpty() || !plot.contains(event->position())) {
+        QToolTip::hideText();
+        return;
+    }
+
+    int set = static_cast<int>((offset + event->position().x() - plot.left()) / pixelsPerSet());
+    int row = static_cast<int>((event->position().y() - plot.top()) / (plot.height() / rowCount()));
+    set = qBound(0, set, stats.setCount - 1);
+    row = qBound(0, row, rowCount() - 1);
+
+    QString text = QString("Set %1\nAccesses: %2\nMisses: %3\nEvictions: %4")
+                       .arg(set).arg(stats.accesses[set]).arg(stats.misses[set]).arg(stats.evictions[set]);
+    if (currentMode == WayHits) {
+        text += QString("\nWay %1 hits: %2").arg(row).arg(stats.wayHits[set * stats.wayCount + row]);
+    }
+    QToolTip::showText(event->globalPosition().toPoint(), text, this);
+}
+
+void CacheHeatmapView::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (event->button() == Qt::LeftButton) {
+        dragging = false;
+        unsetCursor();
+    }
+}
+
+void CacheHeatmapView::resizeEvent(QResizeEvent* event)
+{
+    QWidget::resizeEvent(event);
+    // 图块高度与适配宽度随尺寸变化
+    tiles.clear();
+    updateZoomRange();
+}
@@ -0,0 +1,71 @@
+#ifndef CACHEHEATMAPVIEW_H
+#define CACHEHEATMAPVIEW_H
+
+#include "../statistics/SetStatsLoader.h"
+#include <QWidget>
+#include <QImage>
+#include <QPixmap>
+#include <QCache>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QWheelEvent>
+#include <QResizeEvent>
+
+// 缓存逐组热力图: 横轴为组号，纵轴为路 (路命中模式) 或单行 (组级计数)
+// 颜色为对数刻度；滚轮以光标为中心缩放，拖动平移
+// 缩放级别离散化，每级渲染结果按 256 像素宽的图块缓存，平移时只绘制新露出的图块
+class CacheHeatmapView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    enum Mode {
+        WayHits,
+        Accesses,
+        Misses,
+        Evictions
+    };
+
+    explicit CacheHeatmapView(const CacheSetStats& stats, QWidget* parent = nullptr);
+
+    void setMode(Mode mode);
+    Mode mode() const { return currentMode; }
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+private:
+    QRectF plotRect() const;
+    int rowCount() const;
+    double pixelsPerSet() const;
+    double contentWidth() const;
+    void clampOffset();
+    void updateZoomRange();
+    void rebuildLevels();
+    const QPixmap& tile(int tileIndex);
+    void drawAxes(QPainter& painter, const QRectF& plot);
+    static QRgb heatColor(double fraction);
+
+    CacheSetStats stats;
+    Mode currentMode;
+
+    // 逐级取最大值的降采样图像，第 k 级每个像素覆盖 2^k 个组，缩小时热点组不会被丢掉
+    QVector<QImage> levels;
+    quint32 maxValue;
+
+    int zoomLevel;              // 每组像素 = 适配宽度 * 2^(zoomLevel / 2)
+    int maxZoomLevel;
+    double offset;              // 可见区域左边缘在内容坐标中的位置 (像素)
+    QCache<int, QPixmap> tiles;
+
+    bool dragging;
+    QPointF dragStart;
+    double dragOffset;
+};
+
+#endif // CACHEHEATMAPVIEW_H
@@ -0,0 +1,392 @@
+#include "ChipMinimap.h"
+#include "../graphics/ChipPainter.h"
+#include <QPainter>
+#include <QScrollBar>
+#include <QtMath>
+
+namespace {
+
+const int kTileSize = 256;
+const double kBaseSide = 1024;          // 最清晰一级的长边像素数
+const double kMaxScale = 1.0;           // 小芯片也不超过场景的原始大小
+const int kMaxLevels = 8;
+const double kMargin = 40;
+const int kBuckets = 10;                // 与 UtilizationOverlay 的分桶一致
+
+int bucketOf(double value, double maximum)
+{
+    if (maximum <= 0) return 0;
+    return qBound(0, static_cast<int>(value / maximum * kBuckets), kBuckets - 1);
+}
+
+QImage renderTile(const ChipLayout& chip, const BusUtilization::Values* values, const QRectF& area,
+                  double scale, int column, int row)
+{
+    QSize full(qCeil(area.width() * scale), qCeil(area.height() * scale));
+    QImage tile(qMax(1, qMin(kTileSize, full.width() - column * kTileSize)),
+                qMax(1, qMin(kTileSize, full.height() - row * kTileSize)),
+                QImage::Format_ARGB32_Premultiplied);
+    tile.fill(Qt::white);
+    QPainter painter(&tile);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.translate(-column * kTileSize, -row * kTileSize);
+    painter.scale(scale, scale);
+    painter.translate(-area.topLeft());
+    ChipPainter::paint(painter, chip, values, false);
+    painter.end();
+    return tile;
+}
+
+}
+
+ChipMinimap::ChipMinimap(ChipView* view, QWidget* parent)
+    : QWidget(parent)
+    , view(view)
+    , hasColors(false)
+    , generation(0)
+    , pixmapLevel(-1)
+    , dragging(false)
+{
+    setMinimumSize(160, 120);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setToolTip("Drag the rectangle or click elsewhere to move the chip view");
+
+    // 芯片视图平移或缩放时只移动可见范围矩形
+    connect(view->horizontalScrollBar(), &QScrollBar::valueChanged, this, &ChipMinimap::viewportMoved);
+    connect(view->verticalScrollBar(), &QScrollBar::valueChanged, this, &ChipMinimap::viewportMoved);
+    connect(view->horizontalScrollBar(), &QScrollBar::rangeChanged, this, &ChipMinimap::viewportMoved);
+    connect(view->verticalScrollBar(), &QScrollBar::rangeChanged, this, &ChipMinimap::viewportMoved);
+    connect(view, &ChipView::zoomChanged, this, &ChipMinimap::viewportMoved);
+}
+
+ChipMinimap::~ChipMinimap()
+{
+    // 后台任务只持有布局与颜色的副本，取消即可，不需要等待
+    for (Level& level : levels) level.cancel();
+}
+
+QSize ChipMinimap::sizeHint() const
+{
+    return QSize(280, 200);
+}
+
+void ChipMinimap::setChipLayout(const ChipLayout& chipLayout)
+{
+    for (Level& level : levels) level.cancel();
+    levels.clear();
+    layout = chipLayout;
+    pixmap = QPixmap();
+    lastViewport = QRectF();
+    if (layout.isEmpty()) {
+        page = QRectF();
+        generation++;
+        update();
+        return;
+    }
+
+    // 每级边长减半，直到一个图块放得下整个芯片
+    page = layout.bounds.adjusted(-kMargin, -kMargin, kMargin, kMargin);
+    double longest = qMax(page.width(), page.height());
+    double scale = qMin(kMaxScale, kBaseSide / longest);
+    while (levels.size() < kMaxLevels) {
+        Level level;
+        level.scale = scale;
+        level.columns = qMax(1, qCeil(qCeil(page.width() * scale) / static_cast<double>(kTileSize)));
+        level.rows = qMax(1, qCeil(qCeil(page.height() * scale) / static_cast<double>(kTileSize)));
+        levels.append(level);
+        if (longest * scale <= kTileSize) break;
+        scale /= 2;
+    }
+
+    invalidateTiles();
+}
+
+void ChipMinimap::setValues(const BusUtilization::Values& values)
+{
+    Colors next;
+    for (auto it = values.edges.begin(); it != values.edges.end(); ++it) {
+        if (it.value() >= 0) next.edges.insert(it.key(), bucketOf(it.value(), values.edgeScale));
+    }
+    for (auto it = values.nodes.begin(); it != values.nodes.end(); ++it) {
+        if (it.value() >= 0) next.nodes.insert(it.key(), bucketOf(it.value(), values.nodeScale));
+    }
+
+    // 实时数据每个快照都会调用，颜色没有变化时保留已有的图块
+    if (hasColors && next == colors) return;
+    colors = next;
+    hasColors = true;
+    invalidateTiles();
+}
+
+void ChipMinimap::clearValues()
+{
+    if (!hasColors) return;
+    colors = Colors();
+    hasColors = false;
+    invalidateTiles();
+}
+
+BusUtilization::Values ChipMinimap::bucketValues(const Colors& colors)
+{
+    // 每个桶取中间值，画出的颜色与场景中的叠加层相同
+    BusUtilization::Values values;
+    for (auto it = colors.edges.begin(); it != colors.edges.end(); ++it) {
+        values.edges.insert(it.key(), (it.value() + 0.5) / kBuckets);
+    }
+    for (auto it = colors.nodes.begin(); it != colors.nodes.end(); ++it) {
+        values.nodes.insert(it.key(), (it.value() + 0.5) / kBuckets);
+    }
+    values.edgeMax = 1;
+    values.nodeMax = 1;
+    values.edgeScale = 1;
+    values.nodeScale = 1;
+    return values;
+}
+
+void ChipMinimap::invalidateTiles()
+{
+    generation++;
+    for (Level& level : levels) {
+        level.cancel();
+        level.tasks.clear();
+        level.tiles.clear();
+        level.missing = 0;
+        level.urgent = -1;
+    }
+    pixmapLevel = -1;
+    if (levels.isEmpty()) return;
+
+    // 最粗的一级只有一个图块，先画出来顶替；合成位图在新图块到达前保留旧的颜色
+    requestLevel(levels.size() - 1);
+    rebuildPixmap();
+}
+
+void ChipMinimap::requestLevel(int index)
+{
+    Level& level = levels[index];
+    if (!level.tiles.isEmpty()) return;
+
+    int count = level.columns * level.rows;
+    level.tiles = QVector<QImage>(count);
+    level.tasks = QVector<TaskHandle>(count);
+    level.missing = count;
+
+    // 预取的图块不应挤占交互任务，只有用户正在看的一块立即画
+    level.urgent = tileUnderViewport(index);
+    for (int i = 0; i < count; ++i) {
+        requestTile(index, i, i == level.urgent ? WorkStealingPool::Interactive : WorkStealingPool::Prefetch);
+    }
+}
+
+void ChipMinimap::requestTile(int index, int tile, WorkStealingPool::Priority priority)
+{
+    Level& level = levels[index];
+    ChipLayout chip = layout;
+    BusUtilization::Values values = bucketValues(colors);
+    bool withValues = hasColors;
+    QRectF area = page;
+    double scale = level.scale;
+    int column = tile % level.columns;
+    int row = tile / level.columns;
+    int requested = generation;
+
+    level.tasks[tile] = runInBackground(priority, this, [chip, values, withValues, area, scale, column, row]() {
+        return renderTile(chip, withValues ? &values : nullptr, area, scale, column, row);
+    }, [this, index, tile, requested](const QImage& image) {
+        if (requested != generation) return;
+        Level& level = levels[index];
+        level.tiles[tile] = image;
+        level.tasks[tile].reset();
+        if (--level.missing > 0) return;
+        rebuildPixmap();
+        update();
+    });
+}
+
+int ChipMinimap::tileUnderViewport(int index) const
+{
+    if (page.isEmpty()) return -1;
+    const Level& level = levels[index];
+    QPointF center = view->mapToScene(view->viewport()->rect()).boundingRect().center();
+    QPointF pixel = (center - page.topLeft()) * level.scale;
+    int column = qBound(0, static_cast<int>(pixel.x() / kTileSize), level.columns - 1);
+    int row = qBound(0, static_cast<int>(pixel.y() / kTileSize), level.rows - 1);
+    return row * level.columns + column;
+}
+
+void ChipMinimap::raiseVisibleTiles()
+{
+    // 已提交的任务不能改变优先级，取消仍在排队的预取任务后以 Interactive 重新提交
+    for (int index = 0; index < levels.size(); ++index) {
+        Level& level = levels[index];
+        if (level.tiles.isEmpty() || level.missing == 0) continue;
+        int tile = tileUnderViewport(index);
+        if (tile < 0 || tile == level.urgent || !level.tiles[tile].isNull()) continue;
+        level.tasks[tile].cancel();
+        level.urgent = tile;
+        requestTile(index, tile, WorkStealingPool::Interactive);
+    }
+}
+
+int ChipMinimap::preferredLevel() const
+{
+    // 不比控件的像素更粗的最粗一级
+    double needed = targetRect().width() / page.width() * devicePixelRatioF();
+    for (int i = levels.size() - 1; i >= 0; --i) {
+        if (levels[i].scale >= needed) return i;
+    }
+    return 0;
+}
+
+void ChipMinimap::rebuildPixmap()
+{
+    QRectF target = targetRect();
+    if (levels.isEmpty() || target.isEmpty()) return;
+
+    int wanted = preferredLevel();
+    requestLevel(wanted);
+
+    // 想要的一级还没画好时用最接近的已有一级，同样接近时选更清晰的
+    int chosen = -1;
+    for (int distance = 0; distance < levels.size() && chosen < 0; ++distance) {
+        for (int index : {wanted - distance, wanted + distance}) {
+            if (index >= 0 && index < levels.size() && levels[index].ready()) {
+                chosen = index;
+                break;
+            }
+        }
+    }
+    if (chosen < 0) return;
+
+    qreal ratio = devicePixelRatioF();
+    QSize size = (target.size() * ratio).toSize();
+    if (chosen == pixmapLevel && pixmap.size() == size) return;
+    QPixmap composed(size);
+    composed.setDevicePixelRatio(ratio);
+    composed.fill(Qt::white);
+
+    const Level& level = levels[chosen];
+    double fit = target.width() / page.width();
+    double factor = fit / level.scale;
+    QPainter painter(&composed);
+    painter.setRenderHint(QPainter::SmoothPixmapTransform);
+    for (int row = 0; row < level.rows; ++row) {
+        for (int column = 0; column < level.columns; ++column) {
+            const QImage& tile = level.tiles[row * level.columns + column];
+            painter.drawImage(QRectF(column * kTileSize * factor, row * kTileSize * factor,
+                                     tile.width() * factor, tile.height() * factor),
+                              tile);
+        }
+    }
+    painter.end();
+
+    pixmap = composed;
+    pixmapLevel = chosen;
+}
+
+QRectF ChipMinimap::targetRect() const
+{
+    if (page.isEmpty()) return QRectF();
+    QRectF area = QRectF(contentsRect()).adjusted(4, 4, -4, -4);
+    double fit = qMin(area.width() / page.width(), area.height() / page.height());
+    if (fit <= 0) return QRectF();
+    QSizeF size(page.width() * fit, page.height() * fit);
+    return QRectF(area.center() - QPointF(size.width() / 2, size.height() / 2), size);
+}
+
+QPointF ChipMinimap::toScene(const QPointF& point) const
+{
+    QRectF target = targetRect();
+    double fit = target.width() / page.width();
+    return page.topLeft() + (point - target.topLeft()) / fit;
+}
+
+QRectF ChipMinimap::viewportRect() const
+{
+    QRectF target = targetRect();
+    if (target.isEmpty()) return QRectF();
+    double fit = target.width() / page.width();
+    QRectF visible = view->mapToScene(view->viewport()->rect()).boundingRect();
+    QRectF rect(target.topLeft() + (visible.topLeft() - page.topLeft()) * fit, visible.size() * fit);
+    return rect.intersected(target);
+}
+
+void ChipMinimap::viewportMoved()
+{
+    // 只重绘矩形移动前后覆盖的区域，合成好的位图直接贴上
+    QRectF current = viewportRect();
+    if (current == lastViewport) return;
+    update(lastViewport.united(current).adjusted(-3, -3, 3, 3).toAlignedRect());
+    lastViewport = current;
+    raiseVisibleTiles();
+}
+
+void ChipMinimap::paintEvent(QPaintEvent* event)
+{
+    QPainter painter(this);
+    painter.fillRect(event->rect(), palette().window());
+
+    QRectF target = targetRect();
+    if (target.isEmpty()) return;
+    if (pixmap.isNull()) {
+        painter.setPen(palette().color(QPalette::PlaceholderText));
+        painter.drawText(rect(), Qt::AlignCenter, "Drawing overview...");
+    } else {
+        painter.drawPixmap(target, pixmap, QRectF(QPointF(0, 0), pixmap.size()));
+    }
+
+    lastViewport = viewportRect();
+    if (lastViewport.isEmpty()) return;
+    painter.setPen(QPen(QColor(253, 126, 20), 2));
+    painter.setBrush(QColor(253, 126, 20, 40));
+    painter.drawRect(lastViewport.adjusted(1, 1, -1, -1));
+}
+
+void ChipMinimap::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton || targetRect().isEmpty()) {
+        QWidget::mousePressEvent(event);
+        return;
+    }
+
+    // 在矩形内按下时保持按下点与矩形的相对位置，否则把视图中心移到按下的位置
+    QPointF scenePoint = toScene(event->position());
+    QRectF visible = view->mapToScene(view->viewport()->rect()).boundingRect();
+    if (visible.contains(scenePoint)) {
+        dragOffset = scenePoint - visible.center();
+    } else {
+        dragOffset = QPointF();
+        view->centerOn(scenePoint);
+    }
+    dragging = true;
+    setCursor(Qt::ClosedHandCursor);
+    event->accept();
+}
+
+void ChipMinimap::mouseMoveEvent(QMouseEvent* event)
+{
+    if (!dragging) {
+        QWidget::mouseMoveEvent(event);
+        return;
+    }
+    view->centerOn(toScene(event->position()) - dragOffset);
+    event->accept();
+}
+
+void ChipMinimap::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (!dragging || event->button() != Qt::LeftButton) {
+        QWidget::mouseReleaseEvent(event);
+        return;
+    }
+    dragging = false;
+    unsetCursor();
+    event->accept();
+}
+
+void ChipMinimap::resizeEvent(QResizeEvent* event)
+{
+    QWidget::resizeEvent(event);
+    rebuildPixmap();
+    lastViewport = QRectF();
+}
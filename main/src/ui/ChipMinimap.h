@@ -0,0 +1,98 @@
+#ifndef CHIPMINIMAP_H
+#define CHIPMINIMAP_H
+
+#include "../analysis/BusUtilization.h"
+#include "../concurrency/BackgroundTask.h"
+#include "../graphics/ChipLayout.h"
+#include "ChipView.h"
+#include <QWidget>
+#include <QHash>
+#include <QImage>
+#include <QPixmap>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QResizeEvent>
+
+// 芯片概览: 整个芯片缩小显示，芯片视图的可见范围画成矩形，拖动矩形或点击别处平移芯片视图
+// 芯片由 ChipPainter 在后台预先画成多级分辨率的图块 (每级边长减半，图块 256 像素)，
+// 图块以 Prefetch 优先级逐块提交，只有芯片视图可见范围中心所在的图块以 Interactive 优先级提交，
+// 按当前尺寸选择最接近的一级合成为一张位图；平移缩放芯片视图时只重绘可见范围矩形经过的区域。
+// 图块只在芯片重新布局或叠加层颜色 (与场景中相同的 10 级分桶) 变化时重画，数值变化但颜色不变时不重画
+class ChipMinimap : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ChipMinimap(ChipView* view, QWidget* parent = nullptr);
+    ~ChipMinimap();
+
+    // 芯片重新布局后调用，清空所有图块；与芯片视图的场景使用相同的坐标
+    void setChipLayout(const ChipLayout& layout);
+
+    // 与场景中的总线热力叠加层同步
+    void setValues(const BusUtilization::Values& values);
+    void clearValues();
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+
+private:
+    struct Level {
+        double scale = 0;           // 每个场景单位的像素数
+        int columns = 0;
+        int rows = 0;
+        QVector<QImage> tiles;      // 按行排列，为空表示尚未请求，单个图块为空表示尚未画好
+        QVector<TaskHandle> tasks;  // 与 tiles 同序，图块画好后重置
+        int missing = 0;            // 尚未画好的图块数
+        int urgent = -1;            // 以 Interactive 优先级提交的图块
+
+        bool ready() const { return !tiles.isEmpty() && missing == 0; }
+        void cancel() { for (TaskHandle& task : tasks) task.cancel(); }
+    };
+
+    // 按颜色分桶后的叠加层，作为图块是否需要重画的依据
+    struct Colors {
+        QHash<QPair<int, int>, int> edges;
+        QHash<int, int> nodes;
+        bool operator==(const Colors& other) const { return edges == other.edges && nodes == other.nodes; }
+    };
+
+    void invalidateTiles();
+    void requestLevel(int index);
+    void requestTile(int index, int tile, WorkStealingPool::Priority priority);
+    int tileUnderViewport(int index) const;     // 可见范围中心所在的图块，没有时为 -1
+    void raiseVisibleTiles();
+    int preferredLevel() const;
+    void rebuildPixmap();
+
+    QRectF targetRect() const;                  // 芯片在控件中的位置 (保持长宽比居中)
+    QPointF toScene(const QPointF& point) const;
+    QRectF viewportRect() const;                // 芯片视图的可见范围，控件坐标
+    void viewportMoved();
+
+    static BusUtilization::Values bucketValues(const Colors& colors);
+
+    ChipView* view;
+    ChipLayout layout;
+    QRectF page;                    // 芯片范围加边距，场景坐标
+    Colors colors;
+    bool hasColors;
+
+    QVector<Level> levels;          // 第 0 级最清晰
+    int generation;                 // 图块失效时递增，丢弃过期的后台结果
+
+    QPixmap pixmap;                 // 当前尺寸下合成好的芯片，绘制时直接贴上
+    int pixmapLevel;                // 合成所用的一级，-1 表示图块已失效
+    QRectF lastViewport;
+
+    bool dragging;
+    QPointF dragOffset;             // 按下点相对可见范围中心的偏移，场景坐标
+};
+
+#endif // CHIPMINIMAP_H
@@ -0,0 +1,89 @@
+#include "ChipView.h"
+#include <QDebug>
+#include <QtMath>
+
+namespace {
+
+const double kMinimumZoom = 0.005;
+const double kMaximumZoom = 8.0;
+const double kZoomStep = 1.25;              // 每格滚轮
+const qint64 kFrameBudgetNs = 16700000;     // 60 fps
+const qint64 kReportIntervalMs = 2000;
+
+}
+
+ChipView::ChipView(QGraphicsScene* scene, QWidget* parent)
+    : QGraphicsView(scene, parent)
+    , slowFrames(0)
+    , slowestFrameNs(0)
+{
+    setRenderHint(QPainter::Antialiasing);
+    setDragMode(QGraphicsView::ScrollHandDrag);
+    setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
+
+    // 各图元自行设置画笔与画刷并在边界中留出了线宽，不需要视图保存状态或扩大重绘区域；
+    // 平移时视图滚动已有的像素，只重绘新露出的部分，背景不变所以也缓存起来
+    setOptimizationFlags(QGraphicsView::DontSavePainterState | QGraphicsView::DontAdjustForAntialiasing);
+    setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+    setBackgroundBrush(Qt::white);
+    setCacheMode(QGraphicsView::CacheBackground);
+}
+
+double ChipView::zoom() const
+{
+    return transform().m11();
+}
+
+void ChipView::setZoom(double scale)
+{
+    scale = qBound(kMinimumZoom, scale, kMaximumZoom);
+    if (qFuzzyCompare(scale, zoom())) return;
+    setTransform(QTransform::fromScale(scale, scale));
+    emit zoomChanged(scale);
+}
+
+void ChipView::fitScene()
+{
+    QRectF bounds = sceneRect();
+    if (bounds.width() > viewport()->width() || bounds.height() > viewport()->height()) {
+        fitInView(bounds, Qt::KeepAspectRatio);
+    }
+    emit zoomChanged(zoom());
+}
+
+void ChipView::wheelEvent(QWheelEvent* event)
+{
+    int steps = event->angleDelta().y() / 120;
+    if (steps == 0) {
+        event->ignore();
+        return;
+    }
+    // 以光标为锚点 (AnchorUnderMouse)，光标下的内容不动
+    setZoom(zoom() * qPow(kZoomStep, steps));
+    event->accept();
+}
+
+void ChipView::paintEvent(QPaintEvent* event)
+{
+    QElapsedTimer timer;
+    timer.start();
+    QGraphicsView::paintEvent(event);
+    qint64 elapsed = timer.nsecsElapsed();
+    emit framePainted(elapsed);
+
+    if (elapsed > kFrameBudgetNs) {
+        slowFrames++;
+        slowestFrameNs = qMax(slowestFrameNs, elapsed);
+    }
+    if (!slowFrameReport.isValid()) slowFrameReport.start();
+    if (slowFrameReport.elapsed() >= kReportIntervalMs) {
+        if (slowFrames > 0) {
+            qDebug() << "Chip view:" << slowFrames << "frames over budget in the last"
+                     << slowFrameReport.elapsed() << "ms, slowest" << slowestFrameNs / 1000000.0 << "ms at zoom"
+                     << zoom();
+        }
+        slowFrames = 0;
+        slowestFrameNs = 0;
+        slowFrameReport.restart();
+    }
+}
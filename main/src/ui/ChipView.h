@@ -0,0 +1,40 @@
+#ifndef CHIPVIEW_H
+#define CHIPVIEW_H
+
+#include <QGraphicsView>
+#include <QElapsedTimer>
+#include <QPaintEvent>
+#include <QWheelEvent>
+
+// 芯片视图: 滚轮以光标为中心缩放，拖动平移
+// 缩放比例变化时发出 zoomChanged，ChipRenderer 据此切换细节程度；每帧的绘制耗时由 framePainted 报告给动画。
+// 绘制超过一帧 (16.7 ms) 的预算时在调试输出中报告，便于检查大场景的平移性能
+class ChipView : public QGraphicsView
+{
+    Q_OBJECT
+
+public:
+    explicit ChipView(QGraphicsScene* scene, QWidget* parent = nullptr);
+
+    // 每个场景单位对应的像素数
+    double zoom() const;
+    void setZoom(double scale);
+
+    // 缩放到整个场景可见 (只缩小不放大)
+    void fitScene();
+
+signals:
+    void zoomChanged(double scale);
+    void framePainted(qint64 nanoseconds);
+
+protected:
+    void wheelEvent(QWheelEvent* event) override;
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    QElapsedTimer slowFrameReport;
+    int slowFrames;
+    qint64 slowestFrameNs;
+};
+
+#endif // CHIPVIEW_H
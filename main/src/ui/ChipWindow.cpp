@@ -2,25 +2,75 @@
 #include "../../forms/ui_chipwindow.h"
 #include <QDebug>
 #include <QPushButton>
+#include <QFileDialog>
+#include <QLineEdit>
+#include <QSpinBox>
+#include <QStatusBar>
+#include <QTimer>
+#include <QInputDialog>
+#include <QToolBar>
+#include <QDockWidget>
+#include <cmath>
 
 ChipWindow::ChipWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::ChipWindow)
     , scene(nullptr)
     , view(nullptr)
+    , minimap(nullptr)
     , splitter(nullptr)
     , dataPanel(nullptr)
     , statsLoader(nullptr)
+    , setupLoader(nullptr)
     , chipRenderer(nullptr)
+    , busUtilization(nullptr)
+    , overlayCombo(nullptr)
+    , flowAction(nullptr)
+    , lastFlowTick(0)
     , dataVisualizer(nullptr)
     , statsDisplayer(nullptr)
+    , missRatioAnalyzer(nullptr)
+    , designSpaceExplorer(nullptr)
+    , failedRunCount(0)
+    , baselineRunCount(0)
+    , candidateRunCount(0)
+    , catalogReparsed(0)
+    , queryEngine(nullptr)
+    , queryStore(nullptr)
+    , runManager(nullptr)
+    , memoryLabel(nullptr)
+    , liveIngestor(nullptr)
+    , liveLabel(nullptr)
+    , liveStatusTimer(nullptr)
+    , liveRefreshTimer(nullptr)
+    , counterSearchStale(true)
+    , searchEdit(nullptr)
+    , snapshotServer(nullptr)
 {
     ui->setupUi(this);
     
     // Create functional modules
     statsLoader = new StatsLoader();
+    setupLoader = new SetupLoader();
     dataVisualizer = new DataVisualizer(this);
     statsDisplayer = new StatsDisplayer(dataVisualizer, this);
+    designSpaceExplorer = new DesignSpaceExplorer(this);
+    runManager = new RunManager(512ll * 1024 * 1024, this);
+    connect(runManager, &RunManager::runReady, this, &ChipWindow::onRunReady);
+    connect(runManager, &RunManager::runFailed, this, [this](const QString& id) {
+        if (id == pendingRunId) pendingRunId.clear();
+        statusBar()->showMessage(QString("Failed to load run %1").arg(id), 5000);
+    });
+    connect(runManager, &RunManager::usageChanged, this, &ChipWindow::updateMemoryStatus);
+    liveIngestor = new LiveIngestor(this);
+    connect(liveIngestor, &LiveIngestor::snapshotReady, this, &ChipWindow::onLiveSnapshot);
+    liveStatusTimer = new QTimer(this);
+    liveStatusTimer->setInterval(500);
+    connect(liveStatusTimer, &QTimer::timeout, this, &ChipWindow::updateLiveStatus);
+    liveRefreshTimer = new QTimer(this);
+    liveRefreshTimer->setSingleShot(true);
+    connect(liveRefreshTimer, &QTimer::timeout, this, &ChipWindow::applyLiveSnapshot);
+    snapshotServer = new SnapshotServer(this);
     
     // Setup UI
     setupChipView();
@@ -33,19 +83,55 @@ ChipWindow::ChipWindow(QWidget *parent)
             statsLoader->getStatsData(),
             statsLoader->getPortTransmissions()
         );
+        counterStore.addRun("current", QString(), *statsLoader);
     } else {
         qDebug() << "Failed to load statistics data";
     }
     
-    // Create renderer and draw chip architecture
+    // Load hardware configuration
+    if (setupLoader->loadSetup()) {
+        statsDisplayer->setSetup(setupLoader->getSetup());
+        busUtilization = new BusUtilization(setupLoader->getSetup());
+        startMissRatioAnalysis();
+        startSetStatsLoad();
+    } else {
+        qDebug() << "Failed to load setup data";
+    }
+    
+    // Memory used by opened runs stays visible in the status bar
+    memoryLabel = new QLabel();
+    statusBar()->addPermanentWidget(memoryLabel);
+    updateMemoryStatus(runManager->usage(), runManager->budget());
+    liveLabel = new QLabel();
+    liveLabel->hide();
+    statusBar()->addPermanentWidget(liveLabel);
+    
+    // Create renderer; the chip is laid out from setup.txt in the background
     chipRenderer = new ChipRenderer(scene, this);
-    chipRenderer->drawChipArchitecture();
+    connect(view, &ChipView::zoomChanged, chipRenderer, &ChipRenderer::setLevelOfDetail);
+    connect(view, &ChipView::framePainted, chipRenderer->packetFlow(), &PacketFlowAnimator::recordPaintTime);
+    startChipLayout();
 }
 
 ChipWindow::~ChipWindow()
 {
     delete ui;
     
+    // Stop the design space sweep and live ingestion before the data they use is destroyed
+    delete designSpaceExplorer;
+    delete liveIngestor;
+    delete snapshotServer;
+    
+    // Cancel background analysis and wait for it before releasing its data
+    for (TaskHandle* task : {&layoutTask, &missRatioTask, &setStatsTask, &aggregateTask, &compareTask, &catalogTask, &exportTask}) {
+        task->cancel();
+        task->wait();
+    }
+    delete missRatioAnalyzer;
+    delete queryEngine;
+    delete busUtilization;
+    delete setupLoader;
+    
     // Clean up memory
     if (scene) {
         delete scene;
@@ -62,6 +148,74 @@ void ChipWindow::closeEvent(QCloseEvent *event)
     QMainWindow::closeEvent(event);
 }
 
+void ChipWindow::startChipLayout()
+{
+    // Geometry is computed on the pool; only item creation happens on the GUI thread
+    SetupModel setup = setupLoader->getSetup();
+    layoutTask = runInBackground(WorkStealingPool::Interactive, this, [setup]() {
+        QElapsedTimer timer;
+        timer.start();
+        ChipLayout layout = ChipLayout::cached(setup);
+        qDebug() << "Chip layout:" << layout.components.size() << "components," << layout.busNodes.size()
+                 << "bus nodes (" << GraphLayout::kindName(layout.topology) << ")," << layout.links.size()
+                 << "links in" << timer.elapsed() << "ms";
+        return layout;
+    }, [this](const ChipLayout& layout) {
+        QElapsedTimer timer;
+        timer.start();
+        chipRenderer->drawChipArchitecture(layout);
+        minimap->setChipLayout(layout);
+        qDebug() << "Chip scene:" << scene->items().size() << "items created in" << timer.elapsed() << "ms";
+        
+        // Large configurations start zoomed out so the whole chip is visible (as cluster glyphs)
+        view->fitScene();
+        refreshUtilizationOverlay();
+        layoutTask.reset();
+    });
+}
+
+void ChipWindow::startMissRatioAnalysis()
+{
+    QString tracePath = MissRatioAnalyzer::locateTrace();
+    if (tracePath.isEmpty()) {
+        qDebug() << "No address trace found, miss ratio curves disabled";
+        return;
+    }
+    
+    // One pass over the trace builds the curves of every L2/L3 at once
+    missRatioAnalyzer = new MissRatioAnalyzer(setupLoader->getSetup());
+    MissRatioAnalyzer* analyzer = missRatioAnalyzer;
+    
+    // The curves feed panels the user has not opened yet, so they are prefetched below interactive work
+    missRatioTask = runInBackground(WorkStealingPool::Prefetch, this, [analyzer, tracePath]() {
+        analyzer->processTrace(tracePath);
+    }, [this]() {
+        missRatioCurves = missRatioAnalyzer->getCurves();
+        statsDisplayer->setMissRatioCurves(missRatioCurves);
+        delete missRatioAnalyzer;
+        missRatioAnalyzer = nullptr;
+        missRatioTask.reset();
+    });
+}
+
+void ChipWindow::startSetStatsLoad()
+{
+    // Per-set counters are optional; the cache panels show a heatmap when present
+    QString setStatsPath = SetStatsLoader::locateFile();
+    if (setStatsPath.isEmpty()) return;
+    
+    // sets x ways per cache slice is too much to parse before the first paint, so it is prefetched like the curves
+    SetupModel setup = setupLoader->getSetup();
+    setStatsTask = runInBackground(WorkStealingPool::Prefetch, this, [setup, setStatsPath]() {
+        SetStatsLoader loader(setup);
+        if (!loader.load(setStatsPath)) return QMap<QString, CacheSetStats>();
+        return loader.getSetStats();
+    }, [this](const QMap<QString, CacheSetStats>& setStats) {
+        setStatsTask.reset();
+        if (!setStats.isEmpty()) statsDisplayer->setSetStats(setStats);
+    });
+}
+
 void ChipWindow::setupChipView()
 {
     setWindowTitle("Processor Architecture Visualization");
@@ -73,16 +227,122 @@ void ChipWindow::setupChipView()
     
     // Create graphics scene and view
     scene = new QGraphicsScene(this);
-    view = new QGraphicsView(scene);
+    view = new ChipView(scene);
     splitter->addWidget(view);
     
     // Set scene size
     scene->setSceneRect(0, 0, 1000, 700);
     
-    // Set view properties
-    view->setRenderHint(QPainter::Antialiasing);
-    view->setDragMode(QGraphicsView::ScrollHandDrag);
+    // The chip never moves once drawn, so the BSP index pays for itself on every pan and click;
+    // overlays repaint in place and do not touch the index
+    scene->setItemIndexMethod(QGraphicsScene::BspTreeIndex);
+    
+    // Set view properties (zoom, caching and update modes are set up by ChipView)
     view->setMinimumWidth(800);
+    
+    // Whole-chip overview; it repaints from cached tiles, so panning the view only moves its rectangle
+    QDockWidget* minimapDock = new QDockWidget("Overview", this);
+    minimapDock->setObjectName("minimapDock");
+    minimapDock->setFeatures(QDockWidget::DockWidgetClosable | QDockWidget::DockWidgetMovable |
+                             QDockWidget::DockWidgetFloatable);
+    minimap = new ChipMinimap(view, minimapDock);
+    minimapDock->setWidget(minimap);
+    addDockWidget(Qt::LeftDockWidgetArea, minimapDock);
+    
+    // Counter search lives in a toolbar so it survives data panel rebuilds
+    QToolBar* searchBar = addToolBar("Search");
+    searchBar->setMovable(false);
+    searchEdit = new QLineEdit();
+    searchEdit->setObjectName("counterSearchEdit");
+    searchEdit->setPlaceholderText("Search components and counters (l3 miss, busy, cpu0 ipc)");
+    searchEdit->setClearButtonEnabled(true);
+    searchEdit->setMaximumWidth(420);
+    searchBar->addWidget(searchEdit);
+    connect(searchEdit, &QLineEdit::textChanged, this, &ChipWindow::searchCounters);
+    
+    // Bus heatmap: switching the metric only recolors the overlay, the scene is not rebuilt
+    searchBar->addSeparator();
+    overlayCombo = new QComboBox();
+    overlayCombo->setObjectName("busOverlayCombo");
+    overlayCombo->addItem("Bus overlay: off", -1);
+    overlayCombo->addItem(BusUtilization::metricName(BusUtilization::BusyRate), BusUtilization::BusyRate);
+    overlayCombo->addItem(BusUtilization::metricName(BusUtilization::Traffic), BusUtilization::Traffic);
+    overlayCombo->setToolTip("Color bus edges and nodes by busy rate or by port-to-port traffic routed over the bus");
+    searchBar->addWidget(overlayCombo);
+    connect(overlayCombo, &QComboBox::currentIndexChanged, this, &ChipWindow::refreshUtilizationOverlay);
+    
+    // Packets moving along the bus, driven by the interval between live snapshots
+    flowAction = searchBar->addAction("Packet flow");
+    flowAction->setObjectName("packetFlowAction");
+    flowAction->setCheckable(true);
+    flowAction->setToolTip("Animate per-interval port-to-port traffic along the bus while live ingestion runs");
+    connect(flowAction, &QAction::toggled, this, &ChipWindow::togglePacketFlow);
+    
+    searchBar->addSeparator();
+    QAction* minimapAction = minimapDock->toggleViewAction();
+    minimapAction->setToolTip("Show the whole chip with the visible area; drag the rectangle to move around");
+    searchBar->addAction(minimapAction);
+}
+
+void ChipWindow::togglePacketFlow(bool enabled)
+{
+    lastFlowCounters.clear();
+    if (!enabled) {
+        chipRenderer->hidePacketFlow();
+        return;
+    }
+    if (!liveIngestor->isRunning()) {
+        statusBar()->showMessage("Packet flow follows live data; start live ingestion to see it move", 5000);
+    }
+}
+
+void ChipWindow::updatePacketFlow(quint64 tick, const QMap<QString, QString>& busCounters)
+{
+    // The counters are cumulative: the packets of this interval are the growth since the previous snapshot
+    QHash<QString, double> current;
+    QMap<QString, QString> interval;
+    for (auto it = busCounters.begin(); it != busCounters.end(); ++it) {
+        if (!it.key().startsWith("transmit_package_number_from_")) continue;
+        double value = it.value().toDouble();
+        current.insert(it.key(), value);
+        auto previous = lastFlowCounters.constFind(it.key());
+        if (previous != lastFlowCounters.constEnd() && value > *previous) {
+            interval.insert(it.key(), QString::number(value - *previous, 'g', 12));
+        }
+    }
+    bool haveInterval = !lastFlowCounters.isEmpty() && tick > lastFlowTick;
+    lastFlowCounters = current;
+    lastFlowTick = tick;
+    if (!haveInterval || !busUtilization) return;
+    
+    chipRenderer->showPacketFlow(busUtilization->compute(BusUtilization::Traffic, interval));
+}
+
+void ChipWindow::refreshUtilizationOverlay()
+{
+    updateUtilizationOverlay(currentRun().getPortTransmissions());
+}
+
+void ChipWindow::updateUtilizationOverlay(const QMap<QString, QString>& busCounters)
+{
+    int metric = overlayCombo->currentData().toInt();
+    if (metric < 0 || !busUtilization) {
+        chipRenderer->hideUtilization();
+        minimap->clearValues();
+        return;
+    }
+    
+    BusUtilization::Values values = busUtilization->compute(static_cast<BusUtilization::Metric>(metric), busCounters);
+    chipRenderer->showUtilization(values);
+    minimap->setValues(values);
+    if (liveIngestor->isRunning()) return;
+    
+    QString message = QString("%1: edge max %2, node max %3")
+                          .arg(BusUtilization::metricName(static_cast<BusUtilization::Metric>(metric)))
+                          .arg(values.edgeMax, 0, 'g', 4)
+                          .arg(values.nodeMax, 0, 'g', 4);
+    if (values.unroutable > 0) message += QString(", %1 port pairs without a bus path").arg(values.unroutable);
+    statusBar()->showMessage(message, 5000);
 }
 
 void ChipWindow::setupDataPanel()
@@ -107,18 +367,8 @@ void ChipWindow::setupDataPanel()
     dataPanelLayout->setSpacing(10);
     dataPanelLayout->setContentsMargins(15, 15, 15, 15);
     
-    // Add Port transmission overview button
-    QPushButton* portOverviewBtn = dataVisualizer->createStyledButton("Port Transmission Overview", "#007bff");
-    connect(portOverviewBtn, &QPushButton::clicked, this, &ChipWindow::showPortTransmissionOverview);
-    dataPanelLayout->addWidget(portOverviewBtn);
-    
-    // Initialize hint
-    QLabel* hintLabel = new QLabel("Click on any component to view its statistics\n\nOr click the button above to see port transmission overview");
-    hintLabel->setStyleSheet("color: #6c757d; font-size: 14px; font-style: italic; text-align: center;");
-    hintLabel->setAlignment(Qt::AlignCenter);
-    hintLabel->setWordWrap(true);
-    dataPanelLayout->addWidget(hintLabel);
-    dataPanelLayout->addStretch();
+    // Add buttons and initial hint
+    resetDataPanel();
     
     // Set splitter proportions
     splitter->setSizes({800, 400});
@@ -126,30 +376,570 @@ void ChipWindow::setupDataPanel()
 
 void ChipWindow::onComponentClicked(const QString& componentId)
 {
+    chipRenderer->clearHighlights();
     statsDisplayer->showComponentData(componentId, dataPanelLayout);
+    shownComponent = componentId;
 }
 
 void ChipWindow::showPortTransmissionOverview()
 {
     statsDisplayer->showPortTransmissionOverview(dataPanelLayout);
+    connectPanelButtons();
+}
+
+void ChipWindow::showLatencyBreakdown()
+{
+    statsDisplayer->showLatencyBreakdown(dataPanelLayout);
+    connectPanelButtons();
+}
+
+void ChipWindow::showValidationReport()
+{
+    // The GUI checks the loaded run; batches are validated with ppv-cli
+    ConservationValidator validator;
+    validator.setSetup(setupLoader->getSetup());
+    QVector<ValidationIssue> issues = validator.validate(counterStore);
     
-    // Need to reconnect "Back" button to this class's slot
-    // Since StatsDisplayer creates the button without connecting it
-    QPushButton* backBtn = dataPanel->findChild<QPushButton*>();
-    if (backBtn) {
-        disconnect(backBtn, nullptr, nullptr, nullptr);  // Disconnect any possible connections
-        connect(backBtn, &QPushButton::clicked, this, &ChipWindow::resetDataPanel);
+    statsDisplayer->showValidationReport(counterStore, issues, validator.instanceCount(), dataPanelLayout);
+    connectPanelButtons();
+}
+
+void ChipWindow::showNucaBalance()
+{
+    NucaBalanceAnalyzer analyzer(setupLoader->getSetup());
+    if (!analyzer.bind(counterStore)) return;
+    
+    NucaSnapshot snapshot = analyzer.analyzeAll();
+    statsDisplayer->showNucaBalance(snapshot, analyzer.slices(), dataPanelLayout);
+    connectPanelButtons();
+    
+    // Outline hot slices on the chip view until the panel is left
+    QMap<QString, QColor> highlights;
+    QMap<QString, QString> tooltips;
+    for (int slice : snapshot.hotSlices) {
+        const QString& id = analyzer.slices()[slice];
+        highlights[id] = QColor(220, 53, 69);
+        tooltips[id] = QString("Hot slice: %1 accesses (mean %2)")
+                           .arg(snapshot.accesses[slice], 0, 'f', 0)
+                           .arg(snapshot.accessBalance.mean, 0, 'f', 0);
+    }
+    chipRenderer->highlightComponents(highlights, tooltips);
+}
+
+void ChipWindow::showDesignSpaceExploration()
+{
+    // Calibrate once against the loaded run; later visits reuse the finished sweep
+    if (!designSpaceExplorer->isRunning() && designSpaceExplorer->evaluatedPoints().isEmpty()) {
+        if (!designSpaceExplorer->setBaseline(currentRun().getStatsData(), setupLoader->getSetup(), missRatioCurves)) {
+            qDebug() << "Design space exploration unavailable: missing cache configuration";
+            return;
+        }
+        designSpaceExplorer->start(DesignSpaceExplorer::GridSweep);
+    }
+    
+    statsDisplayer->showDesignSpaceExploration(designSpaceExplorer, dataPanelLayout);
+    connectPanelButtons();
+}
+
+void ChipWindow::aggregateRunDirectory()
+{
+    if (aggregateTask.isValid()) return;
+    
+    QString directory = QFileDialog::getExistingDirectory(this, "Select Run Directory");
+    if (directory.isEmpty()) return;
+    
+    // Parsing and aggregation run as batch work on the shared pool, behind anything interactive;
+    // the GUI only reads the results afterwards
+    runSetStore.clear();
+    delete queryEngine;
+    queryEngine = nullptr;
+    aggregateTask = runInBackground(WorkStealingPool::Batch, this, [this, directory]() {
+        QStringList files = RunSetLoader::discoverRuns({directory});
+        RunSetLoader loader;
+        loader.load(files, runSetStore);
+        failedRunCount = loader.failedFiles().size();
+        runAggregate.aggregate(runSetStore);
+    }, [this]() {
+        aggregateTask.reset();
+        
+        qDebug() << "Aggregated" << runAggregate.runCount() << "runs," << failedRunCount << "failed";
+        statsDisplayer->setRunAggregate(runAggregate, counterStore);
+        statsDisplayer->showRunAggregateSummary(failedRunCount, dataPanelLayout);
+        connectPanelButtons();
+    });
+}
+
+void ChipWindow::compareRunSets()
+{
+    if (compareTask.isValid()) return;
+    
+    QString baselineDir = QFileDialog::getExistingDirectory(this, "Select Baseline Run Directory");
+    if (baselineDir.isEmpty()) return;
+    QString candidateDir = QFileDialog::getExistingDirectory(this, "Select Candidate Run Directory");
+    if (candidateDir.isEmpty()) return;
+    
+    compareTask = runInBackground(WorkStealingPool::Batch, this, [this, baselineDir, candidateDir]() {
+        CounterStore baseline, candidate;
+        RunSetLoader loader;
+        loader.load(RunSetLoader::discoverRuns({baselineDir}), baseline);
+        loader.load(RunSetLoader::discoverRuns({candidateDir}), candidate);
+        baselineRunCount = baseline.runCount();
+        candidateRunCount = candidate.runCount();
+        comparisons = RegressionDetector().compare(baseline, candidate);
+    }, [this]() {
+        compareTask.reset();
+        
+        statsDisplayer->showRegressionReport(comparisons, baselineRunCount, candidateRunCount, dataPanelLayout);
+        connectPanelButtons();
+        
+        // Red for components with a regression, green for those that only improved
+        QMap<QString, QColor> highlights;
+        QMap<QString, QStringList> movedCounters;
+        for (const CounterComparison& comparison : comparisons) {
+            if (comparison.direction == CounterComparison::Regression) {
+                highlights[comparison.component()] = QColor(220, 53, 69);
+            } else if (comparison.direction == CounterComparison::Improvement) {
+                if (!highlights.contains(comparison.component())) {
+                    highlights[comparison.component()] = QColor(40, 167, 69);
+                }
+            } else {
+                continue;
+            }
+            movedCounters[comparison.component()].append(
+                QString("%1 %2%3%").arg(comparison.column.section('.', 1))
+                                   .arg(comparison.relativeChange >= 0 ? "+" : "")
+                                   .arg(comparison.relativeChange * 100, 0, 'f', 1));
+        }
+        QMap<QString, QString> tooltips;
+        for (auto it = movedCounters.begin(); it != movedCounters.end(); ++it) {
+            tooltips[it.key()] = it.value().mid(0, 8).join("\n");
+        }
+        chipRenderer->highlightComponents(highlights, tooltips);
+    });
+}
+
+void ChipWindow::openRunCatalog()
+{
+    if (catalogTask.isValid()) return;
+    
+    QString root = QFileDialog::getExistingDirectory(this, "Select Run Archive");
+    if (root.isEmpty()) return;
+    
+    // Only new or modified runs are parsed; the catalog is saved next to the archive
+    delete queryEngine;
+    queryEngine = nullptr;
+    catalogTask = runInBackground(WorkStealingPool::Batch, this, [this, root]() {
+        QString catalogPath = RunCatalog::defaultCatalogPath({root});
+        runCatalog = RunCatalog();
+        runCatalog.load(catalogPath);
+        catalogReparsed = runCatalog.update({root});
+        if (catalogReparsed > 0 || runCatalog.removedCount() > 0) {
+            runCatalog.save(catalogPath);
+        }
+        catalogStore.clear();
+        runCatalog.toCounterStore(catalogStore);
+    }, [this]() {
+        catalogTask.reset();
+        
+        statsDisplayer->showRunCatalog(runCatalog, catalogReparsed, dataPanelLayout);
+        connectPanelButtons();
+    });
+}
+
+void ChipWindow::runQuery()
+{
+    QLineEdit* queryEdit = dataPanel->findChild<QLineEdit*>("queryEdit");
+    if (!queryEdit || queryEdit->text().trimmed().isEmpty()) return;
+    QString query = queryEdit->text().trimmed();
+    
+    // Query the largest run set available: the catalog, then an aggregated directory, then the loaded run
+    if (catalogTask.isValid() || aggregateTask.isValid()) return;
+    const CounterStore* store = &counterStore;
+    QString source = "Loaded run";
+    if (catalogStore.runCount() > 0) {
+        store = &catalogStore;
+        source = "Run catalog";
+    } else if (runSetStore.runCount() > 0) {
+        store = &runSetStore;
+        source = "Aggregated directory";
+    }
+    
+    if (!queryEngine || queryStore != store) {
+        delete queryEngine;
+        queryEngine = new QueryEngine(*store);
+        queryStore = store;
     }
+    
+    QueryResult result = queryEngine->execute(query);
+    statsDisplayer->showQueryResult(query, result, source, dataPanelLayout);
+    connectPanelButtons();
+}
+
+void ChipWindow::exportArrow()
+{
+    // Export the same run set a query would see
+    if (exportTask.isValid() || catalogTask.isValid() || aggregateTask.isValid()) return;
+    const CounterStore* store = &counterStore;
+    if (catalogStore.runCount() > 0) {
+        store = &catalogStore;
+    } else if (runSetStore.runCount() > 0) {
+        store = &runSetStore;
+    }
+    
+    QString directory = QFileDialog::getExistingDirectory(this, "Export Arrow Files To");
+    if (directory.isEmpty()) return;
+    
+    // Writing runs as batch work on the shared pool; the store is implicitly shared, so the copy is
+    // cheap and later run switches or reloads do not touch what is being exported
+    statusBar()->showMessage(QString("Exporting Arrow files to %1...").arg(directory));
+    CounterStore snapshot = *store;
+    exportTask = runInBackground(WorkStealingPool::Batch, this, [snapshot, directory]() {
+        ArrowExporter exporter;
+        if (!exporter.exportStore(snapshot, directory)) {
+            return QString("Arrow export failed: %1").arg(exporter.errorString());
+        }
+        return QString("Exported %1 runs to %2 Arrow files in %3")
+            .arg(exporter.exportedRuns()).arg(exporter.writtenFiles().size()).arg(directory);
+    }, [this](const QString& message) {
+        exportTask.reset();
+        statusBar()->showMessage(message, 8000);
+    });
+}
+
+void ChipWindow::showOpenRuns()
+{
+    statsDisplayer->showOpenRuns(runManager->runs(), runManager->usage(), runManager->budget(),
+                                 activeRunId, dataPanelLayout);
+    connectPanelButtons();
+}
+
+void ChipWindow::openRunFile()
+{
+    QString path = QFileDialog::getOpenFileName(this, "Open Run", QString(), "Statistics (statistic.txt *.txt)");
+    if (path.isEmpty()) return;
+    
+    // Parsing happens in the background; the run is shown once it is ready
+    pendingRunId = runManager->open(path);
+    showOpenRuns();
+}
+
+void ChipWindow::activateRun(const QString& id)
+{
+    std::shared_ptr<const StatsLoader> run = runManager->acquire(id);
+    if (!run) {
+        // Evicted or still loading: show it when the background load finishes
+        pendingRunId = id;
+        showOpenRuns();
+        return;
+    }
+    
+    pendingRunId.clear();
+    activeRun = run;
+    activeRunId = id;
+    
+    statsDisplayer->setStatsData(run->getStatsData(), run->getPortTransmissions());
+    counterStore.clear();
+    counterStore.addRun(id, QString(), *run);
+    if (queryStore == &counterStore) {
+        delete queryEngine;
+        queryEngine = nullptr;
+    }
+    
+    setWindowTitle(QString("Processor Architecture Visualization - %1").arg(id));
+    chipRenderer->clearHighlights();
+    refreshUtilizationOverlay();
+    showOpenRuns();
+}
+
+void ChipWindow::onRunReady(const QString& id)
+{
+    if (snapshotServer->isRunning()) publishSnapshots();
+    counterSearchStale = true;
+    
+    if (id == pendingRunId) {
+        activateRun(id);
+    } else if (dataPanel->findChild<QSpinBox*>("budgetSpin")) {
+        // Refresh the run list while it is on screen
+        showOpenRuns();
+    }
+}
+
+void ChipWindow::updateMemoryStatus(qint64 usage, qint64 budget)
+{
+    const double megabyte = 1024.0 * 1024.0;
+    memoryLabel->setText(QString("Open runs: %1 / %2 MB").arg(usage / megabyte, 0, 'f', 1)
+                                                          .arg(budget / megabyte, 0, 'f', 0));
+}
+
+void ChipWindow::toggleLiveIngestion()
+{
+    if (liveIngestor->isRunning()) {
+        liveIngestor->stop();
+        liveRefreshTimer->stop();
+        liveStatusTimer->stop();
+        updateLiveStatus();
+        
+        // Back to the run shown before live mode
+        statsDisplayer->setStatsData(currentRun().getStatsData(), currentRun().getPortTransmissions());
+        refreshUtilizationOverlay();
+        chipRenderer->hidePacketFlow();
+        lastFlowCounters.clear();
+        statusBar()->showMessage("Live ingestion stopped", 5000);
+        return;
+    }
+    
+    bool ok = false;
+    QString name = QInputDialog::getText(this, "Live Ingestion", "Shared-memory ring written by the simulator:",
+                                         QLineEdit::Normal, "/ppv-live", &ok);
+    if (!ok || name.isEmpty()) return;
+    
+    if (!liveIngestor->start(name)) {
+        statusBar()->showMessage(QString("Live ingestion failed: %1").arg(liveIngestor->errorString()), 8000);
+        return;
+    }
+    lastLiveRefresh.invalidate();
+    liveLabel->show();
+    liveStatusTimer->start();
+    updateLiveStatus();
+}
+
+void ChipWindow::onLiveSnapshot()
+{
+    // Rebuilding the panel is the expensive part, so refresh at most every 100 ms
+    const qint64 minimumIntervalMs = 100;
+    if (liveRefreshTimer->isActive()) return;
+    qint64 sinceLast = lastLiveRefresh.isValid() ? lastLiveRefresh.elapsed() : minimumIntervalMs;
+    if (sinceLast >= minimumIntervalMs) {
+        applyLiveSnapshot();
+    } else {
+        liveRefreshTimer->start(static_cast<int>(minimumIntervalMs - sinceLast));
+    }
+}
+
+void ChipWindow::applyLiveSnapshot()
+{
+    if (!liveIngestor->isRunning()) return;
+    LiveIngestor::Snapshot snapshot = liveIngestor->latest();
+    if (snapshot.names.isEmpty()) return;
+    
+    // Same shape as a parsed statistic.txt: component -> counter -> text, every key also in the port map
+    QMap<QString, ComponentStats> liveStats;
+    QMap<QString, QString> livePorts;
+    for (int i = 0; i < snapshot.names.size() && i < snapshot.values.size(); ++i) {
+        if (std::isnan(snapshot.values[i])) continue;
+        const QString& name = snapshot.names[i];
+        int dot = name.indexOf('.');
+        if (dot <= 0) continue;
+        
+        QString component = name.left(dot);
+        QString counter = name.mid(dot + 1);
+        QString text = QString::number(snapshot.values[i], 'g', 12);
+        ComponentStats& stats = liveStats[component];
+        stats.name = component;
+        stats.data[counter] = text;
+        livePorts[counter] = text;
+    }
+    
+    statsDisplayer->setStatsData(liveStats, livePorts);
+    if (overlayCombo->currentData().toInt() >= 0) updateUtilizationOverlay(livePorts);
+    if (flowAction->isChecked()) updatePacketFlow(snapshot.tick, livePorts);
+    if (!shownComponent.isEmpty()) {
+        statsDisplayer->showComponentData(shownComponent, dataPanelLayout);
+    }
+    lastLiveRefresh.start();
+    
+    // The update counts as delivered once the panel shows it
+    liveIngestor->recordViewLatency(SharedMemoryRing::monotonicNs() - snapshot.sendNs);
+}
+
+void ChipWindow::updateLiveStatus()
+{
+    if (!liveIngestor->isRunning()) {
+        liveLabel->hide();
+        return;
+    }
+    
+    LiveIngestor::Statistics stats = liveIngestor->statistics();
+    liveLabel->setText(QString("Live %1: %2 records/s, ingest p99 %3 us, view p50 %4 ms / p99 %5 ms")
+                           .arg(liveIngestor->ringName())
+                           .arg(stats.recordsPerSecond, 0, 'f', 0)
+                           .arg(stats.ingestP99Ns / 1000.0, 0, 'f', 0)
+                           .arg(stats.viewP50Ns / 1e6, 0, 'f', 1)
+                           .arg(stats.viewP99Ns / 1e6, 0, 'f', 1));
+}
+
+void ChipWindow::toggleSnapshotServer()
+{
+    if (snapshotServer->isRunning()) {
+        snapshotServer->stop();
+        statusBar()->showMessage("HTTP server stopped", 5000);
+        return;
+    }
+    
+    bool ok = false;
+    int port = QInputDialog::getInt(this, "HTTP Server", "Serve JSON on 127.0.0.1, port:", 8765, 1, 65535, 1, &ok);
+    if (!ok) return;
+    
+    if (!snapshotServer->start(static_cast<quint16>(port))) {
+        statusBar()->showMessage(QString("HTTP server failed: %1").arg(snapshotServer->errorString()), 8000);
+        return;
+    }
+    publishSnapshots();
+    statusBar()->showMessage(QString("Serving loaded runs at http://127.0.0.1:%1/api").arg(snapshotServer->port()), 8000);
+}
+
+void ChipWindow::publishSnapshots()
+{
+    // The default statistic.txt plus every open run that is currently parsed;
+    // evicted runs are listed but not reloaded just to be served
+    QVector<PublishedRun> runs;
+    PublishedRun defaultRun;
+    defaultRun.id = "default";
+    defaultRun.state = RunManager::stateName(RunManager::Loaded);
+    defaultRun.stats = std::make_shared<const StatsLoader>(*statsLoader);
+    runs.append(defaultRun);
+    
+    for (const RunManager::RunStatus& status : runManager->runs()) {
+        PublishedRun run;
+        run.id = status.id;
+        run.path = status.path;
+        run.state = RunManager::stateName(status.state);
+        run.stats = runManager->peek(status.id);
+        runs.append(run);
+    }
+    
+    // Serialization runs on the thread pool; requests keep getting the previous documents meanwhile
+    snapshotServer->publish(runs);
+}
+
+void ChipWindow::searchCounters(const QString& text)
+{
+    if (text.trimmed().isEmpty()) {
+        resetDataPanel();
+        return;
+    }
+    
+    if (counterSearchStale) {
+        // Same runs the HTTP endpoint serves: the default statistic.txt and every parsed open run
+        counterSearch.clear();
+        counterSearch.addRun("default", statsLoader->getStatsData());
+        for (const RunManager::RunStatus& status : runManager->runs()) {
+            if (std::shared_ptr<const StatsLoader> run = runManager->peek(status.id)) {
+                counterSearch.addRun(status.id, run->getStatsData());
+            }
+        }
+        counterSearch.finalize();
+        counterSearchStale = false;
+    }
+    
+    QElapsedTimer timer;
+    timer.start();
+    QVector<CounterSearch::Match> matches = counterSearch.search(text);
+    double elapsedMicroseconds = timer.nsecsElapsed() / 1000.0;
+    
+    statsDisplayer->showSearchResults(text.trimmed(), matches, counterSearch.documentCount(), elapsedMicroseconds,
+                                      dataPanelLayout);
+    connectPanelButtons();
+    
+    // Outline every component with a match; the best one is selected with Show
+    QMap<QString, QColor> highlights;
+    for (const CounterSearch::Match& match : matches) {
+        highlights[match.component] = QColor(255, 193, 7);
+    }
+    chipRenderer->highlightComponents(highlights);
+}
+
+void ChipWindow::jumpToComponent(const QString& componentId)
+{
+    QMap<QString, QColor> highlights;
+    highlights[componentId] = QColor(255, 193, 7);
+    chipRenderer->highlightComponents(highlights);
+    
+    QRectF rect = chipRenderer->componentRect(componentId);
+    if (!rect.isNull()) {
+        // Zoom in far enough for labels to be drawn
+        if (view->zoom() < 0.6) view->setZoom(0.6);
+        view->centerOn(rect.center());
+    }
+    
+    statsDisplayer->showComponentData(componentId, dataPanelLayout);
+    shownComponent = componentId;
 }
 
 void ChipWindow::resetDataPanel()
 {
+    chipRenderer->clearHighlights();
     statsDisplayer->resetDataPanel(dataPanelLayout);
+    connectPanelButtons();
+}
+
+void ChipWindow::connectPanelButtons()
+{
+    // Every panel other than the component view ends up here
+    shownComponent.clear();
     
-    // Reconnect port overview button
-    QPushButton* portOverviewBtn = dataPanel->findChild<QPushButton*>();
-    if (portOverviewBtn) {
-        disconnect(portOverviewBtn, nullptr, nullptr, nullptr);  // Disconnect any possible connections
+    // StatsDisplayer creates the buttons without connecting them
+    if (QPushButton* portOverviewBtn = dataPanel->findChild<QPushButton*>("portOverviewBtn")) {
         connect(portOverviewBtn, &QPushButton::clicked, this, &ChipWindow::showPortTransmissionOverview);
     }
-} 
\ No newline at end of file
+    if (QPushButton* latencyBtn = dataPanel->findChild<QPushButton*>("latencyBtn")) {
+        connect(latencyBtn, &QPushButton::clicked, this, &ChipWindow::showLatencyBreakdown);
+    }
+    if (QPushButton* nucaBtn = dataPanel->findChild<QPushButton*>("nucaBtn")) {
+        connect(nucaBtn, &QPushButton::clicked, this, &ChipWindow::showNucaBalance);
+    }
+    if (QPushButton* validateBtn = dataPanel->findChild<QPushButton*>("validateBtn")) {
+        connect(validateBtn, &QPushButton::clicked, this, &ChipWindow::showValidationReport);
+    }
+    if (QPushButton* dseBtn = dataPanel->findChild<QPushButton*>("dseBtn")) {
+        connect(dseBtn, &QPushButton::clicked, this, &ChipWindow::showDesignSpaceExploration);
+    }
+    if (QPushButton* aggregateBtn = dataPanel->findChild<QPushButton*>("aggregateBtn")) {
+        connect(aggregateBtn, &QPushButton::clicked, this, &ChipWindow::aggregateRunDirectory);
+    }
+    if (QPushButton* compareBtn = dataPanel->findChild<QPushButton*>("compareBtn")) {
+        connect(compareBtn, &QPushButton::clicked, this, &ChipWindow::compareRunSets);
+    }
+    if (QPushButton* catalogBtn = dataPanel->findChild<QPushButton*>("catalogBtn")) {
+        connect(catalogBtn, &QPushButton::clicked, this, &ChipWindow::openRunCatalog);
+    }
+    if (QPushButton* queryBtn = dataPanel->findChild<QPushButton*>("queryBtn")) {
+        connect(queryBtn, &QPushButton::clicked, this, &ChipWindow::runQuery);
+    }
+    if (QLineEdit* queryEdit = dataPanel->findChild<QLineEdit*>("queryEdit")) {
+        connect(queryEdit, &QLineEdit::returnPressed, this, &ChipWindow::runQuery);
+    }
+    if (QPushButton* serverBtn = dataPanel->findChild<QPushButton*>("serverBtn")) {
+        connect(serverBtn, &QPushButton::clicked, this, &ChipWindow::toggleSnapshotServer);
+    }
+    if (QPushButton* liveBtn = dataPanel->findChild<QPushButton*>("liveBtn")) {
+        connect(liveBtn, &QPushButton::clicked, this, &ChipWindow::toggleLiveIngestion);
+    }
+    if (QPushButton* exportBtn = dataPanel->findChild<QPushButton*>("exportBtn")) {
+        connect(exportBtn, &QPushButton::clicked, this, &ChipWindow::exportArrow);
+    }
+    if (QPushButton* runsBtn = dataPanel->findChild<QPushButton*>("runsBtn")) {
+        connect(runsBtn, &QPushButton::clicked, this, &ChipWindow::showOpenRuns);
+    }
+    if (QPushButton* openRunBtn = dataPanel->findChild<QPushButton*>("openRunBtn")) {
+        connect(openRunBtn, &QPushButton::clicked, this, &ChipWindow::openRunFile);
+    }
+    for (QPushButton* resultBtn : dataPanel->findChildren<QPushButton*>("searchResultBtn")) {
+        QString componentId = resultBtn->property("componentId").toString();
+        connect(resultBtn, &QPushButton::clicked, this, [this, componentId]() { jumpToComponent(componentId); });
+    }
+    for (QPushButton* activateBtn : dataPanel->findChildren<QPushButton*>("activateRunBtn")) {
+        QString id = activateBtn->property("runId").toString();
+        connect(activateBtn, &QPushButton::clicked, this, [this, id]() { activateRun(id); });
+    }
+    if (QSpinBox* budgetSpin = dataPanel->findChild<QSpinBox*>("budgetSpin")) {
+        connect(budgetSpin, &QSpinBox::editingFinished, this, [this, budgetSpin]() {
+            runManager->setBudget(static_cast<qint64>(budgetSpin->value()) * 1024 * 1024);
+            // Rebuild the panel after the spin box has finished emitting
+            QTimer::singleShot(0, this, &ChipWindow::showOpenRuns);
+        });
+    }
+    if (QPushButton* backBtn = dataPanel->findChild<QPushButton*>("backBtn")) {
+        connect(backBtn, &QPushButton::clicked, this, &ChipWindow::resetDataPanel);
+    }
+}
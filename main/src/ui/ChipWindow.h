@@ -8,12 +8,38 @@
 #include <QScrollArea>
 #include <QVBoxLayout>
 #include <QCloseEvent>
+#include <QLabel>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QAction>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <memory>
 
 #include "../components/ClickableItems.h"
 #include "../statistics/StatsLoader.h"
+#include "../statistics/SetupLoader.h"
+#include "../statistics/SetStatsLoader.h"
+#include "../statistics/CounterStore.h"
+#include "../statistics/RunSetLoader.h"
+#include "../statistics/RunCatalog.h"
+#include "../statistics/RunManager.h"
+#include "../statistics/LiveIngestor.h"
+#include "../server/SnapshotServer.h"
+#include "../concurrency/BackgroundTask.h"
+#include "../export/ArrowExporter.h"
 #include "../statistics/StatsDisplayer.h"
 #include "../graphics/ChipRenderer.h"
+#include "../analysis/BusUtilization.h"
+#include "../analysis/MissRatioCurve.h"
+#include "../analysis/CounterSearch.h"
+#include "../analysis/DesignSpaceExplorer.h"
+#include "../analysis/RunAggregator.h"
+#include "../analysis/RegressionDetector.h"
+#include "../analysis/QueryEngine.h"
 #include "DataVisualizer.h"
+#include "ChipView.h"
+#include "ChipMinimap.h"
 
 namespace Ui {
 class ChipWindow;
@@ -38,14 +64,39 @@ protected:
 
 private slots:
     void showPortTransmissionOverview();
+    void showLatencyBreakdown();
+    void showValidationReport();
+    void showNucaBalance();
+    void showDesignSpaceExploration();
+    void aggregateRunDirectory();
+    void compareRunSets();
+    void openRunCatalog();
+    void runQuery();
+    void exportArrow();
+    void showOpenRuns();
+    void openRunFile();
+    void activateRun(const QString& id);
+    void onRunReady(const QString& id);
+    void updateMemoryStatus(qint64 usage, qint64 budget);
+    void toggleLiveIngestion();
+    void onLiveSnapshot();
+    void applyLiveSnapshot();
+    void updateLiveStatus();
+    void toggleSnapshotServer();
+    void publishSnapshots();
+    void searchCounters(const QString& text);
+    void jumpToComponent(const QString& componentId);
     void resetDataPanel();
+    void refreshUtilizationOverlay();
+    void togglePacketFlow(bool enabled);
 
 private:
     Ui::ChipWindow *ui;
     
     // 图形相关
     QGraphicsScene *scene;
-    QGraphicsView *view;
+    ChipView *view;
+    ChipMinimap *minimap;           // 概览停靠窗口，显示整个芯片与视图的可见范围
     
     // 布局
     QSplitter *splitter;
@@ -55,13 +106,87 @@ private:
     
     // 功能模块
     StatsLoader *statsLoader;
+    SetupLoader *setupLoader;
     ChipRenderer *chipRenderer;
+    TaskHandle layoutTask;          // 后台计算芯片布局
+    BusUtilization *busUtilization; // 总线热力叠加层的数据来源，setup.txt 读取成功后创建
+    QComboBox *overlayCombo;
+    QAction *flowAction;            // 实时数据的包流动画
+    QHash<QString, double> lastFlowCounters;    // 上一次快照的端口间累计包数
+    quint64 lastFlowTick;
     DataVisualizer *dataVisualizer;
     StatsDisplayer *statsDisplayer;
+    CounterStore counterStore;      // 当前运行的列式计数器
+    
+    // 后台分析，在共享线程池上运行; 句柄在结果交给界面后才重置
+    MissRatioAnalyzer *missRatioAnalyzer;
+    TaskHandle missRatioTask;
+    QMap<QString, MissRatioCurve> missRatioCurves;
+    TaskHandle setStatsTask;        // 读取 set_statistic.txt
+    DesignSpaceExplorer *designSpaceExplorer;
+    TaskHandle aggregateTask;
+    CounterStore runSetStore;       // 多次运行汇总的输入，只在后台任务结束后访问
+    RunAggregator runAggregate;
+    int failedRunCount;
+    TaskHandle compareTask;
+    QVector<CounterComparison> comparisons;
+    int baselineRunCount;
+    int candidateRunCount;
+    TaskHandle catalogTask;
+    RunCatalog runCatalog;          // 最近打开的运行目录索引
+    int catalogReparsed;
+    CounterStore catalogStore;      // 索引摘要的列式形式，供查询使用
+    TaskHandle exportTask;          // Arrow 导出，写入的是存储的副本
+    QueryEngine *queryEngine;       // 缓存块摘要，数据源变化时重建
+    const CounterStore *queryStore;
+    
+    // 打开的运行
+    RunManager *runManager;
+    std::shared_ptr<const StatsLoader> activeRun;  // 当前显示的运行 (为空时显示默认的 statistic.txt)
+    QString activeRunId;
+    QString pendingRunId;           // 等待后台加载完成后显示的运行
+    QLabel *memoryLabel;
+    
+    // 实时采集
+    LiveIngestor *liveIngestor;
+    QLabel *liveLabel;
+    QTimer *liveStatusTimer;
+    QTimer *liveRefreshTimer;       // 限制面板刷新频率
+    QElapsedTimer lastLiveRefresh;
+    QString shownComponent;         // 当前数据面板显示的组件，实时数据到达时刷新
+    
+    // 计数器搜索: 索引默认运行与已加载的打开运行，有运行加载完成后在下次搜索时重建
+    CounterSearch counterSearch;
+    bool counterSearchStale;
+    QLineEdit *searchEdit;
+    
+    // 本机 HTTP/JSON 服务
+    SnapshotServer *snapshotServer;
+    
+    // 当前显示的运行
+    const StatsLoader& currentRun() const { return activeRun ? *activeRun : *statsLoader; }
     
     // 初始化方法
     void setupChipView();
     void setupDataPanel();
+    
+    // 在后台线程中由 setup.txt 计算芯片布局，完成后创建图元
+    void startChipLayout();
+    
+    // 用给定的 Bus 计数器 (端口传输表的格式) 刷新热力叠加层，叠加层关闭时隐藏
+    void updateUtilizationOverlay(const QMap<QString, QString>& busCounters);
+    
+    // 由相邻两次实时快照的端口间包数之差驱动包流动画
+    void updatePacketFlow(quint64 tick, const QMap<QString, QString>& busCounters);
+    
+    // 在后台线程中从地址 trace 生成缺失率曲线
+    void startMissRatioAnalysis();
+    
+    // 在后台读取 set_statistic.txt，读完后交给缓存面板显示热力图
+    void startSetStatsLoad();
+    
+    // 按 objectName 连接数据面板中由 StatsDisplayer 创建的按钮
+    void connectPanelButtons();
 };
 
 #endif // CHIPWINDOW_H 
\ No newline at end of file
@@ -1,5 +1,31 @@
 #include "DataVisualizer.h"
+#include "MissRatioChart.h"
+#include "LatencyWaterfallChart.h"
+#include "CacheHeatmapView.h"
+#include "PortChordChart.h"
+#include "RunTableModel.h"
 #include <QHBoxLayout>
+#include <QComboBox>
+#include <QGridLayout>
+#include <QTableView>
+#include <QHeaderView>
+#include <QSortFilterProxyModel>
+#include <QLineEdit>
+#include <QSpinBox>
+#include <cmath>
+
+namespace {
+
+// 计数器取整显示，比例与小数保留有效位
+QString formatCounterValue(double value)
+{
+    if (std::isnan(value)) return "-";
+    if (std::fabs(value) >= 1e7) return QString::number(value, 'g', 4);
+    if (value == std::floor(value)) return QString::number(value, 'f', 0);
+    return QString::number(value, 'g', 4);
+}
+
+}
 
 DataVisualizer::DataVisualizer(QObject* parent)
     : QObject(parent)
@@ -65,7 +91,7 @@ QPushButton* DataVisualizer::createStyledButton(const QString& text, const QStri
     return button;
 }
 
-QWidget* DataVisualizer::createDataGroup(const QString& title, const QMap<QString, QString>& data)
+QGroupBox* DataVisualizer::createStyledGroup(const QString& title)
 {
     QGroupBox* groupBox = new QGroupBox(title);
     groupBox->setStyleSheet(
@@ -73,6 +99,12 @@ QWidget* DataVisualizer::createDataGroup(const QString& title, const QMap<QStrin
         "border-radius: 5px; margin-top: 1ex; padding-top: 10px; background-color: white; }"
         "QGroupBox::title { subcontrol-origin: margin; left: 10px; padding: 0 10px 0 10px; }"
     );
+    return groupBox;
+}
+
+QWidget* DataVisualizer::createDataGroup(const QString& title, const QMap<QString, QString>& data)
+{
+    QGroupBox* groupBox = createStyledGroup(title);
     
     QVBoxLayout* layout = new QVBoxLayout(groupBox);
     layout->setSpacing(5);
@@ -140,4 +172,296 @@ QWidget* DataVisualizer::createStatCard(const QString& title, const QString& val
     layout->addWidget(valueLabel);
     
     return card;
-} 
\ No newline at end of file
+}
+
+QWidget* DataVisualizer::createMissRatioChart(const MissRatioCurve& curve)
+{
+    QGroupBox* groupBox = createStyledGroup("Miss Ratio Curve");
+
+    QVBoxLayout* layout = new QVBoxLayout(groupBox);
+    layout->addWidget(new MissRatioChart(curve));
+
+    return groupBox;
+}
+
+QWidget* DataVisualizer::createLatencyWaterfall(const QVector<EventLatency>& events)
+{
+    QGroupBox* groupBox = createStyledGroup("Latency Waterfall");
+
+    QVBoxLayout* layout = new QVBoxLayout(groupBox);
+    layout->addWidget(new LatencyWaterfallChart(events));
+
+    return groupBox;
+}
+
+QWidget* DataVisualizer::createPortChordChart(const PortTraffic& traffic)
+{
+    QGroupBox* groupBox = createStyledGroup("Port Traffic");
+
+    QVBoxLayout* layout = new QVBoxLayout(groupBox);
+    QLabel* hint = new QLabel("Arc length is packets sent plus received; ribbons are colored by the sending port's bus node. "
+                              "Hover a port or ribbon for details.");
+    hint->setWordWrap(true);
+    hint->setStyleSheet("color: #6c757d; font-size: 11px;");
+    layout->addWidget(hint);
+    layout->addWidget(new PortChordChart(traffic));
+
+    return groupBox;
+}
+
+QWidget* DataVisualizer::createCacheHeatmap(const CacheSetStats& stats)
+{
+    QGroupBox* groupBox = createStyledGroup("Per-Set Heatmap");
+
+    QVBoxLayout* layout = new QVBoxLayout(groupBox);
+    CacheHeatmapView* heatmap = new CacheHeatmapView(stats);
+
+    QComboBox* modeBox = new QComboBox();
+    if (stats.hasWayHits()) modeBox->addItem("Way Hits", CacheHeatmapView::WayHits);
+    modeBox->addItem("Accesses", CacheHeatmapView::Accesses);
+    modeBox->addItem("Misses", CacheHeatmapView::Misses);
+    modeBox->addItem("Evictions", CacheHeatmapView::Evictions);
+    connect(modeBox, &QComboBox::currentIndexChanged, heatmap, [heatmap, modeBox](int index) {
+        heatmap->setMode(static_cast<CacheHeatmapView::Mode>(modeBox->itemData(index).toInt()));
+    });
+
+    QLabel* hint = new QLabel("Scroll to zoom, drag to pan");
+    hint->setStyleSheet("font-weight: normal; color: #6c757d; font-size: 11px;");
+
+    QHBoxLayout* controls = new QHBoxLayout();
+    controls->addWidget(modeBox);
+    controls->addStretch();
+    controls->addWidget(hint);
+
+    layout->addLayout(controls);
+    layout->addWidget(heatmap);
+
+    return groupBox;
+}
+
+QWidget* DataVisualizer::createIssueGroup(const QString& title, const QStringList& items, const QColor& color)
+{
+    QGroupBox* groupBox = createStyledGroup(title);
+    groupBox->setStyleSheet(groupBox->styleSheet() + QString("QGroupBox { color: %1; }").arg(color.name()));
+
+    QVBoxLayout* layout = new QVBoxLayout(groupBox);
+    layout->setSpacing(4);
+
+    for (const QString& item : items) {
+        QLabel* label = new QLabel(item);
+        label->setStyleSheet(QString("font-weight: normal; color: #2c3e50; border-left: 3px solid %1; padding-left: 6px;")
+                                 .arg(color.name()));
+        label->setWordWrap(true);
+        label->setTextInteractionFlags(Qt::TextSelectableByMouse);
+        layout->addWidget(label);
+    }
+
+    return groupBox;
+}
+
+QWidget* DataVisualizer::createDistributionGroup(const QString& title, const QStringList& counters,
+                                                 const QVector<double>& current,
+                                                 const QVector<CounterDistribution>& distributions)
+{
+    QGroupBox* groupBox = createStyledGroup(title);
+
+    QGridLayout* grid = new QGridLayout(groupBox);
+    grid->setHorizontalSpacing(8);
+    grid->setVerticalSpacing(3);
+
+    const QStringList headers = {"Counter", "This Run", "Mean ± SD", "P5 / P50 / P95"};
+    for (int column = 0; column < headers.size(); ++column) {
+        QLabel* header = new QLabel(headers[column]);
+        header->setStyleSheet("font-weight: bold; color: #495057; font-size: 11px;");
+        grid->addWidget(header, 0, column, column == 0 ? Qt::AlignLeft : Qt::AlignRight);
+    }
+
+    for (int i = 0; i < counters.size(); ++i) {
+        const CounterDistribution& distribution = distributions[i];
+        double value = i < current.size() ? current[i] : std::nan("");
+        bool outlier = !std::isnan(value) && distribution.samples > 1 &&
+                       (value < distribution.p5 || value > distribution.p95);
+
+        QLabel* name = new QLabel(counters[i]);
+        name->setStyleSheet("font-weight: normal; color: #6c757d; font-size: 11px;");
+        name->setToolTip(QString("%1 runs, min %2, max %3")
+                             .arg(distribution.samples)
+                             .arg(formatCounterValue(distribution.min))
+                             .arg(formatCounterValue(distribution.max)));
+
+        QLabel* runValue = new QLabel(formatCounterValue(value));
+        runValue->setStyleSheet(QString("font-weight: bold; font-size: 11px; color: %1;")
+                                    .arg(outlier ? "#dc3545" : "#2c3e50"));
+
+        QLabel* mean = new QLabel(QString("%1 ± %2")
+                                      .arg(formatCounterValue(distribution.mean))
+                                      .arg(formatCounterValue(distribution.stddev)));
+        mean->setStyleSheet("font-weight: normal; color: #2c3e50; font-size: 11px;");
+
+        QLabel* percentiles = new QLabel(QString("%1 / %2 / %3")
+                                             .arg(formatCounterValue(distribution.p5))
+                                             .arg(formatCounterValue(distribution.p50))
+                                             .arg(formatCounterValue(distribution.p95)));
+        percentiles->setStyleSheet("font-weight: normal; color: #2c3e50; font-size: 11px;");
+
+        grid->addWidget(name, i + 1, 0);
+        grid->addWidget(runValue, i + 1, 1, Qt::AlignRight);
+        grid->addWidget(mean, i + 1, 2, Qt::AlignRight);
+        grid->addWidget(percentiles, i + 1, 3, Qt::AlignRight);
+    }
+
+    return groupBox;
+}
+
+QWidget* DataVisualizer::createRunTable(const QString& title, const QStringList& runIds,
+                                        const QStringList& columnNames, const QVector<QVector<double>>& columns)
+{
+    QGroupBox* groupBox = createStyledGroup(title);
+
+    QVBoxLayout* layout = new QVBoxLayout(groupBox);
+
+    RunTableModel* model = new RunTableModel(groupBox);
+    model->setRuns(runIds, columnNames, columns);
+
+    // Sort on the numeric value rather than the display text
+    QSortFilterProxyModel* proxy = new QSortFilterProxyModel(groupBox);
+    proxy->setSourceModel(model);
+    proxy->setSortRole(Qt::UserRole);
+
+    QTableView* table = new QTableView();
+    table->setModel(proxy);
+    table->setSortingEnabled(true);
+    table->sortByColumn(0, Qt::AscendingOrder);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->verticalHeader()->setVisible(false);
+    table->verticalHeader()->setDefaultSectionSize(20);
+    table->horizontalHeader()->setStretchLastSection(true);
+    table->setStyleSheet("QTableView { background-color: white; font-weight: normal; font-size: 11px; }");
+    table->setMinimumHeight(300);
+    layout->addWidget(table);
+
+    QLabel* countLabel = new QLabel(QString("%1 runs").arg(runIds.size()));
+    countLabel->setStyleSheet("font-weight: normal; color: #6c757d; font-size: 11px;");
+    layout->addWidget(countLabel);
+
+    return groupBox;
+}
+
+QWidget* DataVisualizer::createQueryBox(const QString& text)
+{
+    QGroupBox* groupBox = createStyledGroup("Query Runs");
+
+    QVBoxLayout* layout = new QVBoxLayout(groupBox);
+
+    QLineEdit* queryEdit = new QLineEdit(text);
+    queryEdit->setObjectName("queryEdit");
+    queryEdit->setPlaceholderText("select run, CPU*.ipc where L3Cache*.llc_hit_rate < 0.4 limit 20");
+    queryEdit->setStyleSheet("QLineEdit { background-color: white; font-weight: normal; font-family: monospace; padding: 4px; }");
+    layout->addWidget(queryEdit);
+
+    QPushButton* queryBtn = createStyledButton("Run Query", "#343a40", false);
+    queryBtn->setObjectName("queryBtn");
+    layout->addWidget(queryBtn);
+
+    return groupBox;
+}
+
+QWidget* DataVisualizer::createOpenRunList(const QVector<RunManager::RunStatus>& runs, const QString& activeId)
+{
+    QGroupBox* groupBox = createStyledGroup("Runs (most recently used first)");
+
+    QVBoxLayout* layout = new QVBoxLayout(groupBox);
+    layout->setSpacing(4);
+
+    if (runs.isEmpty()) {
+        QLabel* emptyLabel = new QLabel("No runs opened yet");
+        emptyLabel->setStyleSheet("font-weight: normal; color: #6c757d;");
+        layout->addWidget(emptyLabel);
+    }
+
+    for (const RunManager::RunStatus& run : runs) {
+        QHBoxLayout* rowLayout = new QHBoxLayout();
+
+        QString details = QString("%1, %2 KB").arg(RunManager::stateName(run.state)).arg(run.bytes / 1024);
+        if (run.id == activeId) details += ", shown";
+        else if (run.pinned) details += ", in use";
+
+        QLabel* label = new QLabel(QString("<b>%1</b><br><span style='color: #6c757d;'>%2</span>")
+                                       .arg(run.id.toHtmlEscaped(), details));
+        label->setStyleSheet("font-weight: normal; color: #2c3e50;");
+        label->setToolTip(run.path);
+
+        QPushButton* showBtn = new QPushButton(run.id == activeId ? "Shown" : "Show");
+        showBtn->setObjectName("activateRunBtn");
+        showBtn->setProperty("runId", run.id);
+        showBtn->setEnabled(run.id != activeId);
+        showBtn->setMaximumWidth(70);
+
+        rowLayout->addWidget(label, 1);
+        rowLayout->addWidget(showBtn);
+        layout->addLayout(rowLayout);
+    }
+
+    return groupBox;
+}
+
+QWidget* DataVisualizer::createSearchResultList(const QVector<CounterSearch::Match>& matches)
+{
+    QGroupBox* groupBox = createStyledGroup(QString("Matches (%1)").arg(matches.size()));
+
+    QVBoxLayout* layout = new QVBoxLayout(groupBox);
+    layout->setSpacing(4);
+
+    if (matches.isEmpty()) {
+        QLabel* emptyLabel = new QLabel("No component or counter matches");
+        emptyLabel->setStyleSheet("font-weight: normal; color: #6c757d;");
+        layout->addWidget(emptyLabel);
+    }
+
+    for (const CounterSearch::Match& match : matches) {
+        QHBoxLayout* rowLayout = new QHBoxLayout();
+
+        QString name = match.counter.isEmpty() ? match.component : match.component + "." + match.counter;
+        QString details = match.counter.isEmpty() ? QString("component") : QString("= %1").arg(match.value);
+        if (match.runs.size() > 1) details += QString(", in %1 runs").arg(match.runs.size());
+
+        QLabel* label = new QLabel(QString("<b>%1</b><br><span style='color: #6c757d;'>%2</span>")
+                                       .arg(name.toHtmlEscaped(), details.toHtmlEscaped()));
+        label->setStyleSheet("font-weight: normal; color: #2c3e50;");
+        label->setToolTip(match.runs.join(", "));
+
+        QPushButton* showBtn = new QPushButton("Show");
+        showBtn->setObjectName("searchResultBtn");
+        showBtn->setProperty("componentId", match.component);
+        showBtn->setMaximumWidth(70);
+
+        rowLayout->addWidget(label, 1);
+        rowLayout->addWidget(showBtn);
+        layout->addLayout(rowLayout);
+    }
+
+    return groupBox;
+}
+
+QWidget* DataVisualizer::createBudgetControl(int megabytes)
+{
+    QGroupBox* groupBox = createStyledGroup("Memory Budget");
+
+    QHBoxLayout* layout = new QHBoxLayout(groupBox);
+
+    QLabel* label = new QLabel("Budget for open runs:");
+    label->setStyleSheet("font-weight: normal; color: #6c757d;");
+
+    QSpinBox* budgetSpin = new QSpinBox();
+    budgetSpin->setObjectName("budgetSpin");
+    budgetSpin->setRange(1, 1024 * 1024);
+    budgetSpin->setSuffix(" MB");
+    budgetSpin->setValue(megabytes);
+    budgetSpin->setStyleSheet("QSpinBox { background-color: white; font-weight: normal; }");
+
+    layout->addWidget(label);
+    layout->addWidget(budgetSpin);
+
+    return groupBox;
+}
@@ -11,6 +11,14 @@
 #include <QProgressBar>
 #include <QPushButton>
 
+#include "../analysis/MissRatioCurve.h"
+#include "../analysis/LatencyDecomposition.h"
+#include "../analysis/PortTraffic.h"
+#include "../statistics/SetStatsLoader.h"
+#include "../analysis/RunAggregator.h"
+#include "../statistics/RunManager.h"
+#include "../analysis/CounterSearch.h"
+
 class DataVisualizer : public QObject
 {
     Q_OBJECT
@@ -25,6 +33,32 @@ public:
     QWidget* createDataGroup(const QString& title, const QMap<QString, QString>& data);
     QWidget* createPercentageBar(const QString& label, double percentage, const QColor& color);
     QWidget* createStatCard(const QString& title, const QString& value, const QString& unit = "");
+    QWidget* createMissRatioChart(const MissRatioCurve& curve);
+    QWidget* createLatencyWaterfall(const QVector<EventLatency>& events);
+    QWidget* createCacheHeatmap(const CacheSetStats& stats);
+    QWidget* createPortChordChart(const PortTraffic& traffic);
+    QWidget* createIssueGroup(const QString& title, const QStringList& items, const QColor& color);
+    
+    // 打开的运行列表，每行带一个 objectName 为 "activateRunBtn"、属性 runId 的按钮
+    QWidget* createOpenRunList(const QVector<RunManager::RunStatus>& runs, const QString& activeId);
+    
+    // 计数器搜索结果，每行带一个 objectName 为 "searchResultBtn"、属性 componentId 的按钮
+    QWidget* createSearchResultList(const QVector<CounterSearch::Match>& matches);
+    
+    // 内存预算输入框 (objectName "budgetSpin"，单位 MB)
+    QWidget* createBudgetControl(int megabytes);
+    
+    // 查询输入框: objectName 为 "queryEdit" 的输入框与 "queryBtn" 按钮，由 ChipWindow 连接
+    QWidget* createQueryBox(const QString& text = QString());
+    
+    // 运行列表 (可按列排序)，columns 按列存放，每列与 runIds 等长
+    QWidget* createRunTable(const QString& title, const QStringList& runIds, const QStringList& columnNames,
+                            const QVector<QVector<double>>& columns);
+    
+    // 多次运行的分布表，current 为当前运行的值 (NaN 表示没有)，超出 [P5, P95] 时标红
+    QWidget* createDistributionGroup(const QString& title, const QStringList& counters,
+                                     const QVector<double>& current,
+                                     const QVector<CounterDistribution>& distributions);
     
     // 添加标题
     QLabel* createTitleLabel(const QString& title);
@@ -32,6 +66,10 @@ public:
     // 创建按钮
     QPushButton* createStyledButton(const QString& text, const QString& colorCode, 
                                    bool isPrimary = true);
+
+private:
+    // 统一样式的分组框
+    QGroupBox* createStyledGroup(const QString& title);
 };
 
 #endif // DATAVISUALIZER_H 
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "LatencyWaterfallChart.h"
+#include <QPainter>
+#include <cmath>
+
+namespace {
+
+const int kHeaderHeight = 20;
+const int kRowHeight = 16;
+const int kGroupSpacing = 8;
+const int kLegendHeight = 22;
+const int kAxisHeight = 20;
+const int kLabelWidth = 80;
+
+const QColor kLookupColor(0, 123, 255);
+const QColor kBusColor(253, 126, 20);
+const QColor kMemoryColor(220, 53, 69);
+const QColor kOtherColor(173, 181, 189);
+
+}
+
+LatencyWaterfallChart::LatencyWaterfallChart(const QVector<EventLatency>& events, QWidget* parent)
+    : QWidget(parent), events(events), maxCycles(1)
+{
+    int height = kLegendHeight + kAxisHeight;
+    for (const EventLatency& event : events) {
+        maxCycles = qMax(maxCycles, event.avgCycles);
+        height += kHeaderHeight + event.hops.size() * kRowHeight + kGroupSpacing;
+    }
+    setMinimumHeight(height);
+    setStyleSheet("background-color: white;");
+}
+
+QString LatencyWaterfallChart::hopLabel(const HopLatency& hop)
+{
+    auto name = [](const QString& endpoint) {
+        if (endpoint == "mem") return QString("Mem");
+        if (endpoint.startsWith("o")) return "Other " + endpoint.mid(1).toUpper();
+        return endpoint.toUpper();
+    };
+    return name(hop.from) + " → " + name(hop.to);
+}
+
+void LatencyWaterfallChart::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(rect(), Qt::white);
+
+    if (events.isEmpty()) {
+        painter.setPen(QColor(108, 117, 125));
+        painter.drawText(rect(), Qt::AlignCenter, "No cache_event_trace data");
+        return;
+    }
+
+    double left = kLabelWidth;
+    double plotWidth = width() - kLabelWidth - 15;
+    auto mapX = [&](double cycles) { return left + cycles / maxCycles * plotWidth; };
+
+    // 图例
+    struct LegendItem { QString name; QColor color; };
+    const QList<LegendItem> legend = {
+        {"Lookup", kLookupColor}, {"Bus", kBusColor}, {"DRAM", kMemoryColor}, {"Queue/Other", kOtherColor}
+    };
+    painter.setFont(QFont("Arial", 8));
+    double legendX = left;
+    for (const LegendItem& item : legend) {
+        painter.fillRect(QRectF(legendX, 6, 10, 10), item.color);
+        painter.setPen(QColor(73, 80, 87));
+        painter.drawText(QRectF(legendX + 14, 2, 80, 18), Qt::AlignLeft | Qt::AlignVCenter, item.name);
+        legendX += 22 + painter.fontMetrics().horizontalAdvance(item.name);
+    }
+
+    // 纵向网格
+    double top = kLegendHeight;
+    double bottom = height() - kAxisHeight;
+    double step = std::pow(10.0, std::floor(std::log10(maxCycles / 2)));
+    if (maxCycles / step > 8) step *= 2;
+    painter.setFont(QFont("Arial", 7));
+    for (double cycles = 0; cycles <= maxCycles + 1e-9; cycles += step) {
+        double x = mapX(cycles);
+        painter.setPen(QPen(QColor(222, 226, 230), 1));
+        painter.drawLine(QPointF(x, top), QPointF(x, bottom));
+        painter.setPen(QColor(108, 117, 125));
+        painter.drawText(QRectF(x - 20, bottom + 3, 40, 14), Qt::AlignCenter, QString::number(cycles));
+    }
+    painter.drawText(QRectF(left, bottom + 3, plotWidth, 14), Qt::AlignRight, "cycles");
+
+    // 每类事件
+    double y = top;
+    for (const EventLatency& latency : events) {
+        painter.setPen(QColor(44, 62, 80));
+        painter.setFont(QFont("Arial", 8, QFont::Bold));
+        painter.drawText(QRectF(4, y, width() - 8, kHeaderHeight), Qt::AlignLeft | Qt::AlignVCenter,
+                         QString("%1  —  %2 cycles avg, %3 events")
+                             .arg(latency.label)
+                             .arg(latency.avgCycles, 0, 'f', 1)
+                             .arg(latency.count));
+        y += kHeaderHeight;
+
+        double start = 0;
+        painter.setFont(QFont("Arial", 7));
+        for (const HopLatency& hop : latency.hops) {
+            painter.setPen(QColor(108, 117, 125));
+            painter.drawText(QRectF(4, y, kLabelWidth - 8, kRowHeight), Qt::AlignRight | Qt::AlignVCenter,
+                             hopLabel(hop));
+
+            // 段内按类别依次堆叠
+            double segments[4] = {hop.lookupCycles, hop.busCycles, hop.memoryCycles, hop.otherCycles};
+            double x = start;
+            for (int i = 0; i < 4; ++i) {
+                if (segments[i] <= 0) continue;
+                QRectF bar(mapX(x), y + 3, mapX(x + segments[i]) - mapX(x), kRowHeight - 6);
+                painter.fillRect(bar, legend[i].color);
+                x += segments[i];
+            }
+
+            // 段间连接线
+            painter.setPen(QPen(QColor(73, 80, 87), 1, Qt::DotLine));
+            painter.drawLine(QPointF(mapX(x), y + 3), QPointF(mapX(x), y + kRowHeight + 3));
+
+            start += hop.cycles;
+            y += kRowHeight;
+        }
+        y += kGroupSpacing;
+    }
+}
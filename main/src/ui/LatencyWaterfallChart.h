@@ -0,0 +1,27 @@
+#ifndef LATENCYWATERFALLCHART_H
+#define LATENCYWATERFALLCHART_H
+
+#include "../analysis/LatencyDecomposition.h"
+#include <QWidget>
+#include <QPaintEvent>
+
+// 延迟瀑布图: 每类事件一组，每段传输一行，条形从上一段结束处开始，
+// 内部按缓存查找 / 总线 / 内存 / 其他分色堆叠，横轴为所有事件共用的周期刻度
+class LatencyWaterfallChart : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit LatencyWaterfallChart(const QVector<EventLatency>& events, QWidget* parent = nullptr);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    static QString hopLabel(const HopLatency& hop);
+
+    QVector<EventLatency> events;
+    double maxCycles;
+};
+
+#endif // LATENCYWATERFALLCHART_H
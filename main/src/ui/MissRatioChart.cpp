@@ -0,0 +1,106 @@
+#include "MissRatioChart.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <cmath>
+
+MissRatioChart::MissRatioChart(const MissRatioCurve& curve, QWidget* parent)
+    : QWidget(parent), curve(curve)
+{
+    setMinimumHeight(220);
+    setStyleSheet("background-color: white;");
+}
+
+QString MissRatioChart::formatBytes(double bytes)
+{
+    if (bytes >= 1024.0 * 1024.0) return QString("%1M").arg(bytes / (1024.0 * 1024.0), 0, 'g', 3);
+    if (bytes >= 1024.0) return QString("%1K").arg(bytes / 1024.0, 0, 'g', 3);
+    return QString("%1B").arg(bytes, 0, 'g', 3);
+}
+
+void MissRatioChart::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(rect(), Qt::white);
+
+    QRectF plot(45, 25, width() - 60, height() - 55);
+
+    painter.setPen(QColor(44, 62, 80));
+    painter.setFont(QFont("Arial", 9, QFont::Bold));
+    painter.drawText(QRectF(0, 2, width(), 20), Qt::AlignCenter,
+                     QString("Hit Ratio vs Capacity (sample rate %1%)")
+                         .arg(curve.sampleRate * 100, 0, 'g', 3));
+
+    if (curve.capacityBytes.size() < 2) {
+        painter.drawText(plot, Qt::AlignCenter, "Not enough trace data");
+        return;
+    }
+
+    double minLog = std::log2(curve.capacityBytes.first());
+    double maxLog = std::log2(curve.capacityBytes.last());
+    if (maxLog <= minLog) maxLog = minLog + 1;
+
+    auto mapX = [&](double bytes) {
+        return plot.left() + (std::log2(bytes) - minLog) / (maxLog - minLog) * plot.width();
+    };
+    auto mapY = [&](double ratio) {
+        return plot.bottom() - ratio * plot.height();
+    };
+
+    // 坐标轴与网格
+    painter.setFont(QFont("Arial", 7));
+    painter.setPen(QPen(QColor(222, 226, 230), 1));
+    for (int i = 0; i <= 4; ++i) {
+        double y = mapY(i / 4.0);
+        painter.drawLine(QPointF(plot.left(), y), QPointF(plot.right(), y));
+    }
+    painter.setPen(QColor(108, 117, 125));
+    for (int i = 0; i <= 4; ++i) {
+        painter.drawText(QRectF(0, mapY(i / 4.0) - 8, plot.left() - 5, 16),
+                         Qt::AlignRight | Qt::AlignVCenter, QString("%1%").arg(i * 25));
+    }
+    for (int exponent = static_cast<int>(std::ceil(minLog)); exponent <= static_cast<int>(maxLog); exponent += 2) {
+        double x = mapX(std::pow(2.0, exponent));
+        painter.drawText(QRectF(x - 25, plot.bottom() + 3, 50, 14), Qt::AlignCenter,
+                         formatBytes(std::pow(2.0, exponent)));
+    }
+    painter.setPen(QPen(QColor(73, 80, 87), 1));
+    painter.drawLine(plot.bottomLeft(), plot.bottomRight());
+    painter.drawLine(plot.bottomLeft(), plot.topLeft());
+
+    // 曲线
+    QPainterPath path;
+    path.moveTo(mapX(curve.capacityBytes[0]), mapY(curve.hitRatio[0]));
+    for (int i = 1; i < curve.capacityBytes.size(); ++i) {
+        path.lineTo(mapX(curve.capacityBytes[i]), mapY(curve.hitRatio[i]));
+    }
+    painter.setPen(QPen(QColor(0, 123, 255), 2));
+    painter.drawPath(path);
+
+    // 当前配置容量
+    if (curve.configuredBytes > 0) {
+        double x = mapX(curve.configuredBytes);
+        if (x >= plot.left() && x <= plot.right()) {
+            QPen markerPen(QColor(220, 53, 69), 1.5, Qt::DashLine);
+            painter.setPen(markerPen);
+            painter.drawLine(QPointF(x, plot.top()), QPointF(x, plot.bottom()));
+
+            double ratio = curve.hitRatioAt(curve.configuredBytes);
+            painter.setBrush(QColor(220, 53, 69));
+            painter.drawEllipse(QPointF(x, mapY(ratio)), 3.5, 3.5);
+
+            painter.setFont(QFont("Arial", 8, QFont::Bold));
+            QString label = QString("%1: %2%").arg(formatBytes(curve.configuredBytes))
+                                              .arg(ratio * 100, 0, 'f', 1);
+            double labelX = x + 5 + 90 > plot.right() ? x - 95 : x + 5;
+            painter.drawText(QRectF(labelX, plot.top(), 90, 14), Qt::AlignLeft, label);
+        }
+    }
+
+    painter.setPen(QColor(108, 117, 125));
+    painter.setFont(QFont("Arial", 7));
+    painter.drawText(QRectF(plot.left(), height() - 14, plot.width(), 14), Qt::AlignCenter,
+                     QString("%1 accesses, LRU reuse distance").arg(curve.accessCount));
+}
@@ -0,0 +1,25 @@
+#ifndef MISSRATIOCHART_H
+#define MISSRATIOCHART_H
+
+#include "../analysis/MissRatioCurve.h"
+#include <QWidget>
+#include <QPaintEvent>
+
+// 命中率-容量曲线，横轴为对数刻度，竖线标出当前配置容量
+class MissRatioChart : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit MissRatioChart(const MissRatioCurve& curve, QWidget* parent = nullptr);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private:
+    static QString formatBytes(double bytes);
+
+    MissRatioCurve curve;
+};
+
+#endif // MISSRATIOCHART_H
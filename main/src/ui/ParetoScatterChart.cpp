@@ -0,0 +1,179 @@
+#include "ParetoScatterChart.h"
+#include <QPainter>
+#include <QPainterPath>
+#include <cmath>
+
+ParetoScatterChart::ParetoScatterChart(QWidget* parent)
+    : QWidget(parent)
+    , hasSelection(false)
+    , minLog(0), maxLog(1)
+    , minAmat(0), maxAmat(1)
+{
+    setMinimumHeight(260);
+    setStyleSheet("background-color: white;");
+    setCursor(Qt::PointingHandCursor);
+}
+
+void ParetoScatterChart::setData(const QVector<DesignPoint>& points, const QVector<DesignPoint>& front,
+                                 const DesignPoint& baseline)
+{
+    this->points = points;
+    this->front = front;
+    this->baseline = baseline;
+    updateRange();
+    update();
+}
+
+void ParetoScatterChart::updateRange()
+{
+    minLog = maxLog = baseline.capacityBytes > 0 ? std::log2(baseline.capacityBytes) : 0;
+    minAmat = maxAmat = baseline.amat;
+
+    for (const DesignPoint& point : points) {
+        if (point.capacityBytes <= 0) continue;
+        double log = std::log2(point.capacityBytes);
+        minLog = qMin(minLog, log);
+        maxLog = qMax(maxLog, log);
+        minAmat = qMin(minAmat, point.amat);
+        maxAmat = qMax(maxAmat, point.amat);
+    }
+
+    if (maxLog - minLog < 1) maxLog = minLog + 1;
+    double margin = qMax(0.5, (maxAmat - minAmat) * 0.05);
+    minAmat = qMax(0.0, minAmat - margin);
+    maxAmat += margin;
+}
+
+QRectF ParetoScatterChart::plotRect() const
+{
+    return QRectF(50, 25, width() - 65, height() - 60);
+}
+
+QPointF ParetoScatterChart::mapPoint(const DesignPoint& point) const
+{
+    QRectF plot = plotRect();
+    double x = plot.left() + (std::log2(qMax(1.0, point.capacityBytes)) - minLog) / (maxLog - minLog) * plot.width();
+    double y = plot.bottom() - (point.amat - minAmat) / (maxAmat - minAmat) * plot.height();
+    return QPointF(x, y);
+}
+
+void ParetoScatterChart::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+
+    QPainter painter(this);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.fillRect(rect(), Qt::white);
+
+    QRectF plot = plotRect();
+
+    painter.setPen(QColor(44, 62, 80));
+    painter.setFont(QFont("Arial", 9, QFont::Bold));
+    painter.drawText(QRectF(0, 2, width(), 20), Qt::AlignCenter,
+                     QString("AMAT vs Total Cache Capacity (%1 configs, %2 on front)")
+                         .arg(points.size()).arg(front.size()));
+
+    if (points.isEmpty()) {
+        painter.drawText(plot, Qt::AlignCenter, "No configurations evaluated yet");
+        return;
+    }
+
+    // 坐标轴与刻度
+    painter.setFont(QFont("Arial", 7));
+    painter.setPen(QPen(QColor(222, 226, 230), 1));
+    for (int i = 0; i <= 4; ++i) {
+        double y = plot.bottom() - i / 4.0 * plot.height();
+        painter.drawLine(QPointF(plot.left(), y), QPointF(plot.right(), y));
+    }
+    painter.setPen(QColor(108, 117, 125));
+    for (int i = 0; i <= 4; ++i) {
+        double y = plot.bottom() - i / 4.0 * plot.height();
+        double amat = minAmat + i / 4.0 * (maxAmat - minAmat);
+        painter.drawText(QRectF(0, y - 8, plot.left() - 5, 16), Qt::AlignRight | Qt::AlignVCenter,
+                         QString::number(amat, 'f', 1));
+    }
+    for (int exponent = static_cast<int>(std::ceil(minLog)); exponent <= static_cast<int>(maxLog); ++exponent) {
+        double x = plot.left() + (exponent - minLog) / (maxLog - minLog) * plot.width();
+        double kb = std::pow(2.0, exponent) / 1024.0;
+        QString label = kb >= 1024 ? QString("%1M").arg(kb / 1024.0, 0, 'g', 3) : QString("%1K").arg(kb, 0, 'g', 3);
+        painter.drawText(QRectF(x - 25, plot.bottom() + 3, 50, 14), Qt::AlignCenter, label);
+    }
+    painter.drawText(QRectF(plot.left(), height() - 16, plot.width(), 14), Qt::AlignCenter,
+                     "Total L2 + L3 capacity (log scale)");
+    painter.setPen(QPen(QColor(73, 80, 87), 1));
+    painter.drawLine(plot.bottomLeft(), plot.bottomRight());
+    painter.drawLine(plot.bottomLeft(), plot.topLeft());
+
+    // 所有配置
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(QColor(173, 181, 189, 140));
+    for (const DesignPoint& point : points) {
+        painter.drawEllipse(mapPoint(point), 2.0, 2.0);
+    }
+
+    // 帕累托前沿
+    if (!front.isEmpty()) {
+        QPainterPath path;
+        path.moveTo(mapPoint(front[0]));
+        for (int i = 1; i < front.size(); ++i) {
+            path.lineTo(mapPoint(front[i]));
+        }
+        painter.setBrush(Qt::NoBrush);
+        painter.setPen(QPen(QColor(0, 123, 255), 2));
+        painter.drawPath(path);
+
+        painter.setPen(Qt::NoPen);
+        painter.setBrush(QColor(0, 123, 255));
+        for (const DesignPoint& point : front) {
+            painter.drawEllipse(mapPoint(point), 3.5, 3.5);
+        }
+    }
+
+    // 当前配置
+    QPointF base = mapPoint(baseline);
+    painter.setPen(QPen(QColor(220, 53, 69), 2));
+    painter.setBrush(Qt::NoBrush);
+    painter.drawLine(base + QPointF(-5, -5), base + QPointF(5, 5));
+    painter.drawLine(base + QPointF(-5, 5), base + QPointF(5, -5));
+    painter.setFont(QFont("Arial", 8, QFont::Bold));
+    painter.drawText(QRectF(base.x() + 7, base.y() - 16, 80, 14), Qt::AlignLeft, "current");
+
+    // 选中的配置
+    if (hasSelection) {
+        painter.setPen(QPen(QColor(40, 167, 69), 2));
+        painter.drawEllipse(mapPoint(selected), 6.0, 6.0);
+    }
+}
+
+void ParetoScatterChart::mousePressEvent(QMouseEvent* event)
+{
+    if (points.isEmpty()) return;
+
+    // 前沿上的点优先，其次是所有配置中最近的点
+    QPointF click = event->position();
+    auto nearest = [&click, this](const QVector<DesignPoint>& candidates, double& bestDistance) {
+        int best = -1;
+        for (int i = 0; i < candidates.size(); ++i) {
+            QPointF delta = mapPoint(candidates[i]) - click;
+            double distance = delta.x() * delta.x() + delta.y() * delta.y();
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                best = i;
+            }
+        }
+        return best;
+    };
+
+    double frontDistance = 64.0;
+    int frontIndex = nearest(front, frontDistance);
+    if (frontIndex >= 0) {
+        selected = front[frontIndex];
+    } else {
+        double pointDistance = 1e18;
+        selected = points[nearest(points, pointDistance)];
+    }
+
+    hasSelection = true;
+    update();
+    emit pointSelected(selected);
+}
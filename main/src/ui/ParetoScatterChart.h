@@ -0,0 +1,43 @@
+#ifndef PARETOSCATTERCHART_H
+#define PARETOSCATTERCHART_H
+
+#include "../analysis/DesignSpaceExplorer.h"
+#include <QWidget>
+#include <QPaintEvent>
+#include <QMouseEvent>
+
+// 设计空间散点图: 横轴为总容量 (对数刻度)，纵轴为 AMAT
+// 灰点为已评估配置，折线为帕累托前沿，点击选中最近的配置
+class ParetoScatterChart : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit ParetoScatterChart(QWidget* parent = nullptr);
+
+    void setData(const QVector<DesignPoint>& points, const QVector<DesignPoint>& front,
+                 const DesignPoint& baseline);
+
+signals:
+    void pointSelected(const DesignPoint& point);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+
+private:
+    QRectF plotRect() const;
+    QPointF mapPoint(const DesignPoint& point) const;
+    void updateRange();
+
+    QVector<DesignPoint> points;
+    QVector<DesignPoint> front;
+    DesignPoint baseline;
+    DesignPoint selected;
+    bool hasSelection;
+
+    double minLog, maxLog;
+    double minAmat, maxAmat;
+};
+
+#endif // PARETOSCATTERCHART_H
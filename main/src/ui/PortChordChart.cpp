@@ -0,0 +1,360 @@
+#include "PortChordChart.h"
+#include <QCache>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QRegion>
+#include <QToolTip>
+#include <QtMath>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double kRibbonRadius = 0.9;       // 单位圆上，弦带端点所在的半径
+const double kArcInner = 0.93;
+const double kArcOuter = 1.0;
+const double kLabelRadius = 1.03;
+const double kStartAngle = 90;          // 第一个端口从正上方开始
+const double kMaxGapDegrees = 2.0;      // 相邻端口之间的空隙，端口多时按比例缩小
+const double kTotalGapDegrees = 72.0;
+const int kLabelSpace = 70;             // 圆外留给标签的像素
+const int kCachedGeometries = 4;
+const int kRibbonAlpha = 150;
+const int kTooltipFlows = 3;
+
+QPointF polar(double degrees, double radius)
+{
+    double radians = qDegreesToRadians(degrees);
+    return QPointF(radius * std::cos(radians), -radius * std::sin(radians));
+}
+
+QRectF circle(double radius)
+{
+    return QRectF(-radius, -radius, 2 * radius, 2 * radius);
+}
+
+}
+
+PortChordChart::PortChordChart(const PortTraffic& traffic, QWidget* parent)
+    : QWidget(parent)
+    , traffic(traffic)
+    , geometry(cachedGeometry(traffic))
+    , hoveredArc(-1)
+    , hoveredRibbon(-1)
+{
+    setMinimumHeight(320);
+    setMouseTracking(true);
+    setAttribute(Qt::WA_OpaquePaintEvent);
+}
+
+QSize PortChordChart::sizeHint() const
+{
+    return QSize(420, 420);
+}
+
+PortChordChart::Geometry PortChordChart::cachedGeometry(const PortTraffic& traffic)
+{
+    // 面板每次打开都会重新创建图表，同一矩阵的几何只计算一次 (只在界面线程使用)
+    static QCache<QByteArray, Geometry> cache(kCachedGeometries);
+
+    QByteArray key = traffic.fingerprint();
+    if (Geometry* cached = cache.object(key)) return *cached;
+
+    Geometry result = computeGeometry(traffic);
+    cache.insert(key, new Geometry(result));
+    return result;
+}
+
+PortChordChart::Geometry PortChordChart::computeGeometry(const PortTraffic& traffic)
+{
+    Geometry result;
+    const QVector<PortTraffic::Port>& ports = traffic.ports();
+    const QVector<PortTraffic::Flow>& flows = traffic.flows();
+    if (flows.isEmpty()) return result;
+
+    // 每个包在发送端与接收端各占一份弧长
+    int count = ports.size();
+    double gap = count > 1 ? qMin(kMaxGapDegrees, kTotalGapDegrees / count) : 0;
+    double degreesPerPacket = (360.0 - gap * count) / (2 * traffic.total());
+
+    result.arcs.resize(count);
+    double angle = kStartAngle;
+    for (int i = 0; i < count; ++i) {
+        Arc& arc = result.arcs[i];
+        arc.start = angle;
+        arc.span = (ports[i].sent + ports[i].received) * degreesPerPacket;
+        arc.color = nodeColor(ports[i].node);
+        arc.path.moveTo(polar(arc.start, kArcOuter));
+        arc.path.arcTo(circle(kArcOuter), arc.start, arc.span);
+        arc.path.lineTo(polar(arc.start + arc.span, kArcInner));
+        arc.path.arcTo(circle(kArcInner), arc.start + arc.span, -arc.span);
+        arc.path.closeSubpath();
+        angle += arc.span + gap;
+    }
+
+    // 弧内先排发送 (按接收端口的顺序)，再排接收 (按发送端口的顺序)，弦带不在弧内交叉
+    QVector<QVector<int>> outgoing(count);
+    QVector<QVector<int>> incoming(count);
+    for (int f = 0; f < flows.size(); ++f) {
+        outgoing[flows[f].from].append(f);
+        incoming[flows[f].to].append(f);
+        result.arcs[flows[f].from].ribbons.append(f);
+        if (flows[f].to != flows[f].from) result.arcs[flows[f].to].ribbons.append(f);
+    }
+    QVector<double> sourceStart(flows.size());
+    QVector<double> targetStart(flows.size());
+    for (int i = 0; i < count; ++i) {
+        std::sort(outgoing[i].begin(), outgoing[i].end(), [&flows](int a, int b) { return flows[a].to < flows[b].to; });
+        std::sort(incoming[i].begin(), incoming[i].end(), [&flows](int a, int b) { return flows[a].from < flows[b].from; });
+        double cursor = result.arcs[i].start;
+        for (int f : outgoing[i]) {
+            sourceStart[f] = cursor;
+            cursor += flows[f].packets * degreesPerPacket;
+        }
+        for (int f : incoming[i]) {
+            targetStart[f] = cursor;
+            cursor += flows[f].packets * degreesPerPacket;
+        }
+    }
+
+    result.ribbons.resize(flows.size());
+    QRectF inner = circle(kRibbonRadius);
+    for (int f = 0; f < flows.size(); ++f) {
+        Ribbon& ribbon = result.ribbons[f];
+        double width = flows[f].packets * degreesPerPacket;
+        double s = sourceStart[f];
+        double t = targetStart[f];
+        ribbon.flow = f;
+        ribbon.color = result.arcs[flows[f].from].color;
+        ribbon.path.moveTo(polar(s, kRibbonRadius));
+        ribbon.path.arcTo(inner, s, width);
+        ribbon.path.quadTo(QPointF(0, 0), polar(t, kRibbonRadius));
+        ribbon.path.arcTo(inner, t, width);
+        ribbon.path.quadTo(QPointF(0, 0), polar(s, kRibbonRadius));
+        ribbon.path.closeSubpath();
+        ribbon.bounds = ribbon.path.boundingRect();
+    }
+    return result;
+}
+
+QColor PortChordChart::nodeColor(int node)
+{
+    if (node < 0) return QColor(150, 150, 150);
+    // 黄金分割取色相，相邻节点颜色差别大
+    return QColor::fromHsvF(std::fmod(node * 0.618034, 1.0), 0.6, 0.85);
+}
+
+QTransform PortChordChart::chartTransform() const
+{
+    double radius = qMax(20.0, qMin(width(), height()) / 2.0 - kLabelSpace);
+    QTransform transform;
+    transform.translate(width() / 2.0, height() / 2.0);
+    transform.scale(radius, radius);
+    return transform;
+}
+
+void PortChordChart::renderBase()
+{
+    qreal ratio = devicePixelRatioF();
+    base = QPixmap(size() * ratio);
+    base.setDevicePixelRatio(ratio);
+    base.fill(Qt::white);
+    pick = QImage(size(), QImage::Format_RGB32);
+    pick.fill(0);
+
+    QPainter painter(&base);
+    painter.setRenderHint(QPainter::Antialiasing);
+    if (geometry.ribbons.isEmpty()) {
+        painter.setPen(QColor(108, 117, 125));
+        painter.drawText(rect(), Qt::AlignCenter, "No port-to-port traffic");
+        return;
+    }
+
+    // 大的弦带先画，小的叠在上面仍然可见；拾取图按相同顺序画，不开抗锯齿以免编号混色
+    QTransform transform = chartTransform();
+    QPainter picker(&pick);
+    painter.setTransform(transform);
+    picker.setTransform(transform);
+    painter.setPen(Qt::NoPen);
+    for (int i = 0; i < geometry.ribbons.size(); ++i) {
+        const Ribbon& ribbon = geometry.ribbons[i];
+        QColor color = ribbon.color;
+        color.setAlpha(kRibbonAlpha);
+        painter.fillPath(ribbon.path, color);
+        picker.fillPath(ribbon.path, QColor::fromRgb(static_cast<QRgb>(i + 1)));
+    }
+    picker.end();
+    for (const Arc& arc : geometry.arcs) {
+        painter.fillPath(arc.path, arc.color);
+    }
+
+    // 弧长放得下一行文字时才标注，端口很多时只标出流量大的端口
+    painter.resetTransform();
+    QFont font = painter.font();
+    font.setPointSize(8);
+    painter.setFont(font);
+    painter.setPen(QColor(52, 58, 64));
+    QFontMetrics metrics(font);
+    double radius = transform.m11();
+    for (int i = 0; i < geometry.arcs.size(); ++i) {
+        const Arc& arc = geometry.arcs[i];
+        if (qDegreesToRadians(arc.span) * radius < metrics.height()) continue;
+        double middle = arc.start + arc.span / 2;
+        QPointF anchor = transform.map(polar(middle, kLabelRadius));
+        bool right = std::cos(qDegreesToRadians(middle)) >= 0;
+        QString text = metrics.elidedText(traffic.ports()[i].label(), Qt::ElideMiddle, kLabelSpace * 2);
+        QRectF box(right ? anchor.x() : anchor.x() - kLabelSpace * 2, anchor.y() - metrics.height() / 2.0,
+                   kLabelSpace * 2, metrics.height());
+        painter.drawText(box, (right ? Qt::AlignLeft : Qt::AlignRight) | Qt::AlignVCenter, text);
+    }
+}
+
+void PortChordChart::paintEvent(QPaintEvent* event)
+{
+    Q_UNUSED(event);
+    if (base.isNull()) renderBase();
+
+    QPainter painter(this);
+    painter.drawPixmap(0, 0, base);
+    if (hoveredArc < 0 && hoveredRibbon < 0) return;
+
+    // 高亮的弦带不透明并描边，画在位图之上；重绘区域只包含这些弦带
+    QVector<int> highlighted = hoveredArc >= 0 ? geometry.arcs[hoveredArc].ribbons : QVector<int>{hoveredRibbon};
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setTransform(chartTransform());
+    for (int i : highlighted) {
+        const Ribbon& ribbon = geometry.ribbons[i];
+        QPen pen(ribbon.color.darker(160), 1);
+        pen.setCosmetic(true);
+        painter.setPen(pen);
+        painter.setBrush(ribbon.color);
+        painter.drawPath(ribbon.path);
+    }
+
+    QPen outline(QColor(33, 37, 41), 2);
+    outline.setCosmetic(true);
+    painter.setPen(outline);
+    painter.setBrush(Qt::NoBrush);
+    if (hoveredArc >= 0) {
+        painter.drawPath(geometry.arcs[hoveredArc].path);
+    } else {
+        const PortTraffic::Flow& flow = traffic.flows()[hoveredRibbon];
+        painter.drawPath(geometry.arcs[flow.from].path);
+        painter.drawPath(geometry.arcs[flow.to].path);
+    }
+}
+
+void PortChordChart::resizeEvent(QResizeEvent* event)
+{
+    QWidget::resizeEvent(event);
+    base = QPixmap();
+    pick = QImage();
+}
+
+int PortChordChart::arcAt(const QPointF& unitPoint) const
+{
+    if (geometry.arcs.isEmpty()) return -1;
+    double angle = qRadiansToDegrees(std::atan2(-unitPoint.y(), unitPoint.x()));
+    while (angle < kStartAngle) angle += 360;
+    while (angle >= kStartAngle + 360) angle -= 360;
+
+    // 圆弧按起始角递增排列
+    auto next = std::upper_bound(geometry.arcs.begin(), geometry.arcs.end(), angle,
+                                 [](double value, const Arc& arc) { return value < arc.start; });
+    if (next == geometry.arcs.begin()) return -1;
+    int index = static_cast<int>(next - geometry.arcs.begin()) - 1;
+    const Arc& arc = geometry.arcs[index];
+    return angle <= arc.start + arc.span ? index : -1;
+}
+
+void PortChordChart::mouseMoveEvent(QMouseEvent* event)
+{
+    QPointF position = event->position();
+    QPointF unit = chartTransform().inverted().map(position);
+    double radius = std::hypot(unit.x(), unit.y());
+
+    int arc = -1;
+    int ribbon = -1;
+    if (radius >= kArcInner - 0.01 && radius <= kArcOuter + 0.02) {
+        arc = arcAt(unit);
+    } else if (radius < kRibbonRadius && !pick.isNull() && pick.rect().contains(position.toPoint())) {
+        ribbon = static_cast<int>(pick.pixel(position.toPoint()) & 0xFFFFFF) - 1;
+    }
+    setHover(arc, ribbon);
+
+    if (arc >= 0 || ribbon >= 0) {
+        QToolTip::showText(event->globalPosition().toPoint(), tooltipText(), this);
+    } else {
+        QToolTip::hideText();
+    }
+    QWidget::mouseMoveEvent(event);
+}
+
+void PortChordChart::leaveEvent(QEvent* event)
+{
+    setHover(-1, -1);
+    QWidget::leaveEvent(event);
+}
+
+QRect PortChordChart::ribbonRect(int ribbon) const
+{
+    return chartTransform().mapRect(geometry.ribbons[ribbon].bounds).toAlignedRect().adjusted(-2, -2, 2, 2);
+}
+
+void PortChordChart::setHover(int arc, int ribbon)
+{
+    if (arc == hoveredArc && ribbon == hoveredRibbon) return;
+
+    // 只重绘高亮前后涉及的弦带与圆弧
+    QTransform transform = chartTransform();
+    QRegion dirty;
+    auto addHover = [&](int hoverArc, int hoverRibbon) {
+        if (hoverArc >= 0) {
+            dirty += transform.mapRect(geometry.arcs[hoverArc].path.boundingRect()).toAlignedRect().adjusted(-2, -2, 2, 2);
+            for (int i : geometry.arcs[hoverArc].ribbons) dirty += ribbonRect(i);
+        }
+        if (hoverRibbon >= 0) {
+            const PortTraffic::Flow& flow = traffic.flows()[hoverRibbon];
+            dirty += ribbonRect(hoverRibbon);
+            dirty += transform.mapRect(geometry.arcs[flow.from].path.boundingRect()).toAlignedRect().adjusted(-2, -2, 2, 2);
+            dirty += transform.mapRect(geometry.arcs[flow.to].path.boundingRect()).toAlignedRect().adjusted(-2, -2, 2, 2);
+        }
+    };
+    addHover(hoveredArc, hoveredRibbon);
+    hoveredArc = arc;
+    hoveredRibbon = ribbon >= 0 && ribbon < geometry.ribbons.size() ? ribbon : -1;
+    addHover(hoveredArc, hoveredRibbon);
+    update(dirty);
+}
+
+QString PortChordChart::tooltipText() const
+{
+    const QVector<PortTraffic::Port>& ports = traffic.ports();
+    const QVector<PortTraffic::Flow>& flows = traffic.flows();
+    auto share = [this](double packets) { return QString::number(packets / traffic.total() * 100, 'f', 1); };
+
+    if (hoveredRibbon >= 0) {
+        const PortTraffic::Flow& flow = flows[hoveredRibbon];
+        return QString("%1 → %2\n%3 packages (%4% of all)")
+            .arg(ports[flow.from].label(), ports[flow.to].label())
+            .arg(flow.packets, 0, 'f', 0)
+            .arg(share(flow.packets));
+    }
+    if (hoveredArc < 0) return QString();
+
+    const PortTraffic::Port& port = ports[hoveredArc];
+    QString text = port.label();
+    if (port.node >= 0) text += QString("\nBus node %1").arg(port.node);
+    text += QString("\nSent: %1, Received: %2").arg(port.sent, 0, 'f', 0).arg(port.received, 0, 'f', 0);
+
+    // 弦带按包数从大到小编号，前几条即最大的流
+    int shown = 0;
+    for (int i : geometry.arcs[hoveredArc].ribbons) {
+        if (shown++ == kTooltipFlows) break;
+        const PortTraffic::Flow& flow = flows[i];
+        text += flow.from == hoveredArc
+                    ? QString("\n→ %1: %2").arg(ports[flow.to].label()).arg(flow.packets, 0, 'f', 0)
+                    : QString("\n← %1: %2").arg(ports[flow.from].label()).arg(flow.packets, 0, 'f', 0);
+    }
+    return text;
+}
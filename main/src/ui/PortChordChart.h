@@ -0,0 +1,75 @@
+#ifndef PORTCHORDCHART_H
+#define PORTCHORDCHART_H
+
+#include "../analysis/PortTraffic.h"
+#include <QWidget>
+#include <QColor>
+#include <QImage>
+#include <QPainterPath>
+#include <QPixmap>
+#include <QTransform>
+#include <QPaintEvent>
+#include <QMouseEvent>
+#include <QResizeEvent>
+
+// 端口间流量的弦图: 每个端口一段圆弧 (长度为发送与接收之和，先发送后接收)，
+// 每个非零端口对一条弦带，两端宽度为包数，颜色取发送端口所在的总线节点
+// 几何在单位圆上计算，按矩阵摘要缓存，改变尺寸只改变变换；全部弦带画成一张位图，
+// 同时画一张以弦带编号为颜色的拾取图，悬停时查表得到弦带，只重绘高亮前后涉及的弦带范围
+class PortChordChart : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit PortChordChart(const PortTraffic& traffic, QWidget* parent = nullptr);
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void resizeEvent(QResizeEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void leaveEvent(QEvent* event) override;
+
+private:
+    struct Arc {
+        double start = 0;           // 角度，与 QPainterPath::arcTo 相同 (逆时针，0 度朝右)
+        double span = 0;
+        QPainterPath path;
+        QColor color;
+        QVector<int> ribbons;       // 与这个端口相连的弦带
+    };
+
+    struct Ribbon {
+        int flow = 0;               // PortTraffic::flows() 的下标
+        QPainterPath path;
+        QRectF bounds;
+        QColor color;
+    };
+
+    struct Geometry {
+        QVector<Arc> arcs;          // 与 PortTraffic::ports() 同序
+        QVector<Ribbon> ribbons;    // 与 PortTraffic::flows() 同序 (从大到小)
+    };
+
+    static Geometry cachedGeometry(const PortTraffic& traffic);
+    static Geometry computeGeometry(const PortTraffic& traffic);
+    static QColor nodeColor(int node);
+
+    QTransform chartTransform() const;          // 单位圆 -> 控件坐标
+    void renderBase();
+    int arcAt(const QPointF& unitPoint) const;
+    void setHover(int arc, int ribbon);
+    QRect ribbonRect(int ribbon) const;
+    QString tooltipText() const;
+
+    PortTraffic traffic;
+    Geometry geometry;
+
+    QPixmap base;                   // 全部弦带、圆弧与标签
+    QImage pick;                    // 每个像素为弦带编号 + 1，0 为空白
+    int hoveredArc;
+    int hoveredRibbon;
+};
+
+#endif // PORTCHORDCHART_H
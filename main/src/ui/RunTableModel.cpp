@@ -0,0 +1,59 @@
+#include "RunTableModel.h"
+#include <cmath>
+
+RunTableModel::RunTableModel(QObject* parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void RunTableModel::setRuns(const QStringList& runIds, const QStringList& columnNames,
+                            const QVector<QVector<double>>& columns)
+{
+    beginResetModel();
+    this->runIds = runIds;
+    this->columnNames = columnNames;
+    this->columns = columns;
+    endResetModel();
+}
+
+int RunTableModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : runIds.size();
+}
+
+int RunTableModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : columnNames.size() + 1;
+}
+
+QVariant RunTableModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid()) return QVariant();
+
+    int row = index.row();
+    if (index.column() == 0) {
+        if (role == Qt::DisplayRole || role == Qt::ToolTipRole || role == Qt::UserRole) return runIds[row];
+        return QVariant();
+    }
+
+    double value = columns[index.column() - 1][row];
+    switch (role) {
+    case Qt::DisplayRole:
+        if (std::isnan(value)) return QString("-");
+        return value == std::floor(value) && std::fabs(value) < 1e15 ? QString::number(value, 'f', 0)
+                                                                      : QString::number(value, 'g', 5);
+    case Qt::UserRole:
+        // 缺失值按负无穷排序
+        return std::isnan(value) ? -HUGE_VAL : value;
+    case Qt::TextAlignmentRole:
+        return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+    default:
+        return QVariant();
+    }
+}
+
+QVariant RunTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) return QVariant();
+    return section == 0 ? QString("Run") : columnNames.value(section - 1);
+}
@@ -0,0 +1,31 @@
+#ifndef RUNTABLEMODEL_H
+#define RUNTABLEMODEL_H
+
+#include <QAbstractTableModel>
+#include <QStringList>
+#include <QVector>
+
+// 运行列表的表格模型: 第一列为运行标识，其余为数值列
+// 只保存列式数据，视图按需取值，数万行也能即时显示；Qt::UserRole 返回数值用于排序
+class RunTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit RunTableModel(QObject* parent = nullptr);
+
+    void setRuns(const QStringList& runIds, const QStringList& columnNames,
+                 const QVector<QVector<double>>& columns);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+private:
+    QStringList runIds;
+    QStringList columnNames;
+    QVector<QVector<double>> columns;
+};
+
+#endif // RUNTABLEMODEL_H
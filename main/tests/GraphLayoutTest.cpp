@@ -0,0 +1,118 @@
+#include "../src/graphics/GraphLayout.h"
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <utility>
+#include <vector>
+
+// GraphLayout 规则排布的不变量: 环与链相邻节点在网格上相邻，能排满的环首尾都在第 0 列，
+// 网格按行列原样排列，任何排布中每个单元最多一个节点
+
+namespace {
+
+int failures = 0;
+
+void check(bool condition, const char* what, int count)
+{
+    if (condition) return;
+    fprintf(stderr, "FAIL (%d nodes): %s\n", count, what);
+    failures++;
+}
+
+bool adjacentCells(const GraphLayout::Result& result, int a, int b)
+{
+    return std::abs(result.row[a] - result.row[b]) + std::abs(result.column[a] - result.column[b]) == 1;
+}
+
+bool distinctCells(const GraphLayout::Result& result, int count)
+{
+    std::set<std::pair<int, int>> cells;
+    for (int i = 0; i < count; ++i) {
+        if (result.row[i] < 0 || result.row[i] >= result.rows) return false;
+        if (result.column[i] < 0 || result.column[i] >= result.columns) return false;
+        cells.insert({result.row[i], result.column[i]});
+    }
+    return static_cast<int>(cells.size()) == count;
+}
+
+// 节点编号打乱后连成环、链或网格，确认识别不依赖编号顺序 (count 须与 7919 互质)
+std::vector<int> shuffledNodes(int count)
+{
+    std::vector<int> nodes(count);
+    for (int i = 0; i < count; ++i) nodes[i] = (i * 7919) % count;
+    return nodes;
+}
+
+void testChain(int count, bool closed)
+{
+    std::vector<int> nodes = shuffledNodes(count);
+    std::vector<std::pair<int, int>> edges;
+    for (int i = 0; i + 1 < count; ++i) edges.emplace_back(nodes[i], nodes[i + 1]);
+    if (closed) edges.emplace_back(nodes[count - 1], nodes[0]);
+
+    GraphLayout::Result result = GraphLayout::compute(count, edges);
+    check(result.kind == (closed ? GraphLayout::Ring : GraphLayout::Line), "ring or line recognised", count);
+    check(distinctCells(result, count), "one node per cell", count);
+
+    // 链的每条边都连接相邻单元；环从哪个节点开始不确定，不相邻的边最多一条 (闭合边)
+    std::vector<std::pair<int, int>> gaps;
+    for (const auto& edge : edges) {
+        if (!adjacentCells(result, edge.first, edge.second)) gaps.push_back(edge);
+    }
+    if (!closed) {
+        check(gaps.empty(), "chain neighbours share a cell edge", count);
+        return;
+    }
+    check(gaps.size() <= 1, "ring breaks at most at the closing edge", count);
+
+    // 排满偶数行的环，闭合边的两端都在第 0 列，沿左侧通道直上
+    bool filled = result.rows % 2 == 0 && result.rows * result.columns == count;
+    if (count % 4 == 0) check(filled, "ring with an even factorisation fills even rows", count);
+    if (filled && !gaps.empty()) {
+        check(result.column[gaps[0].first] == 0 && result.column[gaps[0].second] == 0,
+              "closing edge runs straight up column 0", count);
+    }
+}
+
+void testMesh(int rows, int columns)
+{
+    const int count = rows * columns;
+    std::vector<int> nodes = shuffledNodes(count);
+    auto at = [&](int r, int c) { return nodes[r * columns + c]; };
+    std::vector<std::pair<int, int>> edges;
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < columns; ++c) {
+            if (c + 1 < columns) edges.emplace_back(at(r, c), at(r, c + 1));
+            if (r + 1 < rows) edges.emplace_back(at(r, c), at(r + 1, c));
+        }
+    }
+
+    GraphLayout::Result result = GraphLayout::compute(count, edges);
+    check(result.kind == GraphLayout::Mesh, "mesh recognised", count);
+    check(result.rows * result.columns == count, "mesh fills its grid", count);
+    check(distinctCells(result, count), "one node per cell", count);
+    bool neighbours = true;
+    for (const auto& edge : edges) neighbours = neighbours && adjacentCells(result, edge.first, edge.second);
+    check(neighbours, "mesh edges share a cell edge", count);
+}
+
+}
+
+int main()
+{
+    for (int count : {9, 12, 16, 30, 31, 64, 100, 5000}) {
+        testChain(count, false);
+        testChain(count, true);
+    }
+    testMesh(2, 3);
+    testMesh(3, 5);
+    testMesh(8, 8);
+    testMesh(16, 12);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d checks failed\n", failures);
+        return 1;
+    }
+    printf("GraphLayout: all checks passed\n");
+    return 0;
+}